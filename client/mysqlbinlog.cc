@@ -62,6 +62,10 @@ static void warning(const char *format, ...) ATTRIBUTE_FORMAT(printf, 1, 2);
 #include "semisync_slave_client.h"
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 
 using std::min;
 using std::max;
@@ -213,6 +217,12 @@ enum class Check_database_decision : signed char {
 */
 static Format_description_log_event* glob_description_event= NULL;
 
+/**
+  Offset of the Format_description_log_event that check_header() found
+  before the start position of the local binlog, 0 if it found none.
+*/
+static my_off_t glob_description_event_pos= 0;
+
 /**
   Exit status for functions in this file.
 */
@@ -249,6 +259,8 @@ ReplSemiSyncSlave repl_semisync;
 
 static uint opt_receive_buffer_size = 0;
 static uint opt_flush_result_file = 0;
+static ulonglong opt_read_ahead_size= 0;
+static uint opt_decode_threads= 1;
 
 static Exit_status dump_local_log_entries(PRINT_EVENT_INFO *print_event_info,
                                           const char* logname);
@@ -257,6 +269,8 @@ static Exit_status dump_remote_log_entries(PRINT_EVENT_INFO *print_event_info,
 static Exit_status dump_single_log(PRINT_EVENT_INFO *print_event_info,
                                    const char* logname);
 static Exit_status dump_multiple_logs(int argc, char **argv);
+static void start_file_readers(char **lognames, int first, int last);
+static void stop_file_readers();
 static Exit_status safe_connect();
 
 /**
@@ -2310,6 +2324,19 @@ static struct my_option my_long_options[] =
    "for initialization of previous gtid sets (local log only).",
    &opt_index_file_str, &opt_index_file_str, 0,
    GET_STR_ALLOC, REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
+  {"read-ahead-size", OPT_READ_AHEAD_SIZE,
+   "Read and decode the events of local binlog files on a separate thread, "
+   "up to this many bytes per file ahead of the printing, and skip the "
+   "events filtered out by GTID or by database without printing them. "
+   "0 reads and decodes the events on the printing thread.",
+   &opt_read_ahead_size, &opt_read_ahead_size, 0,
+   GET_ULL, REQUIRED_ARG, 0, 0, ULONGLONG_MAX, 0, 0, 0},
+  {"decode-threads", OPT_DECODE_THREADS,
+   "Number of local binlog files read and decoded at the same time with "
+   "--read-ahead-size, each on its own thread: the file being printed and "
+   "the files after it. The events are still printed in binlog order.",
+   &opt_decode_threads, &opt_decode_threads, 0,
+   GET_UINT, REQUIRED_ARG, 1, 1, 256, 0, 0, 0},
   {0, 0, 0, 0, 0, 0, GET_NO_ARG, NO_ARG, 0, 0, 0, 0, 0, 0}
 };
 
@@ -2700,16 +2727,29 @@ static Exit_status dump_multiple_logs(int argc, char **argv)
   // Dump all logs.
   my_off_t save_stop_position= stop_position;
   stop_position= ~(my_off_t)0;
+  int read_ahead_end= 1;
   for (int i= 0; i < argc; i++)
   {
     if (i == argc - 1) // last log, --stop-position applies
       stop_position= save_stop_position;
+    /*
+      Decode the local logs after this one while it is printed, up to
+      --decode-threads logs at a time. This log gets its reader when it is
+      opened, as it may start at --start-position.
+    */
+    if (opt_read_ahead_size && opt_remote_proto == BINLOG_LOCAL)
+    {
+      int end= min<int>(argc, i + opt_decode_threads);
+      start_file_readers(argv, read_ahead_end, end);
+      read_ahead_end= end;
+    }
     if ((rc= dump_single_log(&print_event_info, argv[i])) != OK_CONTINUE)
       break;
 
     // For next log, --start-position does not apply
     start_position= BIN_LOG_HEADER_SIZE;
   }
+  stop_file_readers();
 
   if (buff_ev.elements > 0)
     warning("The range of printed events ends with an Intvar_event, "
@@ -3485,6 +3525,7 @@ static Exit_status check_header(IO_CACHE* file,
     error("Failed creating Format_description_log_event; out of memory?");
     DBUG_RETURN(ERROR_STOP);
   }
+  glob_description_event_pos= 0;
 
   pos= my_b_tell(file);
 
@@ -3641,6 +3682,7 @@ static Exit_status check_header(IO_CACHE* file,
                   "out of memory?");
             DBUG_RETURN(ERROR_STOP);
           }
+          glob_description_event_pos= 0;
         }
         break;
       }
@@ -3661,6 +3703,7 @@ static Exit_status check_header(IO_CACHE* file,
                 (ulonglong)tmp_pos);
           DBUG_RETURN(ERROR_STOP);
         }
+        glob_description_event_pos= tmp_pos;
         if (opt_base64_output_mode == BASE64_OUTPUT_AUTO)
         {
           /*
@@ -3705,6 +3748,562 @@ static Exit_status check_header(IO_CACHE* file,
 }
 
 
+/**
+  Reads the table id and the flags of a row event from its raw buffer,
+  as the Rows_log_event constructor does.
+
+  @param[in] buf Raw event
+  @param[in] description_event Description of the event
+  @param[out] table_id Id of the table of the rows
+  @param[out] flags Flags of the event
+
+  @retval true  *table_id and *flags are set
+  @retval false the event cannot be read without decoding it
+*/
+static bool read_rows_event_header(const char *buf,
+                                   const Format_description_log_event
+                                   *description_event,
+                                   ulonglong *table_id, uint16 *flags)
+{
+  uint const event_type= (uchar) buf[EVENT_TYPE_OFFSET];
+  uint8 const common_header_len= description_event->common_header_len;
+
+  if (description_event->event_type_permutation ||
+      event_type > description_event->number_of_event_types)
+    return false;
+  uint8 const post_header_len=
+    description_event->post_header_len[event_type - 1];
+  if (post_header_len < 6 ||
+      uint4korr(buf + EVENT_LEN_OFFSET) < (uint) common_header_len +
+                                          post_header_len)
+    return false;
+
+  const char *post_start= buf + common_header_len + RW_MAPID_OFFSET;
+  if (post_header_len == 6)
+  {
+    *table_id= uint4korr(post_start);
+    post_start+= 4;
+  }
+  else
+  {
+    *table_id= uint6korr(post_start);
+    post_start+= RW_FLAGS_OFFSET;
+  }
+  *flags= uint2korr(post_start);
+  return true;
+}
+
+
+/**
+  Reads the events of a local binlog file and decodes them on a separate
+  thread, so that the printing thread only has to filter and print them.
+  Used with --read-ahead-size.
+
+  The reader opens the file itself, so that the files following the one
+  being printed can be decoded at the same time (--decode-threads). It
+  stays up to --read-ahead-size bytes of events ahead of the printing; the
+  events are still handed over in file order. It stops at the end of the
+  file and at the first event it cannot read or decode. The caller then
+  seeks back to the position returned by next() and reads on with
+  Log_event::read_log_event(), which reports the end of file or the error
+  as it does without the reader.
+
+  The reader does not decode the events that it expects process_event()
+  to filter out: the events of transactions filtered out by GTID, and the
+  row events of tables filtered out by --database or --table. It tracks
+  the filtering from the events of its own file only, so the caller makes
+  the final decision with skip_filtered_event().
+*/
+class Binlog_event_reader
+{
+public:
+  /**
+    @param logname Name of the binlog file
+    @param start_pos Offset of the first event to return
+    @param fde_pos Offset of the Format_description_log_event in effect
+    at start_pos, 0 if there is none
+    @param read_ahead_size Size of the events to queue at most
+  */
+  Binlog_event_reader(const char *logname, my_off_t start_pos,
+                      my_off_t fde_pos, ulonglong read_ahead_size)
+    : m_logname(logname), m_start_pos(start_pos), m_fde_pos(fde_pos),
+      m_read_ahead_size(read_ahead_size), m_description_event(NULL),
+      m_gtid_filtered(false), m_bytes(0), m_end_pos(start_pos),
+      m_done(false), m_stop(false)
+  {
+    DBUG_ASSERT(m_read_ahead_size > 0);
+    m_thread= std::thread(&Binlog_event_reader::run, this);
+  }
+
+  ~Binlog_event_reader()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop= true;
+    }
+    m_cond.notify_all();
+    m_thread.join();
+    for (const Event &event : m_events)
+    {
+      if (event.ev)
+        delete event.ev;
+      else
+        my_free(event.buf);
+    }
+  }
+
+  /** Whether the reader returns the events of logname from pos on */
+  bool reads(const char *logname, my_off_t pos) const
+  {
+    return logname == m_logname && pos == m_start_pos;
+  }
+
+  /**
+    Return the next event: decoded in *ev, or in the raw buffer *buf if
+    the reader expects it to be filtered out. The caller must delete *ev
+    or free *buf.
+
+    @retval true  *ev, *buf and *pos are set to the event and its offset
+    @retval false the reader stopped; *pos is set to the position of the
+                  first event it did not return
+  */
+  bool next(Log_event **ev, char **buf, my_off_t *pos)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cond.wait(lock, [this] { return !m_events.empty() || m_done; });
+    if (m_events.empty())
+    {
+      *pos= m_end_pos;
+      return false;
+    }
+    const Event &event= m_events.front();
+    *ev= event.ev;
+    *buf= event.buf;
+    *pos= event.pos;
+    m_bytes-= event.len;
+    m_events.pop_front();
+    lock.unlock();
+    m_cond.notify_all();
+    return true;
+  }
+
+private:
+  struct Event
+  {
+    Log_event *ev;
+    char *buf;
+    ulong len;
+    my_off_t pos;
+  };
+
+  /** Whether the transaction of a Gtid_log_event is filtered out */
+  bool is_gtid_filtered(Gtid_log_event *gtid)
+  {
+    /* --print-gtids adds to gtid_set_excluded while the events are printed */
+    if (opt_print_gtids ||
+        (opt_include_gtids_str == NULL && opt_exclude_gtids_str == NULL))
+      return false;
+
+    rpl_sidno sidno= gtid->get_sidno(true);
+    global_sid_lock->rdlock();
+    bool filtered=
+      (opt_include_gtids_str != NULL &&
+       !gtid_set_included->contains_gtid(sidno, gtid->get_gno())) ||
+      (opt_exclude_gtids_str != NULL &&
+       gtid_set_excluded->contains_gtid(sidno, gtid->get_gno()));
+    global_sid_lock->unlock();
+    return filtered;
+  }
+
+  /** Whether process_event() is expected to filter out a raw event */
+  bool is_filtered(const char *buf)
+  {
+    ulonglong table_id;
+    uint16 flags;
+
+    switch ((uchar) buf[EVENT_TYPE_OFFSET])
+    {
+    case WRITE_ROWS_EVENT:
+    case UPDATE_ROWS_EVENT:
+    case DELETE_ROWS_EVENT:
+    case WRITE_ROWS_EVENT_V1:
+    case UPDATE_ROWS_EVENT_V1:
+    case DELETE_ROWS_EVENT_V1:
+      if (!read_rows_event_header(buf, m_description_event, &table_id,
+                                  &flags))
+        return false;
+      /* process_event() flushes the statement on its last event */
+      if (flags & Rows_log_event::STMT_END_F)
+      {
+        m_ignored_tables.clear();
+        return m_gtid_filtered;
+      }
+      return m_gtid_filtered || m_ignored_tables.count(table_id);
+    case TABLE_MAP_EVENT:
+    case ROWS_QUERY_LOG_EVENT:
+    case INTVAR_EVENT:
+    case RAND_EVENT:
+    case USER_VAR_EVENT:
+      return m_gtid_filtered;
+    default:
+      return false;
+    }
+  }
+
+  /** Track the filtering from a decoded event, as process_event() does */
+  void track(Log_event *ev)
+  {
+    switch (ev->get_type_code())
+    {
+    case GTID_LOG_EVENT:
+    case ANONYMOUS_GTID_LOG_EVENT:
+      m_gtid_filtered= is_gtid_filtered(static_cast<Gtid_log_event*>(ev));
+      break;
+    case XID_EVENT:
+      m_gtid_filtered= false;
+      break;
+    case QUERY_EVENT:
+      if (static_cast<Query_log_event*>(ev)->ends_group())
+        m_gtid_filtered= false;
+      break;
+    case TABLE_MAP_EVENT:
+    {
+      Table_map_log_event *map= static_cast<Table_map_log_event*>(ev);
+      if (shall_skip_table(map->get_db_name(), map->get_table_name()))
+        m_ignored_tables.insert(map->get_table_id());
+      break;
+    }
+    default:
+      break;
+    }
+  }
+
+  /**
+    Read the next event, and decode it unless it is expected to be
+    filtered out. A Format_description_log_event also becomes the
+    description of the events after it.
+  */
+  bool read(IO_CACHE *file, Event *event)
+  {
+    uchar head[LOG_EVENT_MINIMAL_HEADER_LEN];
+    uint header_size= min<uint>(m_description_event->common_header_len,
+                                LOG_EVENT_MINIMAL_HEADER_LEN);
+    ulong const max_size=
+      max<ulong>(max_allowed_packet,
+                 opt_binlog_rows_event_max_size + MAX_LOG_EVENT_HEADER);
+    const char *error;
+    char *buf;
+
+    event->pos= my_b_tell(file);
+    event->ev= NULL;
+    event->buf= NULL;
+    if (my_b_read(file, head, header_size))
+      return false;
+    event->len= uint4korr(head + EVENT_LEN_OFFSET);
+    if (event->len < header_size || event->len > max_size ||
+        !(buf= (char*) my_malloc(event->len + 1, MYF(MY_WME))))
+      return false;
+
+    // some events use the extra byte to null-terminate strings
+    buf[event->len]= 0;
+    memcpy(buf, head, header_size);
+    if (my_b_read(file, (uchar*) buf + header_size, event->len - header_size))
+    {
+      my_free(buf);
+      return false;
+    }
+
+    if (is_filtered(buf))
+    {
+      if (opt_verify_binlog_checksum &&
+          event_checksum_test((uchar*) buf, event->len,
+                              m_description_event->checksum_alg))
+      {
+        my_free(buf);
+        return false;
+      }
+      event->buf= buf;
+      return true;
+    }
+
+    if (!(event->ev= Log_event::read_log_event(buf, event->len, &error,
+                                               m_description_event,
+                                               opt_verify_binlog_checksum)))
+    {
+      my_free(buf);
+      return false;
+    }
+    event->ev->register_temp_buf(buf);
+    track(event->ev);
+
+    if (event->ev->get_type_code() == FORMAT_DESCRIPTION_EVENT)
+    {
+      /* The printing takes the event over, decode it again to keep it */
+      Log_event *fde= Log_event::read_log_event(buf, event->len, &error,
+                                                m_description_event, FALSE);
+      if (!fde || fde->get_type_code() != FORMAT_DESCRIPTION_EVENT)
+      {
+        delete fde;
+        delete event->ev;
+        return false;
+      }
+      delete m_description_event;
+      m_description_event= static_cast<Format_description_log_event*>(fde);
+    }
+    return true;
+  }
+
+  /**
+    Set up the description of the events at m_start_pos as check_header()
+    does, and seek there.
+  */
+  bool start(IO_CACHE *file)
+  {
+    uchar head[BIN_LOG_HEADER_SIZE + PROBE_HEADER_LEN];
+    uint8 binlog_version= 3;
+
+    if (!my_b_read(file, head, sizeof(head)) &&
+        head[BIN_LOG_HEADER_SIZE + EVENT_TYPE_OFFSET] == START_EVENT_V3 &&
+        uint4korr(head + BIN_LOG_HEADER_SIZE + EVENT_LEN_OFFSET) <
+        LOG_EVENT_MINIMAL_HEADER_LEN + START_V3_HEADER_LEN)
+      binlog_version= 1;
+    m_description_event= new Format_description_log_event(binlog_version);
+    if (!m_description_event->is_valid())
+      return false;
+
+    if (m_fde_pos)
+    {
+      Event event;
+      my_b_seek(file, m_fde_pos);
+      if (!read(file, &event))
+        return false;
+      if (!event.ev)
+      {
+        my_free(event.buf);
+        return false;
+      }
+      delete event.ev;
+    }
+    my_b_seek(file, m_start_pos);
+    return true;
+  }
+
+  void read_events(IO_CACHE *file)
+  {
+    for (;;)
+    {
+      Event event;
+      bool got= read(file, &event);
+
+      std::unique_lock<std::mutex> lock(m_mutex);
+      if (!got)
+      {
+        m_end_pos= event.pos;
+        return;
+      }
+      m_cond.wait(lock, [this] {
+        return m_bytes < m_read_ahead_size || m_stop;
+      });
+      if (m_stop)
+      {
+        if (event.ev)
+          delete event.ev;
+        else
+          my_free(event.buf);
+        return;
+      }
+      m_events.push_back(event);
+      m_bytes+= event.len;
+      lock.unlock();
+      m_cond.notify_all();
+    }
+  }
+
+  void run()
+  {
+    IO_CACHE file;
+    File fd;
+
+    my_thread_init();
+    if ((fd= my_open(m_logname, O_RDONLY | O_BINARY, MYF(0))) >= 0)
+    {
+      if (!init_io_cache(&file, fd, 0, READ_CACHE, 0, 0, MYF(MY_NABP)))
+      {
+        if (start(&file))
+          read_events(&file);
+        end_io_cache(&file);
+      }
+      my_close(fd, MYF(0));
+    }
+    delete m_description_event;
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_done= true;
+    }
+    m_cond.notify_all();
+    my_thread_end();
+  }
+
+  const char *const m_logname;
+  const my_off_t m_start_pos;
+  const my_off_t m_fde_pos;
+  const ulonglong m_read_ahead_size;
+
+  /* Used by the reader thread only */
+  Format_description_log_event *m_description_event;
+  bool m_gtid_filtered;
+  std::set<ulonglong> m_ignored_tables;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cond;
+  std::deque<Event> m_events;
+  ulonglong m_bytes;
+  my_off_t m_end_pos;
+  bool m_done;
+  bool m_stop;
+  std::thread m_thread;
+};
+
+
+/**
+  Readers started by start_file_readers() for the local binlog files
+  after the one being printed, in file order.
+*/
+static std::deque<Binlog_event_reader*> file_readers;
+
+
+/**
+  Start reading and decoding local binlog files ahead of the printing.
+
+  @param[in] lognames Names of the binlogs
+  @param[in] first Index of the first binlog to start a reader for
+  @param[in] last Index after the last one
+*/
+static void start_file_readers(char **lognames, int first, int last)
+{
+  for (int i= first; i < last; i++)
+  {
+    /* Not stdin, which only the printing thread reads */
+    if (strcmp(lognames[i], "-"))
+      file_readers.push_back(
+        new Binlog_event_reader(lognames[i], BIN_LOG_HEADER_SIZE, 0,
+                                opt_read_ahead_size));
+  }
+}
+
+
+/** Stop the readers of the local binlog files that were not printed */
+static void stop_file_readers()
+{
+  for (Binlog_event_reader *reader : file_readers)
+    delete reader;
+  file_readers.clear();
+}
+
+
+/**
+  Return the reader of a local binlog from the offset pos on: the one
+  start_file_readers() started for it, or a new one.
+*/
+static Binlog_event_reader *get_file_reader(const char *logname,
+                                            my_off_t pos)
+{
+  if (!file_readers.empty() && file_readers.front()->reads(logname, pos))
+  {
+    Binlog_event_reader *reader= file_readers.front();
+    file_readers.pop_front();
+    return reader;
+  }
+  return new Binlog_event_reader(logname, pos, glob_description_event_pos,
+                                 opt_read_ahead_size);
+}
+
+
+/**
+  Skip an event from its raw buffer if process_event() filters it out,
+  printing nothing but its position.
+
+  These are the events of a transaction that --include-gtids or
+  --exclude-gtids filters out, and the row events of a table that
+  --database or --table filters out, except the last one of a statement,
+  on which process_event() flushes the statement. Skipping them has the
+  same effect as decoding them and passing them to process_event().
+
+  @param[in,out] print_event_info Parameters and context state
+  @param[in] buf Raw event
+  @param[in] pos Offset of the event from the beginning of the binlog
+
+  @retval true  the event was skipped
+  @retval false the event must be decoded and passed to process_event()
+*/
+static bool skip_filtered_event(PRINT_EVENT_INFO *print_event_info,
+                                const char *buf, my_off_t pos)
+{
+  bool skip_table= false;
+  ulonglong table_id;
+  uint16 flags;
+
+  switch ((Log_event_type) (uchar) buf[EVENT_TYPE_OFFSET])
+  {
+  case WRITE_ROWS_EVENT:
+  case UPDATE_ROWS_EVENT:
+  case DELETE_ROWS_EVENT:
+  case WRITE_ROWS_EVENT_V1:
+  case UPDATE_ROWS_EVENT_V1:
+  case DELETE_ROWS_EVENT_V1:
+    if (filter_based_on_gtids)
+      break;
+    if (!print_event_info->m_table_map_ignored.count() ||
+        !read_rows_event_header(buf, glob_description_event, &table_id,
+                                &flags) ||
+        (flags & Rows_log_event::STMT_END_F) ||
+        !print_event_info->m_table_map_ignored.get_table(table_id))
+      return false;
+    skip_table= true;
+    break;
+  case TABLE_MAP_EVENT:
+  case ROWS_QUERY_LOG_EVENT:
+  case INTVAR_EVENT:
+  case RAND_EVENT:
+  case USER_VAR_EVENT:
+    if (!filter_based_on_gtids)
+      return false;
+    break;
+  default:
+    return false;
+  }
+
+  my_time_t when= uint4korr(buf);
+  if (rec_count >= offset && when >= start_datetime)
+  {
+    /* Let process_event() end the program */
+    if (when >= stop_datetime || pos >= stop_position_mot)
+      return false;
+
+    start_datetime= 0;
+    offset= 0;
+    ulong server_id= uint4korr(buf + SERVER_ID_OFFSET);
+#ifdef HAVE_REPLICATION
+    server_id&= opt_server_id_mask;
+#endif
+    if (!filter_server_id || filter_server_id == server_id)
+    {
+      char ll_buff[21];
+      if (!short_form)
+        my_b_printf(&print_event_info->head_cache,
+                    "# at %s\n", llstr(pos, ll_buff));
+      print_event_info->hexdump_from= opt_hexdump ? pos : 0;
+      print_event_info->base64_output_mode= opt_base64_output_mode;
+      if (skip_table)
+        print_event_info->skipped_event_in_transaction= true;
+    }
+  }
+  rec_count++;
+  return true;
+}
+
+
 /**
   Reads a local binlog and prints the events it sees.
 
@@ -3725,6 +4324,7 @@ static Exit_status dump_local_log_entries(PRINT_EVENT_INFO *print_event_info,
   IO_CACHE cache,*file= &cache;
   uchar tmp_buff[BIN_LOG_HEADER_SIZE];
   Exit_status retval= OK_CONTINUE;
+  Binlog_event_reader *reader= NULL;
 
   if (logname && strcmp(logname, "-") != 0)
   {
@@ -3781,13 +4381,57 @@ static Exit_status dump_local_log_entries(PRINT_EVENT_INFO *print_event_info,
     error("Failed reading from file.");
     goto err;
   }
+  /* Not from stdin, where the reader could not seek back */
+  if (fd >= 0 && opt_read_ahead_size)
+    reader= get_file_reader(logname, my_b_tell(file));
   for (;;)
   {
     char llbuff[21];
-    my_off_t old_off = my_b_tell(file);
+    my_off_t old_off;
+    Log_event* ev= NULL;
 
-    Log_event* ev = Log_event::read_log_event(file, glob_description_event,
-                                              opt_verify_binlog_checksum);
+    if (reader)
+    {
+      char *buf;
+      if (reader->next(&ev, &buf, &old_off))
+      {
+        if (ev)
+        {
+          /* As Log_event::read_log_event() did to the reader's description */
+          if (ev->get_type_code() == START_EVENT_V3)
+            glob_description_event->checksum_alg= BINLOG_CHECKSUM_ALG_OFF;
+        }
+        else if (skip_filtered_event(print_event_info, buf, old_off))
+        {
+          my_free(buf);
+          continue;
+        }
+        else
+        {
+          const char *read_error;
+          if ((ev= Log_event::read_log_event(buf,
+                                             uint4korr(buf + EVENT_LEN_OFFSET),
+                                             &read_error,
+                                             glob_description_event, FALSE)))
+            ev->register_temp_buf(buf);
+          else
+            my_free(buf);
+        }
+      }
+      if (!ev)
+      {
+        /* Read the event again below, to report the end of file or error */
+        delete reader;
+        reader= NULL;
+        my_b_seek(file, old_off);
+      }
+    }
+    if (!ev)
+    {
+      old_off= my_b_tell(file);
+      ev= Log_event::read_log_event(file, glob_description_event,
+                                    opt_verify_binlog_checksum);
+    }
     if (!ev)
     {
       /*
@@ -3818,6 +4462,7 @@ err:
   retval= ERROR_STOP;
 
 end:
+  delete reader;
   if (fd >= 0)
     my_close(fd, MYF(MY_WME));
   /*
@@ -3888,6 +4533,12 @@ static int args_post_process(void)
     }
   }
 
+  if (opt_decode_threads > 1 && !opt_read_ahead_size)
+  {
+    error("--decode-threads requires --read-ahead-size");
+    DBUG_RETURN(ERROR_STOP);
+  }
+
   if (opt_start_gtid_str != NULL && opt_exclude_gtids_str != NULL)
   {
     error("--start-gtid and --exclude-gtids should not be used together");
@@ -160,6 +160,8 @@ static uint opt_mysql_port= 0, opt_master_data;
 static uint opt_slave_data;
 static uint opt_compression_chunk_size = 0;
 static my_bool do_compress = 0;
+static uint opt_parallel= 0;
+static ulonglong opt_parallel_chunk_size= 1000000;
 static uint my_end_arg;
 static char * opt_mysql_unix_port=0;
 static char *opt_bind_addr = NULL;
@@ -706,6 +708,17 @@ static struct my_option my_long_options[] =
    "Sets the minimum HLC in the output file based on the snapshot HLC",
    &opt_set_minimum_hlc, &opt_set_minimum_hlc, 0,
    GET_BOOL, NO_ARG,  0, 0, 0, 0, 0, 0},
+  {"parallel", OPT_PARALLEL,
+   "Dump the data of the tables on this many connections that share one "
+   "consistent snapshot. Requires --tab and --single-transaction.",
+   &opt_parallel, &opt_parallel, 0,
+   GET_UINT, REQUIRED_ARG, 0, 0, 256, 0, 0, 0},
+  {"parallel-chunk-size", OPT_PARALLEL_CHUNK_SIZE,
+   "With --parallel, split the data of a table with an integer primary key "
+   "into ranges of about this many rows, as estimated by the server, dumped "
+   "to <table>.txt.<n>. 0 dumps every table to one file.",
+   &opt_parallel_chunk_size, &opt_parallel_chunk_size, 0,
+   GET_ULL, REQUIRED_ARG, 1000000, 0, ULONGLONG_MAX, 0, 0, 0},
   {0, 0, 0, 0, 0, 0, GET_NO_ARG, NO_ARG, 0, 0, 0, 0, 0, 0}
 };
 
@@ -1289,6 +1302,16 @@ static int get_options(int *argc, char ***argv)
     return(EX_USAGE);
   }
 
+  if (opt_parallel > 1 && (!path || !opt_single_transaction))
+  {
+    // NO_LINT_DEBUG
+    fprintf(stderr,
+            "%s: --parallel must be used with --tab and "
+            "--single-transaction.\n",
+            my_progname);
+    return(EX_USAGE);
+  }
+
   return(0);
 } /* get_options */
 
@@ -1759,63 +1782,63 @@ static void maybe_exit(int error)
 
 
 /*
-  db_connect -- connects to the host and selects DB.
+  connect_session -- connects to the host and prepares the session for
+  dumping. Used for the main connection and for the --parallel ones.
 */
 
-static int connect_to_db(char *host, char *user,char *passwd)
+static MYSQL *connect_session(MYSQL *con, char *host, char *user,
+                              char *passwd)
 {
   char buff[20+FN_REFLEN];
-  DBUG_ENTER("connect_to_db");
+  DBUG_ENTER("connect_session");
 
   verbose_msg("-- Connecting to %s...\n", host ? host : "localhost");
-  mysql_init(&mysql_connection);
+  mysql_init(con);
   if (opt_compress)
-    mysql_options(&mysql_connection,MYSQL_OPT_COMPRESS,NullS);
+    mysql_options(con,MYSQL_OPT_COMPRESS,NullS);
 #ifdef HAVE_OPENSSL
   if (opt_use_ssl)
   {
-    mysql_ssl_set(&mysql_connection, opt_ssl_key, opt_ssl_cert, opt_ssl_ca,
+    mysql_ssl_set(con, opt_ssl_key, opt_ssl_cert, opt_ssl_ca,
                   opt_ssl_capath, opt_ssl_cipher);
-    mysql_options(&mysql_connection, MYSQL_OPT_SSL_CRL, opt_ssl_crl);
-    mysql_options(&mysql_connection, MYSQL_OPT_SSL_CRLPATH, opt_ssl_crlpath);
+    mysql_options(con, MYSQL_OPT_SSL_CRL, opt_ssl_crl);
+    mysql_options(con, MYSQL_OPT_SSL_CRLPATH, opt_ssl_crlpath);
   }
-  mysql_options(&mysql_connection,MYSQL_OPT_SSL_VERIFY_SERVER_CERT,
+  mysql_options(con,MYSQL_OPT_SSL_VERIFY_SERVER_CERT,
                 (char*)&opt_ssl_verify_server_cert);
 #endif
   if (opt_protocol)
-    mysql_options(&mysql_connection,MYSQL_OPT_PROTOCOL,(char*)&opt_protocol);
+    mysql_options(con,MYSQL_OPT_PROTOCOL,(char*)&opt_protocol);
   if (opt_bind_addr)
-    mysql_options(&mysql_connection,MYSQL_OPT_BIND,opt_bind_addr);
+    mysql_options(con,MYSQL_OPT_BIND,opt_bind_addr);
   if (!opt_secure_auth)
-    mysql_options(&mysql_connection,MYSQL_SECURE_AUTH,(char*)&opt_secure_auth);
+    mysql_options(con,MYSQL_SECURE_AUTH,(char*)&opt_secure_auth);
 #ifdef HAVE_SMEM
   if (shared_memory_base_name)
-    mysql_options(&mysql_connection,MYSQL_SHARED_MEMORY_BASE_NAME,shared_memory_base_name);
+    mysql_options(con,MYSQL_SHARED_MEMORY_BASE_NAME,shared_memory_base_name);
 #endif
-  mysql_options(&mysql_connection, MYSQL_SET_CHARSET_NAME, default_charset);
+  mysql_options(con, MYSQL_SET_CHARSET_NAME, default_charset);
 
   if (opt_plugin_dir && *opt_plugin_dir)
-    mysql_options(&mysql_connection, MYSQL_PLUGIN_DIR, opt_plugin_dir);
+    mysql_options(con, MYSQL_PLUGIN_DIR, opt_plugin_dir);
 
   if (opt_default_auth && *opt_default_auth)
-    mysql_options(&mysql_connection, MYSQL_DEFAULT_AUTH, opt_default_auth);
+    mysql_options(con, MYSQL_DEFAULT_AUTH, opt_default_auth);
 
   if (using_opt_enable_cleartext_plugin)
-    mysql_options(&mysql_connection, MYSQL_ENABLE_CLEARTEXT_PLUGIN,
+    mysql_options(con, MYSQL_ENABLE_CLEARTEXT_PLUGIN,
                   (char *) &opt_enable_cleartext_plugin);
 
-  mysql_options(&mysql_connection, MYSQL_OPT_CONNECT_ATTR_RESET, 0);
-  mysql_options4(&mysql_connection, MYSQL_OPT_CONNECT_ATTR_ADD,
+  mysql_options(con, MYSQL_OPT_CONNECT_ATTR_RESET, 0);
+  mysql_options4(con, MYSQL_OPT_CONNECT_ATTR_ADD,
                  "program_name", "mysqldump");
-  if (!(mysql= mysql_connect_ssl_check(&mysql_connection, host, user,
-                                       passwd, NULL, opt_mysql_port,
-                                       opt_mysql_unix_port, 0,
-                                       opt_ssl_required)))
+  if (!mysql_connect_ssl_check(con, host, user, passwd, NULL, opt_mysql_port,
+                               opt_mysql_unix_port, 0, opt_ssl_required))
   {
-    DB_error(&mysql_connection, "when trying to connect");
-    DBUG_RETURN(1);
+    DB_error(con, "when trying to connect");
+    DBUG_RETURN(NULL);
   }
-  if ((mysql_get_server_version(&mysql_connection) < 40100) ||
+  if ((mysql_get_server_version(con) < 40100) ||
       (opt_compatible_mode & 3))
   {
     /* Don't dump SET NAMES with a pre-4.1 server (bug#7997).  */
@@ -1826,9 +1849,9 @@ static int connect_to_db(char *host, char *user,char *passwd)
   } 
 
   /* Check to see if we support SQL_NO_FCACHE on this server. */
-  if (mysql_query(mysql, "SELECT SQL_NO_FCACHE NOW()") == 0)
+  if (mysql_query(con, "SELECT SQL_NO_FCACHE NOW()") == 0)
   {
-    MYSQL_RES *res = mysql_store_result(mysql);
+    MYSQL_RES *res = mysql_store_result(con);
     if (res)
     {
       mysql_free_result(res);
@@ -1840,24 +1863,24 @@ static int connect_to_db(char *host, char *user,char *passwd)
     As we're going to set SQL_MODE, it would be lost on reconnect, so we
     cannot reconnect.
   */
-  mysql->reconnect= 0;
+  con->reconnect= 0;
   my_snprintf(buff, sizeof(buff), "/*!40100 SET @@SQL_MODE='%s' */",
               compatible_mode_normal_str);
-  if (mysql_query_with_error_report(mysql, 0, buff))
-    DBUG_RETURN(1);
+  if (mysql_query_with_error_report(con, 0, buff))
+    DBUG_RETURN(NULL);
 
   if (opt_timeout)
   {
     my_snprintf(buff, sizeof(buff), "SET wait_timeout=%lu, "
                 "net_write_timeout=%lu", opt_timeout, opt_timeout);
-    if (mysql_query_with_error_report(mysql, 0, buff))
-      DBUG_RETURN(1);
+    if (mysql_query_with_error_report(con, 0, buff))
+      DBUG_RETURN(NULL);
   }
 
   if (opt_lra_size)
   {
     my_snprintf(buff, sizeof(buff), "SET innodb_lra_size=%lu", opt_lra_size);
-    if (mysql_query(mysql, buff))
+    if (mysql_query(con, buff))
     {
       fprintf(stderr,
               "%s: Warning: Server does not support logical read ahead. "
@@ -1869,22 +1892,22 @@ static int connect_to_db(char *host, char *user,char *passwd)
       {
         my_snprintf(buff, sizeof(buff), "SET innodb_lra_sleep=%lu",
                     opt_lra_sleep);
-        if (mysql_query_with_error_report(mysql, 0, buff))
-          DBUG_RETURN(1);
+        if (mysql_query_with_error_report(con, 0, buff))
+          DBUG_RETURN(NULL);
       }
       if (opt_lra_pages_before_sleep)
       {
         my_snprintf(buff, sizeof(buff),
                     "SET innodb_lra_pages_before_sleep=%lu",
                     opt_lra_pages_before_sleep);
-        if (mysql_query(mysql, buff))
+        if (mysql_query(con, buff))
         {
           // Older mysql uses innodb_lra_n_node_recs_before_sleep.
           my_snprintf(buff, sizeof(buff),
                       "SET innodb_lra_n_node_recs_before_sleep=%lu",
                       opt_lra_pages_before_sleep);
-        if (mysql_query_with_error_report(mysql, 0, buff))
-          DBUG_RETURN(1);
+        if (mysql_query_with_error_report(con, 0, buff))
+          DBUG_RETURN(NULL);
         }
       }
     }
@@ -1897,27 +1920,40 @@ static int connect_to_db(char *host, char *user,char *passwd)
   if (opt_tz_utc)
   {
     my_snprintf(buff, sizeof(buff), "/*!40103 SET TIME_ZONE='+00:00' */");
-    if (mysql_query_with_error_report(mysql, 0, buff))
-      DBUG_RETURN(1);
+    if (mysql_query_with_error_report(con, 0, buff))
+      DBUG_RETURN(NULL);
   }
 
   if (opt_long_query_time)
   {
     my_snprintf(buff, sizeof(buff), "SET session long_query_time=%lu",
         opt_long_query_time);
-    if (mysql_query_with_error_report(mysql, 0, buff))
-      DBUG_RETURN(1);
+    if (mysql_query_with_error_report(con, 0, buff))
+      DBUG_RETURN(NULL);
   }
 
   /* set innodb_stats_on_metadata if the default engine is InnoDB */
-  if (opt_innodb_stats_on_metadata && default_engine(mysql, "InnoDB"))
+  if (opt_innodb_stats_on_metadata && default_engine(con, "InnoDB"))
   {
     my_snprintf(buff, sizeof(buff), "SET session innodb_stats_on_metadata=%u",
         opt_innodb_stats_on_metadata);
-    if (mysql_query_with_error_report(mysql, 0, buff))
-      DBUG_RETURN(1);
+    if (mysql_query_with_error_report(con, 0, buff))
+      DBUG_RETURN(NULL);
   }
 
+  DBUG_RETURN(con);
+} /* connect_session */
+
+
+/*
+  db_connect -- connects to the host and selects DB.
+*/
+
+static int connect_to_db(char *host, char *user,char *passwd)
+{
+  DBUG_ENTER("connect_to_db");
+  if (!(mysql= connect_session(&mysql_connection, host, user, passwd)))
+    DBUG_RETURN(1);
   DBUG_RETURN(0);
 } /* connect_to_db */
 
@@ -4023,6 +4059,410 @@ static void restore_secondary_keys(char *table)
 
 
 
+/*
+  Build the SELECT ... INTO OUTFILE query of --tab for a table, optionally
+  restricted to a range of its primary key.
+*/
+
+static void build_outfile_query(DYNAMIC_STRING *query_string,
+                                const char *filename, const char *from,
+                                const char *range)
+{
+  dynstr_append_checked(query_string, "SELECT /*!40001 SQL_NO_CACHE */ ");
+  if (server_supports_sql_no_fcache)
+  {
+    dynstr_append_checked(query_string, "/*!50084 SQL_NO_FCACHE */ ");
+  }
+  dynstr_append_checked(query_string, "* INTO OUTFILE '");
+  dynstr_append_checked(query_string, filename);
+  dynstr_append_checked(query_string, "'");
+
+  dynstr_append_checked(query_string, " /*!50138 CHARACTER SET ");
+  dynstr_append_checked(query_string, default_charset == mysql_universal_client_charset ?
+                                      my_charset_bin.name : /* backward compatibility */
+                                      default_charset);
+  dynstr_append_checked(query_string, " */");
+
+  if (fields_terminated || enclosed || opt_enclosed || escaped)
+    dynstr_append_checked(query_string, " FIELDS");
+  
+  add_load_option(query_string, " TERMINATED BY ", fields_terminated);
+  add_load_option(query_string, " ENCLOSED BY ", enclosed);
+  add_load_option(query_string, " OPTIONALLY ENCLOSED BY ", opt_enclosed);
+  add_load_option(query_string, " ESCAPED BY ", escaped);
+  add_load_option(query_string, " LINES TERMINATED BY ", lines_terminated);
+
+  dynstr_append_checked(query_string, " FROM ");
+  dynstr_append_checked(query_string, from);
+
+  if (where || range)
+  {
+    dynstr_append_checked(query_string, " WHERE ");
+    if (where && range)
+      dynstr_append_checked(query_string, "(");
+    if (where)
+      dynstr_append_checked(query_string, where);
+    if (where && range)
+      dynstr_append_checked(query_string, ") AND ");
+    if (range)
+      dynstr_append_checked(query_string, range);
+  }
+
+  if (order_by)
+  {
+    dynstr_append_checked(query_string, " ORDER BY ");
+    dynstr_append_checked(query_string, order_by);
+  }
+}
+
+
+/*
+  Data dump of --parallel.
+
+  With --parallel=N the data files of --tab are written by N worker
+  threads, each with its own connection. The worker connections start
+  their transactions while the main connection holds FLUSH TABLES WITH
+  READ LOCK, right after the main connection has started its own and read
+  the binary log position, so that all of them see the same snapshot. The
+  main thread still writes the table definitions, and queues one
+  SELECT ... INTO OUTFILE for every table, or for every primary key range
+  of a table with --parallel-chunk-size, to the workers.
+*/
+
+typedef struct st_dump_job
+{
+  struct st_dump_job *next;
+  char *query;
+  char filename[FN_REFLEN];
+  char table[NAME_LEN+1];
+} DUMP_JOB;
+
+static pthread_mutex_t dump_job_mutex;
+static pthread_cond_t dump_job_cond;
+static DUMP_JOB *dump_job_head= NULL, **dump_job_tail= &dump_job_head;
+static my_bool dump_jobs_done= 0;
+static int dump_job_error= 0;
+static MYSQL *dump_connections= NULL;
+static uint dump_connection_count= 0;
+static pthread_t *dump_threads= NULL;
+static uint dump_thread_count= 0;
+
+
+static void run_dump_job(MYSQL *con, DUMP_JOB *job)
+{
+  struct compress_context *compress_ctx= NULL;
+
+  verbose_msg("-- Dumping data of table '%s' to %s\n", job->table,
+              job->filename);
+  if (do_compress)
+    compress_ctx= start_pipe_and_compress_output(
+        job->filename, opt_compression_chunk_size, job->table);
+
+  if (mysql_real_query(con, job->query, strlen(job->query)))
+  {
+    pthread_mutex_lock(&dump_job_mutex);
+    fprintf(stderr, "%s: Got error: %d: %s when executing "
+            "'SELECT INTO OUTFILE'\n",
+            my_progname, mysql_errno(con), mysql_error(con));
+    fflush(stderr);
+    if (!dump_job_error)
+      dump_job_error= EX_MYSQLERR;
+    pthread_mutex_unlock(&dump_job_mutex);
+  }
+  if (do_compress)
+    finish_pipe_and_compress_output(compress_ctx);
+}
+
+
+static void *dump_worker(void *arg)
+{
+  MYSQL *con= (MYSQL*) arg;
+  DUMP_JOB *job;
+
+  mysql_thread_init();
+  for (;;)
+  {
+    pthread_mutex_lock(&dump_job_mutex);
+    while (!dump_job_head && !dump_jobs_done)
+      pthread_cond_wait(&dump_job_cond, &dump_job_mutex);
+    if ((job= dump_job_head) && !(dump_job_head= job->next))
+      dump_job_tail= &dump_job_head;
+    /* Without --force the remaining jobs are dropped after an error */
+    my_bool skip= dump_job_error && !ignore_errors;
+    pthread_mutex_unlock(&dump_job_mutex);
+
+    if (!job)
+      break;
+    if (!skip)
+      run_dump_job(con, job);
+    my_free(job->query);
+    my_free(job);
+  }
+  mysql_thread_end();
+  return NULL;
+}
+
+
+static void add_dump_job(const char *filename, const char *table,
+                         const char *from, const char *range)
+{
+  DYNAMIC_STRING query_string;
+  DUMP_JOB *job;
+
+  if (!(job= (DUMP_JOB*) my_malloc(sizeof(DUMP_JOB), MYF(MY_WME))))
+    die(EX_MYSQLERR, "Couldn't allocate memory");
+
+  /* Must delete the file that 'INTO OUTFILE' will write to */
+  my_delete(filename, MYF(0));
+  strmake(job->filename, filename, sizeof(job->filename) - 1);
+  strmake(job->table, table, sizeof(job->table) - 1);
+
+  init_dynamic_string_checked(&query_string, "", 1024, 1024);
+  build_outfile_query(&query_string, job->filename, from, range);
+  if (!(job->query= my_strdup(query_string.str, MYF(MY_WME))))
+    die(EX_MYSQLERR, "Couldn't allocate memory");
+  dynstr_free(&query_string);
+
+  job->next= NULL;
+  pthread_mutex_lock(&dump_job_mutex);
+  *dump_job_tail= job;
+  dump_job_tail= &job->next;
+  pthread_cond_signal(&dump_job_cond);
+  pthread_mutex_unlock(&dump_job_mutex);
+}
+
+
+/*
+  Find the smallest and largest value of the primary key of a table, if
+  the primary key is a single integer column. Runs on the main connection,
+  so the values are the ones of the snapshot.
+
+  RETURN
+    1 if the key was found, with its quoted name in key_buff
+    0 otherwise
+*/
+
+static my_bool get_primary_key_range(const char *table, char *key_buff,
+                                     longlong *min_value,
+                                     longlong *max_value)
+{
+  char query[QUERY_LENGTH];
+  MYSQL_RES *res;
+  MYSQL_ROW row;
+  MYSQL_FIELD *field;
+  my_bool found= 0;
+
+  my_snprintf(query, sizeof(query), "SHOW KEYS FROM %s", table);
+  if (mysql_query_with_error_report(mysql, &res, query))
+    return 0;
+  /* SHOW KEYS lists the columns of the PRIMARY key first */
+  if ((row= mysql_fetch_row(res)) && !strcmp(row[2], "PRIMARY"))
+  {
+    quote_name(row[4], key_buff, 0);
+    found= !((row= mysql_fetch_row(res)) && !strcmp(row[2], "PRIMARY"));
+  }
+  mysql_free_result(res);
+  if (!found)
+    return 0;
+
+  my_snprintf(query, sizeof(query), "SELECT MIN(%s), MAX(%s) FROM %s",
+              key_buff, key_buff, table);
+  if (mysql_query_with_error_report(mysql, &res, query))
+    return 0;
+  found= 0;
+  field= mysql_fetch_field_direct(res, 0);
+  if ((row= mysql_fetch_row(res)) && row[0] && row[1] &&
+      (field->type == MYSQL_TYPE_TINY || field->type == MYSQL_TYPE_SHORT ||
+       field->type == MYSQL_TYPE_INT24 || field->type == MYSQL_TYPE_LONG ||
+       field->type == MYSQL_TYPE_LONGLONG))
+  {
+    int error;
+    *min_value= my_strtoll10(row[0], NULL, &error);
+    if (!error)
+      *max_value= my_strtoll10(row[1], NULL, &error);
+    /* Unsigned values above LONGLONG_MAX are not split */
+    found= !error && *min_value <= *max_value &&
+           !((field->flags & UNSIGNED_FLAG) && *max_value < 0);
+  }
+  mysql_free_result(res);
+  return found;
+}
+
+
+/*
+  Get the estimated number of rows of a table from SHOW TABLE STATUS.
+
+  RETURN
+    the estimate, 0 if it is not known
+*/
+
+static ulonglong get_table_row_estimate(const char *table_name)
+{
+  char buff[FN_REFLEN+80], show_name_buff[FN_REFLEN];
+  MYSQL_RES *res;
+  MYSQL_ROW row;
+  ulonglong rows= 0;
+
+  my_snprintf(buff, sizeof(buff), "show table status like %s",
+              quote_for_like(table_name, show_name_buff));
+  if (mysql_query_with_error_report(mysql, &res, buff))
+    return 0;
+  if ((row= mysql_fetch_row(res)) && row[4])
+  {
+    int error;
+    rows= (ulonglong) my_strtoll10(row[4], NULL, &error);
+    if (error)
+      rows= 0;
+  }
+  mysql_free_result(res);
+  return rows;
+}
+
+
+/*
+  Queue the data dump of a table to the --parallel workers. A table with
+  a single column integer primary key and more than --parallel-chunk-size
+  rows (as estimated by the server) is dumped in about one chunk per that
+  many rows, to <table>.txt.1, <table>.txt.2 and so on. The chunks are
+  equal ranges of the key, so sparse keys don't make more chunks.
+*/
+
+static void queue_table_dump(const char *filename, const char *table,
+                             const char *qualified_table,
+                             const char *table_name)
+{
+  char key[NAME_LEN*2+3];
+  char range[NAME_LEN*4+100];
+  char chunk_filename[FN_REFLEN];
+  longlong min_value, max_value;
+  ulonglong rows, span, step, offset;
+  uint chunk;
+
+  if (!opt_parallel_chunk_size ||
+      (rows= get_table_row_estimate(table_name)) <= opt_parallel_chunk_size ||
+      !get_primary_key_range(table, key, &min_value, &max_value) ||
+      !(span= (ulonglong) max_value - (ulonglong) min_value))
+  {
+    add_dump_job(filename, table_name, qualified_table, NULL);
+    return;
+  }
+
+  /* Rounded up, so that no more than rows / chunk size chunks are made */
+  step= span / ((rows - 1) / opt_parallel_chunk_size + 1) + 1;
+
+  for (offset= 0, chunk= 1; ; offset+= step, chunk++)
+  {
+    longlong low= (longlong) ((ulonglong) min_value + offset);
+    my_bool last= span - offset < step;
+    char *end= range;
+
+    if (offset)
+      end+= my_snprintf(end, sizeof(range), "%s >= %lld", key, low);
+    if (!last)
+      my_snprintf(end, sizeof(range) - (end - range), "%s%s < %lld",
+                  offset ? " AND " : "", key,
+                  (longlong) ((ulonglong) low + step));
+    my_snprintf(chunk_filename, sizeof(chunk_filename), "%s.%u",
+                filename, chunk);
+    add_dump_job(chunk_filename, table_name, qualified_table, range);
+    if (last)
+      break;
+  }
+}
+
+
+/*
+  Open the connections of --parallel and start the workers. Called with
+  the global read lock held by the main connection, which is released
+  when all connections have started their transactions.
+*/
+
+static int start_dump_workers()
+{
+  my_bool use_rocksdb= opt_rocksdb || default_engine(mysql, "ROCKSDB");
+  uint i;
+  DBUG_ENTER("start_dump_workers");
+
+  pthread_mutex_init(&dump_job_mutex, NULL);
+  pthread_cond_init(&dump_job_cond, NULL);
+  if (!(dump_connections= (MYSQL*) my_malloc(opt_parallel * sizeof(MYSQL),
+                                             MYF(MY_WME))) ||
+      !(dump_threads= (pthread_t*) my_malloc(opt_parallel * sizeof(pthread_t),
+                                             MYF(MY_WME))))
+    DBUG_RETURN(1);
+
+  for (i= 0; i < opt_parallel; i++)
+  {
+    MYSQL *con= &dump_connections[i];
+    if (!connect_session(con, current_host, current_user, opt_password))
+      DBUG_RETURN(1);
+    dump_connection_count++;
+
+    if ((use_rocksdb &&
+         mysql_query_with_error_report(con, 0,
+                                       "SET SESSION rocksdb_skip_fill_cache=1")) ||
+        mysql_query_with_error_report(con, 0,
+                                      "SET SESSION TRANSACTION ISOLATION "
+                                      "LEVEL REPEATABLE READ") ||
+        mysql_query_with_error_report(con, 0,
+                                      "START TRANSACTION "
+                                      "/*!40100 WITH CONSISTENT SNAPSHOT */"))
+      DBUG_RETURN(1);
+  }
+
+  verbose_msg("-- Started %u transactions, unlocking tables...\n",
+              dump_connection_count);
+  if (mysql_query_with_error_report(mysql, 0, "UNLOCK TABLES"))
+    DBUG_RETURN(1);
+
+  for (i= 0; i < opt_parallel; i++)
+  {
+    if (pthread_create(&dump_threads[i], NULL, dump_worker,
+                       &dump_connections[i]))
+      die(EX_MYSQLERR, "Couldn't start dump thread");
+    dump_thread_count++;
+  }
+  DBUG_RETURN(0);
+}
+
+
+/*
+  Wait until the queued data dumps are done and close the connections of
+  --parallel.
+
+  RETURN
+    0 or the exit code of the first failed dump
+*/
+
+static int finish_dump_workers()
+{
+  uint i;
+  DBUG_ENTER("finish_dump_workers");
+
+  if (!dump_connections)
+    DBUG_RETURN(0);
+
+  pthread_mutex_lock(&dump_job_mutex);
+  dump_jobs_done= 1;
+  pthread_cond_broadcast(&dump_job_cond);
+  pthread_mutex_unlock(&dump_job_mutex);
+
+  for (i= 0; i < dump_thread_count; i++)
+    pthread_join(dump_threads[i], NULL);
+  for (i= 0; i < dump_connection_count; i++)
+    mysql_close(&dump_connections[i]);
+
+  pthread_mutex_destroy(&dump_job_mutex);
+  pthread_cond_destroy(&dump_job_cond);
+  my_free(dump_threads);
+  my_free(dump_connections);
+  dump_threads= NULL;
+  dump_connections= NULL;
+  dump_thread_count= dump_connection_count= 0;
+  DBUG_RETURN(dump_job_error);
+}
+
+
 /*
 
  SYNOPSIS
@@ -4172,45 +4612,18 @@ static void dump_table(char *table, char *db)
     to_unix_path(filename);
 
     /* now build the query string */
-
-    dynstr_append_checked(&query_string, "SELECT /*!40001 SQL_NO_CACHE */ ");
-    if (server_supports_sql_no_fcache)
+    if (opt_parallel > 1)
     {
-      dynstr_append_checked(&query_string, "/*!50084 SQL_NO_FCACHE */ ");
-    }
-    dynstr_append_checked(&query_string, "* INTO OUTFILE '");
-    dynstr_append_checked(&query_string, filename);
-    dynstr_append_checked(&query_string, "'");
-
-    dynstr_append_checked(&query_string, " /*!50138 CHARACTER SET ");
-    dynstr_append_checked(&query_string, default_charset == mysql_universal_client_charset ?
-                                         my_charset_bin.name : /* backward compatibility */
-                                         default_charset);
-    dynstr_append_checked(&query_string, " */");
-
-    if (fields_terminated || enclosed || opt_enclosed || escaped)
-      dynstr_append_checked(&query_string, " FIELDS");
-    
-    add_load_option(&query_string, " TERMINATED BY ", fields_terminated);
-    add_load_option(&query_string, " ENCLOSED BY ", enclosed);
-    add_load_option(&query_string, " OPTIONALLY ENCLOSED BY ", opt_enclosed);
-    add_load_option(&query_string, " ESCAPED BY ", escaped);
-    add_load_option(&query_string, " LINES TERMINATED BY ", lines_terminated);
-
-    dynstr_append_checked(&query_string, " FROM ");
-    dynstr_append_checked(&query_string, result_table);
-
-    if (where)
-    {
-      dynstr_append_checked(&query_string, " WHERE ");
-      dynstr_append_checked(&query_string, where);
+      char qualified_table[NAME_LEN*4+6];
+      char db_buff[NAME_LEN*2+3];
+      strxmov(qualified_table, quote_name(db, db_buff, 1), ".",
+              result_table, NullS);
+      queue_table_dump(filename, result_table, qualified_table, table);
+      dynstr_free(&query_string);
+      DBUG_VOID_RETURN;
     }
 
-    if (order_by)
-    {
-      dynstr_append_checked(&query_string, " ORDER BY ");
-      dynstr_append_checked(&query_string, order_by);
-    }
+    build_outfile_query(&query_string, filename, result_table, NULL);
 
     struct compress_context *compress_ctx = NULL;
     if (do_compress)
@@ -6773,7 +7186,7 @@ int main(int argc, char **argv)
     goto err;
 
   if ((opt_lock_all_tables ||
-       (opt_single_transaction && flush_logs)) &&
+       (opt_single_transaction && (flush_logs || opt_parallel > 1))) &&
       do_flush_tables_read_lock(mysql))
     goto err;
 
@@ -6842,6 +7255,9 @@ int main(int argc, char **argv)
   if (opt_slave_data && do_show_slave_status(mysql))
     goto err;
 
+  if (opt_parallel > 1 && start_dump_workers())
+    goto err;
+
   if (opt_alltspcs)
     dump_all_tablespaces();
 
@@ -6883,6 +7299,14 @@ int main(int argc, char **argv)
     }
   }
 
+  if ((exit_code= finish_dump_workers()))
+  {
+    if (!first_error)
+      first_error= exit_code;
+    if (!ignore_errors)
+      goto err;
+  }
+
   /* if --dump-slave , start the slave sql thread */
   if (opt_slave_data && do_start_slave_sql(mysql))
     goto err;
@@ -6934,6 +7358,7 @@ int main(int argc, char **argv)
     server.
   */
 err:
+  (void) finish_dump_workers();
   dbDisconnect(current_host);
   if (!path)
     write_footer(md_result_file);
@@ -284,6 +284,8 @@ extern int my_umask_dir,
 extern my_bool my_use_symdir;
 
 extern ulong	my_default_record_cache_size;
+extern ulong	my_mem_root_cache_size;
+extern int64 volatile my_mem_root_cache_bytes;
 extern my_bool  my_disable_locking, my_disable_async_io,
                 my_disable_flush_key_blocks, my_disable_symlinks;
 extern char	wild_many,wild_one,wild_prefix;
@@ -522,6 +524,9 @@ typedef struct st_io_cache		/* Used when cacheing files */
 
   /* Disk usage reported to global/session tracking. */
   my_off_t reported_disk_usage;
+
+  /* Background read of the next block, see init_io_cache_read_ahead() */
+  struct io_cache_read_ahead *read_ahead;
 } IO_CACHE;
 
 typedef int (*qsort2_cmp)(const void *, const void *, const void *);
@@ -781,6 +786,7 @@ extern int _my_b_seq_read(IO_CACHE *info,uchar *Buffer,size_t Count);
 extern int _my_b_net_read(IO_CACHE *info,uchar *Buffer,size_t Count);
 extern int _my_b_get(IO_CACHE *info);
 extern int _my_b_async_read(IO_CACHE *info,uchar *Buffer,size_t Count);
+extern int _my_b_read_ahead(IO_CACHE *info,uchar *Buffer,size_t Count);
 extern int _my_b_write(IO_CACHE *info,const uchar *Buffer,size_t Count);
 extern int my_b_append(IO_CACHE *info,const uchar *Buffer,size_t Count);
 extern int my_b_safe_write(IO_CACHE *info,const uchar *Buffer,size_t Count);
@@ -814,6 +820,9 @@ extern void io_cache_set_preclose_callback(IO_CACHE *cache,
           IO_CACHE_CALLBACK preclose);
 extern int end_io_cache_compressor(IO_CACHE *info);
 extern int end_io_cache_decompressor(IO_CACHE *info);
+extern int init_io_cache_read_ahead(IO_CACHE *info);
+extern void reset_io_cache_read_ahead(IO_CACHE *info);
+extern void end_io_cache_read_ahead(IO_CACHE *info);
 
 File create_temp_file(char *to, const char *dir, const char *pfx,
 		      int mode, myf MyFlags);
@@ -888,6 +897,8 @@ extern my_bool my_compress(NET *, uchar *,
 extern void set_memroot_max_capacity(MEM_ROOT *mem_root, size_t size);
 extern void set_memroot_error_reporting(MEM_ROOT *mem_root,
                                        my_bool report_error);
+extern void mem_root_cache_stats(ulonglong *hits, ulonglong *misses);
+extern void mem_root_cache_end(void);
 extern my_bool my_uncompress(NET *, uchar *,
                              size_t , size_t *);
 extern uchar *my_compress_alloc(NET *net,
@@ -898,6 +909,8 @@ extern int unpackfrm(uchar **, size_t *, const uchar *);
 
 extern ha_checksum my_checksum(ha_checksum crc, const uchar *mem,
                                size_t count);
+extern ha_checksum my_checksum_combine(ha_checksum crc1, ha_checksum crc2,
+                                       size_t length2);
 extern void my_sleep(ulong m_seconds);
 extern ulong crc32(ulong crc, const uchar *buf, uint len);
 extern uint my_set_max_open_files(uint files);
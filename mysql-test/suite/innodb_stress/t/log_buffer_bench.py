@@ -0,0 +1,82 @@
+# Measures the commit throughput of small InnoDB transactions for an
+# increasing number of concurrent connections. With
+# innodb_flush_log_at_trx_commit = 0 the commits do not wait for the redo
+# log to be written, so the throughput is bounded by mtr_commit and the
+# copying of the redo log records into the log buffer.
+#
+# usage: log_buffer_bench.py user host port rows_per_thread row_size
+#        max_threads
+
+import MySQLdb
+import sys
+import threading
+import time
+
+class InsertWorker(threading.Thread):
+  def __init__(self, user, host, port, table, num_rows, row_size):
+    threading.Thread.__init__(self)
+    self.con = MySQLdb.connect(user=user, host=host, port=port, db='test')
+    self.table = table
+    self.num_rows = num_rows
+    self.payload = 'x' * row_size
+    self.exception = None
+
+  def run(self):
+    try:
+      cur = self.con.cursor()
+      cur.execute("SET autocommit = 1")
+      for i in range(self.num_rows):
+        # Every statement is one transaction, and updates both the
+        # clustered and the secondary index.
+        cur.execute("INSERT INTO %s (id, k, v) VALUES (%d, %d, '%s')" %
+                    (self.table, i, i % 1000, self.payload))
+      cur.close()
+    except Exception as e:
+      self.exception = e
+    finally:
+      self.con.close()
+
+def run_round(user, host, port, num_threads, num_rows, row_size):
+  con = MySQLdb.connect(user=user, host=host, port=port, db='test')
+  cur = con.cursor()
+  tables = ['bench_%d' % i for i in range(num_threads)]
+  for t in tables:
+    cur.execute("DROP TABLE IF EXISTS %s" % t)
+    cur.execute("CREATE TABLE %s (id INT PRIMARY KEY, k INT, v TEXT, "
+                "KEY (k)) ENGINE=InnoDB" % t)
+
+  workers = [InsertWorker(user, host, port, t, num_rows, row_size)
+             for t in tables]
+  start = time.time()
+  for w in workers:
+    w.start()
+  for w in workers:
+    w.join()
+  elapsed = time.time() - start
+
+  for w in workers:
+    if w.exception is not None:
+      raise w.exception
+
+  for t in tables:
+    cur.execute("DROP TABLE %s" % t)
+  cur.close()
+  con.close()
+
+  return (num_threads * num_rows) / elapsed
+
+if __name__ == '__main__':
+  user = sys.argv[1]
+  host = sys.argv[2]
+  port = int(sys.argv[3])
+  num_rows = int(sys.argv[4])
+  row_size = int(sys.argv[5])
+  max_threads = int(sys.argv[6])
+
+  print("row_size %d, %d rows per thread" % (row_size, num_rows))
+  num_threads = 1
+  while num_threads <= max_threads:
+    rate = run_round(user, host, port, num_threads, num_rows, row_size)
+    print("threads %3d: %10.0f commits/s" % (num_threads, rate))
+    sys.stdout.flush()
+    num_threads *= 2
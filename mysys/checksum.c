@@ -33,3 +33,68 @@ ha_checksum my_checksum(ha_checksum crc, const uchar *pos, size_t length)
   return (ha_checksum)crc32((uint)crc, pos, (uint)length);
 }
 
+
+
+/* Reflected CRC-32 polynomial, as used by zlib */
+#define CRC32_POLY 0xedb88320UL
+
+/* x^(2^n) modulo the CRC-32 polynomial, for n= 0..31 */
+static const uint32 crc32_x2n_table[32]=
+{
+  0x40000000UL, 0x20000000UL, 0x08000000UL, 0x00800000UL,
+  0x00008000UL, 0xedb88320UL, 0xb1e6b092UL, 0xa06a2517UL,
+  0xed627daeUL, 0x88d14467UL, 0xd7bbfe6aUL, 0xec447f11UL,
+  0x8e7ea170UL, 0x6427800eUL, 0x4d47bae0UL, 0x09fe548fUL,
+  0x83852d0fUL, 0x30362f1aUL, 0x7b5a9cc3UL, 0x31fec169UL,
+  0x9fec022aUL, 0x6c8dedc4UL, 0x15d6874dUL, 0x5fde7a4eUL,
+  0xbad90e37UL, 0x2e4e5eefUL, 0x4eaba214UL, 0xa8a472c0UL,
+  0x429a969eUL, 0x148d302aUL, 0xc40ba6d0UL, 0xc4e22c3cUL
+};
+
+/* Multiply a and b modulo the CRC-32 polynomial */
+static uint32 crc32_multmodp(uint32 a, uint32 b)
+{
+  uint32 m= (uint32) 1 << 31, p= 0;
+  for (;;)
+  {
+    if (a & m)
+    {
+      p^= b;
+      if ((a & (m - 1)) == 0)
+        break;
+    }
+    m>>= 1;
+    b= (b & 1) ? (b >> 1) ^ CRC32_POLY : b >> 1;
+  }
+  return p;
+}
+
+/*
+  Combine two checksums computed with my_checksum().
+
+  SYNOPSIS
+    my_checksum_combine()
+      crc1      checksum of the first memory block
+      crc2      checksum of the second memory block, with start value 0
+      length2   length of the second memory block
+
+  DESCRIPTION
+    Returns the checksum of the concatenation of the two blocks, without
+    reading them again. The cost depends on the number of bits set in
+    length2, not on its value, so this is much cheaper than recomputing
+    the checksum of a long block.
+*/
+
+ha_checksum my_checksum_combine(ha_checksum crc1, ha_checksum crc2,
+                                size_t length2)
+{
+  /* Multiply crc1 by x^(8 * length2) */
+  uint32 p= (uint32) 1 << 31;
+  uint k= 3;
+  for (; length2; length2>>= 1, k++)
+  {
+    if (length2 & 1)
+      p= crc32_multmodp(crc32_x2n_table[k & 31], p);
+  }
+  return (ha_checksum) (crc32_multmodp(p, (uint32) crc1) ^ crc2);
+}
@@ -111,7 +111,8 @@ init_functions(IO_CACHE* info)
     info->write_function = 0;			/* Force a core if used */
     break;
   default:
-    info->read_function = info->share ? _my_b_read_r : _my_b_read;
+    info->read_function = info->share ? _my_b_read_r :
+                          info->read_ahead ? _my_b_read_ahead : _my_b_read;
     info->write_function = _my_b_write;
   }
 
@@ -165,6 +166,7 @@ int init_io_cache(IO_CACHE *info, File file, size_t cachesize,
   info->compressor = 0;
   info->decompressor = 0;
   info->reported_disk_usage = 0;
+  info->read_ahead = 0;
 
   if (file >= 0)
   {
@@ -340,6 +342,10 @@ my_bool reinit_io_cache(IO_CACHE *info, enum cache_type type,
 	      type != WRITE_NET && info->type != WRITE_NET &&
 	      type != SEQ_READ_APPEND && info->type != SEQ_READ_APPEND);
 
+  /* A block read ahead may be stale once the cache moves or writes */
+  if (info->read_ahead)
+    reset_io_cache_read_ahead(info);
+
   /* If the whole file is in memory, avoid flushing to disk */
   if (! clear_cache &&
       seek_offset >= info->pos_in_file &&
@@ -671,6 +677,7 @@ void init_io_cache_share(IO_CACHE *read_cache, IO_CACHE_SHARE *cshare,
 
   DBUG_ASSERT(num_threads > 1);
   DBUG_ASSERT(read_cache->type == READ_CACHE);
+  DBUG_ASSERT(!read_cache->read_ahead);
   DBUG_ASSERT(!write_cache || (write_cache->type == WRITE_CACHE));
 
   mysql_mutex_init(key_IO_CACHE_SHARE_mutex,
@@ -1885,6 +1892,8 @@ int end_io_cache(IO_CACHE *info)
     (*pre_close)(info);
     info->pre_close= 0;
   }
+  if (info->read_ahead)
+    end_io_cache_read_ahead(info);
   if (info->alloced_buffer)
   {
     info->alloced_buffer=0;
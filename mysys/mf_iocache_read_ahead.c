@@ -0,0 +1,318 @@
+/* Copyright (c) 2016, Facebook, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/*
+  Read-ahead for sequential READ_CACHE readers.
+
+  The cache gets a second buffer of read_length bytes. Whenever the
+  cache buffer is refilled, a POSIX asynchronous read of the following
+  block into the second buffer is started, so that the disk read
+  overlaps with the caller consuming the current block. When the reader
+  reaches the end of the buffer and the request covers exactly the block
+  it needs, the two buffers are swapped instead of reading again.
+
+  A block that was read ahead is only used if it came back complete.
+  Short reads, errors, seeks and reinit_io_cache() make the cache fall
+  back to a synchronous pread() at the current position, so a file that
+  is still growing (an active binary log, for example) is always read
+  the same way as without read-ahead at its end.
+
+  Reads are done with pread(), so the file offset is not moved.
+  seek_not_done is set after every fill to make any later non read-ahead
+  access position the file first.
+*/
+
+#include "mysys_priv.h"
+#include <errno.h>
+
+#if defined(HAVE_AIO_H) && defined(HAVE_AIO_READ)
+#include <aio.h>
+#include <sys/stat.h>
+
+typedef struct io_cache_read_ahead
+{
+  struct aiocb cb;                      /* The request in flight */
+  uchar *buffer;                        /* Second buffer, read_length bytes */
+  my_bool pending;                      /* If cb has not been reaped yet */
+} io_cache_read_ahead;
+
+
+/* Wait for the request in flight and return what aio_return() reports */
+
+static ssize_t read_ahead_wait(io_cache_read_ahead *ra)
+{
+  const struct aiocb *list[1];
+  list[0]= &ra->cb;
+
+  while (aio_error(&ra->cb) == EINPROGRESS)
+    (void) aio_suspend(list, 1, NULL);  /* EINTR: just check again */
+
+  ra->pending= 0;
+  return aio_return(&ra->cb);
+}
+
+
+/* Drop the request in flight, if any */
+
+static void read_ahead_cancel(io_cache_read_ahead *ra)
+{
+  if (ra->pending)
+  {
+    (void) aio_cancel(ra->cb.aio_fildes, &ra->cb);
+    (void) read_ahead_wait(ra);
+  }
+}
+
+
+/* Start reading the block at pos into the second buffer */
+
+static void read_ahead_start(IO_CACHE *info, my_off_t pos)
+{
+  io_cache_read_ahead *ra= info->read_ahead;
+  size_t length= info->read_length;
+
+  if (info->end_of_file != ~(my_off_t) 0)
+  {
+    if (info->end_of_file <= pos)
+      return;
+    if (length > info->end_of_file - pos)
+      length= (size_t) (info->end_of_file - pos);
+  }
+
+  memset(&ra->cb, 0, sizeof(ra->cb));
+  ra->cb.aio_fildes= info->file;
+  ra->cb.aio_offset= (off_t) pos;
+  ra->cb.aio_buf= ra->buffer;
+  ra->cb.aio_nbytes= length;
+  ra->cb.aio_sigevent.sigev_notify= SIGEV_NONE;
+
+  /* If the request can't be queued the next fill is synchronous */
+  ra->pending= aio_read(&ra->cb) == 0;
+}
+
+
+/*
+  Fill info->buffer with length bytes from pos.
+
+  RETURN
+    number of bytes in the buffer, or (size_t) -1 for a read error
+*/
+
+static size_t read_ahead_fill(IO_CACHE *info, my_off_t pos, size_t length)
+{
+  io_cache_read_ahead *ra= info->read_ahead;
+  size_t read_length;
+
+  if (ra->pending)
+  {
+    if ((my_off_t) ra->cb.aio_offset == pos && ra->cb.aio_nbytes == length)
+    {
+      if (read_ahead_wait(ra) == (ssize_t) length)
+      {
+        uchar *buffer= info->buffer;
+        /* write_buffer is the same memory for a plain READ_CACHE */
+        if (info->write_buffer == buffer)
+          info->write_buffer= ra->buffer;
+        info->buffer= info->request_pos= ra->buffer;
+        ra->buffer= buffer;
+        read_length= length;
+        goto start_next;
+      }
+    }
+    else
+      read_ahead_cancel(ra);
+  }
+
+  read_length= mysql_file_pread(info->file, info->buffer, length, pos,
+                                info->myflags);
+  if (read_length != length)
+    return read_length;                 /* End of file or error */
+
+start_next:
+  read_ahead_start(info, pos + read_length);
+  return read_length;
+}
+
+
+/*
+  Read from an IO_CACHE that has read-ahead enabled.
+
+  SYNOPSIS
+    _my_b_read_ahead()
+      info                      IO_CACHE pointer
+      Buffer                    Buffer to retrieve count bytes from file
+      Count                     Number of bytes to read into Buffer
+
+  NOTE
+    Like _my_b_read(), this is only called from the my_b_read() macro when
+    the buffer can't satisfy the request, and it returns the same way.
+
+  RETURN
+    0      we succeeded in reading all data
+    1      Error: couldn't read requested characters. In this case:
+             If info->error == -1, we got a read error.
+             Otherwise info->error contains the number of bytes in Buffer.
+*/
+
+int _my_b_read_ahead(IO_CACHE *info, uchar *Buffer, size_t Count)
+{
+  size_t length, left_length, max_length;
+  my_off_t pos_in_file;
+  DBUG_ENTER("_my_b_read_ahead");
+
+  if ((left_length= (size_t) (info->read_end - info->read_pos)))
+  {
+    DBUG_ASSERT(Count >= left_length);	/* User is not using my_b_read() */
+    memcpy(Buffer, info->read_pos, left_length);
+    Buffer+= left_length;
+    Count-= left_length;
+  }
+
+  /* pos_in_file always point on where info->buffer was read */
+  pos_in_file= info->pos_in_file + (size_t) (info->read_end - info->buffer);
+
+  for (;;)
+  {
+    /* Read up to the next IO_SIZE boundary, as _my_b_read() does */
+    max_length= info->read_length - (size_t) (pos_in_file & (IO_SIZE-1));
+    if (max_length > info->end_of_file - pos_in_file)
+      max_length= (size_t) (info->end_of_file - pos_in_file);
+
+    length= max_length ? read_ahead_fill(info, pos_in_file, max_length) : 0;
+    info->seek_not_done= 1;
+    info->pos_in_file= pos_in_file;
+
+    if (length == (size_t) -1)
+    {
+      info->error= -1;
+      info->read_pos= info->read_end= info->buffer;
+      DBUG_RETURN(1);
+    }
+    if (length < Count)
+    {
+      memcpy(Buffer, info->buffer, length);
+      info->read_pos= info->read_end= info->buffer;
+      if (length < max_length || !length)
+      {
+        /* End of file. Return, how much we got in total. */
+        info->error= (int) (length + left_length);
+        DBUG_RETURN(1);
+      }
+      /* The request is larger than the buffer, go on with the next block */
+      Buffer+= length;
+      Count-= length;
+      left_length+= length;
+      pos_in_file+= length;
+      continue;
+    }
+
+    info->read_pos= info->buffer + Count;
+    info->read_end= info->buffer + length;
+    memcpy(Buffer, info->buffer, Count);
+    DBUG_RETURN(0);
+  }
+}
+
+
+/*
+  Enable read-ahead on a READ_CACHE.
+
+  SYNOPSIS
+    init_io_cache_read_ahead()
+      info                      A READ_CACHE on a regular file, created
+                                by init_io_cache() with its own buffer.
+
+  NOTE
+    Read-ahead is kept over reinit_io_cache() and only used while the
+    cache is a READ_CACHE. It is released by end_io_cache().
+
+  RETURN
+    0  ok, or read-ahead is of no use for this cache
+    1  read-ahead is not available, the cache works as before
+*/
+
+int init_io_cache_read_ahead(IO_CACHE *info)
+{
+  io_cache_read_ahead *ra;
+  MY_STAT stat_info;
+  DBUG_ENTER("init_io_cache_read_ahead");
+
+  if (info->read_ahead)
+    DBUG_RETURN(0);
+  if (info->type != READ_CACHE || info->share || !info->alloced_buffer ||
+      info->file < 0)
+    DBUG_RETURN(1);
+  if (my_fstat(info->file, &stat_info, MYF(0)) ||
+      !MY_S_ISREG(stat_info.st_mode))
+    DBUG_RETURN(1);
+  /* Nothing to gain if the rest of the file fits into the buffer */
+  if (info->end_of_file != ~(my_off_t) 0 &&
+      info->end_of_file - my_b_tell(info) <= info->read_length)
+    DBUG_RETURN(0);
+
+  if (!(ra= (io_cache_read_ahead*) my_malloc(sizeof(*ra),
+                                             MYF(MY_ZEROFILL))))
+    DBUG_RETURN(1);
+  if (!(ra->buffer= (uchar*) my_malloc(info->buffer_length, MYF(0))))
+  {
+    my_free(ra);
+    DBUG_RETURN(1);
+  }
+  info->read_ahead= ra;
+  info->read_function= _my_b_read_ahead;
+  DBUG_PRINT("info", ("read-ahead enabled, block size: %lu",
+                      (ulong) info->read_length));
+  DBUG_RETURN(0);
+}
+
+
+/* Drop any block read ahead, before the cache is repositioned */
+
+void reset_io_cache_read_ahead(IO_CACHE *info)
+{
+  read_ahead_cancel(info->read_ahead);
+}
+
+
+void end_io_cache_read_ahead(IO_CACHE *info)
+{
+  io_cache_read_ahead *ra= info->read_ahead;
+  read_ahead_cancel(ra);
+  my_free(ra->buffer);
+  my_free(ra);
+  info->read_ahead= 0;
+}
+
+#else /* HAVE_AIO_H && HAVE_AIO_READ */
+
+int _my_b_read_ahead(IO_CACHE *info, uchar *Buffer, size_t Count)
+{
+  return _my_b_read(info, Buffer, Count);
+}
+
+int init_io_cache_read_ahead(IO_CACHE *info MY_ATTRIBUTE((unused)))
+{
+  return 1;
+}
+
+void reset_io_cache_read_ahead(IO_CACHE *info MY_ATTRIBUTE((unused)))
+{
+}
+
+void end_io_cache_read_ahead(IO_CACHE *info MY_ATTRIBUTE((unused)))
+{
+}
+
+#endif /* HAVE_AIO_H && HAVE_AIO_READ */
@@ -15,9 +15,9 @@
 
 /* Routines to handle mallocing of results which will be freed the same time */
 
-#include <my_global.h>
-#include <my_sys.h>
+#include "mysys_priv.h"
 #include <m_string.h>
+#include <my_atomic.h>
 #include "mysys_err.h"
 
 #undef EXTRA_DEBUG
@@ -25,6 +25,229 @@
 
 static inline my_bool is_mem_available(MEM_ROOT *mem_root, size_t size);
 
+/*
+  Cache of the MEM_ROOT blocks freed by a thread.
+
+  Blocks that free_root() releases are kept here instead of going back to
+  malloc, and alloc_root() takes its new blocks from here first. Thus the
+  memory roots of the next statement of the thread reuse the blocks of the
+  previous one. The blocks are kept in power of two size classes, the
+  smallest holds blocks of 1K up to 2K. The total size of the blocks a
+  thread keeps is bounded by my_mem_root_cache_size, so all threads
+  together may keep that size times the number of threads. A thread
+  gives its blocks back when it ends, when it calls mem_root_cache_end()
+  before it waits in the server's thread cache, and on its next free or
+  mem_root_cache_stats() after the limit was lowered.
+
+  my_mem_root_cache_bytes is the size of the blocks kept by all threads,
+  as last reported by mem_root_cache_stats(), so that the threads do not
+  update it on every block.
+*/
+
+#define MEM_ROOT_CACHE_MIN_SHIFT 10
+#define MEM_ROOT_CACHE_CLASSES   7
+
+typedef struct st_mem_root_cache
+{
+  USED_MEM *blocks[MEM_ROOT_CACHE_CLASSES]; /* free blocks of each class */
+  size_t size;                              /* size of all blocks */
+  size_t reported;              /* size added to my_mem_root_cache_bytes */
+  ulonglong hits;                           /* blocks taken from the cache */
+  ulonglong misses;                         /* blocks malloc'ed instead */
+} MEM_ROOT_CACHE;
+
+
+/* Get the size class of a block, -1 if blocks of that size aren't cached */
+
+static inline int mem_root_cache_class(size_t size)
+{
+  int cls= -1;
+
+  for (size>>= MEM_ROOT_CACHE_MIN_SHIFT; size; size>>= 1)
+    cls++;
+  return cls < MEM_ROOT_CACHE_CLASSES ? cls : -1;
+}
+
+
+/* Get the block cache of the current thread, create it if asked to */
+
+static MEM_ROOT_CACHE *mem_root_cache_get(my_bool create)
+{
+  MEM_ROOT_CACHE *cache;
+
+  if (!THR_KEY_mysys_initialized)
+    return NULL;
+
+  cache= my_pthread_getspecific(MEM_ROOT_CACHE*, THR_KEY_mem_root_cache);
+  if (!cache && create &&
+      (cache= (MEM_ROOT_CACHE*) my_malloc(sizeof(MEM_ROOT_CACHE),
+                                          MYF(MY_ZEROFILL))) &&
+      my_pthread_setspecific_ptr(THR_KEY_mem_root_cache, cache))
+  {
+    my_free(cache);
+    cache= NULL;
+  }
+  return cache;
+}
+
+
+/* Free all blocks of a cache */
+
+static void mem_root_cache_flush(MEM_ROOT_CACHE *cache)
+{
+  USED_MEM *next, *old;
+  int cls;
+
+  for (cls= 0; cls < MEM_ROOT_CACHE_CLASSES; cls++)
+  {
+    for (next= cache->blocks[cls]; next ;)
+    {
+      old= next; next= next->next;
+      my_free(old);
+    }
+    cache->blocks[cls]= 0;
+  }
+  cache->size= 0;
+}
+
+
+/*
+  Free a cache, the destructor of THR_KEY_mem_root_cache
+*/
+
+void mem_root_cache_destroy(void *cache)
+{
+  MEM_ROOT_CACHE *mem_root_cache= (MEM_ROOT_CACHE*) cache;
+
+  my_atomic_add64(&my_mem_root_cache_bytes,
+                  -(int64) mem_root_cache->reported);
+  mem_root_cache_flush(mem_root_cache);
+  my_free(cache);
+}
+
+
+/*
+  Free the block cache of the current thread, at thread end
+*/
+
+void mem_root_cache_end(void)
+{
+  MEM_ROOT_CACHE *cache= mem_root_cache_get(FALSE);
+
+  if (cache)
+  {
+    my_pthread_setspecific_ptr(THR_KEY_mem_root_cache, NULL);
+    mem_root_cache_destroy(cache);
+  }
+}
+
+
+/*
+  Get how many blocks the current thread took from its cache (hits), and
+  how many it had to malloc while the cache was enabled (misses).
+
+  Also frees the cached blocks if my_mem_root_cache_size was lowered below
+  their size, and adds the change of their size to my_mem_root_cache_bytes.
+  The server calls this after every command.
+*/
+
+void mem_root_cache_stats(ulonglong *hits, ulonglong *misses)
+{
+  MEM_ROOT_CACHE *cache= mem_root_cache_get(FALSE);
+
+  if (!cache)
+  {
+    *hits= *misses= 0;
+    return;
+  }
+
+  if (cache->size > my_mem_root_cache_size)
+    mem_root_cache_flush(cache);
+
+  if (cache->size != cache->reported)
+  {
+    my_atomic_add64(&my_mem_root_cache_bytes,
+                    (int64) cache->size - (int64) cache->reported);
+    cache->reported= cache->size;
+  }
+
+  *hits= cache->hits;
+  *misses= cache->misses;
+}
+
+
+#if !(defined(HAVE_purify) && defined(EXTRA_DEBUG))
+/*
+  Take a block of at least 'size' bytes from the cache of the thread.
+  Blocks of the next size class are big enough for any size of the class.
+
+  RETURN VALUE
+    The block, or NULL if the cache has none
+*/
+
+static USED_MEM *mem_root_cache_take(MEM_ROOT *mem_root, size_t size)
+{
+  MEM_ROOT_CACHE *cache;
+  USED_MEM *next, **prev;
+  int cls;
+
+  if (!my_mem_root_cache_size || (cls= mem_root_cache_class(size)) < 0 ||
+      !(cache= mem_root_cache_get(TRUE)))
+    return NULL;
+
+  for (prev= &cache->blocks[cls]; (next= *prev); prev= &next->next)
+  {
+    if (next->size >= size)
+      break;
+  }
+  if (!next && cls + 1 < MEM_ROOT_CACHE_CLASSES &&
+      (next= cache->blocks[cls + 1]))
+    prev= &cache->blocks[cls + 1];
+
+  if (!next || !is_mem_available(mem_root, next->size))
+  {
+    cache->misses++;
+    return NULL;
+  }
+
+  *prev= next->next;
+  cache->size-= next->size;
+  cache->hits++;
+  return next;
+}
+#endif
+
+
+/*
+  Free a block of a memory root, or keep it in the cache of the thread
+*/
+
+static void mem_root_block_free(USED_MEM *block)
+{
+#if !(defined(HAVE_purify) && defined(EXTRA_DEBUG))
+  MEM_ROOT_CACHE *cache;
+  int cls;
+
+  /* Look for an existing cache to flush if the cache was disabled */
+  if ((cls= mem_root_cache_class(block->size)) >= 0 &&
+      (cache= mem_root_cache_get(my_mem_root_cache_size != 0)))
+  {
+    /* my_mem_root_cache_size may have been lowered */
+    if (cache->size > my_mem_root_cache_size)
+      mem_root_cache_flush(cache);
+
+    if (cache->size + block->size <= my_mem_root_cache_size)
+    {
+      block->next= cache->blocks[cls];
+      cache->blocks[cls]= block;
+      cache->size+= block->size;
+      return;
+    }
+  }
+#endif
+  my_free(block);
+}
+
 /*
   Initialize memory root
 
@@ -134,7 +357,7 @@ void reset_root_defaults(MEM_ROOT *mem_root, size_t block_size,
             mem->left= mem->size;
             mem_root->allocated_size-= mem->size;
             TRASH_MEM(mem);
-            my_free(mem);
+            mem_root_block_free(mem);
           }
         }
         else
@@ -264,7 +487,9 @@ void *alloc_root(MEM_ROOT *mem_root, size_t length)
       else
         DBUG_RETURN(NULL);
     }
-    if (!(next = (USED_MEM*) my_malloc(get_size,MYF(MY_WME | ME_FATALERROR))))
+    if ((next= mem_root_cache_take(mem_root, get_size)))
+      get_size= next->size;
+    else if (!(next = (USED_MEM*) my_malloc(get_size,MYF(MY_WME | ME_FATALERROR))))
     {
       if (mem_root->error_handler)
 	(*mem_root->error_handler)();
@@ -414,7 +639,7 @@ void free_root(MEM_ROOT *root, myf MyFlags)
     {
       old->left= old->size;
       TRASH_MEM(old);
-      my_free(old);
+      mem_root_block_free(old);
     }
   }
   for (next=root->free ; next ;)
@@ -424,7 +649,7 @@ void free_root(MEM_ROOT *root, myf MyFlags)
     {
       old->left= old->size;
       TRASH_MEM(old);
-      my_free(old);
+      mem_root_block_free(old);
     }
   }
   root->used=root->free=0;
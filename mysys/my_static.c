@@ -45,6 +45,10 @@ struct st_remember _my_sig_remember[MAX_SIGNALS]={{0,0}};
 	/* from mf_reccache.c */
 ulong my_default_record_cache_size=RECORD_CACHE_SIZE;
 
+	/* from my_alloc.c, 0 disables the per thread MEM_ROOT block cache */
+ulong my_mem_root_cache_size= 0;
+int64 volatile my_mem_root_cache_bytes= 0;
+
 	/* from soundex.c */
 				/* ABCDEFGHIJKLMNOPQRSTUVWXYZ */
 				/* :::::::::::::::::::::::::: */
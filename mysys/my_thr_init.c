@@ -23,6 +23,7 @@
 #include <signal.h>
 
 pthread_key(struct st_my_thread_var*, THR_KEY_mysys);
+pthread_key(struct st_mem_root_cache*, THR_KEY_mem_root_cache);
 my_bool THR_KEY_mysys_initialized= FALSE;
 mysql_mutex_t THR_LOCK_malloc, THR_LOCK_open,
               THR_LOCK_lock, THR_LOCK_myisam, THR_LOCK_heap,
@@ -152,6 +153,14 @@ my_bool my_thread_global_init(void)
     return 1;
   }
 
+  if ((pth_ret= pthread_key_create(&THR_KEY_mem_root_cache,
+                                   mem_root_cache_destroy)) != 0)
+  {
+    fprintf(stderr, "Can't initialize threads: error %d\n", pth_ret);
+    pthread_key_delete(THR_KEY_mysys);
+    return 1;
+  }
+
   THR_KEY_mysys_initialized= TRUE;
   mysql_mutex_init(key_THR_LOCK_malloc, &THR_LOCK_malloc, MY_MUTEX_INIT_FAST);
   mysql_mutex_init(key_THR_LOCK_open, &THR_LOCK_open, MY_MUTEX_INIT_FAST);
@@ -211,6 +220,8 @@ void my_thread_global_end(void)
   mysql_mutex_unlock(&THR_LOCK_threads);
 
   DBUG_ASSERT(THR_KEY_mysys_initialized);
+  mem_root_cache_end();
+  pthread_key_delete(THR_KEY_mem_root_cache);
   pthread_key_delete(THR_KEY_mysys);
   THR_KEY_mysys_initialized= FALSE;
 #ifdef PTHREAD_ADAPTIVE_MUTEX_INITIALIZER_NP
@@ -343,6 +354,9 @@ void my_thread_end(void)
   PSI_THREAD_CALL(delete_current_thread)();
 #endif
 
+  /* Give the MEM_ROOT blocks cached by this thread back to malloc */
+  mem_root_cache_end();
+
   if (tmp && tmp->init)
   {
 #if !defined(DBUG_OFF)
@@ -60,6 +60,11 @@ extern mysql_mutex_t THR_LOCK_malloc, THR_LOCK_open, THR_LOCK_keycache;
 extern mysql_mutex_t THR_LOCK_lock, THR_LOCK_net;
 extern mysql_mutex_t THR_LOCK_charset;
 
+/* The thread's cache of freed MEM_ROOT blocks, see my_alloc.c */
+extern my_bool THR_KEY_mysys_initialized;
+extern pthread_key(struct st_mem_root_cache*, THR_KEY_mem_root_cache);
+extern void mem_root_cache_destroy(void *cache);
+
 #include <mysql/psi/mysql_file.h>
 
 #ifdef HAVE_PSI_INTERFACE
@@ -4037,6 +4037,65 @@ static char *get_suffix_buffer(conn *c) {
     return suffix;
 }
 
+/*
+ * Let the engine look up all keys of a batch of tokens at once. The items
+ * that get() returns may share one buffer of the engine, so a batch of
+ * several keys can only be served by get_multi(). On success *nitems is
+ * the number of items stored in items, 0 if the batch has a single key
+ * to be fetched by get(). ENGINE_ENOTSUP is returned if the engine can't
+ * look up several keys at once.
+ */
+static ENGINE_ERROR_CODE prefetch_get_items(conn *c, token_t *key_token,
+                                            item **items, int *nitems) {
+    const void *keys[MAX_TOKENS];
+    int nkeys[MAX_TOKENS];
+    int count = 0;
+    ENGINE_ERROR_CODE ret;
+
+    *nitems = 0;
+
+    for (; key_token->length != 0; key_token++) {
+        if (key_token->length > KEY_MAX_LENGTH) {
+            /* The caller rejects the command when it gets there */
+            return ENGINE_SUCCESS;
+        }
+
+        keys[count] = key_token->value;
+        nkeys[count] = key_token->length;
+        count++;
+    }
+
+    if (count < 2) {
+        return ENGINE_SUCCESS;
+    }
+
+    if (settings.engine.v1->get_multi == NULL
+        || c->aiostat != ENGINE_SUCCESS) {
+        return ENGINE_ENOTSUP;
+    }
+
+    ret = settings.engine.v1->get_multi(settings.engine.v0, c, items,
+                                        keys, nkeys, count, 0);
+    if (ret == ENGINE_SUCCESS) {
+        *nitems = count;
+    }
+
+    return ret;
+}
+
+/*
+ * Release the items that won't be sent to the client.
+ */
+static void release_get_items(conn *c, item **items, int count) {
+    int ii;
+
+    for (ii = 0; ii < count; ii++) {
+        if (items[ii] != NULL) {
+            settings.engine.v1->release(settings.engine.v0, c, items[ii]);
+        }
+    }
+}
+
 /* ntokens is overwritten here... shrug.. */
 static inline char* process_get_command(conn *c, token_t *tokens, size_t ntokens, bool return_cas) {
     char *key;
@@ -4044,15 +4103,34 @@ static inline char* process_get_command(conn *c, token_t *tokens, size_t ntokens
     int i = c->ileft;
     item *it;
     token_t *key_token = &tokens[KEY_TOKEN];
+    item *prefetched[MAX_TOKENS];
+    int nprefetched;
+    int next_prefetched;
     assert(c != NULL);
 
-    /* We temporarily block the mgets commands till wl6650 checked in. */
-    if ((key_token + 1)->length > 0) {
-	out_string(c, "We temporarily don't support multiple get option.");
-	return NULL;
-    }
-
     do {
+        ENGINE_ERROR_CODE mret = prefetch_get_items(c, key_token, prefetched,
+                                                    &nprefetched);
+        if (mret != ENGINE_SUCCESS) {
+            /* Items of earlier batches won't be sent */
+            release_get_items(c, c->ilist + c->ileft, i - c->ileft);
+            switch (mret) {
+            case ENGINE_ENOTSUP:
+                out_string(c, "We temporarily don't support multiple get option.");
+                break;
+            case ENGINE_ENOMEM:
+                out_string(c, "SERVER_ERROR out of memory");
+                break;
+            case ENGINE_TMPFAIL:
+                out_string(c, "SERVER_ERROR temporary failure");
+                break;
+            default:
+                out_string(c, "SERVER_ERROR internal");
+            }
+            return NULL;
+        }
+        next_prefetched = 0;
+
         while(key_token->length != 0) {
 
             key = key_token->value;
@@ -4066,7 +4144,11 @@ static inline char* process_get_command(conn *c, token_t *tokens, size_t ntokens
             ENGINE_ERROR_CODE ret = c->aiostat;
             c->aiostat = ENGINE_SUCCESS;
 
-            if (ret == ENGINE_SUCCESS) {
+            if (next_prefetched < nprefetched) {
+                it = prefetched[next_prefetched];
+                prefetched[next_prefetched++] = NULL;
+                ret = it != NULL ? ENGINE_SUCCESS : ENGINE_KEY_ENOENT;
+            } else if (ret == ENGINE_SUCCESS) {
                 ret = settings.engine.v1->get(settings.engine.v0, c, &it, key, nkey, 0);
             }
 
@@ -4113,6 +4195,7 @@ static inline char* process_get_command(conn *c, token_t *tokens, size_t ntokens
                 if (suffix == NULL) {
                     out_string(c, "SERVER_ERROR out of memory rebuilding suffix");
                     settings.engine.v1->release(settings.engine.v0, c, it);
+                    release_get_items(c, prefetched, nprefetched);
                     return NULL;
                 }
                 int suffix_len = snprintf(suffix, SUFFIX_SIZE,
@@ -4136,6 +4219,7 @@ static inline char* process_get_command(conn *c, token_t *tokens, size_t ntokens
                   if (cas == NULL) {
                     out_string(c, "SERVER_ERROR out of memory making CAS suffix");
                     settings.engine.v1->release(settings.engine.v0, c, it);
+                    release_get_items(c, prefetched, nprefetched);
                     return NULL;
                   }
                   int cas_len = snprintf(cas, SUFFIX_SIZE, " %" PRIu64"\r\n",
@@ -4184,6 +4268,9 @@ static inline char* process_get_command(conn *c, token_t *tokens, size_t ntokens
             key_token++;
         }
 
+        /* Items left over if the loop above was terminated early. */
+        release_get_items(c, prefetched, nprefetched);
+
         /*
          * If the command string hasn't been fully processed, get the next set
          * of tokens.
@@ -5260,7 +5347,19 @@ bool conn_ship_log(conn *c) {
     return cont;
 }
 
+/*
+ * Let the engine finish the quiet updates it batched for this connection,
+ * the client must not see a response or go idle before they are done.
+ */
+static void end_engine_batch(conn *c) {
+    if (settings.engine.v1->end_batch != NULL) {
+        settings.engine.v1->end_batch(settings.engine.v0, c);
+    }
+}
+
 bool conn_waiting(conn *c) {
+    end_engine_batch(c);
+
     if (!update_event(c, EV_READ | EV_PERSIST)) {
         if (settings.verbose > 0) {
             settings.extensions.logger->log(EXTENSION_LOG_INFO, c,
@@ -5491,6 +5590,8 @@ bool conn_write(conn *c) {
 }
 
 bool conn_mwrite(conn *c) {
+    end_engine_batch(c);
+
     if (IS_UDP(c->transport) && c->msgcurr == 0 && build_udp_headers(c) != 0) {
         if (settings.verbose > 0) {
             settings.extensions.logger->log(EXTENSION_LOG_INFO, c,
@@ -6410,6 +6511,11 @@ static int get_socket_fd(const void *cookie) {
     return c->sfd;
 }
 
+static bool is_quiet(const void *cookie) {
+    conn *c = (conn *)cookie;
+    return c->noreply;
+}
+
 static void set_tap_nack_mode(const void *cookie, bool enable) {
     conn *c = (conn *)cookie;
     c->tap_nack_mode = enable;
@@ -6868,7 +6974,8 @@ static SERVER_HANDLE_V1 *get_server_api(void)
         .set_tap_nack_mode = set_tap_nack_mode,
         .notify_io_complete = notify_io_complete,
         .reserve = reserve_cookie,
-        .release = release_cookie
+        .release = release_cookie,
+        .is_quiet = is_quiet
     };
 
     static SERVER_STAT_API server_stat_api = {
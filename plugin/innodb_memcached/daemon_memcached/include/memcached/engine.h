@@ -334,6 +334,32 @@ extern "C" {
                                  const int nkey,
                                  uint16_t vbucket);
 
+        /**
+         * Retrieve several items at once (optional, may be NULL).
+         *
+         * The engine may fetch the keys in any order it likes, but
+         * items[i] receives the item of keys[i], or NULL if that key
+         * was not found. Every item returned must be released.
+         *
+         * @param handle the engine handle
+         * @param cookie The cookie provided by the frontend
+         * @param items output array that will receive the located items
+         * @param keys the keys to look up
+         * @param nkeys the lengths of the keys
+         * @param count the number of keys
+         * @param vbucket the virtual bucket id
+         *
+         * @return ENGINE_SUCCESS if all keys were looked up; on any
+         *         other return the frontend gets the keys one by one
+         */
+        ENGINE_ERROR_CODE (*get_multi)(ENGINE_HANDLE* handle,
+                                       const void* cookie,
+                                       item** items,
+                                       const void* const* keys,
+                                       const int* nkeys,
+                                       int count,
+                                       uint16_t vbucket);
+
         /**
          * Store an item.
          *
@@ -353,6 +379,20 @@ extern "C" {
                                    ENGINE_STORE_OPERATION operation,
                                    uint16_t vbucket);
 
+        /**
+         * Finish the updates that the engine is holding back for this
+         * connection (optional, may be NULL).
+         *
+         * Called before the frontend sends a response to the client or
+         * waits for more input, so an engine may group a run of quiet
+         * (noreply) updates and make them persistent at once.
+         *
+         * @param handle the engine handle
+         * @param cookie The cookie provided by the frontend
+         */
+        void (*end_batch)(ENGINE_HANDLE* handle,
+                          const void *cookie);
+
         /**
          * Perform an increment or decrement operation on an item.
          *
@@ -155,6 +155,14 @@ extern "C" {
          */
         void (*release)(const void *cookie);
 
+        /**
+         * Check whether the command the connection is processing is a
+         * quiet one (noreply text command or quiet binary command), so
+         * the client does not wait for its response.
+         *
+         * @param cookie The cookie provided by the frontend
+         */
+        bool (*is_quiet)(const void *cookie);
 
     } SERVER_COOKIE_API;
 
@@ -71,6 +71,11 @@ static void mock_cookie_release(const void *cookie) {
     (void)cookie;
 }
 
+static bool mock_is_quiet(const void *cookie) {
+    (void)cookie;
+    return false;
+}
+
 static const char *mock_get_server_version() {
     return "mock server";
 }
@@ -276,7 +281,8 @@ SERVER_HANDLE_V1 *get_mock_server_api(void)
         .set_tap_nack_mode = mock_set_tap_nack_mode,
         .notify_io_complete = mock_notify_io_complete,
         .reserve = mock_cookie_reserve,
-        .release = mock_cookie_release
+        .release = mock_cookie_release,
+        .is_quiet = mock_is_quiet
     };
 
     static SERVER_STAT_API server_stat_api = {
@@ -75,6 +75,14 @@ struct innodb_conn_data_struct {
 	bool		is_stale;	/*!< connection closed, this is
 					stale */
 	bool		is_flushing;	/*!< if flush is running. */
+	bool		commit_deferred;/*!< whether the commit of a full
+					write batch waits for
+					innodb_end_batch() */
+	bool		quiet_update;	/*!< whether the current update
+					is a quiet (noreply) one */
+	int		n_mget_items;	/*!< number of items a multi-get
+					returned that are not released
+					yet */
 	bool            is_waiting_for_mdl;
 					/*!< Used to detrmine if the connection is
 					locked and waiting on MDL */
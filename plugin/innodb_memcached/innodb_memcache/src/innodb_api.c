@@ -1934,6 +1934,33 @@ innodb_api_flush(
 	return(err);
 }
 
+/*************************************************************//**
+Get the cursor that the connection's transaction was started on
+@return the search cursor of the connection */
+static
+ib_crsr_t
+innodb_api_conn_crsr(
+/*=================*/
+	innodb_conn_data_t*	conn_data)	/*!< in: cursor affiliated
+						with a connection */
+{
+	meta_cfg_info_t*	meta_info = conn_data->conn_meta;
+	meta_index_t*		meta_index = &meta_info->index_info;
+
+	if (meta_index->srch_use_idx == META_USE_SECONDARY) {
+		assert(conn_data->idx_crsr
+		       || conn_data->idx_read_crsr);
+
+		return(conn_data->idx_crsr
+		       ? conn_data->idx_crsr
+		       : conn_data->idx_read_crsr);
+	}
+
+	assert(conn_data->crsr || conn_data->read_crsr);
+
+	return(conn_data->crsr ? conn_data->crsr : conn_data->read_crsr);
+}
+
 /*************************************************************//**
 Increment read and write counters, if they exceed the batch size,
 commit the transaction. */
@@ -1968,25 +1995,7 @@ innodb_reset_conn(
 	}
 
 	if (conn_data->crsr_trx) {
-		ib_crsr_t		ib_crsr;
-		meta_cfg_info_t*	meta_info = conn_data->conn_meta;
-		meta_index_t*		meta_index = &meta_info->index_info;
-
-		if (meta_index->srch_use_idx == META_USE_SECONDARY) {
-			assert(conn_data->idx_crsr
-			       || conn_data->idx_read_crsr);
-
-			ib_crsr = conn_data->idx_crsr
-				  ? conn_data->idx_crsr
-				  : conn_data->idx_read_crsr;
-		} else {
-			assert(conn_data->crsr
-			       || conn_data->read_crsr);
-
-			ib_crsr = conn_data->crsr
-				  ? conn_data->crsr
-				  : conn_data->read_crsr;
-		}
+		ib_crsr_t	ib_crsr = innodb_api_conn_crsr(conn_data);
 
 		if (commit) {
 			if (has_binlog && conn_data->thd
@@ -2018,6 +2027,7 @@ innodb_reset_conn(
 
 	conn_data->n_writes_since_commit = 0;
 	conn_data->n_reads_since_commit = 0;
+	conn_data->commit_deferred = false;
 
 	UNLOCK_CURRENT_CONN_IF_NOT_LOCKED(has_lock, conn_data);
 	return(commit_trx);
@@ -2052,7 +2062,32 @@ innodb_api_cursor_reset(
 		break;
 	}
 
-	if (release_mdl_lock
+	if ((op_type == CONN_OP_WRITE || op_type == CONN_OP_DELETE)
+	    && (commit
+		? (conn_data->quiet_update && !release_mdl_lock
+		   && conn_data->n_reads_since_commit
+		      < engine->read_batch_size
+		   && conn_data->n_writes_since_commit
+		      >= engine->write_batch_size)
+		: conn_data->commit_deferred)) {
+		/* A quiet update filled the write batch. The client does
+		not wait for its response and may have more quiet updates
+		queued, innodb_end_batch() commits them all before the
+		client gets a response or the connection goes idle.
+		An update that failed after such a quiet one has been
+		rolled back to its savepoint by InnoDB. It must neither
+		be committed here nor take the earlier quiet updates
+		down with it, so leave their commit to innodb_end_batch()
+		as well. */
+		if (conn_data->commit_deferred) {
+			/* The first deferred operation keeps the table
+			marked as used by memcached until the commit. */
+			ib_cb_cursor_set_memcached_sync(
+				innodb_api_conn_crsr(conn_data), false);
+		}
+
+		conn_data->commit_deferred = true;
+	} else if (release_mdl_lock
 	    || conn_data->n_reads_since_commit >= engine->read_batch_size
 	    || conn_data->n_writes_since_commit >= engine->write_batch_size
 	    || (op_type == CONN_OP_FLUSH) || !commit) {
@@ -184,9 +184,11 @@ create_instance(
 	innodb_eng->engine.release = innodb_release;
 	innodb_eng->engine.clean_engine= innodb_clean_engine;
 	innodb_eng->engine.get = innodb_get;
+	innodb_eng->engine.get_multi = innodb_get_multi;
 	innodb_eng->engine.get_stats = innodb_get_stats;
 	innodb_eng->engine.reset_stats = innodb_reset_stats;
 	innodb_eng->engine.store = innodb_store;
+	innodb_eng->engine.end_batch = innodb_end_batch;
 	innodb_eng->engine.arithmetic = innodb_arithmetic;
 	innodb_eng->engine.flush = innodb_flush;
 	innodb_eng->engine.unknown_command = innodb_unknown_command;
@@ -1411,6 +1413,8 @@ innodb_remove(
 		return(ENGINE_TMPFAIL);
 	}
 
+	conn_data->quiet_update = innodb_eng->server.cookie->is_quiet(cookie);
+
 	/* In the binary protocol there is such a thing as a CAS delete.
 	This is the CAS check. If we will also be deleting from the database,
 	there are two possibilities:
@@ -1615,8 +1619,7 @@ innodb_release(
 	ENGINE_HANDLE*		handle,		/*!< in: Engine handle */
 	const void*		cookie __attribute__((unused)),
 						/*!< in: connection cookie */
-	item*			item __attribute__((unused)))
-						/*!< in: item to free */
+	item*			item)		/*!< in: item to free */
 {
 	struct innodb_engine*	innodb_eng = innodb_handle(handle);
 	innodb_conn_data_t*	conn_data;
@@ -1627,6 +1630,17 @@ innodb_release(
 		return;
 	}
 
+	/* A copy made by innodb_get_multi() */
+	if (conn_data->n_mget_items > 0 && item != conn_data->result) {
+		free(item);
+
+		if (--conn_data->n_mget_items == 0) {
+			conn_data->result_in_use = false;
+		}
+
+		return;
+	}
+
 	conn_data->result_in_use = false;
 
 	/* If item's memory comes from Memcached default engine, release it
@@ -1721,6 +1735,160 @@ innodb_free_item(
 			false;
 	}
 }
+/*******************************************************************//**
+Check the expiration of a row read by innodb_api_search(), and assemble
+its memcached value from the mapped value columns
+@return ENGINE_SUCCESS if successfully, ENGINE_KEY_ENOENT if expired */
+static
+ENGINE_ERROR_CODE
+innodb_get_value(
+/*=============*/
+	innodb_conn_data_t*	conn_data,	/*!< in/out: connection data */
+	meta_cfg_info_t*	meta_info,	/*!< in: metadata info */
+	mci_item_t*		result)		/*!< in/out: row read */
+{
+	int			option_length;
+	const char*		option_delimiter;
+
+	/* Only if expiration field is enabled, and the value is not zero,
+	we will check whether the item is expired */
+	if (result->col_value[MCI_COL_EXP].is_valid
+	    && result->col_value[MCI_COL_EXP].value_int) {
+		uint64_t time;
+		time = mci_get_time();
+		if (time > result->col_value[MCI_COL_EXP].value_int) {
+			innodb_free_item(result);
+			return(ENGINE_KEY_ENOENT);
+		}
+	}
+
+	if (result->extra_col_value) {
+		int		i;
+		char*		c_value;
+		char*		value_end;
+		unsigned int	total_len = 0;
+		char		int_buf[MAX_INT_CHAR_LEN];
+
+		GET_OPTION(meta_info, OPTION_ID_COL_SEP, option_delimiter,
+			   option_length);
+
+		assert(option_length > 0 && option_delimiter);
+
+		for (i = 0; i < result->n_extra_col; i++) {
+			mci_column_t*   mci_item = &result->extra_col_value[i];
+
+			if (mci_item->value_len == 0) {
+				total_len += option_length;
+				continue;
+			}
+
+			if (!mci_item->is_str) {
+				memset(int_buf, 0, sizeof int_buf);
+				assert(!mci_item->value_str);
+
+				total_len += convert_to_char(
+					int_buf, sizeof int_buf,
+					&mci_item->value_int,
+					mci_item->value_len,
+					mci_item->is_unsigned);
+			} else {
+				total_len += result->extra_col_value[i].value_len;
+			}
+
+			total_len += option_length;
+		}
+
+		/* No need to add the last separator */
+		total_len -= option_length;
+
+		if (total_len > conn_data->mul_col_buf_len) {
+			if (conn_data->mul_col_buf) {
+				free(conn_data->mul_col_buf);
+			}
+
+			conn_data->mul_col_buf = malloc(total_len + 1);
+			conn_data->mul_col_buf_len = total_len;
+		}
+
+		c_value = conn_data->mul_col_buf;
+		value_end = conn_data->mul_col_buf + total_len;
+
+		for (i = 0; i < result->n_extra_col; i++) {
+			mci_column_t*   col_value;
+
+			col_value = &result->extra_col_value[i];
+
+			if (col_value->value_len != 0) {
+				if (!col_value->is_str) {
+					int	int_len;
+					memset(int_buf, 0, sizeof int_buf);
+
+					int_len = convert_to_char(
+						int_buf,
+						sizeof int_buf,
+						&col_value->value_int,
+						col_value->value_len,
+						col_value->is_unsigned);
+
+                                        assert(int_len <= conn_data->mul_col_buf_len);
+
+					memcpy(c_value, int_buf, int_len);
+					c_value += int_len;
+				} else {
+					memcpy(c_value,
+					       col_value->value_str,
+					       col_value->value_len);
+					c_value += col_value->value_len;
+				}
+			}
+
+			if (i < result->n_extra_col - 1 ) {
+				memcpy(c_value, option_delimiter, option_length);
+				c_value += option_length;
+			}
+
+			assert(c_value <= value_end);
+
+			if (col_value->allocated) {
+				free(col_value->value_str);
+			}
+		}
+
+		result->col_value[MCI_COL_VALUE].value_str = conn_data->mul_col_buf;
+		result->col_value[MCI_COL_VALUE].value_len = total_len;
+		((char*)result->col_value[MCI_COL_VALUE].value_str)[total_len] = 0;
+
+		free(result->extra_col_value);
+	} else if (!result->col_value[MCI_COL_VALUE].is_str
+		&& result->col_value[MCI_COL_VALUE].value_len != 0) {
+		unsigned int	int_len;
+		char		int_buf[MAX_INT_CHAR_LEN];
+
+		int_len = convert_to_char(
+			int_buf, sizeof int_buf,
+			&result->col_value[MCI_COL_VALUE].value_int,
+			result->col_value[MCI_COL_VALUE].value_len,
+			result->col_value[MCI_COL_VALUE].is_unsigned);
+
+		if (int_len > conn_data->mul_col_buf_len) {
+			if (conn_data->mul_col_buf) {
+				free(conn_data->mul_col_buf);
+			}
+
+			conn_data->mul_col_buf = malloc(int_len + 1);
+			conn_data->mul_col_buf_len = int_len;
+		}
+
+		memcpy(conn_data->mul_col_buf, int_buf, int_len);
+		result->col_value[MCI_COL_VALUE].value_str =
+			 conn_data->mul_col_buf;
+
+		result->col_value[MCI_COL_VALUE].value_len = int_len;
+	}
+
+	return(ENGINE_SUCCESS);
+}
+
 /*******************************************************************//**
 Support memcached "GET" command, fetch the value according to key
 @return ENGINE_SUCCESS if successfully, otherwise error code */
@@ -1744,8 +1912,6 @@ innodb_get(
 	ENGINE_ERROR_CODE	err_ret = ENGINE_SUCCESS;
 	innodb_conn_data_t*	conn_data = NULL;
 	meta_cfg_info_t*	meta_info = innodb_eng->meta_info;
-	int			option_length;
-	const char*		option_delimiter;
 	size_t			key_len = nkey;
 	int			lock_mode;
 	bool			report_table_switch = false;
@@ -1849,161 +2015,219 @@ search_done:
 	result->col_value[MCI_COL_KEY].value_str = (char*)key;
 	result->col_value[MCI_COL_KEY].value_len = nkey;
 
-	/* Only if expiration field is enabled, and the value is not zero,
-	we will check whether the item is expired */
-	if (result->col_value[MCI_COL_EXP].is_valid
-	    && result->col_value[MCI_COL_EXP].value_int) {
-		uint64_t time;
-		time = mci_get_time();
-		if (time > result->col_value[MCI_COL_EXP].value_int) {
-			innodb_free_item(result);
-			err_ret = ENGINE_KEY_ENOENT;
-			goto func_exit;
-		}
+	err_ret = innodb_get_value(conn_data, meta_info, result);
+
+	if (err_ret != ENGINE_SUCCESS) {
+		goto func_exit;
 	}
 
-	if (result->extra_col_value) {
-		int		i;
-		char*		c_value;
-		char*		value_end;
-		unsigned int	total_len = 0;
-		char		int_buf[MAX_INT_CHAR_LEN];
+        *item = result;
 
-		GET_OPTION(meta_info, OPTION_ID_COL_SEP, option_delimiter,
-			   option_length);
+func_exit:
 
-		assert(option_length > 0 && option_delimiter);
+	if (!report_table_switch) {
+		innodb_api_cursor_reset(innodb_eng, conn_data,
+					CONN_OP_READ, true);
+	}
 
-		for (i = 0; i < result->n_extra_col; i++) {
-			mci_column_t*   mci_item = &result->extra_col_value[i];
+err_exit:
 
-			if (mci_item->value_len == 0) {
-				total_len += option_length;
-				continue;
-			}
+	/* If error return, memcached will not call InnoDB Memcached's
+	callback function "innodb_release" to reset the result_in_use
+	value. So we reset it here */
+	if (err_ret != ENGINE_SUCCESS && conn_data) {
+		conn_data->result_in_use = false;
+	}
+	return(err_ret);
+}
 
-			if (!mci_item->is_str) {
-				memset(int_buf, 0, sizeof int_buf);
-				assert(!mci_item->value_str);
+/** A key of a multi-get, and its position in the request */
+typedef struct innodb_mget_key {
+	const char*	key;		/*!< key */
+	int		nkey;		/*!< key length */
+	int		pos;		/*!< position of the key in the
+					request */
+} innodb_mget_key_t;
 
-				total_len += convert_to_char(
-					int_buf, sizeof int_buf,
-					&mci_item->value_int,
-					mci_item->value_len,
-					mci_item->is_unsigned);
-			} else {
-				total_len += result->extra_col_value[i].value_len;
-			}
+/*******************************************************************//**
+Compare two keys of a multi-get, used by qsort()
+@return < 0, 0 or > 0 if key1 sorts before, equal to or after key2 */
+static
+int
+innodb_mget_key_cmp(
+/*================*/
+	const void*	key1,		/*!< in: innodb_mget_key_t */
+	const void*	key2)		/*!< in: innodb_mget_key_t */
+{
+	const innodb_mget_key_t*	k1 = key1;
+	const innodb_mget_key_t*	k2 = key2;
+	int				cmp;
 
-			total_len += option_length;
-		}
+	cmp = memcmp(k1->key, k2->key,
+		     k1->nkey < k2->nkey ? k1->nkey : k2->nkey);
 
-		/* No need to add the last separator */
-		total_len -= option_length;
+	return(cmp != 0 ? cmp : k1->nkey - k2->nkey);
+}
 
-		if (total_len > conn_data->mul_col_buf_len) {
-			if (conn_data->mul_col_buf) {
-				free(conn_data->mul_col_buf);
-			}
+/*******************************************************************//**
+Copy a result into memory of its own, as the next search of the
+connection reuses the buffers the result points into
+@return own: copy of the result, or NULL if out of memory */
+static
+mci_item_t*
+innodb_copy_item(
+/*=============*/
+	const mci_item_t*	result)		/*!< in: result to copy */
+{
+	const mci_column_t*	key = &result->col_value[MCI_COL_KEY];
+	const mci_column_t*	value = &result->col_value[MCI_COL_VALUE];
+	mci_item_t*		copy;
+	char*			buf;
 
-			conn_data->mul_col_buf = malloc(total_len + 1);
-			conn_data->mul_col_buf_len = total_len;
-		}
+	copy = malloc(sizeof(*copy) + key->value_len + value->value_len + 1);
 
-		c_value = conn_data->mul_col_buf;
-		value_end = conn_data->mul_col_buf + total_len;
+	if (!copy) {
+		return(NULL);
+	}
 
-		for (i = 0; i < result->n_extra_col; i++) {
-			mci_column_t*   col_value;
+	*copy = *result;
+	copy->extra_col_value = NULL;
+	copy->n_extra_col = 0;
 
-			col_value = &result->extra_col_value[i];
+	buf = (char*) (copy + 1);
+	memcpy(buf, key->value_str, key->value_len);
+	copy->col_value[MCI_COL_KEY].value_str = buf;
+	copy->col_value[MCI_COL_KEY].allocated = false;
 
-			if (col_value->value_len != 0) {
-				if (!col_value->is_str) {
-					int	int_len;
-					memset(int_buf, 0, sizeof int_buf);
+	buf += key->value_len;
 
-					int_len = convert_to_char(
-						int_buf,
-						sizeof int_buf,
-						&col_value->value_int,
-						col_value->value_len,
-						col_value->is_unsigned);
+	if (value->value_len > 0) {
+		memcpy(buf, value->value_str, value->value_len);
+	}
 
-                                        assert(int_len <= conn_data->mul_col_buf_len);
+	buf[value->value_len] = '\0';
+	copy->col_value[MCI_COL_VALUE].value_str = buf;
+	copy->col_value[MCI_COL_VALUE].allocated = false;
 
-					memcpy(c_value, int_buf, int_len);
-					c_value += int_len;
-				} else {
-					memcpy(c_value,
-					       col_value->value_str,
-					       col_value->value_len);
-					c_value += col_value->value_len;
-				}
-			}
+	return(copy);
+}
 
-			if (i < result->n_extra_col - 1 ) {
-				memcpy(c_value, option_delimiter, option_length);
-				c_value += option_length;
-			}
+/*******************************************************************//**
+Support memcached "GET" command with multiple keys. The keys are looked
+up in key order with the read cursor of a single operation, each row
+found is copied out, so that all items stay valid until released.
+@return ENGINE_SUCCESS if successfully, ENGINE_ENOTSUP if the keys must
+be fetched one by one, otherwise error code */
+static
+ENGINE_ERROR_CODE
+innodb_get_multi(
+/*=============*/
+	ENGINE_HANDLE*		handle,		/*!< in: Engine Handle */
+	const void*		cookie,		/*!< in: connection cookie */
+	item**			items,		/*!< out: items to fill, NULL
+						for keys not found */
+	const void* const*	keys,		/*!< in: search keys */
+	const int*		nkeys,		/*!< in: key lengths */
+	int			count,		/*!< in: number of keys */
+	uint16_t		vbucket __attribute__((unused)))
+						/*!< in: bucket, used by default
+						engine only */
+{
+	struct innodb_engine*	innodb_eng = innodb_handle(handle);
+	meta_cfg_info_t*	meta_info = innodb_eng->meta_info;
+	innodb_conn_data_t*	conn_data;
+	innodb_mget_key_t*	sorted;
+	ib_crsr_t		crsr;
+	int			lock_mode;
+	int			n_found = 0;
+	int			i;
 
-			assert(c_value <= value_end);
+	/* Items of the memcached default engine and table mapping
+	switches are handled by innodb_get() */
+	if (meta_info->get_option != META_CACHE_OPT_INNODB) {
+		return(ENGINE_ENOTSUP);
+	}
 
-			if (col_value->allocated) {
-				free(col_value->value_str);
-			}
+	sorted = malloc(count * sizeof(*sorted));
+
+	if (!sorted) {
+		return(ENGINE_ENOMEM);
+	}
+
+	for (i = 0; i < count; i++) {
+		const char*	key = keys[i];
+
+		if (nkeys[i] > 1 && key[0] == '@' && key[1] == '@') {
+			free(sorted);
+			return(ENGINE_ENOTSUP);
 		}
 
-		result->col_value[MCI_COL_VALUE].value_str = conn_data->mul_col_buf;
-		result->col_value[MCI_COL_VALUE].value_len = total_len;
-		((char*)result->col_value[MCI_COL_VALUE].value_str)[total_len] = 0;
+		sorted[i].key = key;
+		sorted[i].nkey = nkeys[i];
+		sorted[i].pos = i;
+		items[i] = NULL;
+	}
 
-		free(result->extra_col_value);
-	} else if (!result->col_value[MCI_COL_VALUE].is_str
-		&& result->col_value[MCI_COL_VALUE].value_len != 0) {
-		unsigned int	int_len;
-		char		int_buf[MAX_INT_CHAR_LEN];
+	/* Probe the index in key order, which touches each leaf page once
+	for neighbouring keys */
+	qsort(sorted, count, sizeof(*sorted), innodb_mget_key_cmp);
 
-		int_len = convert_to_char(
-			int_buf, sizeof int_buf,
-			&result->col_value[MCI_COL_VALUE].value_int,
-			result->col_value[MCI_COL_VALUE].value_len,
-			result->col_value[MCI_COL_VALUE].is_unsigned);
+	lock_mode = (innodb_eng->trx_level == IB_TRX_SERIALIZABLE
+		     && innodb_eng->read_batch_size == 1)
+			? IB_LOCK_S
+			: IB_LOCK_NONE;
 
-		if (int_len > conn_data->mul_col_buf_len) {
-			if (conn_data->mul_col_buf) {
-				free(conn_data->mul_col_buf);
-			}
+	conn_data = innodb_conn_init(innodb_eng, cookie, CONN_MODE_READ,
+				     lock_mode, false, NULL);
 
-			conn_data->mul_col_buf = malloc(int_len + 1);
-			conn_data->mul_col_buf_len = int_len;
+	if (!conn_data) {
+		free(sorted);
+		return(ENGINE_TMPFAIL);
+	}
+
+	for (i = 0; i < count; i++) {
+		mci_item_t*	result = (mci_item_t*)(conn_data->result);
+		ib_err_t	err;
+
+		err = innodb_api_search(conn_data, &crsr, sorted[i].key,
+					sorted[i].nkey, result, NULL, true);
+
+		if (err != DB_SUCCESS) {
+			continue;
 		}
 
-		memcpy(conn_data->mul_col_buf, int_buf, int_len);
-		result->col_value[MCI_COL_VALUE].value_str =
-			 conn_data->mul_col_buf;
+		result->col_value[MCI_COL_KEY].value_str =
+			(char*) sorted[i].key;
+		result->col_value[MCI_COL_KEY].value_len = sorted[i].nkey;
 
-		result->col_value[MCI_COL_VALUE].value_len = int_len;
-	}
+		if (innodb_get_value(conn_data, meta_info, result)
+		    != ENGINE_SUCCESS) {
+			continue;
+		}
 
-        *item = result;
+		items[sorted[i].pos] = innodb_copy_item(result);
 
-func_exit:
+		if (items[sorted[i].pos]) {
+			n_found++;
+		}
 
-	if (!report_table_switch) {
-		innodb_api_cursor_reset(innodb_eng, conn_data,
-					CONN_OP_READ, true);
+		if (result->col_value[MCI_COL_VALUE].allocated) {
+			free(result->col_value[MCI_COL_VALUE].value_str);
+			result->col_value[MCI_COL_VALUE].allocated = false;
+		}
 	}
 
-err_exit:
+	innodb_api_cursor_reset(innodb_eng, conn_data, CONN_OP_READ, true);
 
-	/* If error return, memcached will not call InnoDB Memcached's
-	callback function "innodb_release" to reset the result_in_use
-	value. So we reset it here */
-	if (err_ret != ENGINE_SUCCESS && conn_data) {
-		conn_data->result_in_use = false;
-	}
-	return(err_ret);
+	/* The copies are released by innodb_release(). A get with more
+	keys than fit in one token batch calls us once per batch before
+	any item is released, so add to the copies still outstanding. */
+	conn_data->n_mget_items += n_found;
+	conn_data->result_in_use = conn_data->n_mget_items > 0;
+
+	free(sorted);
+
+	return(ENGINE_SUCCESS);
 }
 
 /*******************************************************************//**
@@ -2103,6 +2327,8 @@ innodb_store(
 		return(ENGINE_NOT_STORED);
 	}
 
+	conn_data->quiet_update = innodb_eng->server.cookie->is_quiet(cookie);
+
 	input_cas = hash_item_get_cas(item);
 
 	result = innodb_api_store(innodb_eng, conn_data, value + len - key_len,
@@ -2114,6 +2340,45 @@ innodb_store(
 	return(result);
 }
 
+/*******************************************************************//**
+Commit the write batch whose commit was deferred by
+innodb_api_cursor_reset(), before the client gets a response to its
+updates or the connection goes idle */
+static
+void
+innodb_end_batch(
+/*=============*/
+	ENGINE_HANDLE*		handle,		/*!< in: Engine Handle */
+	const void*		cookie)		/*!< in: connection cookie */
+{
+	struct innodb_engine*	innodb_eng = innodb_handle(handle);
+	innodb_conn_data_t*	conn_data;
+
+	conn_data = innodb_eng->server.cookie->get_engine_specific(cookie);
+
+	if (!conn_data || !conn_data->commit_deferred) {
+		return;
+	}
+
+	LOCK_CURRENT_CONN_IF_NOT_LOCKED(false, conn_data);
+
+	/* The background thread could have committed it meanwhile */
+	if (conn_data->commit_deferred && conn_data->crsr_trx) {
+		if (conn_data->thd) {
+			handler_thd_attach(conn_data->thd, NULL);
+		}
+
+		/* Let the commit unmark the table as used by memcached,
+		as the commit of the last operation would have done */
+		conn_data->in_use = true;
+
+		innodb_reset_conn(conn_data, true, true,
+				  innodb_eng->enable_binlog);
+	}
+
+	UNLOCK_CURRENT_CONN_IF_NOT_LOCKED(false, conn_data);
+}
+
 /*******************************************************************//**
 Support memcached "INCR" and "DECR" command, add or subtract a "delta"
 value from an integer key value
@@ -2169,6 +2434,8 @@ innodb_arithmetic(
 		return(ENGINE_NOT_STORED);
 	}
 
+	conn_data->quiet_update = innodb_eng->server.cookie->is_quiet(cookie);
+
 	err_ret = innodb_api_arithmetic(innodb_eng, conn_data, key, nkey,
 					delta, increment, cas, exptime,
 					create, initial, result);
@@ -148,6 +148,23 @@ innodb_get(
 	uint16_t	vbucket);	/*!< in: bucket, used by default
 					engine only */
 
+/*******************************************************************//**
+Support memcached "GET" command with multiple keys
+@return ENGINE_SUCCESS if successfully, ENGINE_ENOTSUP if the keys must
+be fetched one by one, otherwise error code */
+static
+ENGINE_ERROR_CODE
+innodb_get_multi(
+/*=============*/
+	ENGINE_HANDLE*	handle,		/*!< in: Engine Handle */
+	const void*	cookie,		/*!< in: connection cookie */
+	item**		items,		/*!< out: items to fill */
+	const void* const* keys,	/*!< in: search keys */
+	const int*	nkeys,		/*!< in: key lengths */
+	int		count,		/*!< in: number of keys */
+	uint16_t	vbucket);	/*!< in: bucket, used by default
+					engine only */
+
 /*******************************************************************//**
 Get statistics info
 @return ENGINE_SUCCESS if successfully, otherwise error code */
@@ -187,6 +204,16 @@ innodb_store(
 	uint16_t	vbucket);	/*!< in: bucket, used by default
 					engine only */
 
+/*******************************************************************//**
+Commit the write batch whose commit was deferred, before the client gets
+a response or the connection goes idle */
+static
+void
+innodb_end_batch(
+/*=============*/
+	ENGINE_HANDLE*	handle,		/*!< in: Engine Handle */
+	const void*	cookie);	/*!< in: connection cookie */
+
 /*******************************************************************//**
 Support memcached "INCR" and "DECR" command, add or subtract a "delta"
 value from an integer key value
@@ -62,6 +62,8 @@ extern char glob_hostname[FN_REFLEN];
 
 /* Size for IO_CACHE buffer for binlog & relay log */
 ulong rpl_read_size;
+/* Read binlog & relay log ahead for binlog dump and the SQL thread */
+my_bool rpl_read_ahead;
 
 #define FLAGSTR(V,F) ((V)&(F)?#F" ":"")
 
@@ -97,6 +99,19 @@ int opt_histogram_step_size_binlog_group_commit = 1;
 latency_histogram histogram_binlog_fsync;
 counter_histogram histogram_binlog_group_commit;
 
+char *histogram_step_size_binlog_commit_stages= NULL;
+latency_histogram histogram_binlog_flush_stage_wait;
+latency_histogram histogram_binlog_flush_stage;
+latency_histogram histogram_binlog_sync_delay;
+latency_histogram histogram_binlog_commit_stage_wait;
+latency_histogram histogram_binlog_commit_stage;
+
+ulong opt_binlog_group_commit_sync_delay= 0;
+ulong opt_binlog_group_commit_sync_no_delay_count= 0;
+my_bool opt_binlog_group_commit_adaptive_delay= FALSE;
+/* Delay used by the last group commit, in microseconds */
+ulong binlog_group_commit_last_delay= 0;
+
 extern my_bool opt_core_file;
 
 const char *hlc_ts_lower_bound = "hlc_ts_lower_bound";
@@ -338,6 +353,82 @@ exit0:
 };
 
 
+/**
+  Checksums of the events in a binlog cache, computed by the session
+  that owns the cache before it enters the flush stage of group commit.
+
+  When the flush stage leader copies the cache to the binary log, it has
+  to rewrite the length and the end_log_pos in the header of every event,
+  so it cannot simply copy checksums computed in advance. What it can do
+  is to checksum the common header of each event after rewriting it and
+  combine that with the checksum of the rest of the event, which is
+  position independent and is computed here. This moves almost all of
+  the checksumming out of the critical section protected by LOCK_log.
+
+  Checksums are only computed for caches that are entirely in memory, and
+  only for events that are long enough for my_checksum_combine() to be
+  cheaper than checksumming the event again.
+*/
+#define BINLOG_CHECKSUM_COMBINE_MIN_LEN 256
+
+struct Binlog_event_checksums
+{
+  /**
+    Checksum of every event after its common header, in cache order, or
+    0 for events shorter than BINLOG_CHECKSUM_COMBINE_MIN_LEN.
+  */
+  std::vector<ha_checksum> body_crcs;
+  /** Number of bytes of the cache covered by body_crcs */
+  my_off_t length;
+  /**
+    Events that start before this position were rewritten in place after
+    the checksums were computed, and must be checksummed again.
+  */
+  my_off_t rewritten;
+
+  Binlog_event_checksums() : length(0), rewritten(0) {}
+
+  void clear()
+  {
+    body_crcs.clear();
+    length= rewritten= 0;
+  }
+
+  void compute(const IO_CACHE *cache);
+};
+
+
+void Binlog_event_checksums::compute(const IO_CACHE *cache)
+{
+  DBUG_ENTER("Binlog_event_checksums::compute");
+  clear();
+  if (binlog_checksum_options == BINLOG_CHECKSUM_ALG_OFF ||
+      cache->type != WRITE_CACHE || cache->pos_in_file != 0)
+    DBUG_VOID_RETURN;
+
+  const uchar *buf= cache->write_buffer;
+  const my_off_t cache_length= my_b_tell(cache);
+  my_off_t pos= 0;
+  while (pos + LOG_EVENT_HEADER_LEN <= cache_length)
+  {
+    const uchar *ev= buf + pos;
+    const uint event_len= uint4korr(ev + EVENT_LEN_OFFSET);
+    if (event_len < LOG_EVENT_HEADER_LEN || pos + event_len > cache_length)
+    {
+      DBUG_ASSERT(0);
+      clear();
+      DBUG_VOID_RETURN;
+    }
+    const uint body_len= event_len - LOG_EVENT_HEADER_LEN;
+    body_crcs.push_back(body_len < BINLOG_CHECKSUM_COMBINE_MIN_LEN ? 0 :
+                        my_checksum(0L, ev + LOG_EVENT_HEADER_LEN, body_len));
+    pos+= event_len;
+  }
+  length= pos;
+  DBUG_VOID_RETURN;
+}
+
+
 /**
   Caches for non-transactional and transactional data before writing
   it to the binary log.
@@ -498,6 +589,7 @@ public:
     */
     cache_log.disk_writes= 0;
     group_cache.clear();
+    checksums.clear();
     DBUG_ASSERT(is_binlog_empty());
   }
 
@@ -551,6 +643,11 @@ public:
   */
   Group_cache group_cache;
 
+  /**
+    Checksums of the events in this cache, computed when it is finalized.
+  */
+  Binlog_event_checksums checksums;
+
 protected:
   /*
     It truncates the cache to a certain position. This includes deleting the
@@ -1018,6 +1115,16 @@ static int binlog_init(void *p)
                          histogram_step_size_binlog_fsync);
   counter_histogram_init(&histogram_binlog_group_commit,
                          opt_histogram_step_size_binlog_group_commit);
+  latency_histogram_init(&histogram_binlog_flush_stage_wait,
+                         histogram_step_size_binlog_commit_stages);
+  latency_histogram_init(&histogram_binlog_flush_stage,
+                         histogram_step_size_binlog_commit_stages);
+  latency_histogram_init(&histogram_binlog_sync_delay,
+                         histogram_step_size_binlog_commit_stages);
+  latency_histogram_init(&histogram_binlog_commit_stage_wait,
+                         histogram_step_size_binlog_commit_stages);
+  latency_histogram_init(&histogram_binlog_commit_stage,
+                         histogram_step_size_binlog_commit_stages);
   return 0;
 }
 
@@ -1363,6 +1470,7 @@ gtid_before_write_cache(THD* thd, binlog_cache_data* cache_data)
       /* Update commit time HLC timestamp for this trx */
       hlc_before_write_cache(thd, cache_data);
 
+      cache_data->checksums.rewritten= cache_data->get_byte_position();
       cache_data->reset_write_pos(saved_position, using_file);
     }
 
@@ -1457,6 +1565,11 @@ binlog_cache_data::finalize(THD *thd, Log_event *end_event)
     if (int error= write_event(thd, end_event))
       DBUG_RETURN(error);
     flags.finalized= true;
+    /*
+      Checksum the events now, while no lock is held, so that the flush
+      stage leader only needs to checksum the event headers.
+    */
+    checksums.compute(&cache_log);
     DBUG_PRINT("debug", ("flags.finalized: %s", YESNO(flags.finalized)));
   }
   DBUG_RETURN(0);
@@ -1747,6 +1860,7 @@ Stage_manager::Mutex_queue::append(THD *first)
         first->prepared_engine->get_maps());
 
   bool empty= (m_first == NULL);
+  int32 count= 1;
   *m_last= first;
   DBUG_PRINT("info", ("m_first: 0x%llx, &m_first: 0x%llx, m_last: 0x%llx",
                        (ulonglong) m_first, (ulonglong) &m_first,
@@ -1757,8 +1871,12 @@ Stage_manager::Mutex_queue::append(THD *first)
     the queue as well.
   */
   while (first->next_to_commit)
+  {
     first= first->next_to_commit;
+    ++count;
+  }
   m_last= &first->next_to_commit;
+  my_atomic_add32(&m_size, count);
   DBUG_PRINT("info", ("m_first: 0x%llx, &m_first: 0x%llx, m_last: 0x%llx",
                         (ulonglong) m_first, (ulonglong) &m_first,
                         (ulonglong) m_last));
@@ -1860,6 +1978,7 @@ THD *Stage_manager::Mutex_queue::fetch_and_empty()
   THD *result= m_first;
   m_first= NULL;
   m_last= &m_first;
+  my_atomic_store32(&m_size, 0);
   DBUG_PRINT("info", ("m_first: 0x%llx, &m_first: 0x%llx, m_last: 0x%llx",
                        (ulonglong) m_first, (ulonglong) &m_first,
                        (ulonglong) m_last));
@@ -1878,6 +1997,26 @@ THD *Stage_manager::Mutex_queue::fetch_and_empty()
   DBUG_RETURN(result);
 }
 
+ulonglong
+Stage_manager::wait_count_or_timeout(ulong count, ulong usec, StageID stage)
+{
+  ulonglong start_time= my_timer_now();
+  ulong to_wait= usec;
+  /*
+    For small timeouts poll faster, but not faster than every microsecond.
+    For larger timeouts poll slower to avoid wasting CPU.
+  */
+  const ulong delta= max(1UL, usec / 10);
+
+  while (to_wait > 0 &&
+         (count == 0 || (ulong) m_queue[stage].get_size() < count))
+  {
+    my_sleep(delta);
+    to_wait-= min(delta, to_wait);
+  }
+  return my_timer_since(start_time);
+}
+
 #ifndef DBUG_OFF
 void Stage_manager::clear_preempt_status(THD *head)
 {
@@ -2566,7 +2705,8 @@ int check_binlog_magic(IO_CACHE* log, const char** errmsg)
 }
 
 
-File open_binlog_file(IO_CACHE *log, const char *log_file_name, const char **errmsg)
+File open_binlog_file(IO_CACHE *log, const char *log_file_name,
+                      const char **errmsg, bool read_ahead)
 {
   File file;
   DBUG_ENTER("open_binlog_file");
@@ -2590,6 +2730,9 @@ File open_binlog_file(IO_CACHE *log, const char *log_file_name, const char **err
   }
   if (check_binlog_magic(log,errmsg))
     goto err;
+  /* Without read-ahead the log is just read synchronously */
+  if (read_ahead)
+    (void) init_io_cache_read_ahead(log);
   DBUG_RETURN(file);
 
 err:
@@ -7296,8 +7439,13 @@ bool MYSQL_BIN_LOG::append_buffer(const char* buf, uint len, Master_info *mi)
 
   // write data
   bool error= false;
+  my_off_t pos= my_b_append_tell(&log_file);
   if (my_b_append(&log_file,(uchar*) buf,len) == 0)
   {
+    /* Hand a copy of the event to the SQL thread, see next_event() */
+    if (opt_slave_relay_log_ring_size || relay_log_ring.get_bytes())
+      relay_log_ring.add(open_count, pos, buf, len,
+                         opt_slave_relay_log_ring_size);
     bytes_written += len;
     relay_log_bytes_written += len;
     if (us)
@@ -8050,13 +8198,65 @@ void MYSQL_BIN_LOG::unlock_commits(const snapshot_info_st *ss_info)
   return ret;
 }
 
+/**
+  Write the events of a cache that is entirely in memory to the binary
+  log, fixing the length and the end_log_pos of each event and appending
+  its checksum.
+
+  @param log_file   The binary log
+  @param buf        The contents of the cache
+  @param length     Number of bytes in the cache
+  @param group      Position of the cache in the binary log
+  @param checksums  Checksums computed when the cache was finalized
+
+  @return 0 on success, ER_ERROR_ON_WRITE if writing failed
+*/
+static int write_checksummed_events(IO_CACHE *log_file, uchar *buf,
+                                    my_off_t length, my_off_t group,
+                                    const Binlog_event_checksums *checksums)
+{
+  uchar crc_buf[BINLOG_CHECKSUM_LEN];
+  ulong end_log_pos_inc= 0;
+  size_t index= 0;
+
+  for (my_off_t pos= 0; pos < length; index++)
+  {
+    uchar *ev= buf + pos;
+    DBUG_ASSERT(pos + LOG_EVENT_HEADER_LEN <= length);
+    uint event_len= uint4korr(ev + EVENT_LEN_OFFSET);
+    uint body_len= event_len - LOG_EVENT_HEADER_LEN;
+    DBUG_ASSERT(pos + event_len <= length);
+
+    /* fix end_log_pos and length */
+    end_log_pos_inc+= BINLOG_CHECKSUM_LEN;
+    int4store(ev + LOG_POS_OFFSET,
+              uint4korr(ev + LOG_POS_OFFSET) + group + end_log_pos_inc);
+    int4store(ev + EVENT_LEN_OFFSET, event_len + BINLOG_CHECKSUM_LEN);
+
+    ha_checksum crc= my_checksum(0L, ev, LOG_EVENT_HEADER_LEN);
+    if (body_len >= BINLOG_CHECKSUM_COMBINE_MIN_LEN &&
+        pos >= checksums->rewritten && pos < checksums->length &&
+        index < checksums->body_crcs.size())
+      crc= my_checksum_combine(crc, checksums->body_crcs[index], body_len);
+    else
+      crc= my_checksum(crc, ev + LOG_EVENT_HEADER_LEN, body_len);
+    int4store(crc_buf, crc);
+
+    if (my_b_write(log_file, ev, event_len) ||
+        my_b_write(log_file, crc_buf, BINLOG_CHECKSUM_LEN))
+      return ER_ERROR_ON_WRITE;
+    pos+= event_len;
+  }
+  return 0;
+}
+
 /*
   Write the contents of a cache to the binary log.
 
   SYNOPSIS
     do_write_cache()
-    cache    Cache to write to the binary log
-    lock_log True if the LOCK_log mutex should be aquired, false otherwise
+    cache     Cache to write to the binary log
+    checksums Checksums of the events in the cache, or NULL
 
   DESCRIPTION
     Write the contents of the cache to the binary log. The cache will
@@ -8065,9 +8265,13 @@ void MYSQL_BIN_LOG::unlock_commits(const snapshot_info_st *ss_info)
     Reading from the trans cache with possible (per @c binlog_checksum_options)
     adding checksum value  and then fixing the length and the end_log_pos of
     events prior to fill in the binlog cache.
+
+    If the cache is entirely in memory and its events were checksummed when
+    it was finalized, only the event headers are checksummed here.
 */
 
-int MYSQL_BIN_LOG::do_write_cache(IO_CACHE *cache)
+int MYSQL_BIN_LOG::do_write_cache(IO_CACHE *cache,
+                                  const Binlog_event_checksums *checksums)
 {
   DBUG_ENTER("MYSQL_BIN_LOG::do_write_cache(IO_CACHE *)");
 
@@ -8110,6 +8314,17 @@ int MYSQL_BIN_LOG::do_write_cache(IO_CACHE *cache)
   DBUG_PRINT("debug", ("length: %llu, group: %llu",
                        (ulonglong) length, (ulonglong) group));
   hdr_offs= carry= 0;
+
+  if (do_checksum && checksums != NULL && checksums->length > 0 &&
+      cache->pos_in_file == 0 && length == cache->end_of_file &&
+      !DBUG_EVALUATE_IF("fault_injection_crc_value", 1, 0))
+  {
+    int error= write_checksummed_events(&log_file, cache->read_pos, length,
+                                        group, checksums);
+    cache->read_pos= cache->read_end;
+    DBUG_RETURN(error);
+  }
+
   if (do_checksum)
     crc= crc_0= my_checksum(0L, NULL, 0);
 
@@ -8562,7 +8777,7 @@ bool MYSQL_BIN_LOG::write_cache(THD *thd, binlog_cache_data *cache_data,
             goto err;
           });
 
-      if ((write_error= do_write_cache(cache)))
+      if ((write_error= do_write_cache(cache, &cache_data->checksums)))
         goto err;
       if (us)
       {
@@ -9433,6 +9648,7 @@ MYSQL_BIN_LOG::process_flush_stage_queue(my_off_t *total_bytes_var,
   DBUG_ASSERT(thd_count > 0);
   DBUG_PRINT("info", ("Number of threads in group commit %llu", thd_count));
   counter_histogram_increment(&histogram_binlog_group_commit, thd_count);
+  group_commit_delay.add_group(my_timer_now(), thd_count);
 
   *out_queue_var= first_seen;
   *total_bytes_var= total_bytes;
@@ -9809,15 +10025,107 @@ MYSQL_BIN_LOG::change_stage(THD *thd,
     the thread is the leader. After which, regardless of being the leader, it
     will release the leave_mutex.
   */
+  ulonglong start_time= my_timer_now();
   if (!stage_manager.enroll_for(stage, queue, leave_mutex, enter_mutex))
   {
     DBUG_ASSERT(!thd_get_cache_mngr(thd)->dbug_any_finalized());
     DBUG_RETURN(true);
   }
+  /* Time the leader waited for the stage mutex */
+  if (histogram_step_size_binlog_commit_stages)
+  {
+    if (stage == Stage_manager::FLUSH_STAGE)
+      latency_histogram_increment(&histogram_binlog_flush_stage_wait,
+                                  my_timer_since(start_time), 1);
+    else if (stage == Stage_manager::COMMIT_STAGE)
+      latency_histogram_increment(&histogram_binlog_commit_stage_wait,
+                                  my_timer_since(start_time), 1);
+  }
   DBUG_RETURN(false);
 }
 
 
+void Group_commit_delay::add_group(ulonglong now, ulonglong count)
+{
+  DBUG_ASSERT(count > 0);
+  if (m_last_group != 0 && now > m_last_group)
+  {
+    /*
+      Limit the samples to one second so that an idle period does not
+      keep the average high for many groups afterwards.
+    */
+    ulonglong interval= min((now - m_last_group) / count,
+                            microseconds_to_my_timer(1000000));
+    /* Exponential moving average with a weight of 1/8 for new samples */
+    m_arrival_interval= m_arrival_interval == 0 ? interval
+      : m_arrival_interval - m_arrival_interval / 8 + interval / 8;
+  }
+  m_last_group= now;
+}
+
+
+void Group_commit_delay::add_fsync(ulonglong fsync_time)
+{
+  m_fsync_time= m_fsync_time == 0 ? fsync_time
+    : m_fsync_time - m_fsync_time / 8 + fsync_time / 8;
+}
+
+
+ulonglong
+Group_commit_delay::get_delay(ulong target_count, ulonglong max_delay) const
+{
+  if (m_arrival_interval == 0 || m_arrival_interval >= m_fsync_time)
+    return 0;
+  ulonglong delay= m_fsync_time;
+  if (target_count > 0)
+    delay= min(delay, (target_count - 1) * m_arrival_interval);
+  return min(delay, max_delay);
+}
+
+
+/**
+  Wait for more sessions to join the flush queue before the flush stage
+  leader fetches it, so that they share the binlog write and fsync of
+  this group.
+
+  With binlog_group_commit_adaptive_delay the delay is chosen by
+  Group_commit_delay and binlog_group_commit_sync_delay is its upper
+  bound. The adaptive delay is only used when every group is synced,
+  since otherwise there is no fsync to share. Without it the leader
+  waits binlog_group_commit_sync_delay microseconds. In both cases the
+  wait ends early when binlog_group_commit_sync_no_delay_count sessions
+  are queued.
+
+  @param async  Whether the group is committed without syncing the
+                binary log.
+*/
+void MYSQL_BIN_LOG::delay_flush_stage(bool async)
+{
+  mysql_mutex_assert_owner(&LOCK_log);
+  ulong max_delay= opt_binlog_group_commit_sync_delay;
+  ulong target_count= opt_binlog_group_commit_sync_no_delay_count;
+  ulong delay= max_delay;
+
+  if (opt_binlog_group_commit_adaptive_delay)
+  {
+    delay= 0;
+    if (!async && get_sync_period() == 1)
+      delay= (ulong) my_timer_to_microseconds_ulonglong(
+        group_commit_delay.get_delay(target_count,
+                                     microseconds_to_my_timer(max_delay)));
+  }
+  binlog_group_commit_last_delay= delay;
+
+  if (delay == 0)
+    return;
+
+  ulonglong delay_time= stage_manager.wait_count_or_timeout(
+    target_count, delay, Stage_manager::FLUSH_STAGE);
+  if (histogram_step_size_binlog_commit_stages)
+    latency_histogram_increment(&histogram_binlog_sync_delay, delay_time, 1);
+}
+
+
 
 /**
   Flush the I/O cache to file.
@@ -9874,6 +10182,7 @@ MYSQL_BIN_LOG::sync_binlog_file(bool force, bool async)
                          mysql_file_sync(log_file.file,
                                          MYF(MY_WME | MY_IGNORE_BADFD)));
     binlog_fsync_time = my_timer_since(start_time);
+    group_commit_delay.add_fsync(binlog_fsync_time);
     if (histogram_step_size_binlog_fsync)
       latency_histogram_increment(&histogram_binlog_fsync,
                                   binlog_fsync_time, 1);
@@ -10331,6 +10640,7 @@ int MYSQL_BIN_LOG::ordered_commit(THD *thd, bool all, bool skip_commit,
   my_off_t total_bytes= 0;
   bool do_rotate= false;
   THD *semisync_queue= nullptr;
+  ulonglong start_time;
 
   /*
     These values are used while flushing a transaction, so clear
@@ -10424,6 +10734,9 @@ int MYSQL_BIN_LOG::ordered_commit(THD *thd, bool all, bool skip_commit,
     goto commit_stage;
   }
   DEBUG_SYNC(thd, "waiting_in_the_middle_of_flush_stage");
+  delay_flush_stage(async);
+
+  start_time= my_timer_now();
   flush_stage_error= process_flush_stage_queue(&total_bytes, &do_rotate,
                                          &final_queue, async);
 
@@ -10435,6 +10748,10 @@ int MYSQL_BIN_LOG::ordered_commit(THD *thd, bool all, bool skip_commit,
   if (total_bytes > 0)
     flush_error= flush_cache_to_file(&flush_end_pos);
 
+  if (histogram_step_size_binlog_commit_stages)
+    latency_histogram_increment(&histogram_binlog_flush_stage,
+                                my_timer_since(start_time), 1);
+
   DBUG_EXECUTE_IF("crash_after_flush_binlog", DBUG_SUICIDE(););
   /*
     If the flush finished successfully, we can call the after_flush
@@ -10512,7 +10829,6 @@ commit_stage:
   // The delay is very long to allow large write batches in stress tests.
   DBUG_EXECUTE_IF("emulate_async_delay", usleep(500000););
 
-  ulonglong start_time;
   start_time = my_timer_now();
   process_semisync_stage_queue(semisync_queue);
   thd->semisync_ack_time = my_timer_since(start_time);
@@ -10547,6 +10863,9 @@ commit_stage:
     start_time = my_timer_now();
     process_commit_stage_queue(thd, commit_queue, async);
     thd->engine_commit_time = my_timer_since(start_time);
+    if (histogram_step_size_binlog_commit_stages)
+      latency_histogram_increment(&histogram_binlog_commit_stage,
+                                  thd->engine_commit_time, 1);
     mysql_mutex_unlock(&LOCK_commit);
     /*
       Process after_commit after LOCK_commit is released for avoiding
@@ -20,21 +20,34 @@
 #include "log_event.h"
 #include "log.h"
 #include "rpl_gtid.h"
+#include "rpl_relay_log_ring.h"
 #include <atomic>
 #include <list>
 #include <unordered_map>
 
 extern ulong rpl_read_size;
+extern my_bool rpl_read_ahead;
 extern char *histogram_step_size_binlog_fsync;
 extern int opt_histogram_step_size_binlog_group_commit;
 extern latency_histogram histogram_binlog_fsync;
 extern counter_histogram histogram_binlog_group_commit;
+extern char *histogram_step_size_binlog_commit_stages;
+extern latency_histogram histogram_binlog_flush_stage_wait;
+extern latency_histogram histogram_binlog_flush_stage;
+extern latency_histogram histogram_binlog_sync_delay;
+extern latency_histogram histogram_binlog_commit_stage_wait;
+extern latency_histogram histogram_binlog_commit_stage;
+extern ulong opt_binlog_group_commit_sync_delay;
+extern ulong opt_binlog_group_commit_sync_no_delay_count;
+extern my_bool opt_binlog_group_commit_adaptive_delay;
+extern ulong binlog_group_commit_last_delay;
 extern Slow_log_throttle log_throttle_sbr_unsafe_query;
 class Relay_log_info;
 class Master_info;
 
 class Format_description_log_event;
 struct RaftRotateInfo;
+struct Binlog_event_checksums;
 
 /* The enum defining the server's action when a trx fails inside ordered commit
  * due to an error related to consensus (raft plugin) */
@@ -68,7 +81,8 @@ public:
     friend class Stage_manager;
   public:
     Mutex_queue()
-      : m_first(NULL), m_last(&m_first), group_prepared_engine(NULL)
+      : m_first(NULL), m_last(&m_first), m_size(0),
+        group_prepared_engine(NULL)
     {
     }
 
@@ -92,6 +106,11 @@ public:
       return m_first == NULL;
     }
 
+    /** Number of sessions in the queue, read without the queue lock */
+    int32 get_size() {
+      return my_atomic_load32(&m_size);
+    }
+
     /** Append a linked list of threads to the queue */
     bool append(THD *first);
 
@@ -120,6 +139,9 @@ public:
     */
     THD **m_last;
 
+    /** Number of sessions in the queue */
+    int32 m_size;
+
     /**
        Store the max prepared log for each engine that supports ha_flush_logs.
        We have to init group_prepared_engine after all plugins are inited.
@@ -246,6 +268,19 @@ public:
     return m_queue[stage].fetch_and_empty();
   }
 
+  /**
+    Wait until the queue of a stage holds at least @c count sessions or
+    @c usec microseconds have passed, whichever comes first.
+
+    @param count  Number of sessions to wait for, 0 to wait for the
+                  whole timeout.
+    @param usec   Timeout in microseconds.
+    @param stage  Stage identifier for the queue to watch.
+
+    @return Time spent waiting, in timer units.
+  */
+  ulonglong wait_count_or_timeout(ulong count, ulong usec, StageID stage);
+
   void signal_done(THD *queue) {
     mysql_mutex_lock(&m_lock_done);
     for (THD *thd= queue ; thd ; thd = thd->next_to_commit)
@@ -439,6 +474,55 @@ class HybridLogicalClock {
   mutable std::mutex database_map_lock_;
 };
 
+/**
+  Chooses how long the flush stage leader waits for more sessions to join
+  the group before the group is written and synced.
+
+  The controller keeps moving averages of the interval between two
+  sessions arriving at the flush stage and of the binlog fsync time. The
+  delay is the fsync time, which is how long a session arriving now would
+  wait for the next group anyway, or the time the sessions missing from a
+  target group size need to arrive if that is shorter. No delay is used
+  when less than one session is expected to arrive within the fsync time,
+  and the delay never exceeds the given maximum.
+
+  Protected by LOCK_log.
+*/
+class Group_commit_delay {
+public:
+  Group_commit_delay()
+    : m_last_group(0), m_arrival_interval(0), m_fsync_time(0)
+  {
+  }
+
+  /**
+    Account for a group of sessions fetched from the flush queue.
+
+    @param now    Time the queue was fetched, in timer units.
+    @param count  Number of sessions in the group.
+  */
+  void add_group(ulonglong now, ulonglong count);
+
+  /** Account for one fsync of the binary log, in timer units. */
+  void add_fsync(ulonglong fsync_time);
+
+  /**
+    Delay for the next group, in timer units.
+
+    @param target_count  Group size to aim for, 0 if none.
+    @param max_delay     Upper bound of the delay, in timer units.
+  */
+  ulonglong get_delay(ulong target_count, ulonglong max_delay) const;
+
+private:
+  /** Time the flush queue was fetched the last time */
+  ulonglong m_last_group;
+  /** Moving average of the time between two arriving sessions */
+  ulonglong m_arrival_interval;
+  /** Moving average of the binlog fsync time */
+  ulonglong m_fsync_time;
+};
+
 class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
 {
 public:
@@ -611,6 +695,9 @@ public:
 
   /** Manage the stages in ordered_commit. */
   Stage_manager stage_manager;
+  /** Choose the delay of the flush stage in ordered_commit. */
+  Group_commit_delay group_commit_delay;
+  void delay_flush_stage(bool async);
   void do_flush(THD *thd);
 
   uint32_t non_xid_trxs;
@@ -1039,7 +1126,8 @@ public:
                    bool write_meta_data_event= false);
   bool write_cache(THD *thd, class binlog_cache_data *binlog_cache_data,
                    bool async);
-  int  do_write_cache(IO_CACHE *cache);
+  int  do_write_cache(IO_CACHE *cache,
+                      const Binlog_event_checksums *checksums= NULL);
 
   /**
    * Called after a THD's iocache is written to binlog (i.e binlog's cache)
@@ -1198,6 +1286,8 @@ public:
   inline char* get_log_fname() { return log_file_name; }
   inline char* get_name() { return name; }
   inline mysql_mutex_t* get_log_lock() { return &LOCK_log; }
+  /** Events recently appended to the relay log, protected by LOCK_log. */
+  Relay_log_ring relay_log_ring;
   inline mysql_cond_t* get_log_cond() { return &update_cond; }
   inline IO_CACHE* get_log_file() { return &log_file; }
 
@@ -1272,9 +1362,12 @@ int log_loaded_block(IO_CACHE* file);
 
 /**
   Open a single binary log file for reading.
+
+  @param read_ahead  read the file ahead in the background, see
+                     init_io_cache_read_ahead()
 */
 File open_binlog_file(IO_CACHE *log, const char *log_file_name,
-                      const char **errmsg);
+                      const char **errmsg, bool read_ahead= false);
 int check_binlog_magic(IO_CACHE* log, const char** errmsg);
 bool purge_master_logs(THD* thd, const char* to_log);
 bool purge_master_logs_before_date(THD* thd, time_t purge_time);
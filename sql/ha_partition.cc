@@ -2249,7 +2249,19 @@ void ha_partition::update_create_info(HA_CREATE_INFO *create_info)
   since they can be changed by ALTER TABLE ... REORGANIZE PARTITIONS.
   */
   if (from_alter)
+  {
+    /*
+      The partitions that ALTER TABLE rebuilds keep the page compression
+      of the first one.
+    */
+    if (m_file && m_file_tot_parts && m_file[0])
+    {
+      HA_CREATE_INFO part_info;
+      m_file[0]->update_create_info(&part_info);
+      create_info->page_compression= part_info.page_compression;
+    }
     DBUG_VOID_RETURN;
+  }
 
   /*
     send Handler::update_create_info() to the storage engine for each
@@ -7870,6 +7882,28 @@ ha_rows ha_partition::records()
 }
 
 
+/**
+  Check if records() gives the exact number of rows. see handler.h
+
+  @return true if all used partitions can count their rows
+*/
+
+bool ha_partition::can_count_records()
+{
+  uint i;
+  DBUG_ENTER("ha_partition::can_count_records");
+
+  for (i= bitmap_get_first_set(&m_part_info->read_partitions);
+       i < m_tot_parts;
+       i= bitmap_get_next_set(&m_part_info->read_partitions, i))
+  {
+    if (!m_file[i]->can_count_records())
+      DBUG_RETURN(false);
+  }
+  DBUG_RETURN(true);
+}
+
+
 /*
   Is it ok to switch to a new engine for this table
 
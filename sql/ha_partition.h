@@ -739,6 +739,7 @@ public:
   */
   virtual uint8 table_cache_type();
   virtual ha_rows records();
+  virtual bool can_count_records();
 
   /* Calculate hash value for PARTITION BY KEY tables. */
   uint32 calculate_key_hash_value(Field **field_array);
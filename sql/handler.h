@@ -1192,6 +1192,9 @@ struct st_ha_create_information_base
   enum ha_storage_media storage_media;  /* DEFAULT, DISK or MEMORY */
   bool rbr_column_names; /* If true, column names for this table are logged
                             in Table_map_log_events */
+  uint page_compression; /* Engine specific page compression algorithm of
+                            the table ALTER TABLE rebuilds, plus one. Set by
+                            handler::update_create_info(), 0 if unknown. */
 };
 
 
@@ -2440,6 +2443,12 @@ public:
     (table_flags() & (HA_HAS_RECORDS | HA_STATS_RECORDS_IS_EXACT)) != 0
   */
   virtual ha_rows records() { return stats.records; }
+  /**
+    Check if records() would give the exact number of rows for the
+    current statement, without counting them. EXPLAIN uses this to show
+    the plan that is executed without doing the count.
+  */
+  virtual bool can_count_records() { return true; }
   /**
     Return upper bound of current number of records in the table
     (max. of how many records one will retrieve when doing a full table scan)
@@ -3601,6 +3610,15 @@ public:
              false if old rows should be read (the default)
    */
   virtual bool use_read_free_rpl() const { return false; }
+  /**
+     Determine whether the storage engine can maintain all secondary keys of
+     the table without the old row image, so that a blind 'replace into' can
+     be used even when the table has secondary keys.
+
+     @return true if secondary keys can be written without the old row
+             false otherwise (the default)
+   */
+  virtual bool has_read_free_secondary_keys() const { return false; }
   /**
      Whether the table or last access partition has TTL column
      Only used in replication error checking
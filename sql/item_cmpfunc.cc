@@ -4197,12 +4197,91 @@ static int cmp_decimal(void *cmp_arg, my_decimal *a, my_decimal *b)
 }
 
 
+/*
+  Mix the bits of a 64-bit value so that values differing in a few bits
+  only land in different buckets of the in_vector hash table.
+*/
+static inline ulong in_vector_hash_int(ulonglong val)
+{
+  val^= val >> 33;
+  val*= 0xff51afd7ed558ccdULL;
+  val^= val >> 33;
+  val*= 0xc4ceb9fe1a85ec53ULL;
+  val^= val >> 33;
+  return (ulong) val;
+}
+
+
+static inline ulong in_vector_hash_double(double nr)
+{
+  ulonglong bits;
+  if (nr == 0.0)
+    nr= 0.0;                                    // -0.0 == 0.0
+  memcpy(&bits, &nr, sizeof(bits));
+  return in_vector_hash_int(bits);
+}
+
+
+/*
+  Build a hash table over the sorted values so that find() does not need
+  a binary search.
+
+  SYNOPSIS
+    in_vector::build_hash()
+
+  DESCRIPTION
+    The values are kept sorted since the range optimizer reads them in
+    order. The table has at least twice as many slots as there are values,
+    so a probe finds an empty slot before long.
+
+  RETURN VALUE
+    TRUE        out of memory, find() keeps using the binary search
+    FALSE       ok
+*/
+bool in_vector::build_hash()
+{
+  DBUG_ASSERT(can_hash());
+  uint slots= 1;
+  while (slots < 2 * used_count)
+    slots<<= 1;
+
+  if (!(hash_table= (uint*) sql_calloc(slots * sizeof(uint))))
+    return TRUE;
+  hash_mask= slots - 1;
+
+  for (uint pos= 0; pos < used_count; pos++)
+  {
+    uint i= hash_value((uchar*) base + pos * size) & hash_mask;
+    while (hash_table[i])
+      i= (i + 1) & hash_mask;
+    hash_table[i]= pos + 1;
+  }
+  return FALSE;
+}
+
+
+int in_vector::find_hashed(const uchar *value)
+{
+  for (uint i= hash_value(value) & hash_mask; hash_table[i];
+       i= (i + 1) & hash_mask)
+  {
+    if ((*compare)(collation, base + (hash_table[i] - 1) * size,
+                   value) == 0)
+      return 1;
+  }
+  return 0;
+}
+
+
 int in_vector::find(Item *item)
 {
   uchar *result=get_value(item);
   if (!result || !used_count)
     return 0;				// Null value
 
+  if (hash_table)
+    return find_hashed(result);
+
   uint start,end;
   start=0; end=used_count-1;
   while (start != end)
@@ -4263,6 +4342,17 @@ uchar *in_string::get_value(Item *item)
   return (uchar*) item->val_str(&tmp);
 }
 
+
+ulong in_string::hash_value(const uchar *value)
+{
+  /* hash_sort() agrees with the strnncollsp() used by srtcmp_in() */
+  const String *str= (const String*) value;
+  ulong nr1= 1, nr2= 4;
+  collation->coll->hash_sort(collation, (const uchar*) str->ptr(),
+                             str->length(), &nr1, &nr2);
+  return nr1;
+}
+
 in_row::in_row(uint elements, Item * item)
 {
   base= (char*) new cmp_item_row[count= elements];
@@ -4320,6 +4410,16 @@ uchar *in_longlong::get_value(Item *item)
 }
 
 
+ulong in_longlong::hash_value(const uchar *value)
+{
+  /*
+    Values that cmp_longlong() finds equal have the same bits whatever
+    their signedness.
+  */
+  return in_vector_hash_int((ulonglong) ((packed_longlong*) value)->val);
+}
+
+
 void in_time_as_longlong::set(uint pos,Item *item)
 {
   struct packed_longlong *buff= &((packed_longlong*) base)[pos];
@@ -4397,6 +4497,12 @@ uchar *in_double::get_value(Item *item)
 }
 
 
+ulong in_double::hash_value(const uchar *value)
+{
+  return in_vector_hash_double(*(double*) value);
+}
+
+
 in_decimal::in_decimal(uint elements)
   :in_vector(elements, sizeof(my_decimal),(qsort2_cmp) cmp_decimal, 0)
 {}
@@ -4424,6 +4530,21 @@ uchar *in_decimal::get_value(Item *item)
 }
 
 
+ulong in_decimal::hash_value(const uchar *value)
+{
+  /*
+    Equal decimals may differ in their number of fraction digits, so hash
+    the value rather than the representation. Equal decimals convert to
+    the same double.
+  */
+  my_decimal *dec= (my_decimal*) value;
+  double nr;
+  dec->fix_buffer_pointer();
+  my_decimal2double(E_DEC_FATAL_ERROR, dec, &nr);
+  return in_vector_hash_double(nr);
+}
+
+
 cmp_item* cmp_item::get_comparator(Item_result type,
                                    const CHARSET_INFO *cs)
 {
@@ -4936,6 +5057,8 @@ void Item_func_in::fix_length_and_dec()
       }
       if ((array->used_count= j))
 	array->sort();
+      if (array->used_count >= IN_VECTOR_HASH_THRESHOLD && array->can_hash())
+        array->build_hash();
     }
   }
   else
@@ -908,10 +908,23 @@ public:
 /* Functions to handle the optimized IN */
 
 
+/*
+  Lists with at least this many values are probed through a hash table
+  instead of with a binary search, see in_vector::build_hash().
+*/
+#define IN_VECTOR_HASH_THRESHOLD 32
+
 /* A vector of values of some type  */
 
 class in_vector :public Sql_alloc
 {
+  /*
+    Open addressing hash table over the sorted values. Each slot holds the
+    position of a value plus one, 0 marks an empty slot.
+  */
+  uint *hash_table;
+  uint hash_mask;
+  int find_hashed(const uchar *value);
 public:
   char *base;
   uint size;
@@ -919,10 +932,11 @@ public:
   const CHARSET_INFO *collation;
   uint count;
   uint used_count;
-  in_vector() {}
+  in_vector() :hash_table(NULL), hash_mask(0) {}
   in_vector(uint elements,uint element_length,qsort2_cmp cmp_func, 
   	    const CHARSET_INFO *cmp_coll)
-    :base((char*) sql_calloc(elements*element_length)),
+    :hash_table(NULL), hash_mask(0),
+     base((char*) sql_calloc(elements*element_length)),
      size(element_length), compare(cmp_func), collation(cmp_coll),
      count(elements), used_count(elements) {}
   virtual ~in_vector() {}
@@ -933,6 +947,14 @@ public:
     my_qsort2(base,used_count,size,compare,collation);
   }
   int find(Item *item);
+  bool build_hash();
+
+  /*
+    Whether hash_value() is implemented. Values that compare as equal
+    must have the same hash value.
+  */
+  virtual bool can_hash() const { return false; }
+  virtual ulong hash_value(const uchar *value) { return 0; }
   
   /* 
     Create an instance of Item_{type} (e.g. Item_decimal) constant object
@@ -971,6 +993,8 @@ public:
   ~in_string();
   void set(uint pos,Item *item);
   uchar *get_value(Item *item);
+  bool can_hash() const { return true; }
+  ulong hash_value(const uchar *value);
   Item* create_item()
   { 
     return new Item_string(collation);
@@ -1001,6 +1025,8 @@ public:
   in_longlong(uint elements);
   void set(uint pos,Item *item);
   uchar *get_value(Item *item);
+  bool can_hash() const { return true; }
+  ulong hash_value(const uchar *value);
   
   Item* create_item()
   { 
@@ -1085,6 +1111,8 @@ public:
   in_double(uint elements);
   void set(uint pos,Item *item);
   uchar *get_value(Item *item);
+  bool can_hash() const { return true; }
+  ulong hash_value(const uchar *value);
   Item *create_item()
   { 
     return new Item_float(0.0, 0);
@@ -1104,6 +1132,8 @@ public:
   in_decimal(uint elements);
   void set(uint pos, Item *item);
   uchar *get_value(Item *item);
+  bool can_hash() const { return true; }
+  ulong hash_value(const uchar *value);
   Item *create_item()
   { 
     return new Item_decimal(0, FALSE);
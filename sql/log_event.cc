@@ -14607,7 +14607,8 @@ Write_rows_log_event::write_row(const Relay_log_info *const rli,
     (1) master executed this as an optimized 'replace into' statement
         (as identified by BLIND_REPLACE_INTO_F)
     (2) The table has a well defined primary key (and no hidden pk)
-    (3) The table has no secondary keys
+    (3) The table has no secondary keys, or the storage engine can maintain
+        them without reading the old row
     (4) The table has no triggers defined
 
     If slave is not able to execute this as a blind 'replcae into', then
@@ -14624,7 +14625,8 @@ Write_rows_log_event::write_row(const Relay_log_info *const rli,
     */
     thd->lex->duplicates= DUP_REPLACE;
     thd->lex->blind_replace_into= enable_blind_replace && /* 0 */
-      table->s->keys == 1 /* 2, 3 */ &&
+      (table->s->keys == 1 /* 2, 3 */ ||
+       table->file->has_read_free_secondary_keys() /* 3 */) &&
       table->s->primary_key != MAX_INDEXES && /* 2 */
       !table->triggers /* 4 */;
   }
@@ -634,6 +634,9 @@ ulong relay_io_events= 0;
 /* Number of events executed from the relay log by the SQL thread */
 ulong relay_sql_events= 0;
 
+/* Number of events the SQL thread took from the relay log ring */
+ulong relay_sql_ring_events= 0;
+
 /* Number of bytes written to the relay log by the IO thread */
 ulonglong relay_io_bytes= 0;
 
@@ -654,6 +657,20 @@ ulonglong repl_semi_sync_master_ack_waits= 0;
 SHOW_VAR latency_histogram_binlog_fsync[NUMBER_OF_HISTOGRAM_BINS + 1];
 ulonglong histogram_binlog_fsync_values[NUMBER_OF_HISTOGRAM_BINS];
 
+/* status variables for binlog group commit stage histograms */
+SHOW_VAR
+  latency_histogram_binlog_flush_stage_wait[NUMBER_OF_HISTOGRAM_BINS + 1];
+ulonglong histogram_binlog_flush_stage_wait_values[NUMBER_OF_HISTOGRAM_BINS];
+SHOW_VAR latency_histogram_binlog_flush_stage[NUMBER_OF_HISTOGRAM_BINS + 1];
+ulonglong histogram_binlog_flush_stage_values[NUMBER_OF_HISTOGRAM_BINS];
+SHOW_VAR latency_histogram_binlog_sync_delay[NUMBER_OF_HISTOGRAM_BINS + 1];
+ulonglong histogram_binlog_sync_delay_values[NUMBER_OF_HISTOGRAM_BINS];
+SHOW_VAR
+  latency_histogram_binlog_commit_stage_wait[NUMBER_OF_HISTOGRAM_BINS + 1];
+ulonglong histogram_binlog_commit_stage_wait_values[NUMBER_OF_HISTOGRAM_BINS];
+SHOW_VAR latency_histogram_binlog_commit_stage[NUMBER_OF_HISTOGRAM_BINS + 1];
+ulonglong histogram_binlog_commit_stage_values[NUMBER_OF_HISTOGRAM_BINS];
+
 SHOW_VAR
   histogram_binlog_group_commit_var[NUMBER_OF_COUNTER_HISTOGRAM_BINS + 1];
 ulonglong
@@ -692,6 +709,7 @@ const char *binlog_checksum_default= "NONE";
 ulong binlog_checksum_options;
 my_bool opt_master_verify_checksum= 0;
 my_bool opt_slave_sql_verify_checksum= 1;
+ulonglong opt_slave_relay_log_ring_size= 0;
 ulong opt_slave_check_before_image_consistency= 0;
 const char *binlog_format_names[]= {"MIXED", "STATEMENT", "ROW", NullS};
 my_bool enforce_gtid_consistency;
@@ -2516,6 +2534,11 @@ void clean_up(bool print_message)
   memcached_shutdown();
 
   free_latency_histogram_sysvars(latency_histogram_binlog_fsync);
+  free_latency_histogram_sysvars(latency_histogram_binlog_flush_stage_wait);
+  free_latency_histogram_sysvars(latency_histogram_binlog_flush_stage);
+  free_latency_histogram_sysvars(latency_histogram_binlog_sync_delay);
+  free_latency_histogram_sysvars(latency_histogram_binlog_commit_stage_wait);
+  free_latency_histogram_sysvars(latency_histogram_binlog_commit_stage);
   free_counter_histogram_sysvars(histogram_binlog_group_commit_var);
 
   /*
@@ -3593,6 +3616,9 @@ bool one_thread_per_connection_end(THD *thd, bool block_pthread)
   block_pthread = thd->set_thread_priority(0);
   delete thd;
 
+  /* Don't keep the cached MEM_ROOT blocks while waiting for a connection */
+  mem_root_cache_end();
+
 #ifdef HAVE_PSI_THREAD_INTERFACE
   /*
     Delete the instrumentation for the job that just completed.
@@ -10520,6 +10546,67 @@ static int show_latency_histogram_binlog_fsync(THD *thd, SHOW_VAR *var,
   return 0;
 }
 
+static void show_latency_histogram(latency_histogram *histogram,
+                                   SHOW_VAR *histogram_var,
+                                   ulonglong *histogram_values,
+                                   SHOW_VAR *var)
+{
+  for (size_t i = 0; i < NUMBER_OF_HISTOGRAM_BINS; ++i)
+    histogram_values[i] = latency_histogram_get_count(histogram, i);
+
+  prepare_latency_histogram_vars(histogram, histogram_var, histogram_values);
+  var->type= SHOW_ARRAY;
+  var->value = (char*) histogram_var;
+}
+
+static int show_latency_histogram_binlog_flush_stage_wait(THD *thd,
+                                                          SHOW_VAR *var,
+                                                          char *buff)
+{
+  show_latency_histogram(&histogram_binlog_flush_stage_wait,
+                         latency_histogram_binlog_flush_stage_wait,
+                         histogram_binlog_flush_stage_wait_values, var);
+  return 0;
+}
+
+static int show_latency_histogram_binlog_flush_stage(THD *thd, SHOW_VAR *var,
+                                                     char *buff)
+{
+  show_latency_histogram(&histogram_binlog_flush_stage,
+                         latency_histogram_binlog_flush_stage,
+                         histogram_binlog_flush_stage_values, var);
+  return 0;
+}
+
+static int show_latency_histogram_binlog_sync_delay(THD *thd, SHOW_VAR *var,
+                                                    char *buff)
+{
+  show_latency_histogram(&histogram_binlog_sync_delay,
+                         latency_histogram_binlog_sync_delay,
+                         histogram_binlog_sync_delay_values, var);
+  return 0;
+}
+
+static int show_latency_histogram_binlog_commit_stage_wait(THD *thd,
+                                                           SHOW_VAR *var,
+                                                           char *buff)
+{
+  show_latency_histogram(&histogram_binlog_commit_stage_wait,
+                         latency_histogram_binlog_commit_stage_wait,
+                         histogram_binlog_commit_stage_wait_values, var);
+  return 0;
+}
+
+static int show_latency_histogram_binlog_commit_stage(THD *thd,
+                                                      SHOW_VAR *var,
+                                                      char *buff)
+{
+  show_latency_histogram(&histogram_binlog_commit_stage,
+                         latency_histogram_binlog_commit_stage,
+                         histogram_binlog_commit_stage_values, var);
+  return 0;
+}
+
 static int show_histogram_binlog_group_commit(THD *thd, SHOW_VAR* var,
                                               char *buff)
 {
@@ -11011,6 +11098,7 @@ SHOW_VAR status_vars[]= {
   {"Binlog_cache_disk_use",    (char*) &binlog_cache_disk_use,  SHOW_LONG},
   {"Binlog_cache_use",         (char*) &binlog_cache_use,       SHOW_LONG},
   {"Binlog_fsync_count",       (char*) &binlog_fsync_count, SHOW_LONGLONG},
+  {"Binlog_group_commit_sync_delay", (char*) &binlog_group_commit_last_delay, SHOW_LONG},
   {"Binlog_stmt_cache_disk_use",(char*) &binlog_stmt_cache_disk_use,  SHOW_LONG},
   {"Binlog_stmt_cache_use",    (char*) &binlog_stmt_cache_use,       SHOW_LONG},
   {"Bytes_received",           (char*) offsetof(STATUS_VAR, bytes_received), SHOW_LONGLONG_STATUS},
@@ -11116,14 +11204,27 @@ SHOW_VAR status_vars[]= {
   {"Key_writes",               (char*) offsetof(KEY_CACHE, global_cache_write), SHOW_KEY_CACHE_LONGLONG},
   {"Last_query_cost",          (char*) offsetof(STATUS_VAR, last_query_cost), SHOW_DOUBLE_STATUS},
   {"Last_query_partial_plans", (char*) offsetof(STATUS_VAR, last_query_partial_plans), SHOW_LONGLONG_STATUS},
+  {"Latency_histogram_binlog_commit_stage",
+   (char*) &show_latency_histogram_binlog_commit_stage, SHOW_FUNC},
+  {"Latency_histogram_binlog_commit_stage_wait",
+   (char*) &show_latency_histogram_binlog_commit_stage_wait, SHOW_FUNC},
+  {"Latency_histogram_binlog_flush_stage",
+   (char*) &show_latency_histogram_binlog_flush_stage, SHOW_FUNC},
+  {"Latency_histogram_binlog_flush_stage_wait",
+   (char*) &show_latency_histogram_binlog_flush_stage_wait, SHOW_FUNC},
   {"Latency_histogram_binlog_fsync",
    (char*) &show_latency_histogram_binlog_fsync, SHOW_FUNC},
+  {"Latency_histogram_binlog_sync_delay",
+   (char*) &show_latency_histogram_binlog_sync_delay, SHOW_FUNC},
   {"histogram_binlog_group_commit",
    (char*) &show_histogram_binlog_group_commit, SHOW_FUNC},
   {"Max_used_connections",     (char*) &max_used_connections,  SHOW_LONG},
   {"Max_statement_time_exceeded",   (char*) offsetof(STATUS_VAR, max_statement_time_exceeded), SHOW_LONG_STATUS},
   {"Max_statement_time_set",        (char*) offsetof(STATUS_VAR, max_statement_time_set), SHOW_LONG_STATUS},
   {"Max_statement_time_set_failed", (char*) offsetof(STATUS_VAR, max_statement_time_set_failed), SHOW_LONG_STATUS},
+  {"Mem_root_cache_bytes",     (char*) &my_mem_root_cache_bytes, SHOW_LONGLONG},
+  {"Mem_root_cache_hits",      (char*) offsetof(STATUS_VAR, mem_root_cache_hits), SHOW_LONGLONG_STATUS},
+  {"Mem_root_cache_misses",    (char*) offsetof(STATUS_VAR, mem_root_cache_misses), SHOW_LONGLONG_STATUS},
   {"Non_super_connections",    (char*) &nonsuper_connections,   SHOW_INT},
   {"Not_flushed_delayed_rows", (char*) &delayed_rows_in_use,    SHOW_LONG_NOFLUSH},
   {"Object_stats_misses",      (char*) &object_stats_misses,    SHOW_LONGLONG},
@@ -11138,6 +11239,8 @@ SHOW_VAR status_vars[]= {
   {"Parse_seconds",            (char*) offsetof(STATUS_VAR, parse_time), SHOW_TIMER_STATUS},
   {"Pre_exec_seconds",         (char*) offsetof(STATUS_VAR, pre_exec_time), SHOW_TIMER_STATUS},
   {"Prepared_stmt_count",      (char*) &show_prepared_stmt_count, SHOW_FUNC},
+  {"Prepared_stmt_plan_cache_hits", (char*) offsetof(STATUS_VAR, stmt_plan_cache_hits), SHOW_LONGLONG_STATUS},
+  {"Prepared_stmt_plan_cache_misses", (char*) offsetof(STATUS_VAR, stmt_plan_cache_misses), SHOW_LONGLONG_STATUS},
 #ifdef HAVE_QUERY_CACHE
   {"Qcache_free_blocks",       (char*) &query_cache.free_memory_blocks, SHOW_LONG_NOFLUSH},
   {"Qcache_free_memory",       (char*) &query_cache.free_memory, SHOW_LONG_NOFLUSH},
@@ -11159,6 +11262,7 @@ SHOW_VAR status_vars[]= {
   {"Relay_log_io_events",      (char*) &relay_io_events, SHOW_LONG},
   {"Relay_log_io_bytes",       (char*) &relay_io_bytes, SHOW_LONGLONG},
   {"Relay_log_sql_events",     (char*) &relay_sql_events, SHOW_LONG},
+  {"Relay_log_sql_ring_events", (char*) &relay_sql_ring_events, SHOW_LONG},
   {"Relay_log_sql_bytes",      (char*) &relay_sql_bytes, SHOW_LONGLONG},
   {"Relay_log_sql_wait_seconds", (char*) &relay_sql_wait_time, SHOW_TIMER},
   {"Rows_examined",            (char*) offsetof(STATUS_VAR, rows_examined), SHOW_LONG_STATUS},
@@ -436,7 +436,7 @@ extern ulong relay_io_connected;
 extern ulong opt_peak_lag_time;
 extern ulong opt_peak_lag_sample_rate;
 
-extern ulong relay_io_events, relay_sql_events;
+extern ulong relay_io_events, relay_sql_events, relay_sql_ring_events;
 extern ulonglong relay_io_bytes, relay_sql_bytes;
 extern ulonglong relay_sql_wait_time;
 extern double comp_event_cache_hit_ratio;
@@ -1006,6 +1006,7 @@ extern ulong binlog_checksum_options;
 extern const char *binlog_checksum_type_names[];
 extern my_bool opt_master_verify_checksum;
 extern my_bool opt_slave_sql_verify_checksum;
+extern ulonglong opt_slave_relay_log_ring_size;
 extern ulong opt_slave_check_before_image_consistency;
 extern my_bool enforce_gtid_consistency;
 extern my_bool binlog_gtid_simple_recovery;
@@ -89,6 +89,31 @@ static ulonglong get_exact_record_count(TABLE_LIST *tables)
 }
 
 
+/*
+  Check if the exact count of rows can be taken from all tables
+
+  SYNOPSIS
+    can_get_exact_record_count()
+    tables		List of tables
+
+  NOTES
+    Like get_exact_record_count(), but without counting the rows.
+
+  RETURN
+    true if get_exact_record_count() would not fail
+*/
+
+static bool can_get_exact_record_count(TABLE_LIST *tables)
+{
+  for (TABLE_LIST *tl= tables; tl; tl= tl->next_leaf)
+  {
+    if (!tl->table->file->can_count_records())
+      return false;
+  }
+  return true;
+}
+
+
 /**
   Use index to read MIN(field) value.
   
@@ -249,6 +274,13 @@ int opt_sum_query(THD *thd,
   DBUG_ENTER("opt_sum_query");
 
   const table_map where_tables= conds ? conds->used_tables() : 0;
+  /*
+    EXPLAIN does not evaluate the outermost select, nor anything that
+    uses its result, so it does not need the count of rows; it only
+    needs to know that the count would be taken.
+  */
+  const bool explain_only= thd->lex->describe &&
+                           !thd->lex->current_select->outer_select();
   /*
     opt_sum_query() happens at optimization. A subquery is optimized once but
     executed possibly multiple times.
@@ -334,7 +366,15 @@ int opt_sum_query(THD *thd,
         {
           if (!is_exact_count)
           {
-            if ((count= get_exact_record_count(tables)) == ULONGLONG_MAX)
+            if (explain_only)
+            {
+              if (!can_get_exact_record_count(tables))
+              {
+                const_result= 0;
+                continue;
+              }
+            }
+            else if ((count= get_exact_record_count(tables)) == ULONGLONG_MAX)
             {
               /* Error from handler in counting rows. Don't optimize count() */
               const_result= 0;
@@ -234,6 +234,8 @@ bool init_read_record(READ_RECORD *info,THD *thd, TABLE *table,
                         rr_unpack_from_tempfile : rr_from_tempfile);
     info->io_cache=tempfile;
     reinit_io_cache(info->io_cache,READ_CACHE,0L,0,0);
+    /* The sorted result is read front to back, read the next block ahead */
+    (void) init_io_cache_read_ahead(info->io_cache);
     info->ref_pos=table->file->ref;
     if (!table->file->inited &&
         (error= table->file->ha_rnd_init(0)))
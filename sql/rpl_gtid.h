@@ -853,7 +853,8 @@ struct Gtid
   Represents a set of GTIDs.
 
   This is structured as an array, indexed by SIDNO, where each element
-  contains a linked list of intervals.
+  contains a sorted array of intervals.  Lookups use binary search, and
+  operations on two sets merge the interval arrays in one pass.
 
   This data structure OPTIONALLY knows of a Sid_map that gives a
   correspondence between SIDNO and SID.  If the Sid_map is NULL, then
@@ -933,9 +934,7 @@ public:
   enum_return_status _add_gtid(rpl_sidno sidno, rpl_gno gno)
   {
     DBUG_ENTER("Gtid_set::_add_gtid(sidno, gno)");
-    Interval_iterator ivit(this, sidno);
-    Free_intervals_lock lock(this);
-    enum_return_status ret= add_gno_interval(&ivit, gno, gno + 1, &lock);
+    enum_return_status ret= add_gno_interval(sidno, gno, gno + 1);
     DBUG_RETURN(ret);
   }
   /**
@@ -950,9 +949,7 @@ public:
     DBUG_ENTER("Gtid_set::_remove_gtid(rpl_sidno, rpl_gno)");
     if (sidno <= get_max_sidno())
     {
-      Interval_iterator ivit(this, sidno);
-      Free_intervals_lock lock(this);
-      enum_return_status ret= remove_gno_interval(&ivit, gno, gno + 1, &lock);
+      enum_return_status ret= remove_gno_interval(sidno, gno, gno + 1);
       DBUG_RETURN(ret);
     }
     RETURN_OK;
@@ -1116,8 +1113,7 @@ public:
     DBUG_ASSERT(sidno >= 1);
     if (sidno > get_max_sidno())
       return false;
-    Const_interval_iterator ivit(this, sidno);
-    return ivit.get() != NULL;
+    return get_interval_array(sidno)->count > 0;
   }
   /**
     Returns true if the given string is a valid specification of a
@@ -1237,8 +1233,7 @@ public:
   Sid_map *get_sid_map() const { return sid_map; }
 
   /**
-    Represents one element in the linked list of intervals associated
-    with a SIDNO.
+    Represents one interval of GNOs of a SIDNO.
   */
   struct Interval
   {
@@ -1252,40 +1247,27 @@ public:
     {
       return start == other.start && end == other.end;
     }
-    /// Pointer to next interval in list.
-    Interval *next;
   };
 
   /**
-    Provides an array of Intervals that this Gtid_set can use when
-    groups are subsequently added.  This can be used as an
-    optimization, to reduce allocation for sets that have a known
-    number of intervals.
-
-    @param n_intervals The number of intervals to add.
-    @param intervals Array of n_intervals intervals.
+    The intervals of one SIDNO, stored contiguously and sorted by GNO.
+    Two intervals never intersect or touch: the end of an interval is
+    always smaller than the start of the next one.
   */
-  void add_interval_memory(int n_intervals, Interval *intervals_param)
+  struct Interval_array
   {
-    if (sid_lock != NULL)
-      mysql_mutex_lock(&free_intervals_mutex);
-    add_interval_memory_lock_taken(n_intervals, intervals_param);
-    if (sid_lock != NULL)
-      mysql_mutex_unlock(&free_intervals_mutex);
-  }
-
+    /// The intervals, or NULL if nothing has been allocated.
+    Interval *ivs;
+    /// The number of intervals in use.
+    int count;
+    /// The number of intervals allocated.
+    int capacity;
+  };
 
   /**
-    Iterator over intervals for a given SIDNO.
-
-    This is an abstract template class, used as a common base class
-    for Const_interval_iterator and Interval_iterator.
-
-    The iterator always points to an interval pointer.  The interval
-    pointer is either the initial pointer into the list, or the next
-    pointer of one of the intervals in the list.
+    Iterator over the intervals of a const Gtid_set for a given SIDNO.
   */
-  template<typename Gtid_set_p, typename Interval_p> class Interval_iterator_base
+  class Const_interval_iterator
   {
   public:
     /**
@@ -1294,87 +1276,37 @@ public:
       @param gtid_set The Gtid_set.
       @param sidno The SIDNO.
     */
-    Interval_iterator_base(Gtid_set_p gtid_set, rpl_sidno sidno)
+    Const_interval_iterator(const Gtid_set *gtid_set, rpl_sidno sidno)
     {
       DBUG_ASSERT(sidno >= 1 && sidno <= gtid_set->get_max_sidno());
       init(gtid_set, sidno);
     }
-    /// Construct a new iterator over the free intervals of a Gtid_set.
-    Interval_iterator_base(Gtid_set_p gtid_set)
-    { p= const_cast<Interval_p *>(&gtid_set->free_intervals); }
+    /// Construct an iterator that is not positioned on any interval.
+    Const_interval_iterator(const Gtid_set *gtid_set)
+      : array(NULL), index(0) {}
     /// Reset this iterator.
-    inline void init(Gtid_set_p gtid_set, rpl_sidno sidno)
-    { p= dynamic_element(&gtid_set->intervals, sidno - 1, Interval_p *); }
+    inline void init(const Gtid_set *gtid_set, rpl_sidno sidno)
+    {
+      array= gtid_set->get_interval_array(sidno);
+      index= 0;
+    }
     /// Advance current_elem one step.
     inline void next()
     {
-      DBUG_ASSERT(*p != NULL);
-      p= const_cast<Interval_p *>(&(*p)->next);
+      DBUG_ASSERT(get() != NULL);
+      index++;
     }
-    /// Return current_elem.
-    inline Interval_p get() const { return *p; }
-  protected:
-    /**
-      Holds the address of the 'next' pointer of the previous element,
-      or the address of the initial pointer into the list, if the
-      current element is the first element.
-    */
-    Interval_p *p;
-  };
-
-  /**
-    Iterator over intervals of a const Gtid_set.
-  */
-  class Const_interval_iterator
-    : public Interval_iterator_base<const Gtid_set *, const Interval *>
-  {
-  public:
-    /// Create this Const_interval_iterator.
-    Const_interval_iterator(const Gtid_set *gtid_set, rpl_sidno sidno)
-      : Interval_iterator_base<const Gtid_set *, const Interval *>(gtid_set, sidno) {}
-    /// Create this Const_interval_iterator.
-    Const_interval_iterator(const Gtid_set *gtid_set)
-      : Interval_iterator_base<const Gtid_set *, const Interval *>(gtid_set) {}
-  };
-
-  /**
-    Iterator over intervals of a non-const Gtid_set, with additional
-    methods to modify the Gtid_set.
-  */
-  class Interval_iterator
-    : public Interval_iterator_base<Gtid_set *, Interval *>
-  {
-  public:
-    /// Create this Interval_iterator.
-    Interval_iterator(Gtid_set *gtid_set, rpl_sidno sidno)
-      : Interval_iterator_base<Gtid_set *, Interval *>(gtid_set, sidno) {}
-    /// Destroy this Interval_iterator.
-    Interval_iterator(Gtid_set *gtid_set)
-      : Interval_iterator_base<Gtid_set *, Interval *>(gtid_set) {}
-  private:
-    /**
-      Set current_elem to the given Interval but do not touch the
-      next pointer of the given Interval.
-    */
-    inline void set(Interval *iv) { *p= iv; }
-    /// Insert the given element before current_elem.
-    inline void insert(Interval *iv) { iv->next= *p; set(iv); }
-    /// Remove current_elem.
-    inline void remove(Gtid_set *gtid_set)
+    /// Return current_elem, or NULL if past the last interval.
+    inline const Interval *get() const
     {
-      DBUG_ASSERT(get() != NULL);
-      Interval *next= (*p)->next;
-      gtid_set->put_free_interval(*p);
-      set(next);
+      return array != NULL && index < array->count ?
+        array->ivs + index : NULL;
     }
-    /**
-      Only Gtid_set is allowed to use set/insert/remove.
-
-      They are not safe to use from other code because: (1) very easy
-      to make a mistakes (2) they don't clear cached_string_format or
-      cached_string_length.
-    */
-    friend class Gtid_set;
+  private:
+    /// The intervals of the SIDNO.
+    const Interval_array *array;
+    /// Position of current_elem in array.
+    int index;
   };
 
 
@@ -1474,19 +1406,8 @@ public:
   size_t get_encoded_length() const;
 
 private:
-  /**
-    Contains a list of intervals allocated by this Gtid_set.  When a
-    method of this class needs a new interval and there are no more
-    free intervals, a new Interval_chunk is allocated and the
-    intervals of it are added to the list of free intervals.
-  */
-  struct Interval_chunk
-  {
-    Interval_chunk *next;
-    Interval intervals[1];
-  };
-  /// The default number of intervals in an Interval_chunk.
-  static const int CHUNK_GROW_SIZE= 8;
+  /// The minimal number of intervals allocated for a SIDNO.
+  static const int MIN_INTERVAL_ARRAY_SIZE= 8;
 
 /*
   Functions sidno_equals() and equals() are only used by unitests
@@ -1507,17 +1428,16 @@ private:
   bool equals(const Gtid_set *other) const;
 #endif
 
+  /// Return the intervals of the given sidno.
+  Interval_array *get_interval_array(rpl_sidno sidno)
+  { return dynamic_element(&intervals, sidno - 1, Interval_array *); }
+  /// Return the intervals of the given sidno.
+  const Interval_array *get_interval_array(rpl_sidno sidno) const
+  { return dynamic_element(&intervals, sidno - 1, const Interval_array *); }
   /// Return the number of intervals for the given sidno.
   int get_n_intervals(rpl_sidno sidno) const
   {
-    Const_interval_iterator ivit(this, sidno);
-    int ret= 0;
-    while (ivit.get() != NULL)
-    {
-      ret++;
-      ivit.next();
-    }
-    return ret;
+    return get_interval_array(sidno)->count;
   }
   /// Return the number of intervals in this Gtid_set.
   int get_n_intervals() const
@@ -1531,218 +1451,102 @@ private:
     return ret;
   }
   /**
-    Allocates a new chunk of Intervals and adds them to the list of
-    unused intervals.
+    Makes room for at least n intervals in the given array, growing the
+    allocation geometrically.
 
-    @param size The number of intervals in this chunk
     @return RETURN_STATUS_OK or RETURN_STATUS_REPORTED_ERROR.
   */
-  enum_return_status create_new_chunk(int size);
+  static enum_return_status reserve_intervals(Interval_array *array, int n);
   /**
-    Returns a fresh new Interval object.
-
-    This usually does not require any real allocation, it only pops
-    the first interval from the list of free intervals.  If there are
-    no free intervals, it calls create_new_chunk.
-
-    @param out The resulting Interval* will be stored here.
-    @return RETURN_STATUS_OK or RETURN_STATUS_REPORTED_ERROR.
-  */
-  enum_return_status get_free_interval(Interval **out);
-  /**
-    Puts the given interval in the list of free intervals.  Does not
-    unlink it from its place in any other list.
-  */
-  void put_free_interval(Interval *iv);
-  /**
-    Like add_interval_memory, but does not acquire
-    free_intervals_mutex.
-    @see Gtid_set::add_interval_memory
+    Returns the position of the first interval in the array that ends
+    after the given GNO, or array->count if there is no such interval.
   */
-  void add_interval_memory_lock_taken(int n_ivs, Interval *ivs);
+  static int find_interval(const Interval_array *array, int first,
+                           rpl_gno gno);
 
-  /// Read-write lock that protects updates to the number of SIDs.
-  mutable Checkable_rwlock *sid_lock;
   /**
-    Lock protecting the list of free intervals.  This lock is only
-    used if sid_lock is not NULL.
-  */
-  mysql_mutex_t free_intervals_mutex;
-  /**
-    Class representing a lock on free_intervals_mutex.
-
-    This is used by the add_* and remove_* functions.  The lock is
-    declared by the top-level function and a pointer to the lock is
-    passed down to low-level functions. If the low-level function
-    decides to access the free intervals list, then it acquires the
-    lock.  The lock is then automatically released by the destructor
-    when the top-level function returns.
-
-    The lock is not taken if Gtid_set->sid_lock == NULL; such
-    Gtid_sets are assumed to be thread-local.
-  */
-  class Free_intervals_lock
-  {
-  public:
-    /// Create a new lock, but do not acquire it.
-    Free_intervals_lock(Gtid_set *_gtid_set)
-      : gtid_set(_gtid_set), locked(false) {}
-    /// Lock the lock if it is not already locked.
-    void lock_if_not_locked()
-    {
-      if (gtid_set->sid_lock && !locked)
-      {
-        mysql_mutex_lock(&gtid_set->free_intervals_mutex);
-        locked= true;
-      }
-    }
-    /// Lock the lock if it is locked.
-    void unlock_if_locked()
-    {
-      if (gtid_set->sid_lock && locked)
-      {
-        mysql_mutex_unlock(&gtid_set->free_intervals_mutex);
-        locked= false;
-      }
-    }
-    /// Destroy this object and unlock the lock if it is locked.
-    ~Free_intervals_lock()
-    {
-      unlock_if_locked();
-    }
-  private:
-    Gtid_set *gtid_set;
-    bool locked;
-  };
-  void assert_free_intervals_locked()
-  {
-    if (sid_lock != NULL)
-      mysql_mutex_assert_owner(&free_intervals_mutex);
-  }
-
-  /**
-    Adds the interval (start, end) to the given Interval_iterator.
+    Adds the interval (start, end) to the given SIDNO.
 
     This is the lowest-level function that adds groups; this is where
-    Interval objects are added, grown, or merged.
+    intervals are added, grown, or merged.
 
-    @param ivitp Pointer to iterator.  After this function returns,
-    the current_element of the iterator will be the interval that
-    contains start and end.
+    The SIDNO must exist in the Gtid_set before this function is called.
+
+    @param sidno The SIDNO.
     @param start The first GNO in the interval.
     @param end The first GNO after the interval.
-    @param lock If this function has to add or remove an interval,
-    then this lock will be taken unless it is already taken.  This
-    mechanism means that the lock will be taken lazily by
-    e.g. add_gtid_set() the first time that the list of free intervals
-    is accessed, and automatically released when add_gtid_set()
-    returns.
     @return RETURN_STATUS_OK or RETURN_STATUS_REPORTED_ERROR.
   */
-  enum_return_status add_gno_interval(Interval_iterator *ivitp,
-                                      rpl_gno start, rpl_gno end,
-                                      Free_intervals_lock *lock);
+  enum_return_status add_gno_interval(rpl_sidno sidno,
+                                      rpl_gno start, rpl_gno end);
   /**
-    Removes the interval (start, end) from the given
-    Interval_iterator. This is the lowest-level function that removes
-    groups; this is where Interval objects are removed, truncated, or
-    split.
+    Removes the interval (start, end) from the given SIDNO.  This is
+    the lowest-level function that removes groups; this is where
+    intervals are removed, truncated, or split.
 
     It is not required that the groups in the interval exist in this
     Gtid_set.
 
-    @param ivitp Pointer to iterator.  After this function returns,
-    the current_element of the iterator will be the next interval
-    after end.
+    @param sidno The SIDNO.
     @param start The first GNO in the interval.
     @param end The first GNO after the interval.
-    @param lock If this function has to add or remove an interval,
-    then this lock will be taken unless it is already taken.  This
-    mechanism means that the lock will be taken lazily by
-    e.g. add_gtid_set() the first time that the list of free intervals
-    is accessed, and automatically released when add_gtid_set()
-    returns.
     @return RETURN_STATUS_OK or RETURN_STATUS_REPORTED_ERROR.
   */
-  enum_return_status remove_gno_interval(Interval_iterator *ivitp,
-                                         rpl_gno start, rpl_gno end,
-                                         Free_intervals_lock *lock);
+  enum_return_status remove_gno_interval(rpl_sidno sidno,
+                                         rpl_gno start, rpl_gno end);
   /**
-    Adds a list of intervals to the given SIDNO.
+    Adds an array of intervals to the given SIDNO, merging it with the
+    intervals of the SIDNO in one pass.
 
     The SIDNO must exist in the Gtid_set before this function is called.
 
     @param sidno The SIDNO to which intervals will be added.
-    @param ivit Iterator over the intervals to add. This is typically
-    an iterator over some other Gtid_set.
-    @param lock If this function has to add or remove an interval,
-    then this lock will be taken unless it is already taken.  This
-    mechanism means that the lock will be taken lazily by
-    e.g. add_gtid_set() the first time that the list of free intervals
-    is accessed, and automatically released when add_gtid_set()
-    returns.
+    @param other The intervals to add. This is typically the intervals
+    of some other Gtid_set.
     @return RETURN_STATUS_OK or RETURN_STATUS_REPORTED_ERROR.
   */
   enum_return_status add_gno_intervals(rpl_sidno sidno,
-                                       Const_interval_iterator ivit,
-                                       Free_intervals_lock *lock);
+                                       const Interval_array *other);
   /**
-    Removes a list of intervals from the given SIDNO.
+    Removes an array of intervals from the given SIDNO, in one pass
+    over the intervals of the SIDNO.
 
     It is not required that the intervals exist in this Gtid_set.
 
     @param sidno The SIDNO from which intervals will be removed.
-    @param ivit Iterator over the intervals to remove. This is typically
-    an iterator over some other Gtid_set.
-    @param lock If this function has to add or remove an interval,
-    then this lock will be taken unless it is already taken.  This
-    mechanism means that the lock will be taken lazily by
-    e.g. add_gtid_set() the first time that the list of free intervals
-    is accessed, and automatically released when add_gtid_set()
-    returns.
+    @param other The intervals to remove. This is typically the
+    intervals of some other Gtid_set.
     @return RETURN_STATUS_OK or RETURN_STATUS_REPORTED_ERROR.
   */
   enum_return_status remove_gno_intervals(rpl_sidno sidno,
-                                          Const_interval_iterator ivit,
-                                          Free_intervals_lock *lock);
+                                          const Interval_array *other);
 
   /// Returns true if every interval of sub is a subset of some
   /// interval of super.
-  static bool is_interval_subset(Const_interval_iterator *sub,
-                                 Const_interval_iterator *super);
-  /// Returns true if at least one sidno in ivit1 is also in ivit2.
-  static bool is_interval_intersection_nonempty(Const_interval_iterator *ivit1,
-                                                Const_interval_iterator *ivit2);
+  static bool is_interval_subset(const Interval_array *sub,
+                                 const Interval_array *super);
+  /// Returns true if at least one GNO in array1 is also in array2.
+  static bool is_interval_intersection_nonempty(const Interval_array *array1,
+                                                const Interval_array *array2);
 
+  /// Read-write lock that protects updates to the number of SIDs.
+  mutable Checkable_rwlock *sid_lock;
   /// Sid_map associated with this Gtid_set.
   Sid_map *sid_map;
   /**
-    Array where the N'th element contains the head pointer to the
-    intervals of SIDNO N+1.
+    Array where the N'th element contains the Interval_array of
+    SIDNO N+1.
   */
   DYNAMIC_ARRAY intervals;
-  /// Linked list of free intervals.
-  Interval *free_intervals;
-  /// Linked list of chunks.
-  Interval_chunk *chunks;
   /// The string length.
   mutable int cached_string_length;
   /// The String_format that was used when cached_string_length was computed.
   mutable const String_format *cached_string_format;
-#ifndef DBUG_OFF
-  /**
-    The number of chunks.  Used only to check some invariants when
-    DBUG is on.
-  */
-  int n_chunks;
-#endif
 
   /// Used by unit tests that need to access private members.
 #ifdef FRIEND_OF_GTID_SET
   friend FRIEND_OF_GTID_SET;
 #endif
-  /// Only Free_intervals_lock is allowed to access free_intervals_mutex.
-  friend class Gtid_set::Free_intervals_lock;
 };
 
 
@@ -69,14 +69,7 @@ void Gtid_set::init()
   DBUG_ENTER("Gtid_set::init");
   cached_string_length= -1;
   cached_string_format= NULL;
-  chunks= NULL;
-  free_intervals= NULL;
-  my_init_dynamic_array(&intervals, sizeof(Interval *), 0, 8);
-  if (sid_lock)
-    mysql_mutex_init(0, &free_intervals_mutex, NULL);
-#ifndef DBUG_OFF
-  n_chunks= 0;
-#endif
+  my_init_dynamic_array(&intervals, sizeof(Interval_array), 0, 8);
   DBUG_VOID_RETURN;
 }
 
@@ -84,20 +77,10 @@ void Gtid_set::init()
 Gtid_set::~Gtid_set()
 {
   DBUG_ENTER("Gtid_set::~Gtid_set");
-  Interval_chunk *chunk= chunks;
-  while (chunk != NULL)
-  {
-    Interval_chunk *next_chunk= chunk->next;
-    free(chunk);
-    chunk= next_chunk;
-#ifndef DBUG_OFF
-    n_chunks--;
-#endif
-  }
-  DBUG_ASSERT(n_chunks == 0);
+  rpl_sidno max_sidno= intervals.elements;
+  for (rpl_sidno sidno= 1; sidno <= max_sidno; sidno++)
+    my_free(get_interval_array(sidno)->ivs);
   delete_dynamic(&intervals);
-  if (sid_lock)
-    mysql_mutex_destroy(&free_intervals_mutex);
   DBUG_VOID_RETURN;
 }
 
@@ -116,6 +99,7 @@ enum_return_status Gtid_set::ensure_sidno(rpl_sidno sidno)
   rpl_sidno max_sidno= get_max_sidno();
   if (sidno > max_sidno)
   {
+    Interval_array empty_array= { NULL, 0, 0 };
     /*
       Not all Gtid_sets are protected by an rwlock.  But if this
       Gtid_set is, we assume that the read lock has been taken.
@@ -143,9 +127,8 @@ enum_return_status Gtid_set::ensure_sidno(rpl_sidno sidno)
     if (allocate_dynamic(&intervals,
                          sid_map == NULL ? sidno : sid_map->get_max_sidno()))
       goto error;
-    Interval *null_p= NULL;
     for (rpl_sidno i= max_sidno; i < sidno; i++)
-      if (insert_dynamic(&intervals, &null_p))
+      if (insert_dynamic(&intervals, &empty_array))
         goto error;
     if (sid_lock != NULL)
     {
@@ -163,66 +146,38 @@ error:
 }
 
 
-void Gtid_set::add_interval_memory_lock_taken(int n_ivs, Interval *ivs)
-{
-  DBUG_ENTER("Gtid_set::add_interval_memory");
-  assert_free_intervals_locked();
-  // make ivs a linked list
-  for (int i= 0; i < n_ivs - 1; i++)
-    ivs[i].next= &(ivs[i + 1]);
-  Interval_iterator ivit(this);
-  ivs[n_ivs - 1].next= ivit.get();
-  // add intervals to list of free intervals
-  ivit.set(&(ivs[0]));
-  DBUG_VOID_RETURN;
-}
-
-
-enum_return_status Gtid_set::create_new_chunk(int size)
+enum_return_status Gtid_set::reserve_intervals(Interval_array *array, int n)
 {
-  DBUG_ENTER("Gtid_set::create_new_chunk");
-  // allocate the new chunk. one element is already pre-allocated, so
-  // we only add size-1 elements to the size of the struct.
-  assert_free_intervals_locked();
-  Interval_chunk *new_chunk=
-    (Interval_chunk *)my_malloc(sizeof(Interval_chunk) +
-                                sizeof(Interval) * (size - 1),
-                                MYF(MY_WME));
-  if (new_chunk == NULL)
-    RETURN_REPORTED_ERROR;
-  // store the chunk in the list of chunks
-  new_chunk->next= chunks;
-  chunks= new_chunk;
-#ifndef DBUG_OFF
-  n_chunks++;
-#endif
-  // add the intervals in the chunk to the list of free intervals
-  add_interval_memory_lock_taken(size, new_chunk->intervals);
-  RETURN_OK;
-}
-
-
-enum_return_status Gtid_set::get_free_interval(Interval **out)
-{
-  DBUG_ENTER("Gtid_set::get_free_interval");
-  assert_free_intervals_locked();
-  Interval_iterator ivit(this);
-  if (ivit.get() == NULL)
-    PROPAGATE_REPORTED_ERROR(create_new_chunk(CHUNK_GROW_SIZE));
-  *out= ivit.get();
-  ivit.set((*out)->next);
+  DBUG_ENTER("Gtid_set::reserve_intervals");
+  if (n > array->capacity)
+  {
+    int capacity= max(max(n, 2 * array->capacity), MIN_INTERVAL_ARRAY_SIZE);
+    Interval *ivs= (Interval *)my_realloc(array->ivs,
+                                          capacity * sizeof(Interval),
+                                          MYF(MY_WME | MY_ALLOW_ZERO_PTR));
+    if (ivs == NULL)
+      RETURN_REPORTED_ERROR;
+    array->ivs= ivs;
+    array->capacity= capacity;
+  }
   RETURN_OK;
 }
 
 
-void Gtid_set::put_free_interval(Interval *iv)
+int Gtid_set::find_interval(const Interval_array *array, int first,
+                            rpl_gno gno)
 {
-  DBUG_ENTER("Gtid_set::put_free_interval");
-  assert_free_intervals_locked();
-  Interval_iterator ivit(this);
-  iv->next= ivit.get();
-  ivit.set(iv);
-  DBUG_VOID_RETURN;
+  // Binary search for the first interval in [first, count) with end > gno.
+  int last= array->count;
+  while (first < last)
+  {
+    int mid= first + (last - first) / 2;
+    if (array->ivs[mid].end > gno)
+      last= mid;
+    else
+      first= mid + 1;
+  }
+  return first;
 }
 
 
@@ -231,28 +186,9 @@ void Gtid_set::clear()
   DBUG_ENTER("Gtid_set::clear");
   cached_string_length= -1;
   rpl_sidno max_sidno= get_max_sidno();
-  if (max_sidno == 0)
-    DBUG_VOID_RETURN;
-  Interval_iterator free_ivit(this);
+  // Keep the allocated intervals, they will be reused.
   for (rpl_sidno sidno= 1; sidno <= max_sidno; sidno++)
-  {
-    /*
-      Link in this list of intervals at the end of the list of
-      free intervals.
-    */
-    Interval_iterator ivit(this, sidno);
-    Interval *iv= ivit.get();
-    if (iv != NULL)
-    {
-      // find the end of the list of free intervals
-      while (free_ivit.get() != NULL)
-        free_ivit.next();
-      // append the present list
-      free_ivit.set(iv);
-      // clear the pointer to the head of this list
-      ivit.set(NULL);
-    }
-  }
+    get_interval_array(sidno)->count= 0;
   DBUG_VOID_RETURN;
 }
 
@@ -262,149 +198,110 @@ void Gtid_set::remove(const std::vector<rpl_sidno>& sidnos)
     sid_lock->assert_some_wrlock();
   cached_string_length = -1;
   rpl_sidno max_sidno = get_max_sidno();
-  if (!max_sidno)
-    return;
-  Free_intervals_lock lock(this);
-  lock.lock_if_not_locked();
   for (auto sidno: sidnos)
   {
     if (sidno >= 1 && sidno <= max_sidno) {
-      Interval_iterator ivit(this, sidno);
-      if (ivit.get())
-        ivit.remove(this);
+      Interval_array *array= get_interval_array(sidno);
+      my_free(array->ivs);
+      array->ivs= NULL;
+      array->count= array->capacity= 0;
     }
   }
-  lock.unlock_if_locked();
 }
 
 enum_return_status
-Gtid_set::add_gno_interval(Interval_iterator *ivitp,
-                           rpl_gno start, rpl_gno end,
-                           Free_intervals_lock *lock)
+Gtid_set::add_gno_interval(rpl_sidno sidno, rpl_gno start, rpl_gno end)
 {
-  DBUG_ENTER("Gtid_set::add_gno_interval(Interval_iterator*, rpl_gno, rpl_gno)");
+  DBUG_ENTER("Gtid_set::add_gno_interval(rpl_sidno, rpl_gno, rpl_gno)");
   DBUG_ASSERT(start > 0);
   DBUG_ASSERT(start < end);
   DBUG_PRINT("info", ("start=%lld end=%lld", start, end));
-  Interval *iv;
-  Interval_iterator ivit= *ivitp;
+  Interval_array *array= get_interval_array(sidno);
   cached_string_length= -1;
 
-  while ((iv= ivit.get()) != NULL)
-  {
-    if (iv->end >= start)
-    {
-      if (iv->start > end)
-        // (start, end) is strictly before the current interval
-        break;
-      // (start, end) and (iv->start, iv->end) touch or intersect.
-      // Save the start of the merged interval.
-      if (iv->start < start)
-        start= iv->start;
-      // Remove the current interval as long as the new interval
-      // intersects with the next interval.
-      while (iv->next && end >= iv->next->start)
-      {
-        lock->lock_if_not_locked();
-        ivit.remove(this);
-        iv= ivit.get();
-      }
-      // Store the interval in the current interval.
-      iv->start= start;
-      if (iv->end < end)
-        iv->end= end;
-      *ivitp= ivit;
-      RETURN_OK;
-    }
-    ivit.next();
-  }
   /*
-    We come here if the interval cannot be combined with any existing
-    interval: it is after the previous interval (if any) and before
-    the current interval (if any). So we allocate a new interval and
-    insert it at the current position.
+    Intervals first..last-1 intersect or touch (start, end): they all
+    end at or after start and begin at or before end.
   */
-  Interval *new_iv;
-  lock->lock_if_not_locked();
-  PROPAGATE_REPORTED_ERROR(get_free_interval(&new_iv));
-  new_iv->start= start;
-  new_iv->end= end;
-  ivit.insert(new_iv);
-  *ivitp= ivit;
+  int first= find_interval(array, 0, start - 1);
+  int last= find_interval(array, first, end);
+  if (last < array->count && array->ivs[last].start <= end)
+    last++;
+
+  if (first == last)
+  {
+    /*
+      The interval cannot be combined with any existing interval: it
+      is after interval first-1 (if any) and before interval first (if
+      any). So we insert a new interval at that position.
+    */
+    PROPAGATE_REPORTED_ERROR(reserve_intervals(array, array->count + 1));
+    memmove(array->ivs + first + 1, array->ivs + first,
+            (array->count - first) * sizeof(Interval));
+    array->ivs[first].start= start;
+    array->ivs[first].end= end;
+    array->count++;
+    RETURN_OK;
+  }
+
+  // Store the merged interval in the first interval and remove the rest.
+  Interval *iv= array->ivs + first;
+  if (iv->start > start)
+    iv->start= start;
+  iv->end= max(end, array->ivs[last - 1].end);
+  memmove(iv + 1, array->ivs + last,
+          (array->count - last) * sizeof(Interval));
+  array->count-= last - first - 1;
   RETURN_OK;
 }
 
 
-enum_return_status Gtid_set::remove_gno_interval(Interval_iterator *ivitp,
-                                                 rpl_gno start, rpl_gno end,
-                                                 Free_intervals_lock *lock)
+enum_return_status Gtid_set::remove_gno_interval(rpl_sidno sidno,
+                                                 rpl_gno start, rpl_gno end)
 {
-  DBUG_ENTER("Gtid_set::remove_gno_interval(Interval_iterator *ivitp, rpl_gno start, rpl_gno end)");
+  DBUG_ENTER("Gtid_set::remove_gno_interval(rpl_sidno, rpl_gno, rpl_gno)");
   DBUG_ASSERT(start < end);
-  Interval_iterator ivit= *ivitp;
-  Interval *iv;
+  Interval_array *array= get_interval_array(sidno);
   cached_string_length= -1;
 
-  // Skip intervals of 'this' that are completely before the removed interval.
-  while (1)
-  {
-    iv= ivit.get();
-    if (iv == NULL)
-      goto ok;
-    if (iv->end > start)
-      break;
-    ivit.next();
-  }
+  // Intervals first..last-1 intersect (start, end).
+  int first= find_interval(array, 0, start);
+  int last= find_interval(array, first, end - 1);
+  if (last < array->count && array->ivs[last].start < end)
+    last++;
+  if (first == last)
+    RETURN_OK;
 
-  // Now iv ends after the beginning of the removed interval.
-  DBUG_ASSERT(iv != NULL && iv->end > start);
-  if (iv->start < start)
+  Interval *iv= array->ivs + first;
+  if (last - first == 1 && iv->start < start && iv->end > end)
   {
-    if (iv->end > end)
-    {
-      // iv cuts also the end of the removed interval: split iv in two
-      Interval *new_iv;
-      lock->lock_if_not_locked();
-      PROPAGATE_REPORTED_ERROR(get_free_interval(&new_iv));
-      new_iv->start= end;
-      new_iv->end= iv->end;
-      iv->end= start;
-      ivit.next();
-      ivit.insert(new_iv);
-      goto ok;
-    }
-    // iv cuts the beginning but not the end of the removed interval:
-    // truncate iv, and iterate one step to next interval
+    // iv covers both ends of the removed interval: split iv in two
+    rpl_gno iv_end= iv->end;
+    PROPAGATE_REPORTED_ERROR(reserve_intervals(array, array->count + 1));
+    iv= array->ivs + first;
+    memmove(iv + 2, iv + 1, (array->count - first - 1) * sizeof(Interval));
     iv->end= start;
-    ivit.next();
-    iv= ivit.get();
-    if (iv == NULL)
-      goto ok;
+    iv[1].start= end;
+    iv[1].end= iv_end;
+    array->count++;
+    RETURN_OK;
   }
 
-  // Now iv starts after the beginning of the removed interval.
-  DBUG_ASSERT(iv != NULL && iv->start >= start);
-  while (iv->end <= end)
+  // Truncate the intervals that cut the beginning or the end of the
+  // removed interval, and remove those that are completely covered.
+  if (iv->start < start)
   {
-    // iv ends before the end of the removed interval, so it is
-    // completely covered: remove iv.
-    lock->lock_if_not_locked();
-    ivit.remove(this);
-    iv= ivit.get();
-    if (iv == NULL)
-      goto ok;
+    iv->end= start;
+    first++;
   }
-
-  // Now iv ends after the removed interval.
-  DBUG_ASSERT(iv != NULL && iv->end > end);
-  if (iv->start < end)
+  if (first < last && array->ivs[last - 1].end > end)
   {
-    // iv begins before the end of the removed interval: truncate iv
-    iv->start= end;
+    array->ivs[last - 1].start= end;
+    last--;
   }
-
-ok:
-  *ivitp= ivit;
+  memmove(array->ivs + first, array->ivs + last,
+          (array->count - last) * sizeof(Interval));
+  array->count-= last - first;
   RETURN_OK;
 }
 
@@ -446,25 +343,7 @@ enum_return_status Gtid_set::add_gtid_text(const char *text, bool *anonymous)
     RETURN_OK;
   }
 
-  Free_intervals_lock lock(this);
-
   DBUG_PRINT("info", ("'%s' not only whitespace", text));
-  // Allocate space for all intervals at once, if nothing is allocated.
-  if (chunks == NULL)
-  {
-    // compute number of intervals in text: it is equal to the number of
-    // colons
-    int n_intervals= 0;
-    text= s;
-    for (; *s; s++)
-      if (*s == ':')
-        n_intervals++;
-    // allocate all intervals in one chunk
-    lock.lock_if_not_locked();
-    create_new_chunk(n_intervals);
-    lock.unlock_if_locked();
-    s= text;
-  }
 
   while (1)
   {
@@ -506,7 +385,6 @@ enum_return_status Gtid_set::add_gtid_text(const char *text, bool *anonymous)
       SKIP_WHITESPACE();
 
       // Iterate over intervals.
-      Interval_iterator ivit(this, sidno);
       while (*s == ':')
       {
         // Skip ':'.
@@ -544,13 +422,7 @@ enum_return_status Gtid_set::add_gtid_text(const char *text, bool *anonymous)
 
         if (end > start)
         {
-          // Add interval.  Use the existing iterator position if the
-          // current interval does not begin before it.  Otherwise iterate
-          // from the beginning.
-          Interval *current= ivit.get();
-          if (current == NULL || start < current->start)
-            ivit.init(this, sidno);
-          if (add_gno_interval(&ivit, start, end, &lock) != RETURN_STATUS_OK)
+          if (add_gno_interval(sidno, start, end) != RETURN_STATUS_OK)
           {
             RETURN_REPORTED_ERROR;
           }
@@ -627,41 +499,112 @@ bool Gtid_set::is_valid(const char *text)
 
 
 enum_return_status
-Gtid_set::add_gno_intervals(rpl_sidno sidno,
-                            Const_interval_iterator other_ivit,
-                            Free_intervals_lock *lock)
+Gtid_set::add_gno_intervals(rpl_sidno sidno, const Interval_array *other)
 {
-  DBUG_ENTER("Gtid_set::add_gno_intervals(rpl_sidno, Const_interval_iterator, bool *)");
+  DBUG_ENTER("Gtid_set::add_gno_intervals(rpl_sidno, const Interval_array *)");
   DBUG_ASSERT(sidno >= 1 && sidno <= get_max_sidno());
-  const Interval *other_iv;
-  Interval_iterator ivit(this, sidno);
-  while ((other_iv= other_ivit.get()) != NULL)
+  Interval_array *array= get_interval_array(sidno);
+  if (other->count == 0)
+    RETURN_OK;
+  cached_string_length= -1;
+  if (array->count == 0)
   {
-    PROPAGATE_REPORTED_ERROR(add_gno_interval(&ivit,
-                                              other_iv->start, other_iv->end,
-                                              lock));
-    other_ivit.next();
+    PROPAGATE_REPORTED_ERROR(reserve_intervals(array, other->count));
+    memcpy(array->ivs, other->ivs, other->count * sizeof(Interval));
+    array->count= other->count;
+    RETURN_OK;
+  }
+  if (other->count == 1)
+  {
+    PROPAGATE_REPORTED_ERROR(add_gno_interval(sidno, other->ivs[0].start,
+                                              other->ivs[0].end));
+    RETURN_OK;
+  }
+
+  /*
+    Merge the two sorted arrays into a new array, combining intervals
+    that intersect or touch, and replace the old array with it.
+  */
+  Interval_array out= { NULL, 0, 0 };
+  PROPAGATE_REPORTED_ERROR(reserve_intervals(&out,
+                                             array->count + other->count));
+  int i= 0, j= 0;
+  while (i < array->count || j < other->count)
+  {
+    const Interval *next;
+    if (j == other->count ||
+        (i < array->count && array->ivs[i].start <= other->ivs[j].start))
+      next= array->ivs + i++;
+    else
+      next= other->ivs + j++;
+    if (out.count > 0 && out.ivs[out.count - 1].end >= next->start)
+    {
+      if (out.ivs[out.count - 1].end < next->end)
+        out.ivs[out.count - 1].end= next->end;
+    }
+    else
+      out.ivs[out.count++]= *next;
   }
+  my_free(array->ivs);
+  *array= out;
   RETURN_OK;
 }
 
 
 enum_return_status
-Gtid_set::remove_gno_intervals(rpl_sidno sidno,
-                               Const_interval_iterator other_ivit,
-                               Free_intervals_lock *lock)
+Gtid_set::remove_gno_intervals(rpl_sidno sidno, const Interval_array *other)
 {
-  DBUG_ENTER("Gtid_set::remove_gno_intervals(rpl_sidno, Interval_iterator, bool *)");
+  DBUG_ENTER("Gtid_set::remove_gno_intervals(rpl_sidno, const Interval_array *)");
   DBUG_ASSERT(sidno >= 1 && sidno <= get_max_sidno());
-  const Interval *other_iv;
-  Interval_iterator ivit(this, sidno);
-  while ((other_iv= other_ivit.get()) != NULL)
+  Interval_array *array= get_interval_array(sidno);
+  if (array->count == 0 || other->count == 0)
+    RETURN_OK;
+  cached_string_length= -1;
+  if (other->count == 1)
   {
-    PROPAGATE_REPORTED_ERROR(remove_gno_interval(&ivit,
-                                                 other_iv->start, other_iv->end,
-                                                 lock));
-    other_ivit.next();
+    PROPAGATE_REPORTED_ERROR(remove_gno_interval(sidno, other->ivs[0].start,
+                                                 other->ivs[0].end));
+    RETURN_OK;
+  }
+
+  /*
+    Subtract the other array from this one in a single pass over both.
+    Every interval of 'other' can split at most one interval of this
+    array, so the result has at most array->count + other->count
+    intervals.
+  */
+  Interval_array out= { NULL, 0, 0 };
+  PROPAGATE_REPORTED_ERROR(reserve_intervals(&out,
+                                             array->count + other->count));
+  int j= 0;
+  for (int i= 0; i < array->count; i++)
+  {
+    rpl_gno start= array->ivs[i].start;
+    const rpl_gno end= array->ivs[i].end;
+    // Skip the intervals of 'other' that end before this interval.
+    j= find_interval(other, j, start);
+    while (start < end)
+    {
+      if (j == other->count || other->ivs[j].start >= end)
+      {
+        out.ivs[out.count].start= start;
+        out.ivs[out.count].end= end;
+        out.count++;
+        break;
+      }
+      if (other->ivs[j].start > start)
+      {
+        out.ivs[out.count].start= start;
+        out.ivs[out.count].end= other->ivs[j].start;
+        out.count++;
+      }
+      start= other->ivs[j].end;
+      if (start <= end)
+        j++;
+    }
   }
+  my_free(array->ivs);
+  *array= out;
   RETURN_OK;
 }
 
@@ -672,14 +615,12 @@ enum_return_status Gtid_set::add_gtid_set(const Gtid_set *other)
   if (sid_lock != NULL)
     sid_lock->assert_some_wrlock();
   rpl_sidno max_other_sidno= other->get_max_sidno();
-  Free_intervals_lock lock(this);
   if (other->sid_map == sid_map || other->sid_map == NULL || sid_map == NULL)
   {
     PROPAGATE_REPORTED_ERROR(ensure_sidno(max_other_sidno));
     for (rpl_sidno sidno= 1; sidno <= max_other_sidno; sidno++)
       PROPAGATE_REPORTED_ERROR(
-        add_gno_intervals(sidno, Const_interval_iterator(other, sidno),
-                          &lock));
+        add_gno_intervals(sidno, other->get_interval_array(sidno)));
   }
   else
   {
@@ -693,16 +634,16 @@ enum_return_status Gtid_set::add_gtid_set(const Gtid_set *other)
     for (rpl_sidno other_sidno= 1; other_sidno <= max_other_sidno;
          other_sidno++)
     {
-      Const_interval_iterator other_ivit(other, other_sidno);
-      if (other_ivit.get() != NULL)
+      const Interval_array *other_array=
+        other->get_interval_array(other_sidno);
+      if (other_array->count > 0)
       {
         const rpl_sid &sid= other_sid_map->sidno_to_sid(other_sidno);
         rpl_sidno this_sidno= sid_map->add_sid(sid);
         if (this_sidno <= 0)
           RETURN_REPORTED_ERROR;
         PROPAGATE_REPORTED_ERROR(ensure_sidno(this_sidno));
-        PROPAGATE_REPORTED_ERROR(add_gno_intervals(this_sidno, other_ivit,
-                                                   &lock));
+        PROPAGATE_REPORTED_ERROR(add_gno_intervals(this_sidno, other_array));
       }
     }
   }
@@ -716,14 +657,12 @@ enum_return_status Gtid_set::remove_gtid_set(const Gtid_set *other)
   if (sid_lock != NULL)
     sid_lock->assert_some_wrlock();
   rpl_sidno max_other_sidno= other->get_max_sidno();
-  Free_intervals_lock lock(this);
   if (other->sid_map == sid_map || other->sid_map == NULL || sid_map == NULL)
   {
     rpl_sidno max_sidno= min(max_other_sidno, get_max_sidno());
     for (rpl_sidno sidno= 1; sidno <= max_sidno; sidno++)
       PROPAGATE_REPORTED_ERROR(
-        remove_gno_intervals(sidno, Const_interval_iterator(other, sidno),
-                             &lock));
+        remove_gno_intervals(sidno, other->get_interval_array(sidno)));
   }
   else
   {
@@ -739,14 +678,15 @@ enum_return_status Gtid_set::remove_gtid_set(const Gtid_set *other)
     for (rpl_sidno other_sidno= 1; other_sidno <= max_other_sidno;
          other_sidno++)
     {
-      Const_interval_iterator other_ivit(other, other_sidno);
-      if (other_ivit.get() != NULL)
+      const Interval_array *other_array=
+        other->get_interval_array(other_sidno);
+      if (other_array->count > 0)
       {
         const rpl_sid &sid= other_sid_map->sidno_to_sid(other_sidno);
         rpl_sidno this_sidno= sid_map->sid_to_sidno(sid);
         if (this_sidno != 0)
           PROPAGATE_REPORTED_ERROR(
-            remove_gno_intervals(this_sidno, other_ivit, &lock));
+            remove_gno_intervals(this_sidno, other_array));
       }
     }
 #endif
@@ -763,17 +703,9 @@ bool Gtid_set::contains_gtid(rpl_sidno sidno, rpl_gno gno) const
     sid_lock->assert_some_lock();
   if (sidno > get_max_sidno())
     DBUG_RETURN(false);
-  Const_interval_iterator ivit(this, sidno);
-  const Interval *iv;
-  while ((iv= ivit.get()) != NULL)
-  {
-    if (gno < iv->start)
-      DBUG_RETURN(false);
-    else if (gno < iv->end)
-      DBUG_RETURN(true);
-    ivit.next();
-  }
-  DBUG_RETURN(false);
+  const Interval_array *array= get_interval_array(sidno);
+  int i= find_interval(array, 0, gno);
+  DBUG_RETURN(i < array->count && array->ivs[i].start <= gno);
 }
 
 int Gtid_set::to_string(char **buf_arg, const Gtid_set::String_format *sf_arg) const
@@ -1028,47 +960,30 @@ bool Gtid_set::equals(const Gtid_set *other) const
 #endif
 
 
-bool Gtid_set::is_interval_subset(Const_interval_iterator *sub,
-                                  Const_interval_iterator *super)
+bool Gtid_set::is_interval_subset(const Interval_array *sub,
+                                  const Interval_array *super)
 {
   DBUG_ENTER("is_interval_subset");
-  // check if all intervals for this sidno are contained in some
-  // interval of super
-  const Interval *super_iv= super->get();
-  const Interval *sub_iv= sub->get();
-
   /*
-    Algorithm: Let sub_iv iterate over intervals of sub.  For each
-    sub_iv, skip over intervals of super that end before sub_iv.  When we
-    find the first super-interval that does not end before sub_iv,
-    check if it covers sub_iv.
+    Algorithm: For each interval of sub, search super (from the
+    position of the previous match, since both arrays are sorted) for
+    the first interval that does not end before sub_iv, and check if
+    it covers sub_iv.
   */
-  do
+  int super_i= 0;
+  for (int sub_i= 0; sub_i < sub->count; sub_i++)
   {
-    if (super_iv == NULL)
+    const Interval *sub_iv= sub->ivs + sub_i;
+    super_i= find_interval(super, super_i, sub_iv->end - 1);
+    // If we reach end of super, then no interval covers sub_iv, so
+    // sub is not a subset of super.
+    if (super_i == super->count)
       DBUG_RETURN(false);
-
-    // Skip over 'smaller' intervals of super.
-    while (sub_iv->start > super_iv->end)
-    {
-      super->next();
-      super_iv= super->get();
-      // If we reach end of super, then no interal covers sub_iv, so
-      // sub is not a subset of super.
-      if (super_iv == NULL)
-        DBUG_RETURN(false);
-    }
-
     // If super_iv does not cover sub_iv, then sub is not a subset of
     // super.
-    if (sub_iv->start < super_iv->start || sub_iv->end > super_iv->end)
+    if (sub_iv->start < super->ivs[super_i].start)
       DBUG_RETURN(false);
-
-    // Next iteration.
-    sub->next();
-    sub_iv= sub->get();
-
-  } while (sub_iv != NULL);
+  }
 
   // If every GNO in sub also exists in super, then it was a subset.
   DBUG_RETURN(true);
@@ -1110,9 +1025,8 @@ bool Gtid_set::is_subset_for_sid(const Gtid_set *super,
     Once we have valid(non-zero) subset's and superset's sid numbers, call
     is_interval_subset().
   */
-  Const_interval_iterator subset_ivit(this, subset_sidno);
-  Const_interval_iterator superset_ivit(super, superset_sidno);
-  if (!is_interval_subset(&subset_ivit, &superset_ivit))
+  if (!is_interval_subset(get_interval_array(subset_sidno),
+                          super->get_interval_array(superset_sidno)))
     DBUG_RETURN(false);
 
   DBUG_RETURN(true);
@@ -1138,9 +1052,8 @@ bool Gtid_set::is_subset(const Gtid_set *super) const
   */
   for (int sidno= 1; sidno <= max_sidno; sidno++)
   {
-    Const_interval_iterator ivit(this, sidno);
-    const Interval *iv= ivit.get();
-    if (iv != NULL)
+    const Interval_array *array= get_interval_array(sidno);
+    if (array->count > 0)
     {
 
       // Get the corresponding super_sidno
@@ -1158,8 +1071,7 @@ bool Gtid_set::is_subset(const Gtid_set *super) const
 
       // Check if all GNOs in this Gtid_set for sidno exist in other
       // Gtid_set for super_
-      Const_interval_iterator super_ivit(super, super_sidno);
-      if (!is_interval_subset(&ivit, &super_ivit))
+      if (!is_interval_subset(array, super->get_interval_array(super_sidno)))
         DBUG_RETURN(false);
     }
   }
@@ -1170,47 +1082,33 @@ bool Gtid_set::is_subset(const Gtid_set *super) const
 }
 
 
-bool Gtid_set::is_interval_intersection_nonempty(Const_interval_iterator *ivit1,
-                                                 Const_interval_iterator *ivit2)
+bool
+Gtid_set::is_interval_intersection_nonempty(const Interval_array *array1,
+                                            const Interval_array *array2)
 {
   DBUG_ENTER("is_interval_intersection_nonempty");
-  const Interval *iv1= ivit1->get();
-  const Interval *iv2= ivit2->get();
-  DBUG_ASSERT(iv1 != NULL);
-  if (iv2 == NULL)
-    DBUG_RETURN(false);
+  DBUG_ASSERT(array1->count > 0);
 
   /*
-    Algorithm: Let iv1 iterate over all intervals of ivit1.  For each
-    iv1, skip over intervals of iv2 that end before iv1.  When we
-    reach the first interval that does not end before iv1, check if it
-    intersects with iv1.
+    Algorithm: For each interval iv1 of array1, search array2 (from the
+    position of the previous search) for the first interval that does
+    not end before iv1, and check if it intersects with iv1.
   */
-  do
+  int i2= 0;
+  for (int i1= 0; i1 < array1->count; i1++)
   {
-
-    // Skip over intervals of iv2 that end before iv1.
-    while (iv2->end <= iv1->start)
-    {
-      ivit2->next();
-      iv2= ivit2->get();
-      // If we reached the end of ivit2, then there is no intersection.
-      if (iv2 == NULL)
-        DBUG_RETURN(false);
-    }
-
+    const Interval *iv1= array1->ivs + i1;
+    i2= find_interval(array2, i2, iv1->start);
+    // If we reached the end of array2, then there is no intersection.
+    if (i2 == array2->count)
+      DBUG_RETURN(false);
     // If iv1 and iv2 intersect, return true.
-    if (iv2->start < iv1->end)
+    if (array2->ivs[i2].start < iv1->end)
       DBUG_RETURN(true);
+  }
 
-    // Next iteration.
-    ivit1->next();
-    iv1= ivit1->get();
-
-  } while (iv1 != NULL);
-
-  // If we iterated over all intervals of ivit1 without finding any
-  // intersection with ivit2, then there is no intersection.
+  // If we iterated over all intervals of array1 without finding any
+  // intersection with array2, then there is no intersection.
   DBUG_RETURN(false);
 }
 
@@ -1249,9 +1147,8 @@ bool Gtid_set::is_intersection_nonempty(const Gtid_set *other) const
   */
   for (int sidno= 1; sidno <= max_sidno; sidno++)
   {
-    Const_interval_iterator ivit(this, sidno);
-    const Interval *iv= ivit.get();
-    if (iv != NULL)
+    const Interval_array *array= get_interval_array(sidno);
+    if (array->count > 0)
     {
 
       // Get the corresponding other_sidno.
@@ -1269,8 +1166,8 @@ bool Gtid_set::is_intersection_nonempty(const Gtid_set *other) const
 
       // Check if there is any GNO in this for sidno that also exists
       // in other for other_sidno.
-      Const_interval_iterator other_ivit(other, other_sidno);
-      if (is_interval_intersection_nonempty(&ivit, &other_ivit))
+      if (is_interval_intersection_nonempty(
+            array, other->get_interval_array(other_sidno)))
         DBUG_RETURN(true);
     }
   }
@@ -1392,7 +1289,6 @@ enum_return_status Gtid_set::add_gtid_encoding(const uchar *encoded,
     sid_lock->assert_some_wrlock();
   size_t pos= 0;
   uint64 n_sids;
-  Free_intervals_lock lock(this);
   // read number of SIDs
   if (length < 8)
   {
@@ -1431,7 +1327,6 @@ enum_return_status Gtid_set::add_gtid_encoding(const uchar *encoded,
                            (ulong) length, (ulong) pos, n_intervals));
       goto report_error;
     }
-    Interval_iterator ivit(this, sidno);
     rpl_gno last= 0;
     for (uint i= 0; i < n_intervals; i++)
     {
@@ -1447,14 +1342,8 @@ enum_return_status Gtid_set::add_gtid_encoding(const uchar *encoded,
         goto report_error;
       }
       last= end;
-      // Add interval.  Use the existing iterator position if the
-      // current interval does not begin before it.  Otherwise iterate
-      // from the beginning.
-      Interval *current= ivit.get();
-      if (current == NULL || start < current->start)
-        ivit.init(this, sidno);
       DBUG_PRINT("info", ("adding %d:%lld-%lld", sidno, start, end - 1));
-      PROPAGATE_REPORTED_ERROR(add_gno_interval(&ivit, start, end, &lock));
+      PROPAGATE_REPORTED_ERROR(add_gno_interval(sidno, start, end));
     }
   }
   DBUG_ASSERT(pos <= length);
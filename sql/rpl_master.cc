@@ -2140,7 +2140,8 @@ void mysql_binlog_send(THD* thd, char* log_ident, my_off_t pos,
   thd->current_linfo = &linfo;
   mutex_unlock_shard(SHARDED(&LOCK_thread_count), thd);
 
-  if ((file=open_binlog_file(&log, log_file_name, &errmsg)) < 0)
+  if ((file=open_binlog_file(&log, log_file_name, &errmsg,
+                             rpl_read_ahead)) < 0)
   {
     my_errno= ER_MASTER_FATAL_ERROR_READING_BINLOG;
     GOTO_ERR;
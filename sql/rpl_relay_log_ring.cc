@@ -0,0 +1,95 @@
+/* Copyright (c) 2016, Facebook, Inc. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include "rpl_relay_log_ring.h"
+
+#include <my_dbug.h>
+#include <string.h>
+
+
+void Relay_log_ring::drop_front()
+{
+  DBUG_ASSERT(!m_entries.empty());
+  m_bytes-= m_entries.front().len;
+  my_free(m_entries.front().buf);
+  m_entries.pop_front();
+}
+
+
+void Relay_log_ring::clear()
+{
+  while (!m_entries.empty())
+    drop_front();
+  DBUG_ASSERT(m_bytes == 0);
+}
+
+
+void Relay_log_ring::add(uint open_count, my_off_t pos, const char *buf,
+                         uint len, ulonglong max_bytes)
+{
+  /* Entries of a rotated relay log can never be taken */
+  if (open_count != m_open_count)
+  {
+    clear();
+    m_open_count= open_count;
+  }
+
+  /*
+    An event that does not fit is not added, the applier reads it from
+    the relay log. The entries after it are still usable since entries
+    are looked up by position.
+  */
+  if (len > max_bytes)
+  {
+    if (max_bytes == 0)
+      clear();
+    return;
+  }
+
+  while (m_bytes + len > max_bytes)
+    drop_front();
+
+  /* Some events use the extra byte to null-terminate strings */
+  Entry entry;
+  if (!(entry.buf= (char*) my_malloc(len + 1, MYF(0))))
+    return;
+  memcpy(entry.buf, buf, len);
+  entry.buf[len]= 0;
+  entry.pos= pos;
+  entry.len= len;
+  m_entries.push_back(entry);
+  m_bytes+= len;
+}
+
+
+bool Relay_log_ring::take(uint open_count, my_off_t pos, char **buf,
+                          uint *len)
+{
+  if (open_count != m_open_count)
+    return false;
+
+  while (!m_entries.empty() && m_entries.front().pos < pos)
+    drop_front();
+
+  if (m_entries.empty() || m_entries.front().pos != pos)
+    return false;
+
+  Entry &entry= m_entries.front();
+  *buf= entry.buf;
+  *len= entry.len;
+  m_bytes-= entry.len;
+  m_entries.pop_front();
+  return true;
+}
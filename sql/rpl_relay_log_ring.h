@@ -0,0 +1,95 @@
+/* Copyright (c) 2016, Facebook, Inc. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#ifndef RPL_RELAY_LOG_RING_H
+#define RPL_RELAY_LOG_RING_H
+
+#include <my_global.h>
+#include <my_sys.h>
+
+#include <deque>
+
+/**
+  Bounded in-memory copy of the most recent events appended to the active
+  relay log.
+
+  The slave IO thread adds every event it appends to the relay log, and
+  the SQL thread (or the MTS coordinator) takes events from the ring
+  instead of reading them back from the relay log while it keeps up.
+  Entries are keyed by their position in the relay log, so an applier that
+  has fallen behind the ring, or an event that was never added, is simply
+  read from the file. When the ring is full the oldest entries are
+  dropped; the IO thread never waits for the applier.
+
+  Protected by the LOCK_log of the relay log.
+*/
+class Relay_log_ring
+{
+public:
+  Relay_log_ring() : m_open_count(0), m_bytes(0) {}
+  ~Relay_log_ring() { clear(); }
+
+  /**
+    Add a copy of an event that was appended to the relay log.
+
+    @param open_count  Open count of the relay log the event was written to.
+    @param pos         Position of the event in the relay log.
+    @param buf         The event.
+    @param len         Length of the event.
+    @param max_bytes   Capacity of the ring in bytes, 0 to disable it.
+  */
+  void add(uint open_count, my_off_t pos, const char *buf, uint len,
+           ulonglong max_bytes);
+
+  /**
+    Take the event at a position of the relay log out of the ring. The
+    entries before it are dropped, as the applier has passed them.
+
+    @param open_count  Open count of the relay log being read.
+    @param pos         Position of the event in the relay log.
+    @param[out] buf    The event, followed by a terminating zero byte. The
+                       caller must release it with my_free().
+    @param[out] len    Length of the event.
+
+    @retval true   The event was found.
+    @retval false  The event is not in the ring and must be read from the
+                   relay log.
+  */
+  bool take(uint open_count, my_off_t pos, char **buf, uint *len);
+
+  /** Drop all entries. */
+  void clear();
+
+  /** Number of event bytes held by the ring. */
+  ulonglong get_bytes() const { return m_bytes; }
+
+private:
+  struct Entry
+  {
+    my_off_t pos;
+    uint len;
+    char *buf;
+  };
+
+  void drop_front();
+
+  std::deque<Entry> m_entries;
+  /** Open count of the relay log the entries belong to */
+  uint m_open_count;
+  /** Sum of the lengths of the entries */
+  ulonglong m_bytes;
+};
+
+#endif /* RPL_RELAY_LOG_RING_H */
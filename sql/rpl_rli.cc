@@ -732,7 +732,8 @@ int Relay_log_info::init_relay_log_pos(const char* log,
       Open the relay log and set cur_log to point at this one
     */
     if ((cur_log_fd=open_binlog_file(&cache_buf,
-                                     linfo.log_file_name,errmsg)) < 0)
+                                     linfo.log_file_name,errmsg,
+                                     rpl_read_ahead)) < 0)
       goto err;
     cur_log = &cache_buf;
   }
@@ -8667,7 +8667,7 @@ static IO_CACHE *reopen_relay_log(Relay_log_info *rli, const char **errmsg)
 
   IO_CACHE *cur_log = rli->cur_log=&rli->cache_buf;
   if ((rli->cur_log_fd=open_binlog_file(cur_log,rli->get_event_relay_log_name(),
-                                        errmsg)) <0)
+                                        errmsg, rpl_read_ahead)) <0)
     DBUG_RETURN(0);
   /*
     We want to start exactly where we was before:
@@ -8681,6 +8681,48 @@ static IO_CACHE *reopen_relay_log(Relay_log_info *rli, const char **errmsg)
 }
 
 
+/**
+  Takes the next event of the hot relay log from the relay log ring, where
+  the slave I/O thread leaves a copy of the events it appends to the relay
+  log when slave_relay_log_ring_size is set. Must be called with the
+  LOCK_log of the relay log held.
+
+  @param rli          Relay_log_info structure for the slave SQL thread.
+  @param cur_log      The hot relay log, positioned at the next event.
+  @param read_length  Set to the length of the event.
+
+  @return The event, or NULL if it has to be read from the relay log.
+*/
+static Log_event* read_event_from_ring(Relay_log_info* rli,
+                                       IO_CACHE* cur_log, int* read_length)
+{
+  mysql_mutex_assert_owner(rli->relay_log.get_log_lock());
+  my_off_t pos= my_b_tell(cur_log);
+  char *buf;
+  uint len;
+
+  if (!rli->relay_log.relay_log_ring.take(rli->cur_log_old_open_count, pos,
+                                          &buf, &len))
+    return NULL;
+
+  const char *error= NULL;
+  Log_event *ev= Log_event::read_log_event(buf, len, &error,
+                                           rli->get_rli_description_event(),
+                                           opt_slave_sql_verify_checksum);
+  if (!ev)
+  {
+    /* Read the event from the relay log again, which reports the error */
+    my_free(buf);
+    return NULL;
+  }
+  ev->register_temp_buf(buf);
+  my_b_seek(cur_log, pos + len);
+  *read_length= len;
+  relay_sql_ring_events++;
+  return ev;
+}
+
+
 /**
   Reads next event from the relay log.  Should be called from the
   slave SQL thread.
@@ -8803,10 +8845,11 @@ static Log_event* next_event(Relay_log_info* rli)
       But if the relay log is created by new_file(): then the solution is:
       MYSQL_BIN_LOG::open() will write the buffered description event.
     */
-    if ((ev= Log_event::read_log_event(cur_log, 0,
-                                       rli->get_rli_description_event(),
-                                       opt_slave_sql_verify_checksum,
-                                       &read_length)))
+    ev= hot_log ? read_event_from_ring(rli, cur_log, &read_length) : NULL;
+    if (ev || (ev= Log_event::read_log_event(cur_log, 0,
+                                             rli->get_rli_description_event(),
+                                             opt_slave_sql_verify_checksum,
+                                             &read_length)))
     {
       DBUG_ASSERT(thd==rli->info_thd);
       /*
@@ -9230,7 +9273,7 @@ static Log_event* next_event(Relay_log_info* rli)
 #endif
       // open_binlog_file() will check the magic header
       if ((rli->cur_log_fd=open_binlog_file(cur_log,rli->linfo.log_file_name,
-                                            &errmsg)) <0)
+                                            &errmsg, rpl_read_ahead)) <0)
         goto err;
     }
     else
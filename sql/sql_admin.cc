@@ -651,6 +651,10 @@ static bool mysql_admin_table(THD* thd, TABLE_LIST* tables,
     result_code = (table->table->file->*operator_func)(thd, check_opt);
     DBUG_PRINT("admin", ("operator_func returned: %d", result_code));
 
+    /* Let prepared statements know that their cached plans are stale. */
+    if (operator_func == &handler::ha_analyze)
+      my_atomic_add64(&table->table->s->stats_version, 1);
+
 send_result:
 
     lex->cleanup_after_one_table_open();
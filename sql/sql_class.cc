@@ -2370,6 +2370,10 @@ bool THD::store_globals()
     created in another thread
   */
   thr_lock_info_init(&lock_info);
+
+  /* Only the blocks cached from now on are used by this session. */
+  mem_root_cache_stats(&mem_root_cache_hits_seen,
+                       &mem_root_cache_misses_seen);
   return 0;
 }
 
@@ -6311,6 +6315,28 @@ void THD::propagate_pending_global_disk_usage()
                    filesort_disk_usage_period_peak);
 }
 
+/*
+  Add the blocks that this thread took from its MEM_ROOT block cache, or
+  had to malloc, since the last call or store_globals() to status_var.
+*/
+void THD::update_mem_root_cache_status()
+{
+  ulonglong hits, misses;
+
+  mem_root_cache_stats(&hits, &misses);
+
+  /* The counters restart if the thread freed its cache meanwhile. */
+  if (hits >= mem_root_cache_hits_seen &&
+      misses >= mem_root_cache_misses_seen)
+  {
+    status_var.mem_root_cache_hits+= hits - mem_root_cache_hits_seen;
+    status_var.mem_root_cache_misses+= misses - mem_root_cache_misses_seen;
+  }
+
+  mem_root_cache_hits_seen= hits;
+  mem_root_cache_misses_seen= misses;
+}
+
 /*
   Set the priority of the underlying OS thread.
 
@@ -663,6 +663,7 @@ typedef struct system_variables
   my_bool   optimizer_low_limit_heuristic;
   my_bool   optimizer_force_index_for_range;
   my_bool   optimizer_full_scan;
+  my_bool   optimizer_plan_cache;
   sql_mode_t sql_mode; ///< which non-standard SQL behaviour should be enabled
   my_bool   error_partial_strict;
   ulong audit_instrumented_event;
@@ -927,6 +928,10 @@ typedef struct system_status_var
   ulonglong com_stmt_fetch;
   ulonglong com_stmt_reset;
   ulonglong com_stmt_close;
+  ulonglong stmt_plan_cache_hits;
+  ulonglong stmt_plan_cache_misses;
+  ulonglong mem_root_cache_hits;
+  ulonglong mem_root_cache_misses;
   ulonglong read_requests;      /* Number of synchronous read requests */
   ulonglong rows_examined;
   ulonglong rows_sent;
@@ -3664,12 +3669,20 @@ public:
   void adjust_filesort_disk_usage(longlong delta);
   void propagate_pending_global_disk_usage();
 
+  /* Add the use of the thread's MEM_ROOT block cache to status_var. */
+  void update_mem_root_cache_status();
+
 private:
   /* Reporting of session disk usage to global counters is done in batches
      to avoid contention on global variables. */
   longlong unreported_global_tmp_table_delta = 0;
   longlong unreported_global_filesort_delta = 0;
 
+  /* Counters of the MEM_ROOT block cache of the thread, which is shared
+     by the sessions the thread serves, already added to status_var. */
+  ulonglong mem_root_cache_hits_seen = 0;
+  ulonglong mem_root_cache_misses_seen = 0;
+
 public:
   /* local hash map of db opt */
   HASH db_read_only_hash;
@@ -1621,12 +1621,14 @@ int write_record(THD *thd, TABLE *table, COPY_INFO *info, COPY_INFO *update)
     (0) Blind replace is enabled (by setting enable_blind_replace sysvar)
     (1) This is a replace into statement (as identified by DUP_REPLACE)
     (2) The table has a well defined primary key (and no hidden pk)
-    (3) The table has no secondary keys
+    (3) The table has no secondary keys, or the storage engine can maintain
+        them without reading the old row
     (4) The table has no triggers defined
   */
   if (enable_blind_replace &&  /* 0 */
       thd->lex->duplicates == DUP_REPLACE && /* 1 */
-      table->s->keys == 1 && /* 2, 3 */
+      (table->s->keys == 1 || /* 2, 3 */
+       table->file->has_read_free_secondary_keys()) && /* 3 */
       table->s->primary_key != MAX_INDEXES && /* 2 */
       !table->triggers /* 4 */)
   {
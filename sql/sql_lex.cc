@@ -1905,6 +1905,7 @@ void st_select_lex::init_select()
 {
   st_select_lex_node::init_select();
   sj_nests.empty();
+  plan_cache= NULL;
   group_list.empty();
   if (group_list_ptrs)
     group_list_ptrs->clear();
@@ -43,6 +43,7 @@ class sp_pcontext;
 class st_alter_tablespace;
 class partition_info;
 class Event_parse_data;
+class Join_plan_cache;
 class set_var_base;
 class sys_var;
 class Item_func_match;
@@ -751,6 +752,11 @@ public:
   /// List of semi-join nests generated for this query block
   List<TABLE_LIST> sj_nests;
   //Dynamic_array<TABLE_LIST*> sj_nests; psergey-5:
+  /**
+    Join order saved by an execution of a prepared statement, for reuse by
+    the next executions. @see Optimize_table_order::choose_table_order()
+  */
+  Join_plan_cache *plan_cache;
   /*
     Beginning of the list of leaves in a FROM clause, where the leaves
     inlcude all base tables including view tables. The tables are connected
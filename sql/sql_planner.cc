@@ -1151,13 +1151,26 @@ bool Optimize_table_order::choose_table_order()
     join_tables= join->all_table_map & ~join->const_table_map;
   }
 
+  const bool cache_plan= !emb_sjm_nest && !straight_join && can_cache_plan();
+  bool cached_plan= false;
+  if (cache_plan)
+  {
+    cached_plan= use_cached_plan();
+    if (cached_plan)
+      thd->status_var.stmt_plan_cache_hits++;
+    else
+      thd->status_var.stmt_plan_cache_misses++;
+  }
+
   Opt_trace_object wrapper(&join->thd->opt_trace);
+  if (cached_plan)
+    wrapper.add("cached_plan", true);
   Opt_trace_array
     trace_plan(&join->thd->opt_trace, "considered_execution_plans",
                Opt_trace_context::GREEDY_SEARCH);
   if (straight_join)
     optimize_straight_join(join_tables);
-  else
+  else if (!cached_plan)
   {
     if (greedy_search(join_tables))
       DBUG_RETURN(true);
@@ -1171,10 +1184,193 @@ bool Optimize_table_order::choose_table_order()
   if (fix_semijoin_strategies())
     DBUG_RETURN(true);
 
+  if (cache_plan && !cached_plan)
+    save_plan();
+
   DBUG_RETURN(false);
 }
 
 
+/**
+  Check whether the plan of this query block may be cached for the next
+  executions of the statement.
+
+  Only the top-level join of a prepared statement or a stored program
+  statement is cached, whose query block outlives the execution.
+  Semi-join strategies depend on more than the table order, so query
+  blocks with semi-join nests are not cached.
+*/
+
+bool Optimize_table_order::can_cache_plan() const
+{
+  return thd->variables.optimizer_plan_cache &&
+         !thd->stmt_arena->is_conventional() &&
+         join->select_lex->sj_nests.is_empty();
+}
+
+
+/**
+  Whether two row estimates of a table would lead to the same join order.
+  Estimates within a factor of two are considered the same.
+*/
+
+static bool similar_row_estimate(ha_rows rows1, ha_rows rows2)
+{
+  return rows1 / 2 <= rows2 && rows2 / 2 <= rows1;
+}
+
+
+/**
+  Find the first key part of an index in the ref access candidates of a
+  table, as best_access_path() refers to the ref access it chooses.
+
+  @return the first Key_use of the index, or NULL if the table has none
+*/
+
+static Key_use *find_keyuse(const JOIN_TAB *tab, uint key)
+{
+  for (Key_use *keyuse= tab->keyuse;
+       keyuse != NULL && keyuse->table == tab->table;
+       keyuse++)
+  {
+    if (keyuse->key == key)
+      return keyuse;
+  }
+  return NULL;
+}
+
+
+/**
+  Set up the plan of the non-constant tables of the join as saved by a
+  previous execution, if the saved plan is still valid for this execution.
+  The tables are put in the saved order and each gets the saved access
+  path, so neither the join order nor the access method of any table is
+  searched for.
+
+  @return true if join->best_positions holds the cached plan, false if
+          the plan must be searched for
+*/
+
+bool Optimize_table_order::use_cached_plan()
+{
+  const Join_plan_cache *const cache= join->select_lex->plan_cache;
+  DBUG_ENTER("Optimize_table_order::use_cached_plan");
+
+  if (cache == NULL ||
+      cache->const_table_map != join->const_table_map ||
+      cache->table_count != join->tables - join->const_tables)
+    DBUG_RETURN(false);
+
+  JOIN_TAB **const best_ref= join->best_ref + join->const_tables;
+  JOIN_TAB **const order=
+    (JOIN_TAB **) thd->alloc(sizeof(JOIN_TAB *) * cache->table_count);
+  Key_use **const keys=
+    (Key_use **) thd->alloc(sizeof(Key_use *) * cache->table_count);
+  if (order == NULL || keys == NULL)
+    DBUG_RETURN(false);
+
+  for (uint i= 0; i < cache->table_count; i++)
+  {
+    const Join_plan_cache::Table *const cached= cache->tables + i;
+    JOIN_TAB *tab= NULL;
+
+    for (uint j= 0; j < cache->table_count; j++)
+    {
+      if (best_ref[j]->table->pos_in_table_list == cached->table_ref)
+      {
+        tab= best_ref[j];
+        break;
+      }
+    }
+
+    if (tab == NULL ||
+        tab->table->s->get_table_ref_version() != cached->table_version ||
+        tab->table->s->stats_version != cached->stats_version ||
+        !(tab->table->quick_keys == cached->quick_keys) ||
+        !similar_row_estimate(tab->found_records, cached->found_records))
+      DBUG_RETURN(false);
+
+    /*
+      The ref access candidates are built anew for every execution, from
+      the same conditions. Point the saved access path to the new ones.
+    */
+    keys[i]= NULL;
+    if (cached->key != MAX_KEY &&
+        (keys[i]= find_keyuse(tab, cached->key)) == NULL)
+      DBUG_RETURN(false);
+
+    order[i]= tab;
+  }
+
+  memcpy(best_ref, order, sizeof(JOIN_TAB *) * cache->table_count);
+
+  for (uint i= 0; i < cache->table_count; i++)
+  {
+    POSITION *const position= join->positions + join->const_tables + i;
+
+    *position= cache->tables[i].position;
+    position->table= order[i];
+    position->key= keys[i];
+  }
+
+  memcpy(join->best_positions + join->const_tables,
+         join->positions + join->const_tables,
+         sizeof(POSITION) * cache->table_count);
+  join->best_read= cache->best_read;
+  join->best_rowcount= cache->best_rowcount;
+  DBUG_RETURN(true);
+}
+
+
+/**
+  Save the join order and the access paths found by the search, so that
+  the next executions of the statement can reuse them. The cache lives on
+  the statement memory root, like the query block that points to it.
+*/
+
+void Optimize_table_order::save_plan()
+{
+  Join_plan_cache *cache= join->select_lex->plan_cache;
+  DBUG_ENTER("Optimize_table_order::save_plan");
+
+  if (cache == NULL)
+  {
+    MEM_ROOT *const mem_root= thd->stmt_arena->mem_root;
+    cache= new (mem_root) Join_plan_cache;
+    if (cache == NULL)
+      DBUG_VOID_RETURN;
+    cache->tables= (Join_plan_cache::Table *)
+      alloc_root(mem_root, sizeof(Join_plan_cache::Table) * join->tables);
+    if (cache->tables == NULL)
+      DBUG_VOID_RETURN;
+    join->select_lex->plan_cache= cache;
+  }
+
+  cache->const_table_map= join->const_table_map;
+  cache->table_count= join->tables - join->const_tables;
+  cache->best_read= join->best_read;
+  cache->best_rowcount= join->best_rowcount;
+
+  for (uint i= 0; i < cache->table_count; i++)
+  {
+    const POSITION *const position=
+      join->best_positions + join->const_tables + i;
+    const JOIN_TAB *const tab= position->table;
+    Join_plan_cache::Table *const cached= cache->tables + i;
+
+    cached->table_ref= tab->table->pos_in_table_list;
+    cached->table_version= tab->table->s->get_table_ref_version();
+    cached->stats_version= tab->table->s->stats_version;
+    cached->quick_keys= tab->table->quick_keys;
+    cached->found_records= tab->found_records;
+    cached->position= *position;
+    cached->key= position->key ? position->key->key : MAX_KEY;
+  }
+
+  DBUG_VOID_RETURN;
+}
+
+
 /**
   Heuristic procedure to automatically guess a reasonable degree of
   exhaustiveness for the greedy search procedure.
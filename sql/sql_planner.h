@@ -25,6 +25,43 @@
 
 class Opt_trace_object;
 
+/**
+  Plan chosen for a query block of a prepared statement: the join order
+  and the access path of each table.
+
+  Later executions of the statement take the non-constant tables in the
+  same order with the same access paths, instead of searching for the best
+  join order and the best access method of each table again. The plan is
+  reused as long as the same tables are constant, no table has been altered
+  or analyzed, and range analysis finds the same usable indexes with
+  similar row estimates for every table, that is, the parameter values hit
+  the same index ranges.
+*/
+class Join_plan_cache : public Sql_alloc
+{
+public:
+  struct Table
+  {
+    TABLE_LIST *table_ref;   ///< Table in this position of the join order
+    ulonglong table_version; ///< TABLE_SHARE::get_table_ref_version()
+    int64 stats_version;     ///< TABLE_SHARE::stats_version
+    key_map quick_keys;      ///< Indexes usable for range access
+    ha_rows found_records;   ///< Rows estimated by range analysis
+    /**
+      Access path chosen for the table. Its table and key point to objects
+      of the execution that saved it, and are set again on reuse.
+    */
+    POSITION position;
+    uint key;                ///< Index of the ref access, or MAX_KEY
+  };
+
+  table_map const_table_map; ///< Tables that were found to be constant
+  uint table_count;          ///< Number of non-constant tables
+  double best_read;          ///< Cost of the plan
+  ha_rows best_rowcount;     ///< Rows estimated for the plan
+  Table *tables;             ///< Non-constant tables in join order
+};
+
 /**
   This class determines the optimal join order for tables within
   a basic query block, ie a query specification clause, possibly extended
@@ -101,6 +138,9 @@ private:
   void backout_nj_state(const table_map remaining_tables,
                         const JOIN_TAB *tab);
   void optimize_straight_join(table_map join_tables);
+  bool can_cache_plan() const;
+  bool use_cached_plan();
+  void save_plan();
   bool greedy_search(table_map remaining_tables);
   bool best_extension_by_limited_search(table_map remaining_tables,
                                         uint idx,
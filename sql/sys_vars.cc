@@ -1126,6 +1126,33 @@ static Sys_var_mybool Sys_binlog_order_commits(
        GLOBAL_VAR(opt_binlog_order_commits),
        CMD_LINE(OPT_ARG), DEFAULT(TRUE));
 
+static Sys_var_ulong Sys_binlog_group_commit_sync_delay(
+       "binlog_group_commit_sync_delay",
+       "The number of microseconds the server waits for more transactions "
+       "to join a binary log group commit before it is written and synced. "
+       "With binlog_group_commit_adaptive_delay this is the upper bound of "
+       "the delay.",
+       GLOBAL_VAR(opt_binlog_group_commit_sync_delay),
+       CMD_LINE(REQUIRED_ARG), VALID_RANGE(0, 1000000), DEFAULT(0),
+       BLOCK_SIZE(1));
+
+static Sys_var_ulong Sys_binlog_group_commit_sync_no_delay_count(
+       "binlog_group_commit_sync_no_delay_count",
+       "If there are this many transactions in a binary log group commit, "
+       "the server stops waiting for more. 0 means no limit.",
+       GLOBAL_VAR(opt_binlog_group_commit_sync_no_delay_count),
+       CMD_LINE(REQUIRED_ARG), VALID_RANGE(0, 100000), DEFAULT(0),
+       BLOCK_SIZE(1));
+
+static Sys_var_mybool Sys_binlog_group_commit_adaptive_delay(
+       "binlog_group_commit_adaptive_delay",
+       "Choose the delay of binary log group commits from the observed "
+       "transaction arrival rate and binlog fsync time, up to "
+       "binlog_group_commit_sync_delay microseconds. Only used when "
+       "sync_binlog is 1.",
+       GLOBAL_VAR(opt_binlog_group_commit_adaptive_delay),
+       CMD_LINE(OPT_ARG), DEFAULT(FALSE));
+
 #ifdef HAVE_REPLICATION
 static Sys_var_mybool Sys_reset_seconds_behind_master(
        "reset_seconds_behind_master",
@@ -1161,6 +1188,15 @@ static Sys_var_charptr Sys_histogram_step_size_binlog_fsync(
        IN_FS_CHARSET, DEFAULT("16ms"), NO_MUTEX_GUARD, NOT_IN_BINLOG,
        ON_CHECK(check_histogram_step_size_syntax));
 
+static Sys_var_charptr Sys_histogram_step_size_binlog_commit_stages(
+       "histogram_step_size_binlog_commit_stages", "Step size of the "
+       "Histograms which are used to track the wait and processing times of "
+       "the binlog group commit stages.",
+       READ_ONLY GLOBAL_VAR(histogram_step_size_binlog_commit_stages),
+       CMD_LINE(REQUIRED_ARG), IN_FS_CHARSET, DEFAULT("64us"),
+       NO_MUTEX_GUARD, NOT_IN_BINLOG,
+       ON_CHECK(check_histogram_step_size_syntax));
+
 static bool update_thread_priority_str(sys_var *self, THD *thd,
                                        set_var *var)
 {
@@ -2542,6 +2578,15 @@ static Sys_var_ulong Sys_max_write_lock_count(
        GLOBAL_VAR(max_write_lock_count), CMD_LINE(REQUIRED_ARG),
        VALID_RANGE(1, ULONG_MAX), DEFAULT(ULONG_MAX), BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_mem_root_cache_size(
+       "mem_root_cache_size",
+       "Size of the cache of freed memory root blocks that each thread "
+       "keeps to reuse in its next statements (0 = no cache). The limit "
+       "is per thread, and Mem_root_cache_bytes shows the size kept by "
+       "all threads",
+       GLOBAL_VAR(my_mem_root_cache_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 16*1024*1024), DEFAULT(0), BLOCK_SIZE(1024));
+
 static Sys_var_ulong Sys_min_examined_row_limit(
        "min_examined_row_limit",
        "Don't write queries to slow log that examine fewer rows "
@@ -2761,6 +2806,15 @@ static Sys_var_mybool Sys_optimizer_full_scan(
       SESSION_VAR(optimizer_full_scan),
       CMD_LINE(OPT_ARG), DEFAULT(TRUE));
 
+static Sys_var_mybool Sys_optimizer_plan_cache(
+      "optimizer_plan_cache",
+      "If enabled, executions of a prepared statement reuse the join order "
+      "and the access paths chosen by the previous execution, as long as the "
+      "tables, their statistics and the index ranges hit by the parameters "
+      "are the same.",
+      SESSION_VAR(optimizer_plan_cache),
+      CMD_LINE(OPT_ARG), DEFAULT(FALSE));
+
 static const char *optimizer_switch_names[]=
 {
   "index_merge", "index_merge_union", "index_merge_sort_union",
@@ -3646,6 +3700,16 @@ static Sys_var_mybool Sys_slave_sql_verify_checksum(
        "log. Enabled by default.",
        GLOBAL_VAR(opt_slave_sql_verify_checksum), CMD_LINE(OPT_ARG), DEFAULT(TRUE));
 
+static Sys_var_ulonglong Sys_slave_relay_log_ring_size(
+       "slave_relay_log_ring_size",
+       "Size in bytes of the in-memory copy of the most recent events the "
+       "slave I/O thread has written to the relay log. The slave SQL thread "
+       "takes events from it instead of reading them back from the relay "
+       "log, and reads the relay log only when it falls behind. 0 disables "
+       "it.",
+       GLOBAL_VAR(opt_slave_relay_log_ring_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 1024 * 1024 * 1024), DEFAULT(0), BLOCK_SIZE(1));
+
 static const char *slave_check_before_image_consistency_names[]= {"OFF",
                                                                   "COUNT",
                                                                   "ON", 0};
@@ -5278,6 +5342,13 @@ static Sys_var_ulong Sys_rpl_read_size(
        VALID_RANGE(IO_SIZE * 2, ULONG_MAX), DEFAULT(IO_SIZE * 2),
        BLOCK_SIZE(IO_SIZE));
 
+static Sys_var_mybool Sys_rpl_read_ahead(
+       "rpl_read_ahead",
+       "Read the next rpl_read_size block of a binlog or relay log in the "
+       "background while binlog dump threads and the slave SQL thread "
+       "process the current one. Takes effect when a log file is opened.",
+       GLOBAL_VAR(rpl_read_ahead), CMD_LINE(OPT_ARG), DEFAULT(FALSE));
+
 static Sys_var_ulong Sys_rpl_event_buffer_size(
        "rpl_event_buffer_size",
        "The size of the preallocated event buffer for slave connections that "
@@ -808,6 +808,13 @@ struct TABLE_SHARE
   bool is_view;
   Table_id table_map_id;                   /* for row-based replication */
 
+  /*
+    Incremented by ANALYZE TABLE, so that plans cached for prepared
+    statements are not reused with the old statistics. ANALYZE does not
+    always evict the share, which would change table_map_id.
+  */
+  volatile int64 stats_version;
+
   /*
     Cache for row-based replication table share checks that does not
     need to be repeated. Possible values are: -1 when cache value is
@@ -2038,7 +2038,8 @@ btr_page_reorganize(
 	dict_index_t*	index,	/*!< in: the index tree of the page */
 	mtr_t*		mtr)	/*!< in/out: mini-transaction */
 {
-	return(btr_page_reorganize_low(false, page_zip_compression_flags,
+	return(btr_page_reorganize_low(false,
+				       page_zip_compression_flags_for(index),
 				       cursor, index, mtr));
 }
 #endif /* !UNIV_HOTBACKUP */
@@ -5102,7 +5103,8 @@ btr_can_merge_with_page(
 		/* We have to reorganize mpage */
 
 		if (!btr_page_reorganize_block(
-			    false, page_zip_level, mblock, index, mtr)) {
+			    false, page_zip_compression_flags_for(index),
+			    mblock, index, mtr)) {
 
 			goto error;
 		}
@@ -3867,6 +3867,153 @@ btr_estimate_n_rows_in_range(
 	}
 }
 
+/*******************************************************************//**
+Splits an index tree into key ranges for a parallel scan. The range
+boundaries are node pointers of the highest non-leaf level that has at
+least n_parts records, so that every range covers whole subtrees of
+that level and the ranges are of roughly equal size.
+@return number of ranges, at least 1 and at most n_parts; range i
+starts at bounds[i - 1] (the low end of the index for i = 0) and ends
+before bounds[i] (the high end of the index for the last range) */
+UNIV_INTERN
+ulint
+btr_cur_partition_index(
+/*====================*/
+	dict_index_t*	index,	/*!< in: index */
+	ulint		n_parts,/*!< in: desired number of ranges */
+	dtuple_t**	bounds,	/*!< out: n_parts - 1 range boundaries,
+				allocated from heap */
+	mem_heap_t*	heap)	/*!< in/out: memory heap */
+{
+	mtr_t		mtr;
+	ulint		space;
+	ulint		zip_size;
+	ulint		level;
+	ulint		n_recs;
+	ulint		n_pages;
+	ulint		n_bounds;
+	ulint		pos;
+	ulint		i;
+	buf_block_t*	block;
+	buf_block_t**	blocks;
+	mem_heap_t*	offsets_heap	= NULL;
+	ulint		offsets_[REC_OFFS_NORMAL_SIZE];
+	ulint*		offsets		= offsets_;
+	rec_offs_init(offsets_);
+
+	if (n_parts < 2) {
+		return(1);
+	}
+
+	space = dict_index_get_space(index);
+	zip_size = dict_table_zip_size(index->table);
+
+	/* The pages of the chosen level are all latched at the same
+	time. The level above it has fewer than n_parts records, so the
+	chosen level cannot have more than n_parts pages. */
+	blocks = static_cast<buf_block_t**>(
+		mem_heap_alloc(heap, n_parts * sizeof *blocks));
+
+	mtr_start(&mtr);
+
+	/* The S-latch on the index tree keeps the non-leaf levels from
+	being split or merged while we look at them. */
+	mtr_s_lock(dict_index_get_lock(index), &mtr);
+
+	block = btr_block_get(space, zip_size, dict_index_get_page(index),
+			      RW_S_LATCH, index, &mtr);
+	level = btr_page_get_level(buf_block_get_frame(block), &mtr);
+
+	for (;;) {
+		ulint		page_no;
+		const rec_t*	rec;
+
+		n_recs = 0;
+		n_pages = 0;
+
+		/* block is the leftmost page of the level */
+		for (;;) {
+			const page_t*	page = buf_block_get_frame(block);
+
+			blocks[n_pages++] = block;
+			n_recs += page_get_n_recs(page);
+
+			page_no = btr_page_get_next(page, &mtr);
+
+			if (page_no == FIL_NULL || n_pages == n_parts) {
+				break;
+			}
+
+			block = btr_block_get(space, zip_size, page_no,
+					      RW_S_LATCH, index, &mtr);
+		}
+
+		if (level == 0) {
+			/* The tree consists of the root page only. */
+			mtr_commit(&mtr);
+			return(1);
+		}
+
+		if (n_recs >= n_parts || level == 1) {
+			break;
+		}
+
+		/* Descend to the leftmost page of the next level. */
+		rec = page_rec_get_next_const(
+			page_get_infimum_rec(buf_block_get_frame(blocks[0])));
+
+		offsets = rec_get_offsets(rec, index, offsets,
+					  ULINT_UNDEFINED, &offsets_heap);
+
+		block = btr_block_get(space, zip_size,
+				      btr_node_ptr_get_child_page_no(
+					      rec, offsets),
+				      RW_S_LATCH, index, &mtr);
+		level--;
+	}
+
+	if (n_recs < n_parts) {
+		n_parts = n_recs;
+	}
+
+	/* Pick n_parts - 1 evenly spaced node pointers. The first node
+	pointer of a level carries the minimum record flag and is never
+	a boundary. */
+	n_bounds = 0;
+	pos = 0;
+
+	for (i = 0; i < n_pages && n_bounds + 1 < n_parts; i++) {
+		const page_t*	page = buf_block_get_frame(blocks[i]);
+		rec_t*		rec = page_rec_get_next(
+			page_get_infimum_rec(const_cast<page_t*>(page)));
+
+		for (; !page_rec_is_supremum(rec);
+		     rec = page_rec_get_next(rec), pos++) {
+
+			if (pos != (n_bounds + 1) * n_recs / n_parts) {
+				continue;
+			}
+
+			bounds[n_bounds] = dict_index_build_data_tuple(
+				index, rec,
+				dict_index_get_n_unique_in_tree(index), heap);
+			dtuple_set_info_bits(bounds[n_bounds], 0);
+
+			if (++n_bounds + 1 == n_parts) {
+				break;
+			}
+		}
+	}
+
+	mtr_commit(&mtr);
+
+	if (offsets_heap != NULL) {
+		mem_heap_free(offsets_heap);
+	}
+
+	return(n_bounds + 1);
+}
+
 /*******************************************************************//**
 Record the number of non_null key values in a given index for
 each n-column prefix of the index where 1 <= n <= dict_index_get_n_unique(index).
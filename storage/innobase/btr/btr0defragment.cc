@@ -406,9 +406,9 @@ btr_defragment_merge_pages(
 	// reorganizing the page, otherwise we need to reorganize the page
 	// first to release more space.
 	if (move_size > max_ins_size) {
-		if (!btr_page_reorganize_block(false, page_zip_level,
-					       to_block, index,
-					       mtr)) {
+		if (!btr_page_reorganize_block(
+			    false, page_zip_compression_flags_for(index),
+			    to_block, index, mtr)) {
 			if (!dict_index_is_clust(index)
 			    && page_is_leaf(to_page)) {
 				ibuf_reset_free_bits(to_block);
@@ -30,8 +30,10 @@ Created April 08, 2011 Vasil Dimov
 
 #include "buf0buf.h" /* buf_pool_mutex_enter(), srv_buf_pool_instances */
 #include "buf0dump.h"
+#include "buf0rea.h" /* buf_read_page_async(), buf_read_pages_async() */
 #include "db0err.h"
 #include "dict0dict.h" /* dict_operation_lock */
+#include "fsp0types.h" /* FSP_EXTENT_SIZE */
 #include "os0file.h" /* OS_FILE_MAX_PATH */
 #include "os0sync.h" /* os_event* */
 #include "os0thread.h" /* os_thread_* */
@@ -68,6 +70,11 @@ typedef ib_uint64_t	buf_dump_t;
 #define BUF_DUMP_SPACE(a)		((ulint) ((a) >> 32))
 #define BUF_DUMP_PAGE(a)		((ulint) ((a) & 0xFFFFFFFFUL))
 
+/* Number of parts a load with innodb_buffer_pool_load_fast splits the dump
+into. The dump is in LRU order, so the first part holds the hottest pages.
+Each part is sorted on its own to get sequential IO within it. */
+static const ulint	BUF_LOAD_N_PARTS = 16;
+
 /*****************************************************************//**
 Wakes up the buffer pool dump/load thread and instructs it to start
 a dump. This function is called by MySQL code via buffer_pool_dump_now()
@@ -186,12 +193,34 @@ get_buf_dump_dir()
 	return(dump_dir);
 }
 
+/*****************************************************************//**
+Frees the per buffer pool instance arrays collected by buf_dump(). */
+static
+void
+buf_dump_free(
+/*==========*/
+	buf_dump_t**	dumps)	/*!< in/out: one array or NULL per
+				buffer pool instance */
+{
+	ulint	i;
+
+	for (i = 0; i < srv_buf_pool_instances; i++) {
+		if (dumps[i] != NULL) {
+			ut_free(dumps[i]);
+			dumps[i] = NULL;
+		}
+	}
+}
+
 /*****************************************************************//**
 Perform a buffer pool dump into the file specified by
 innodb_buffer_pool_filename. If any errors occur then the value of
 innodb_buffer_pool_dump_status will be set accordingly, see buf_dump_status().
 The dump filename can be specified by (relative to srv_data_home):
-SET GLOBAL innodb_buffer_pool_filename='filename'; */
+SET GLOBAL innodb_buffer_pool_filename='filename';
+The pages of all buffer pool instances are written interleaved by their
+LRU position, so that the most recently used pages of every instance come
+first in the file. */
 static
 void
 buf_dump(
@@ -201,12 +230,18 @@ buf_dump(
 {
 #define SHOULD_QUIT()	(SHUTTING_DOWN() && obey_shutdown)
 
-	char	full_filename[OS_FILE_MAX_PATH];
-	char	tmp_filename[OS_FILE_MAX_PATH];
-	char	now[32];
-	FILE*	f;
-	ulint	i;
-	int	ret;
+	char		full_filename[OS_FILE_MAX_PATH];
+	char		tmp_filename[OS_FILE_MAX_PATH];
+	char		now[32];
+	FILE*		f;
+	buf_dump_t*	dumps[MAX_BUFFER_POOLS];
+	ulint		dumps_n[MAX_BUFFER_POOLS];
+	ulint		n_total;
+	ulint		n_max;
+	ulint		n_written;
+	ulint		i;
+	ulint		j;
+	int		ret;
 
 	ut_snprintf(full_filename, sizeof(full_filename),
 		    "%s%c%s", get_buf_dump_dir(), SRV_PATH_SEPARATOR,
@@ -227,13 +262,17 @@ buf_dump(
 	}
 	/* else */
 
+	memset(dumps, 0, sizeof(dumps));
+	memset(dumps_n, 0, sizeof(dumps_n));
+	n_total = 0;
+	n_max = 0;
+
 	/* walk through each buffer pool */
 	for (i = 0; i < srv_buf_pool_instances && !SHOULD_QUIT(); i++) {
 		buf_pool_t*		buf_pool;
 		const buf_page_t*	bpage;
 		buf_dump_t*		dump;
 		ulint			n_pages;
-		ulint			j;
 
 		buf_pool = buf_pool_from_array(i);
 
@@ -264,6 +303,7 @@ buf_dump(
 
 		if (dump == NULL) {
 			buf_pool_mutex_exit(buf_pool);
+			buf_dump_free(dumps);
 			fclose(f);
 			buf_dump_status(STATUS_ERR,
 					"Cannot allocate " ULINTPF " bytes: %s",
@@ -287,12 +327,26 @@ buf_dump(
 
 		buf_pool_mutex_exit(buf_pool);
 
-		for (j = 0; j < n_pages && !SHOULD_QUIT(); j++) {
+		dumps[i] = dump;
+		dumps_n[i] = n_pages;
+		n_total += n_pages;
+		n_max = ut_max(n_max, n_pages);
+	}
+
+	/* Write the j-th most recently used page of every instance before
+	the (j+1)-th of any, so that the file as a whole is in LRU order. */
+	n_written = 0;
+	for (j = 0; j < n_max && !SHOULD_QUIT(); j++) {
+		for (i = 0; i < srv_buf_pool_instances; i++) {
+			if (j >= dumps_n[i]) {
+				continue;
+			}
+
 			ret = fprintf(f, ULINTPF "," ULINTPF "\n",
-				      BUF_DUMP_SPACE(dump[j]),
-				      BUF_DUMP_PAGE(dump[j]));
+				      BUF_DUMP_SPACE(dumps[i][j]),
+				      BUF_DUMP_PAGE(dumps[i][j]));
 			if (ret < 0) {
-				ut_free(dump);
+				buf_dump_free(dumps);
 				fclose(f);
 				buf_dump_status(STATUS_ERR,
 						"Cannot write to '%s': %s",
@@ -301,20 +355,20 @@ buf_dump(
 				return;
 			}
 
-			if (j % 128 == 0) {
+			if (n_written % 128 == 0) {
 				buf_dump_status(
 					STATUS_INFO,
-					"Dumping buffer pool "
-					ULINTPF "/" ULINTPF ", "
+					"Dumping buffer pool(s), "
 					"page " ULINTPF "/" ULINTPF,
-					i + 1, srv_buf_pool_instances,
-					j + 1, n_pages);
+					n_written + 1, n_total);
 			}
-		}
 
-		ut_free(dump);
+			n_written++;
+		}
 	}
 
+	buf_dump_free(dumps);
+
 	ret = fclose(f);
 	if (ret != 0) {
 		buf_dump_status(STATUS_ERR,
@@ -389,12 +443,225 @@ buf_dump_sort(
 			      buf_dump_cmp);
 }
 
+/*****************************************************************//**
+Reads the entries of a buffer pool dump file in a single pass. The file is
+read in large blocks and parsed in memory, which is much faster than
+fscanf() for the dump of a big buffer pool. Entries beyond dump_max are
+ignored. If an error occurs then innodb_buffer_pool_load_status is set
+accordingly.
+@return number of entries stored in dump, or ULINT_UNDEFINED on error */
+static
+ulint
+buf_load_read_file(
+/*===============*/
+	FILE*		f,		/*!< in: dump file */
+	const char*	filename,	/*!< in: name of the dump file */
+	buf_dump_t*	dump,		/*!< out: dump entries */
+	ulint		dump_max)	/*!< in: size of the dump array */
+{
+	static const ulint	BLOCK_SIZE = 1024 * 1024;
+	char*		block;
+	ulint		dump_n = 0;
+	ulint		line = 1;
+	ulint		value[2] = {0, 0};
+	ulint		field = 0;
+	/* 0: no digits yet, 1: in a number, 2: after a number */
+	ulint		state = 0;
+	size_t		len;
+
+	block = static_cast<char*>(ut_malloc(BLOCK_SIZE));
+
+	if (block == NULL) {
+		buf_load_status(STATUS_ERR,
+				"Cannot allocate " ULINTPF " bytes: %s",
+				BLOCK_SIZE, strerror(errno));
+		return(ULINT_UNDEFINED);
+	}
+
+	do {
+		len = fread(block, 1, BLOCK_SIZE, f);
+
+		if (len < BLOCK_SIZE && ferror(f)) {
+			ut_free(block);
+			buf_load_status(STATUS_ERR, "Error reading '%s', "
+					"unable to load buffer pool",
+					filename);
+			return(ULINT_UNDEFINED);
+		}
+
+		/* Run one step past the end of the file to finish a last
+		line that has no newline. */
+		for (size_t i = 0; i < len || (len < BLOCK_SIZE && i == len);
+		     i++) {
+			char	c = (i < len) ? block[i] : '\n';
+
+			switch (c) {
+			case '0': case '1': case '2': case '3': case '4':
+			case '5': case '6': case '7': case '8': case '9':
+				if (state == 2) {
+					goto parse_error;
+				}
+				state = 1;
+				/* Stop growing a bogus value, it is
+				reported at the end of the line */
+				if (value[field] <= ULINT32_MASK) {
+					value[field] = value[field] * 10
+						+ (c - '0');
+				}
+				continue;
+			case ',':
+				if (field != 0 || state == 0) {
+					goto parse_error;
+				}
+				field = 1;
+				state = 0;
+				continue;
+			case ' ': case '\t': case '\r':
+				if (state == 1) {
+					state = 2;
+				}
+				continue;
+			case '\n':
+				break;
+			default:
+				goto parse_error;
+			}
+
+			/* End of a line */
+			if (field == 0 && state == 0) {
+				/* empty line */
+				line++;
+				continue;
+			}
+
+			if (field == 0 || state == 0) {
+				goto parse_error;
+			}
+
+			if (value[0] > ULINT32_MASK
+			    || value[1] > ULINT32_MASK) {
+				ut_free(block);
+				buf_load_status(STATUS_ERR,
+						"Error parsing '%s': bogus "
+						"space,page " ULINTPF ","
+						ULINTPF " at line " ULINTPF
+						", unable to load buffer pool",
+						filename, value[0], value[1],
+						line);
+				return(ULINT_UNDEFINED);
+			}
+
+			dump[dump_n++] = BUF_DUMP_CREATE(value[0], value[1]);
+
+			if (dump_n == dump_max) {
+				/* The dump is larger than the buffer
+				pool(s), ignore the rest of it */
+				ut_free(block);
+				return(dump_n);
+			}
+
+			line++;
+			value[0] = value[1] = 0;
+			field = 0;
+			state = 0;
+		}
+	} while (len == BLOCK_SIZE && !SHUTTING_DOWN());
+
+	ut_free(block);
+	return(dump_n);
+
+parse_error:
+	ut_free(block);
+	buf_load_status(STATUS_ERR, "Error parsing '%s' at line " ULINTPF
+			", unable to load buffer pool", filename, line);
+	return(ULINT_UNDEFINED);
+}
+
+/*****************************************************************//**
+Computes the read rate of a buffer pool load.
+@return MB read per second */
+static
+double
+buf_load_mb_per_sec(
+/*================*/
+	ulint	n_pages,	/*!< in: number of pages read */
+	ullint	elapsed_us)	/*!< in: time taken */
+{
+	if (elapsed_us == 0) {
+		return(0);
+	}
+
+	return((double) n_pages * UNIV_PAGE_SIZE * 1000000
+	       / (1024 * 1024) / elapsed_us);
+}
+
+/*****************************************************************//**
+Reads the pages of a sorted buffer pool dump into the buffer pool, one
+extent of a tablespace at a time. All pages of an extent are queued and
+submitted to the i/o handler threads as one batch, see
+buf_read_pages_async(). Progress and the read rate are reported in
+innodb_buffer_pool_load_status.
+@return number of pages read, or ULINT_UNDEFINED if the load was aborted */
+static
+ulint
+buf_load_extents(
+/*=============*/
+	const buf_dump_t*	dump,		/*!< in: dump entries, each
+						part sorted on
+						space_no, page_no */
+	ulint			dump_n,		/*!< in: number of entries */
+	ullint			start_us)	/*!< in: when the load
+						started */
+{
+	/* Room for the pages of the largest extent in pages */
+	ulint	page_nos[FSP_EXTENT_SIZE_MIN];
+	ulint	n_read = 0;
+	ulint	next_report = 0;
+	ulint	i = 0;
+
+	while (i < dump_n && !SHUTTING_DOWN()) {
+		ulint	space = BUF_DUMP_SPACE(dump[i]);
+		ulint	extent = BUF_DUMP_PAGE(dump[i]) / FSP_EXTENT_SIZE;
+		ulint	n = 0;
+
+		do {
+			page_nos[n++] = BUF_DUMP_PAGE(dump[i++]);
+		} while (i < dump_n && n < FSP_EXTENT_SIZE
+			 && BUF_DUMP_SPACE(dump[i]) == space
+			 && BUF_DUMP_PAGE(dump[i]) / FSP_EXTENT_SIZE
+			 == extent);
+
+		n_read += buf_read_pages_async(space, page_nos, n);
+
+		if (i >= next_report) {
+			ullint	elapsed_us = ut_time_us(NULL) - start_us;
+
+			buf_load_status(STATUS_INFO,
+					"Loaded " ULINTPF "/" ULINTPF
+					" pages, %.1f MB/s",
+					i, dump_n,
+					buf_load_mb_per_sec(n_read,
+							    elapsed_us));
+			next_report = i + 1024;
+		}
+
+		if (buf_load_abort_flag) {
+			return(ULINT_UNDEFINED);
+		}
+	}
+
+	return(n_read);
+}
+
 /*****************************************************************//**
 Perform a buffer pool load from the file specified by
 innodb_buffer_pool_filename. If any errors occur then the value of
 innodb_buffer_pool_load_status will be set accordingly, see buf_load_status().
 The dump filename can be specified by (relative to srv_data_home):
-SET GLOBAL innodb_buffer_pool_filename='filename'; */
+SET GLOBAL innodb_buffer_pool_filename='filename';
+With innodb_buffer_pool_load_fast the dump is split into parts in file
+order, hottest pages first, and each part is sorted and read an extent
+at a time, see buf_load_extents(). */
 static
 void
 buf_load()
@@ -407,10 +674,9 @@ buf_load()
 	buf_dump_t*	dump_tmp;
 	ulint		dump_n;
 	ulint		total_buffer_pools_pages;
+	long		file_size;
 	ulint		i;
-	ulint		space_id;
-	ulint		page_no;
-	int		fscanf_ret;
+	ullint		start_us;
 
 	/* Ignore any leftovers from before */
 	buf_load_abort_flag = FALSE;
@@ -422,6 +688,8 @@ buf_load()
 	buf_load_status(STATUS_NOTICE,
 			"Loading buffer pool(s) from %s", full_filename);
 
+	start_us = ut_time_us(NULL);
+
 	f = fopen(full_filename, "r");
 	if (f == NULL) {
 		buf_load_status(STATUS_ERR,
@@ -431,33 +699,21 @@ buf_load()
 	}
 	/* else */
 
-	/* First scan the file to estimate how many entries are in it.
-	This file is tiny (approx 500KB per 1GB buffer pool), reading it
-	two times is fine. */
-	dump_n = 0;
-	while (fscanf(f, ULINTPF "," ULINTPF, &space_id, &page_no) == 2
-	       && !SHUTTING_DOWN()) {
-		dump_n++;
-	}
-
-	if (!SHUTTING_DOWN() && !feof(f)) {
-		/* fscanf() returned != 2 */
-		const char*	what;
-		if (ferror(f)) {
-			what = "reading";
-		} else {
-			what = "parsing";
-		}
+	if (fseek(f, 0, SEEK_END) != 0
+	    || (file_size = ftell(f)) < 0
+	    || fseek(f, 0, SEEK_SET) != 0) {
 		fclose(f);
-		buf_load_status(STATUS_ERR, "Error %s '%s', "
-				"unable to load buffer pool (stage 1)",
-				what, full_filename);
+		buf_load_status(STATUS_ERR, "Error reading '%s', "
+				"unable to load buffer pool",
+				full_filename);
 		return;
 	}
 
-	/* If dump is larger than the buffer pool(s), then we ignore the
-	extra trailing. This could happen if a dump is made, then buffer
-	pool is shrunk and then load it attempted. */
+	/* The shortest entry is "0,0\n". If dump is larger than the buffer
+	pool(s), then we ignore the extra trailing. This could happen if a
+	dump is made, then buffer pool is shrunk and then load it
+	attempted. */
+	dump_n = (ulint) file_size / 4 + 1;
 	total_buffer_pools_pages = buf_pool_get_n_pages()
 		* srv_buf_pool_instances;
 	if (dump_n > total_buffer_pools_pages) {
@@ -475,12 +731,29 @@ buf_load()
 		return;
 	}
 
+	dump_n = buf_load_read_file(f, full_filename, dump, dump_n);
+
+	fclose(f);
+
+	if (dump_n == ULINT_UNDEFINED) {
+		ut_free(dump);
+		return;
+	}
+
+	if (dump_n == 0) {
+		ut_free(dump);
+		ut_sprintf_timestamp(now);
+		buf_load_status(STATUS_NOTICE,
+				"Buffer pool(s) load completed at %s "
+				"(%s was empty)", now, full_filename);
+		return;
+	}
+
 	dump_tmp = static_cast<buf_dump_t*>(
 		ut_malloc(dump_n * sizeof(*dump_tmp)));
 
 	if (dump_tmp == NULL) {
 		ut_free(dump);
-		fclose(f);
 		buf_load_status(STATUS_ERR,
 				"Cannot allocate " ULINTPF " bytes: %s",
 				(ulint) (dump_n * sizeof(*dump_tmp)),
@@ -488,59 +761,37 @@ buf_load()
 		return;
 	}
 
-	rewind(f);
-
-	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
-		fscanf_ret = fscanf(f, ULINTPF "," ULINTPF,
-				    &space_id, &page_no);
-
-		if (fscanf_ret != 2) {
-			if (feof(f)) {
-				break;
-			}
-			/* else */
+	if (srv_buffer_pool_load_fast) {
+		ulint	part_size = ut_max(dump_n / BUF_LOAD_N_PARTS, 1);
+		ulint	n_read;
 
-			ut_free(dump);
-			ut_free(dump_tmp);
-			fclose(f);
-			buf_load_status(STATUS_ERR,
-					"Error parsing '%s', unable "
-					"to load buffer pool (stage 2)",
-					full_filename);
-			return;
+		for (i = 0; i < dump_n && !SHUTTING_DOWN(); i += part_size) {
+			buf_dump_sort(dump, dump_tmp, i,
+				      ut_min(i + part_size, dump_n));
 		}
 
-		if (space_id > ULINT32_MASK || page_no > ULINT32_MASK) {
-			ut_free(dump);
-			ut_free(dump_tmp);
-			fclose(f);
-			buf_load_status(STATUS_ERR,
-					"Error parsing '%s': bogus "
-					"space,page " ULINTPF "," ULINTPF
-					" at line " ULINTPF ", "
-					"unable to load buffer pool",
-					full_filename,
-					space_id, page_no,
-					i);
-			return;
-		}
+		ut_free(dump_tmp);
 
-		dump[i] = BUF_DUMP_CREATE(space_id, page_no);
-	}
+		n_read = buf_load_extents(dump, dump_n, start_us);
 
-	/* Set dump_n to the actual number of initialized elements,
-	i could be smaller than dump_n here if the file got truncated after
-	we read it the first time. */
-	dump_n = i;
+		ut_free(dump);
 
-	fclose(f);
+		if (n_read == ULINT_UNDEFINED) {
+			buf_load_abort_flag = FALSE;
+			buf_load_status(
+				STATUS_NOTICE,
+				"Buffer pool(s) load aborted on request");
+			return;
+		}
 
-	if (dump_n == 0) {
-		ut_free(dump);
 		ut_sprintf_timestamp(now);
+
 		buf_load_status(STATUS_NOTICE,
 				"Buffer pool(s) load completed at %s "
-				"(%s was empty)", now, full_filename);
+				"(" ULINTPF " pages read, %.1f MB/s)",
+				now, n_read,
+				buf_load_mb_per_sec(
+					n_read, ut_time_us(NULL) - start_us));
 		return;
 	}
 
@@ -845,7 +845,7 @@ buf_LRU_remove_pages(
 	ulint		id,		/*!< in: space id */
 	buf_remove_t	buf_remove,	/*!< in: remove or flush strategy */
 	const trx_t*	trx)		/*!< to check if the operation must
-					be interrupted */
+					be interrupted, can be 0 */
 {
 	switch (buf_remove) {
 	case BUF_REMOVE_ALL_NO_WRITE:
@@ -861,7 +861,6 @@ buf_LRU_remove_pages(
 		break;
 
 	case BUF_REMOVE_FLUSH_WRITE:
-		ut_a(trx != 0);
 		buf_flush_dirty_pages(buf_pool, id, true, trx);
 		/* Ensure that all asynchronous IO is completed. */
 		os_aio_wait_until_no_pending_writes();
@@ -882,7 +881,7 @@ buf_LRU_flush_or_remove_pages(
 	ulint		id,		/*!< in: space id */
 	buf_remove_t	buf_remove,	/*!< in: remove or flush strategy */
 	const trx_t*	trx)		/*!< to check if the operation must
-					be interrupted */
+					be interrupted, can be 0 */
 {
 	ulint		i;
 
@@ -523,6 +523,65 @@ buf_read_page_async(
 	return(count > 0);
 }
 
+/********************************************************************//**
+Reads a batch of pages of one tablespace asynchronously into the buffer
+pool, skipping those that are already there. The requests are queued
+first and then submitted together, so that the pages of an extent reach
+the i/o handler threads as one batch. Used by the buffer pool load.
+@return number of page read requests issued */
+UNIV_INTERN
+ulint
+buf_read_pages_async(
+/*=================*/
+	ulint		space,		/*!< in: space id */
+	const ulint*	page_nos,	/*!< in: page numbers to read */
+	ulint		n_pages)	/*!< in: number of page numbers
+					in the array */
+{
+	ulint		zip_size;
+	ib_int64_t	tablespace_version;
+	ulint		count;
+	dberr_t		err;
+	ulint		i;
+
+	zip_size = fil_space_get_zip_size(space);
+
+	if (zip_size == ULINT_UNDEFINED) {
+		return(0);
+	}
+
+	tablespace_version = fil_space_get_version(space);
+
+	count = 0;
+
+	for (i = 0; i < n_pages; i++) {
+		count += buf_read_page_low(
+			&err, false, BUF_READ_ANY_PAGE
+			| OS_AIO_SIMULATED_WAKE_LATER
+			| BUF_READ_IGNORE_NONEXISTENT_PAGES,
+			space, zip_size, FALSE,
+			tablespace_version, page_nos[i], NULL, TRUE);
+
+		if (err == DB_TABLESPACE_DELETED) {
+			break;
+		}
+	}
+
+#if defined(LINUX_NATIVE_AIO)
+	/* Tell aio to submit all buffered requests. */
+	os_aio_linux_dispatch_read_array_submit();
+#endif
+
+	os_aio_simulated_wake_handler_threads();
+
+	srv_stats.buf_pool_reads.add(count);
+
+	/* As in buf_read_page_async(), these deliberate reads are not
+	counted for the LRU policy. */
+
+	return(count);
+}
+
 /********************************************************************//**
 Applies linear read-ahead if in the buf_pool the page is a border page of
 a linear read-ahead area and all the pages in the area have been accessed.
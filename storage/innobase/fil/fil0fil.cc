@@ -115,7 +115,24 @@ file at the end of the LRU-list. When an i/o-operation is pending on a file,
 the file cannot be closed. We take the file nodes with pending i/o-operations
 out of the LRU-list and keep a count of pending operations. When an operation
 completes, we decrement the count and return the file node to the LRU-list if
-the count drops to zero. */
+the count drops to zero.
+
+An i/o on a file that is already open does not need fil_system->mutex.
+The LRU-list, the list of spaces with unflushed writes and the pending and
+modification counts of the file nodes are split into FIL_N_SHARDS shards on
+the space id, each with its own mutex, and starting or completing an i/o
+only takes the mutex of the shard. The space hash is therefore also
+protected by an array of rw-latches, one per range of space ids, which the
+lookup takes in shared mode. Anything that inserts or removes a space, or
+changes the chain of file nodes of a space, holds both fil_system->mutex
+and the latch for the space id in exclusive mode. A file is only opened or
+closed while holding both fil_system->mutex and the mutex of its shard, so
+either of them keeps node->open stable. The latching order is
+fil_system->mutex, then the space hash latch, then the shard mutex. */
+
+/** Number of rw-latches protecting fil_system->spaces; must be a power
+of 2 */
+#define FIL_SPACES_HASH_N_LOCKS	64
 
 /** When mysqld is run, the default directory "." is the mysqld datadir,
 but in the MySQL Embedded Server Library and mysqlbackup it is not the default
@@ -139,6 +156,8 @@ UNIV_INTERN fil_addr_t	fil_addr_null = {FIL_NULL, 0};
 #ifdef UNIV_PFS_MUTEX
 /* Key to register fil_system_mutex with performance schema */
 UNIV_INTERN mysql_pfs_key_t	fil_system_mutex_key;
+/* Key to register the fil_system shard mutexes with performance schema */
+UNIV_INTERN mysql_pfs_key_t	fil_shard_mutex_key;
 #endif /* UNIV_PFS_MUTEX */
 
 #ifdef UNIV_PFS_RWLOCK
@@ -202,7 +221,7 @@ fil_validate_skip(void)
 
 /********************************************************************//**
 Determines if a file node belongs to the least-recently-used list.
-@return TRUE if the file belongs to fil_system->LRU mutex. */
+@return TRUE if the file belongs to the LRU list of its shard. */
 UNIV_INLINE
 ibool
 fil_space_belongs_in_lru(
@@ -213,6 +232,18 @@ fil_space_belongs_in_lru(
 	       && fil_is_user_tablespace_id(space->id));
 }
 
+/********************************************************************//**
+Gets the shard of the LRU and unflushed_spaces lists of a space.
+@return the shard */
+UNIV_INLINE
+fil_shard_t*
+fil_shard_get(
+/*==========*/
+	ulint	space_id)	/*!< in: space id */
+{
+	return(&fil_system->shards[space_id & (FIL_N_SHARDS - 1)]);
+}
+
 /********************************************************************//**
 NOTE: you must call fil_mutex_enter_and_prepare_for_io() first!
 
@@ -230,7 +261,8 @@ fil_node_prepare_for_io(
 	fil_space_t*	space);	/*!< in: space */
 /********************************************************************//**
 Updates the data structures when an i/o operation finishes. Updates the
-pending i/o's field in the node appropriately. */
+pending i/o's field in the node appropriately. Only takes the mutex of
+the shard of the space. */
 static
 void
 fil_node_complete_io(
@@ -747,7 +779,7 @@ fil_space_get_type(
 
 /**********************************************************************//**
 Checks if all the file nodes in a space are flushed. The caller must hold
-the fil_system mutex.
+the mutex of the shard of the space.
 @return	true if all are flushed */
 static
 bool
@@ -757,7 +789,7 @@ fil_space_is_flushed(
 {
 	fil_node_t*	node;
 
-	ut_ad(mutex_own(&fil_system->mutex));
+	ut_ad(mutex_own(&fil_shard_get(space->id)->mutex));
 
 	node = UT_LIST_GET_FIRST(space->chain);
 
@@ -830,7 +862,9 @@ fil_node_create(
 
 	node->space = space;
 
+	hash_lock_x(fil_system->spaces, id);
 	UT_LIST_ADD_LAST(chain, space->chain, node);
+	hash_unlock_x(fil_system->spaces, id);
 
 	if (id < SRV_LOG_SPACE_FIRST_ID && fil_system->max_assigned_id < id) {
 
@@ -1045,22 +1079,29 @@ add_size:
 
 	ut_a(ret);
 
-	node->open = TRUE;
-
 	system->n_open++;
 	fil_n_file_opened++;
 
+	fil_shard_t*	shard = fil_shard_get(space->id);
+
+	mutex_enter(&shard->mutex);
+
+	node->open = TRUE;
+
 	if (fil_space_belongs_in_lru(space)) {
 
 		/* Put the node to the LRU list */
-		UT_LIST_ADD_FIRST(LRU, system->LRU, node);
+		UT_LIST_ADD_FIRST(LRU, shard->LRU, node);
 	}
 
+	mutex_exit(&shard->mutex);
+
 	return(true);
 }
 
 /**********************************************************************//**
-Closes a file. */
+Closes a file. The caller must hold the fil_system mutex and the mutex of
+the shard of the space. */
 static
 void
 fil_node_close_file(
@@ -1068,10 +1109,15 @@ fil_node_close_file(
 	fil_node_t*	node,	/*!< in: file node */
 	fil_system_t*	system)	/*!< in: tablespace memory cache */
 {
-	ibool	ret;
+	ibool		ret;
+	fil_shard_t*	shard;
 
 	ut_ad(node && system);
 	ut_ad(mutex_own(&(system->mutex)));
+
+	shard = fil_shard_get(node->space->id);
+
+	ut_ad(mutex_own(&shard->mutex));
 	ut_a(node->open);
 	ut_a(node->n_pending == 0);
 	ut_a(node->n_pending_flushes == 0);
@@ -1093,39 +1139,31 @@ fil_node_close_file(
 
 	if (fil_space_belongs_in_lru(node->space)) {
 
-		ut_a(UT_LIST_GET_LEN(system->LRU) > 0);
+		ut_a(UT_LIST_GET_LEN(shard->LRU) > 0);
 
 		/* The node is in the LRU list, remove it */
-		UT_LIST_REMOVE(LRU, system->LRU, node);
+		UT_LIST_REMOVE(LRU, shard->LRU, node);
 	}
 }
 
 /********************************************************************//**
-Tries to close a file in the LRU list. The caller must hold the fil_sys
-mutex.
-@return TRUE if success, FALSE if should retry later; since i/o's
-generally complete in < 100 ms, and as InnoDB writes at most 128 pages
-from the buffer pool in a batch, and then immediately flushes the
-files, there is a good chance that the next time we find a suitable
-node from the LRU list */
+Tries to close a file in the LRU list of a shard. The caller must hold the
+fil_sys mutex and the mutex of the shard.
+@return TRUE if a file was closed */
 static
 ibool
-fil_try_to_close_file_in_LRU(
-/*=========================*/
-	ibool	print_info)	/*!< in: if TRUE, prints information why it
-				cannot close a file */
+fil_try_to_close_file_in_shard_LRU(
+/*===============================*/
+	fil_shard_t*	shard,		/*!< in: shard */
+	ibool		print_info)	/*!< in: if TRUE, prints information
+					why it cannot close a file */
 {
 	fil_node_t*	node;
 
 	ut_ad(mutex_own(&fil_system->mutex));
+	ut_ad(mutex_own(&shard->mutex));
 
-	if (print_info) {
-		fprintf(stderr,
-			"InnoDB: fil_sys open file LRU len %lu\n",
-			(ulong) UT_LIST_GET_LEN(fil_system->LRU));
-	}
-
-	for (node = UT_LIST_GET_LAST(fil_system->LRU);
+	for (node = UT_LIST_GET_LAST(shard->LRU);
 	     node != NULL;
 	     node = UT_LIST_GET_PREV(LRU, node)) {
 
@@ -1169,6 +1207,53 @@ fil_try_to_close_file_in_LRU(
 	return(FALSE);
 }
 
+/********************************************************************//**
+Tries to close a file in the LRU list. The shards are tried in turn, each
+from the least recently used end of its list. The caller must hold the
+fil_sys mutex.
+@return TRUE if success, FALSE if should retry later; since i/o's
+generally complete in < 100 ms, and as InnoDB writes at most 128 pages
+from the buffer pool in a batch, and then immediately flushes the
+files, there is a good chance that the next time we find a suitable
+node from the LRU list */
+static
+ibool
+fil_try_to_close_file_in_LRU(
+/*=========================*/
+	ibool	print_info)	/*!< in: if TRUE, prints information why it
+				cannot close a file */
+{
+	ut_ad(mutex_own(&fil_system->mutex));
+
+	for (ulint i = 0; i < FIL_N_SHARDS; i++) {
+		fil_shard_t*	shard = &fil_system->shards[
+			(fil_system->LRU_shard + i) & (FIL_N_SHARDS - 1)];
+		ibool		success;
+
+		mutex_enter(&shard->mutex);
+
+		if (print_info) {
+			fprintf(stderr,
+				"InnoDB: fil_sys open file LRU len %lu\n",
+				(ulong) UT_LIST_GET_LEN(shard->LRU));
+		}
+
+		success = fil_try_to_close_file_in_shard_LRU(
+			shard, print_info);
+
+		mutex_exit(&shard->mutex);
+
+		if (success) {
+			/* Spread the closes over the shards */
+			fil_system->LRU_shard += i + 1;
+
+			return(TRUE);
+		}
+	}
+
+	return(FALSE);
+}
+
 /*******************************************************************//**
 Reserves the fil_system mutex and tries to make sure we can open at least one
 file while holding it. This should be called before calling
@@ -1320,9 +1405,14 @@ fil_node_free(
 	ut_ad(node && system && space);
 	ut_ad(mutex_own(&(system->mutex)));
 	ut_a(node->magic_n == FIL_NODE_MAGIC_N);
-	ut_a(node->n_pending == 0);
 	ut_a(!node->being_extended);
 
+	fil_shard_t*	shard = fil_shard_get(space->id);
+
+	mutex_enter(&shard->mutex);
+
+	ut_a(node->n_pending == 0);
+
 	if (node->open) {
 		/* We fool the assertion in fil_node_close_file() to think
 		there are no unflushed modifications in the file */
@@ -1341,16 +1431,20 @@ fil_node_free(
 			space->is_in_unflushed_spaces = false;
 
 			UT_LIST_REMOVE(unflushed_spaces,
-				       system->unflushed_spaces,
+				       shard->unflushed_spaces,
 				       space);
 		}
 
 		fil_node_close_file(node, system);
 	}
 
+	mutex_exit(&shard->mutex);
+
 	space->size -= node->size;
 
+	hash_lock_x(system->spaces, space->id);
 	UT_LIST_REMOVE(chain, space->chain, node);
+	hash_unlock_x(system->spaces, space->id);
 
 	os_event_free(node->sync_event);
 	mem_free(node->name);
@@ -1586,7 +1680,9 @@ fil_space_create(
 
 	rw_lock_create(fil_space_latch_key, &space->latch, SYNC_FSP);
 
+	hash_lock_x(fil_system->spaces, id);
 	HASH_INSERT(fil_space_t, hash, fil_system->spaces, id, space);
+	hash_unlock_x(fil_system->spaces, id);
 
 	HASH_INSERT(fil_space_t, name_hash, fil_system->name_hash,
 		    ut_fold_string(name), space);
@@ -1753,7 +1849,9 @@ fil_space_free(
 		return(FALSE);
 	}
 
+	hash_lock_x(fil_system->spaces, id);
 	HASH_DELETE(fil_space_t, hash, fil_system->spaces, id, space);
+	hash_unlock_x(fil_system->spaces, id);
 
 	fnamespace = fil_space_get_by_name(space->name);
 	ut_a(fnamespace);
@@ -1762,15 +1860,21 @@ fil_space_free(
 	HASH_DELETE(fil_space_t, name_hash, fil_system->name_hash,
 		    ut_fold_string(space->name), space);
 
+	fil_shard_t*	shard = fil_shard_get(id);
+
+	mutex_enter(&shard->mutex);
+
 	if (space->is_in_unflushed_spaces) {
 
 		ut_ad(!fil_buffering_disabled(space));
 		space->is_in_unflushed_spaces = false;
 
-		UT_LIST_REMOVE(unflushed_spaces, fil_system->unflushed_spaces,
+		UT_LIST_REMOVE(unflushed_spaces, shard->unflushed_spaces,
 			       space);
 	}
 
+	mutex_exit(&shard->mutex);
+
 	UT_LIST_REMOVE(space_list, fil_system->space_list, space);
 
 	ut_a(space->magic_n == FIL_SPACE_MAGIC_N);
@@ -2020,13 +2124,22 @@ fil_init(
 		     &fil_system->mutex, SYNC_ANY_LATCH);
 
 	fil_system->spaces = hash_create(hash_size);
+	hash_create_sync_obj(fil_system->spaces, HASH_TABLE_SYNC_RW_LOCK,
+			     FIL_SPACES_HASH_N_LOCKS, SYNC_NO_ORDER_CHECK);
 	fil_system->name_hash = hash_create(hash_size);
 
 	fil_system->stats_hash = hash_create(hash_size);
 	hash_create_sync_obj(fil_system->stats_hash, HASH_TABLE_SYNC_MUTEX,
 			     64, SYNC_NO_ORDER_CHECK);
 
-	UT_LIST_INIT(fil_system->LRU);
+	for (ulint i = 0; i < FIL_N_SHARDS; i++) {
+		fil_shard_t*	shard = &fil_system->shards[i];
+
+		mutex_create(fil_shard_mutex_key,
+			     &shard->mutex, SYNC_NO_ORDER_CHECK);
+		UT_LIST_INIT(shard->LRU);
+		UT_LIST_INIT(shard->unflushed_spaces);
+	}
 
 	fil_system->max_n_open = max_n_open;
 
@@ -2138,7 +2251,11 @@ fil_close_all_files(void)
 		     node = UT_LIST_GET_NEXT(chain, node)) {
 
 			if (node->open) {
+				fil_shard_t*	shard = fil_shard_get(space->id);
+
+				mutex_enter(&shard->mutex);
 				fil_node_close_file(node, fil_system);
+				mutex_exit(&shard->mutex);
 			}
 		}
 
@@ -2180,7 +2297,11 @@ fil_close_log_files(
 		     node = UT_LIST_GET_NEXT(chain, node)) {
 
 			if (node->open) {
+				fil_shard_t*	shard = fil_shard_get(space->id);
+
+				mutex_enter(&shard->mutex);
 				fil_node_close_file(node, fil_system);
+				mutex_exit(&shard->mutex);
 			}
 		}
 
@@ -2864,7 +2985,18 @@ fil_check_pending_io(
 
 	*node = UT_LIST_GET_FIRST(space->chain);
 
-	if (space->n_pending_flushes > 0 || (*node)->n_pending > 0) {
+	/* Read the pending count under the shard mutex, which an i/o that
+	does not take fil_system->mutex holds while it checks the stop
+	flags and increments the count */
+	fil_shard_t*	shard = fil_shard_get(space->id);
+
+	mutex_enter(&shard->mutex);
+
+	ulint	n_pending = (*node)->n_pending;
+
+	mutex_exit(&shard->mutex);
+
+	if (space->n_pending_flushes > 0 || n_pending > 0) {
 
 		ut_a(!(*node)->being_extended);
 
@@ -2875,7 +3007,7 @@ fil_check_pending_io(
 				" and %lu pending i/o's on it.",
 				space->name,
 				(ulong) space->n_pending_flushes,
-				(ulong) (*node)->n_pending);
+				(ulong) n_pending);
 		}
 
 		return(count + 1);
@@ -3026,6 +3158,73 @@ fil_close_tablespace(
 	return(err);
 }
 
+#ifndef UNIV_HOTBACKUP
+/*******************************************************************//**
+Truncates a single-file tablespace back to the given size. All pages of
+the tablespace are discarded from the buffer pool without being written;
+the caller must re-initialize the tablespace header afterwards. Used to
+shrink undo tablespaces.
+@return	true if success */
+UNIV_INTERN
+bool
+fil_truncate_tablespace(
+/*====================*/
+	ulint		id,		/*!< in: space id */
+	ulint		size_in_pages)	/*!< in: new size in pages */
+{
+	char*		path = 0;
+	fil_space_t*	space = 0;
+	bool		success;
+
+	ut_a(id != TRX_SYS_SPACE);
+
+	dberr_t		err = fil_check_pending_operations(id, &space, &path);
+
+	if (err != DB_SUCCESS) {
+		return(false);
+	}
+
+	mem_free(path);
+
+	/* Since space->stop_new_ops is set, no new pages of the
+	tablespace can be read into the buffer pool. */
+	buf_LRU_flush_or_remove_pages(id, BUF_REMOVE_ALL_NO_WRITE, 0);
+
+	fil_mutex_enter_and_prepare_for_io(id);
+
+	space = fil_space_get_by_id(id);
+	ut_a(space != NULL);
+
+	/* The following code must change when InnoDB supports
+	multiple datafiles per tablespace. */
+	ut_a(UT_LIST_GET_LEN(space->chain) == 1);
+
+	fil_node_t*	node = UT_LIST_GET_FIRST(space->chain);
+
+	success = fil_node_prepare_for_io(node, fil_system, space);
+
+	if (success) {
+		success = os_file_truncate(
+			node->name, node->handle,
+			(os_offset_t) size_in_pages * UNIV_PAGE_SIZE)
+			&& os_file_flush(node->handle);
+
+		if (success) {
+			space->size = node->size = size_in_pages;
+			node->flush_size = size_in_pages;
+		}
+
+		fil_node_complete_io(node, fil_system, OS_FILE_READ);
+	}
+
+	space->stop_new_ops = FALSE;
+
+	mutex_exit(&fil_system->mutex);
+
+	return(success);
+}
+#endif /* !UNIV_HOTBACKUP */
+
 /*******************************************************************//**
 Deletes a single-table tablespace. The tablespace must be cached in the
 memory cache.
@@ -3418,6 +3617,7 @@ fil_rename_tablespace(
 	ibool		success;
 	fil_space_t*	space;
 	fil_node_t*	node;
+	fil_shard_t*	shard;
 	ulint		count		= 0;
 	char*		new_path;
 	char*		old_name;
@@ -3475,6 +3675,10 @@ retry:
 	ut_a(UT_LIST_GET_LEN(space->chain) == 1);
 	node = UT_LIST_GET_FIRST(space->chain);
 
+	shard = fil_shard_get(id);
+
+	mutex_enter(&shard->mutex);
+
 	if (node->n_pending > 0
 	    || node->n_pending_flushes > 0
 	    || node->being_extended) {
@@ -3496,6 +3700,7 @@ retry:
 			sleep_usecs = 200000;
 		}
 
+		mutex_exit(&shard->mutex);
 		mutex_exit(&fil_system->mutex);
 
 		os_thread_sleep(sleep_usecs);
@@ -3512,6 +3717,7 @@ retry:
 			sleep_usecs = 200000;
 		}
 
+		mutex_exit(&shard->mutex);
 		mutex_exit(&fil_system->mutex);
 
 		os_thread_sleep(sleep_usecs);
@@ -3526,6 +3732,8 @@ retry:
 		fil_node_close_file(node, fil_system);
 	}
 
+	mutex_exit(&shard->mutex);
+
 	/* Check that the old name in the space is right */
 
 	if (old_name_in) {
@@ -6058,6 +6266,8 @@ fil_node_prepare_for_io(
 	fil_system_t*	system,	/*!< in: tablespace memory cache */
 	fil_space_t*	space)	/*!< in: space */
 {
+	fil_shard_t*	shard;
+
 	ut_ad(node && system && space);
 	ut_ad(mutex_own(&(system->mutex)));
 
@@ -6079,19 +6289,112 @@ fil_node_prepare_for_io(
 		}
 	}
 
+	shard = fil_shard_get(space->id);
+
+	mutex_enter(&shard->mutex);
+
 	if (node->n_pending == 0 && fil_space_belongs_in_lru(space)) {
 		/* The node is in the LRU list, remove it */
 
-		ut_a(UT_LIST_GET_LEN(system->LRU) > 0);
+		ut_a(UT_LIST_GET_LEN(shard->LRU) > 0);
 
-		UT_LIST_REMOVE(LRU, system->LRU, node);
+		UT_LIST_REMOVE(LRU, shard->LRU, node);
 	}
 
 	node->n_pending++;
 
+	mutex_exit(&shard->mutex);
+
 	return(true);
 }
 
+#ifndef UNIV_HOTBACKUP
+/********************************************************************//**
+Prepares a file node for i/o without fil_system->mutex. This succeeds if
+the file is open, taking only the mutex of the shard of the space.
+@return the node, with n_pending incremented, or NULL if the caller must
+use fil_mutex_enter_and_prepare_for_io() and fil_node_prepare_for_io() */
+static
+fil_node_t*
+fil_node_prepare_for_io_nolock(
+/*===========================*/
+	ulint		space_id,	/*!< in: space id */
+	ulint		type,		/*!< in: OS_FILE_READ or
+					OS_FILE_WRITE */
+	bool		sync,		/*!< in: true if synchronous i/o */
+	ulint*		block_offset,	/*!< in: offset in the space;
+					out: offset in the returned node */
+	fil_space_t**	space_out)	/*!< out: space of the node */
+{
+	fil_space_t*	space;
+	fil_node_t*	node = NULL;
+	fil_shard_t*	shard;
+	ulint		offset = *block_offset;
+
+	hash_lock_s(fil_system->spaces, space_id);
+
+	HASH_SEARCH(hash, fil_system->spaces, space_id,
+		    fil_space_t*, space,
+		    ut_ad(space->magic_n == FIL_SPACE_MAGIC_N),
+		    space->id == space_id);
+
+	if (space == NULL) {
+		goto func_exit;
+	}
+
+	/* A node whose size is not known yet never matches, and a page
+	past the end of the space is reported by the caller. */
+	for (node = UT_LIST_GET_FIRST(space->chain);
+	     node != NULL && node->size <= offset;
+	     node = UT_LIST_GET_NEXT(chain, node)) {
+
+		offset -= node->size;
+	}
+
+	if (node == NULL) {
+		goto func_exit;
+	}
+
+	shard = fil_shard_get(space_id);
+
+	mutex_enter(&shard->mutex);
+
+	/* Whoever sets the stop flags reads n_pending under the shard
+	mutex afterwards, and waits for it to drop to zero. Checking
+	the flags here under the same mutex makes sure that no i/o is
+	started on this path after that. */
+	if (!node->open
+	    || space->stop_ios
+	    || (type == OS_FILE_READ && !sync && space->stop_new_ops)) {
+
+		mutex_exit(&shard->mutex);
+		node = NULL;
+		goto func_exit;
+	}
+
+	if (node->n_pending == 0 && fil_space_belongs_in_lru(space)) {
+		/* The node is in the LRU list, remove it */
+
+		ut_a(UT_LIST_GET_LEN(shard->LRU) > 0);
+
+		UT_LIST_REMOVE(LRU, shard->LRU, node);
+	}
+
+	node->n_pending++;
+
+	mutex_exit(&shard->mutex);
+
+	*block_offset = offset;
+	*space_out = space;
+	space->stats.used = TRUE;
+
+func_exit:
+	hash_unlock_s(fil_system->spaces, space_id);
+
+	return(node);
+}
+#endif /* !UNIV_HOTBACKUP */
+
 /********************************************************************//**
 Updates the data structures when an i/o operation finishes. Updates the
 pending i/o's field in the node appropriately. */
@@ -6105,9 +6408,14 @@ fil_node_complete_io(
 				the node as modified if
 				type == OS_FILE_WRITE */
 {
+	fil_shard_t*	shard;
+
 	ut_ad(node);
 	ut_ad(system);
-	ut_ad(mutex_own(&(system->mutex)));
+
+	shard = fil_shard_get(node->space->id);
+
+	mutex_enter(&shard->mutex);
 
 	ut_a(node->n_pending > 0);
 
@@ -6115,8 +6423,8 @@ fil_node_complete_io(
 
 	if (type == OS_FILE_WRITE) {
 		ut_ad(!srv_read_only_mode);
-		system->modification_counter++;
-		node->modification_counter = system->modification_counter;
+		shard->modification_counter++;
+		node->modification_counter = shard->modification_counter;
 
 		if (fil_buffering_disabled(node->space)) {
 
@@ -6130,7 +6438,7 @@ fil_node_complete_io(
 
 			node->space->is_in_unflushed_spaces = true;
 			UT_LIST_ADD_FIRST(unflushed_spaces,
-					  system->unflushed_spaces,
+					  shard->unflushed_spaces,
 					  node->space);
 		}
 	}
@@ -6138,8 +6446,10 @@ fil_node_complete_io(
 	if (node->n_pending == 0 && fil_space_belongs_in_lru(node->space)) {
 
 		/* The node must be put back to the LRU list */
-		UT_LIST_ADD_FIRST(LRU, system->LRU, node);
+		UT_LIST_ADD_FIRST(LRU, shard->LRU, node);
 	}
+
+	mutex_exit(&shard->mutex);
 }
 
 /********************************************************************//**
@@ -6287,6 +6597,16 @@ _fil_io(
 		srv_stats.data_written.add(len);
 	}
 
+#ifndef UNIV_HOTBACKUP
+	/* If the file is open, start the i/o without fil_system->mutex */
+	node = fil_node_prepare_for_io_nolock(space_id, type, sync,
+					      &block_offset, &space);
+
+	if (node != NULL) {
+		goto do_io;
+	}
+#endif /* !UNIV_HOTBACKUP */
+
 	/* Reserve the fil_system mutex and make sure that we can open at
 	least one file while holding it, if the file is not already open */
 
@@ -6396,6 +6716,9 @@ _fil_io(
 	/* Now we have made the changes in the data structures of fil_system */
 	mutex_exit(&fil_system->mutex);
 
+#ifndef UNIV_HOTBACKUP
+do_io:
+#endif /* !UNIV_HOTBACKUP */
 	/* Calculate the low 32 bits and the high 32 bits of the file offset */
 
 	if (!zip_size) {
@@ -6454,12 +6777,8 @@ _fil_io(
 		/* The i/o operation is already completed when we return from
 		os_aio: */
 
-		mutex_enter(&fil_system->mutex);
-
 		fil_node_complete_io(node, fil_system, type);
 
-		mutex_exit(&fil_system->mutex);
-
 		ut_ad(fil_validate_skip());
 	}
 
@@ -6513,12 +6832,8 @@ fil_aio_wait(
 
 	srv_set_io_thread_op_info(segment, "complete io for fil node");
 
-	mutex_enter(&fil_system->mutex);
-
 	fil_node_complete_io(fil_node, fil_system, type);
 
-	mutex_exit(&fil_system->mutex);
-
 	ut_ad(fil_validate_skip());
 
 	/* Do the i/o handling */
@@ -6550,6 +6865,7 @@ fil_flush(
 {
 	fil_space_t*	space;
 	fil_node_t*	node;
+	fil_shard_t*	shard;
 	os_file_t	file;
 
 
@@ -6566,6 +6882,10 @@ fil_flush(
 		return;
 	}
 
+	shard = fil_shard_get(space_id);
+
+	mutex_enter(&shard->mutex);
+
 	if (fil_buffering_disabled(space)) {
 
 		/* No need to flush. User has explicitly disabled
@@ -6584,6 +6904,7 @@ fil_flush(
 		}
 #endif /* UNIV_DEBUG */
 
+		mutex_exit(&shard->mutex);
 		mutex_exit(&fil_system->mutex);
 		return;
 	}
@@ -6632,11 +6953,13 @@ retry:
 			ib_int64_t sig_count =
 				os_event_reset(node->sync_event);
 
+			mutex_exit(&shard->mutex);
 			mutex_exit(&fil_system->mutex);
 
 			os_event_wait_low(node->sync_event, sig_count);
 
 			mutex_enter(&fil_system->mutex);
+			mutex_enter(&shard->mutex);
 
 			if (node->flush_counter >= old_mod_counter) {
 
@@ -6650,11 +6973,13 @@ retry:
 		file = node->handle;
 		node->n_pending_flushes++;
 
+		mutex_exit(&shard->mutex);
 		mutex_exit(&fil_system->mutex);
 
 		os_file_flush(file);
 
 		mutex_enter(&fil_system->mutex);
+		mutex_enter(&shard->mutex);
 
 		os_event_set(node->sync_event);
 
@@ -6671,7 +6996,7 @@ skip_flush:
 
 				UT_LIST_REMOVE(
 					unflushed_spaces,
-					fil_system->unflushed_spaces,
+					shard->unflushed_spaces,
 					space);
 			}
 		}
@@ -6683,6 +7008,8 @@ skip_flush:
 		}
 	}
 
+	mutex_exit(&shard->mutex);
+
 	space->n_pending_flushes--;
 
 	mutex_exit(&fil_system->mutex);
@@ -6701,12 +7028,22 @@ fil_flush_file_spaces(
 	fil_space_t*	space;
 	ulint*		space_ids;
 	ulint		n_space_ids;
+	ulint		max_space_ids;
 	ulint		i;
 
 	mutex_enter(&fil_system->mutex);
 
-	n_space_ids = UT_LIST_GET_LEN(fil_system->unflushed_spaces);
-	if (n_space_ids == 0) {
+	max_space_ids = 0;
+
+	for (i = 0; i < FIL_N_SHARDS; i++) {
+		fil_shard_t*	shard = &fil_system->shards[i];
+
+		mutex_enter(&shard->mutex);
+		max_space_ids += UT_LIST_GET_LEN(shard->unflushed_spaces);
+		mutex_exit(&shard->mutex);
+	}
+
+	if (max_space_ids == 0) {
 
 		mutex_exit(&fil_system->mutex);
 		return;
@@ -6715,20 +7052,31 @@ fil_flush_file_spaces(
 	/* Assemble a list of space ids to flush.  Previously, we
 	traversed fil_system->unflushed_spaces and called UT_LIST_GET_NEXT()
 	on a space that was just removed from the list by fil_flush().
-	Thus, the space could be dropped and the memory overwritten. */
+	Thus, the space could be dropped and the memory overwritten.
+	Spaces that get unflushed writes after the lists were counted
+	above are left for the next call. */
 	space_ids = static_cast<ulint*>(
-		mem_alloc(n_space_ids * sizeof *space_ids));
+		mem_alloc(max_space_ids * sizeof *space_ids));
 
 	n_space_ids = 0;
 
-	for (space = UT_LIST_GET_FIRST(fil_system->unflushed_spaces);
-	     space;
-	     space = UT_LIST_GET_NEXT(unflushed_spaces, space)) {
+	for (i = 0; i < FIL_N_SHARDS; i++) {
+		fil_shard_t*	shard = &fil_system->shards[i];
 
-		if (space->purpose == purpose && !space->stop_new_ops) {
+		mutex_enter(&shard->mutex);
 
-			space_ids[n_space_ids++] = space->id;
+		for (space = UT_LIST_GET_FIRST(shard->unflushed_spaces);
+		     space != NULL && n_space_ids < max_space_ids;
+		     space = UT_LIST_GET_NEXT(unflushed_spaces, space)) {
+
+			if (space->purpose == purpose
+			    && !space->stop_new_ops) {
+
+				space_ids[n_space_ids++] = space->id;
+			}
 		}
+
+		mutex_exit(&shard->mutex);
 	}
 
 	mutex_exit(&fil_system->mutex);
@@ -6796,16 +7144,25 @@ fil_validate(void)
 
 	ut_a(fil_system->n_open == n_open);
 
-	UT_LIST_CHECK(LRU, fil_node_t, fil_system->LRU);
+	for (i = 0; i < FIL_N_SHARDS; i++) {
+		fil_shard_t*	shard = &fil_system->shards[i];
+
+		mutex_enter(&shard->mutex);
+
+		UT_LIST_CHECK(LRU, fil_node_t, shard->LRU);
 
-	for (fil_node = UT_LIST_GET_FIRST(fil_system->LRU);
-	     fil_node != 0;
-	     fil_node = UT_LIST_GET_NEXT(LRU, fil_node)) {
+		for (fil_node = UT_LIST_GET_FIRST(shard->LRU);
+		     fil_node != 0;
+		     fil_node = UT_LIST_GET_NEXT(LRU, fil_node)) {
 
-		ut_a(fil_node->n_pending == 0);
-		ut_a(!fil_node->being_extended);
-		ut_a(fil_node->open);
-		ut_a(fil_space_belongs_in_lru(fil_node->space));
+			ut_a(fil_node->n_pending == 0);
+			ut_a(!fil_node->being_extended);
+			ut_a(fil_node->open);
+			ut_a(fil_space_belongs_in_lru(fil_node->space));
+			ut_a(fil_shard_get(fil_node->space->id) == shard);
+		}
+
+		mutex_exit(&shard->mutex);
 	}
 
 	mutex_exit(&fil_system->mutex);
@@ -6895,8 +7252,11 @@ fil_close(void)
 	hash_table_free(fil_system->name_hash);
 	hash_table_free(fil_system->stats_hash);
 
-	ut_a(UT_LIST_GET_LEN(fil_system->LRU) == 0);
-	ut_a(UT_LIST_GET_LEN(fil_system->unflushed_spaces) == 0);
+	for (ulint i = 0; i < FIL_N_SHARDS; i++) {
+		ut_a(UT_LIST_GET_LEN(fil_system->shards[i].LRU) == 0);
+		ut_a(UT_LIST_GET_LEN(
+			     fil_system->shards[i].unflushed_spaces) == 0);
+	}
 	ut_a(UT_LIST_GET_LEN(fil_system->space_list) == 0);
 
 	mem_free(fil_system);
@@ -1094,6 +1094,8 @@ fts_cache_clear(
 		index_cache = static_cast<fts_index_cache_t*>(
 			ib_vector_get(cache->indexes, i));
 
+		ut_ad(index_cache->sync_words == NULL);
+
 		fts_words_free(index_cache->words);
 
 		rbt_free(index_cache->words);
@@ -1441,7 +1443,7 @@ fts_cache_add_doc(
 				ib_vector_last(word->nodes));
 		}
 
-		if (fts_node == NULL || fts_node->synced
+		if (fts_node == NULL
 		    || fts_node->ilist_size > FTS_ILIST_MAX_SIZE
 		    || doc_id < fts_node->last_doc_id) {
 
@@ -3560,8 +3562,27 @@ fts_add_doc_by_id(
 					need_sync = true;
 				}
 
+				/* A running SYNC no longer blocks adding
+				documents, so stop the cache from growing
+				past its limit until the SYNC is done. */
+				bool	need_wait = cache->sync->in_progress
+					&& cache->sync->unlock_cache
+					&& cache->total_size
+					> fts_max_cache_size;
+
+				DBUG_EXECUTE_IF(
+					"fts_instrument_cache_full",
+					need_wait = cache->sync->in_progress
+					&& cache->sync->unlock_cache;
+				);
+
 				rw_lock_x_unlock(&table->fts->cache->lock);
 
+				if (need_wait) {
+					DEBUG_SYNC_C("fts_cache_full_wait");
+					os_event_wait(cache->sync->event);
+				}
+
 				DBUG_EXECUTE_IF(
 					"fts_instrument_sync",
 					fts_optimize_request_sync_table(table);
@@ -3951,39 +3972,40 @@ fts_sync_add_deleted_cache(
 	return(error);
 }
 
-/** Write the words and ilist to disk.
+/** Write the words and ilist that SYNC took out of the cache to disk.
+The words are written in the order of the rb tree, which is also the
+order of the (word, first_doc_id) key of the auxiliary INDEX tables, so
+each auxiliary table gets one ascending run of inserts. The cache lock
+is not needed: the words are only reachable through
+index_cache->sync_words, which nobody but SYNC changes.
 @param[in,out]	trx		transaction
 @param[in]	index_cache	index cache
-@param[in]	unlock_cache	whether unlock cache when write node
 @return DB_SUCCESS if all went well else error code */
 static MY_ATTRIBUTE((nonnull, warn_unused_result))
 dberr_t
 fts_sync_write_words(
 	trx_t*			trx,
-	fts_index_cache_t*	index_cache,
-	bool			unlock_cache)
+	fts_index_cache_t*	index_cache)
 {
 	fts_table_t	fts_table;
 	ulint		n_nodes = 0;
 	ulint		n_words = 0;
 	const ib_rbt_node_t* rbt_node;
 	dberr_t		error = DB_SUCCESS;
-	ibool		print_error = FALSE;
-	dict_table_t*	table = index_cache->index->table;
+	ib_rbt_t*	words = index_cache->sync_words;
 #ifdef FTS_DOC_STATS_DEBUG
+	dict_table_t*	table = index_cache->index->table;
 	ulint		n_new_words = 0;
 #endif /* FTS_DOC_STATS_DEBUG */
 
 	FTS_INIT_INDEX_TABLE(
 		&fts_table, NULL, FTS_INDEX_TABLE, index_cache->index);
 
-	n_words = rbt_size(index_cache->words);
+	n_words = rbt_size(words);
 
-	/* We iterate over the entire tree, even if there is an error,
-	since we want to free the memory used during caching. */
-	for (rbt_node = rbt_first(index_cache->words);
-	     rbt_node;
-	     rbt_node = rbt_next(index_cache->words, rbt_node)) {
+	for (rbt_node = rbt_first(words);
+	     rbt_node != NULL && error == DB_SUCCESS;
+	     rbt_node = rbt_next(words, rbt_node)) {
 
 		ulint			i;
 		ulint			selected;
@@ -4000,7 +4022,7 @@ fts_sync_write_words(
 #ifdef FTS_DOC_STATS_DEBUG
 		/* Check if the word exists in the FTS index and if not
 		then we need to increment the total word count stats. */
-		if (error == DB_SUCCESS && fts_enable_diag_print) {
+		if (fts_enable_diag_print) {
 			ibool	found = FALSE;
 
 			error = fts_is_word_in_index(
@@ -4016,55 +4038,34 @@ fts_sync_write_words(
 		}
 #endif /* FTS_DOC_STATS_DEBUG */
 
-		/* We iterate over all the nodes even if there was an error */
-		for (i = 0; i < ib_vector_size(word->nodes); ++i) {
+		for (i = 0;
+		     i < ib_vector_size(word->nodes) && error == DB_SUCCESS;
+		     ++i) {
 
 			fts_node_t* fts_node = static_cast<fts_node_t*>(
 				ib_vector_get(word->nodes, i));
 
-			if (fts_node->synced) {
-				continue;
-			} else {
-				fts_node->synced = true;
-			}
-
-			/*FIXME: we need to handle the error properly. */
-			if (error == DB_SUCCESS) {
-				if (unlock_cache) {
-					rw_lock_x_unlock(
-						&table->fts->cache->lock);
-				}
-
-				error = fts_write_node(
-					trx,
-					&index_cache->ins_graph[selected],
-					&fts_table, &word->text, fts_node);
-
-				DEBUG_SYNC_C("fts_write_node");
-				DBUG_EXECUTE_IF("fts_write_node_crash",
-					DBUG_SUICIDE(););
+			error = fts_write_node(
+				trx, &index_cache->ins_graph[selected],
+				&fts_table, &word->text, fts_node);
 
-				DBUG_EXECUTE_IF("fts_instrument_sync_sleep",
-					os_thread_sleep(1000000);
-				);
+			DEBUG_SYNC_C("fts_write_node");
+			DBUG_EXECUTE_IF("fts_write_node_crash",
+				DBUG_SUICIDE(););
 
-				if (unlock_cache) {
-					rw_lock_x_lock(
-						&table->fts->cache->lock);
-				}
-			}
+			DBUG_EXECUTE_IF("fts_instrument_sync_sleep",
+				os_thread_sleep(1000000);
+			);
 		}
 
 		n_nodes += ib_vector_size(word->nodes);
+	}
 
-		if (error != DB_SUCCESS && !print_error) {
-			ut_print_timestamp(stderr);
-			fprintf(stderr, "  InnoDB: Error (%s) writing "
-				"word node to FTS auxiliary index "
-				"table.\n", ut_strerr(error));
-
-			print_error = TRUE;
-		}
+	if (error != DB_SUCCESS) {
+		ut_print_timestamp(stderr);
+		fprintf(stderr, "  InnoDB: Error (%s) writing "
+			"word node to FTS auxiliary index "
+			"table.\n", ut_strerr(error));
 	}
 
 #ifdef FTS_DOC_STATS_DEBUG
@@ -4175,12 +4176,12 @@ fts_sync_write_doc_stats(
 	que_t*		graph = NULL;
 	fts_doc_stats_t*  doc_stat;
 
-	if (ib_vector_is_empty(index_cache->doc_stats)) {
+	if (ib_vector_is_empty(index_cache->sync_doc_stats)) {
 		return(DB_SUCCESS);
 	}
 
 	doc_stat = static_cast<ts_doc_stats_t*>(
-		ib_vector_pop(index_cache->doc_stats));
+		ib_vector_pop(index_cache->sync_doc_stats));
 
 	while (doc_stat) {
 		error = fts_sync_write_doc_stat(
@@ -4190,12 +4191,12 @@ fts_sync_write_doc_stats(
 			break;
 		}
 
-		if (ib_vector_is_empty(index_cache->doc_stats)) {
+		if (ib_vector_is_empty(index_cache->sync_doc_stats)) {
 			break;
 		}
 
 		doc_stat = static_cast<ts_doc_stats_t*>(
-			ib_vector_pop(index_cache->doc_stats));
+			ib_vector_pop(index_cache->sync_doc_stats));
 	}
 
 	if (graph != NULL) {
@@ -4316,15 +4317,23 @@ fts_is_word_in_index(
 #endif /* FTS_DOC_STATS_DEBUG */
 
 /*********************************************************************//**
-Begin Sync, create transaction, acquire locks, etc. */
+Begin Sync, create transaction, acquire locks, etc. The words of all the
+index caches are taken out of the cache, together with the heap that
+holds them, so that documents can be added to the cache again while they
+are written to disk. */
 static
 void
 fts_sync_begin(
 /*===========*/
 	fts_sync_t*	sync)			/*!< in: sync state */
 {
+	ulint		i;
 	fts_cache_t*	cache = sync->table->fts->cache;
 
+#ifdef UNIV_SYNC_DEBUG
+	ut_ad(rw_lock_own(&cache->lock, RW_LOCK_EX));
+#endif
+
 	n_nodes = 0;
 	elapsed_time = 0;
 
@@ -4340,6 +4349,32 @@ fts_sync_begin(
 			ib_vector_size(cache->deleted_doc_ids),
 			cache->total_size);
 	}
+
+	sync->sync_doc_id = sync->max_doc_id;
+	sync->sync_size = cache->total_size;
+
+	ut_a(sync->heap == NULL);
+	sync->heap = static_cast<mem_heap_t*>(cache->sync_heap->arg);
+	cache->sync_heap->arg = mem_heap_create(1024);
+
+	cache->total_size = 0;
+
+	for (i = 0; i < ib_vector_size(cache->indexes); ++i) {
+		fts_index_cache_t*	index_cache;
+
+		index_cache = static_cast<fts_index_cache_t*>(
+			ib_vector_get(cache->indexes, i));
+
+		ut_a(index_cache->sync_words == NULL);
+
+		index_cache->sync_words = index_cache->words;
+		index_cache->sync_doc_stats = index_cache->doc_stats;
+
+		index_cache->words = NULL;
+		index_cache->doc_stats = NULL;
+
+		fts_index_cache_init(cache->sync_heap, index_cache);
+	}
 }
 
 /*********************************************************************//**
@@ -4360,12 +4395,12 @@ fts_sync_index(
 
 	if (fts_enable_diag_print) {
 		ib_logf(IB_LOG_LEVEL_INFO,
-			"SYNC words: %ld", rbt_size(index_cache->words));
+			"SYNC words: %ld", rbt_size(index_cache->sync_words));
 	}
 
-	ut_ad(rbt_validate(index_cache->words));
+	ut_ad(rbt_validate(index_cache->sync_words));
 
-	error = fts_sync_write_words(sync->trx, index_cache, sync->unlock_cache);
+	error = fts_sync_write_words(sync->trx, index_cache);
 
 #ifdef FTS_DOC_STATS_DEBUG
 	/* FTS_RESOLVE: the word counter info in auxiliary table "DOC_ID"
@@ -4381,55 +4416,127 @@ fts_sync_index(
 	return(error);
 }
 
-/** Check if index cache has been synced completely
-@param[in,out]	index_cache	index cache
-@return true if index is synced, otherwise false. */
+/** Create a vector holding the elements of two vectors of the same type.
+@param[in]	allocator	allocator of the new vector
+@param[in]	first		elements to copy first, or NULL
+@param[in]	second		elements to copy after them, or NULL
+@param[in]	sizeof_value	size of an element
+@return the new vector */
 static
-bool
-fts_sync_index_check(
+ib_vector_t*
+fts_sync_vector_join(
+	ib_alloc_t*		allocator,
+	const ib_vector_t*	first,
+	const ib_vector_t*	second,
+	ulint			sizeof_value)
+{
+	ulint		n_first = first ? ib_vector_size(first) : 0;
+	ulint		n_second = second ? ib_vector_size(second) : 0;
+	ib_vector_t*	vec;
+
+	vec = ib_vector_create(
+		allocator, sizeof_value, ut_max(n_first + n_second, 4));
+
+	for (ulint i = 0; i < n_first; ++i) {
+		ib_vector_push(vec, ib_vector_get_const(first, i));
+	}
+
+	for (ulint i = 0; i < n_second; ++i) {
+		ib_vector_push(vec, ib_vector_get_const(second, i));
+	}
+
+	return(vec);
+}
+
+/** Free the query graphs that SYNC used on an index cache.
+@param[in,out]	index_cache	index cache */
+static
+void
+fts_sync_index_free_graphs(
 	fts_index_cache_t*	index_cache)
 {
-	const ib_rbt_node_t*	rbt_node;
+	for (ulint j = 0; fts_index_selector[j].value; ++j) {
 
-	for (rbt_node = rbt_first(index_cache->words);
-	     rbt_node != NULL;
-	     rbt_node = rbt_next(index_cache->words, rbt_node)) {
+		if (index_cache->ins_graph[j] != NULL) {
 
-		fts_tokenizer_word_t*	word;
-		word = rbt_value(fts_tokenizer_word_t, rbt_node);
+			fts_que_graph_free_check_lock(
+				NULL, index_cache, index_cache->ins_graph[j]);
+
+			index_cache->ins_graph[j] = NULL;
+		}
 
-		fts_node_t*	fts_node;
-		fts_node = static_cast<fts_node_t*>(ib_vector_last(word->nodes));
+		if (index_cache->sel_graph[j] != NULL) {
 
-		if (!fts_node->synced) {
-			return(false);
+			fts_que_graph_free_check_lock(
+				NULL, index_cache, index_cache->sel_graph[j]);
+
+			index_cache->sel_graph[j] = NULL;
 		}
 	}
-
-	return(true);
 }
 
-/** Reset synced flag in index cache when rollback
+/** Put the words of a failed SYNC back into an index cache, ahead of the
+nodes of the documents added since, so that the next SYNC writes them.
+@param[in,out]	cache		fts cache
 @param[in,out]	index_cache	index cache */
 static
 void
-fts_sync_index_reset(
+fts_sync_index_restore(
+	fts_cache_t*		cache,
 	fts_index_cache_t*	index_cache)
 {
+	ib_rbt_t*		sync_words = index_cache->sync_words;
 	const ib_rbt_node_t*	rbt_node;
+	mem_heap_t*		heap;
+
+	if (sync_words == NULL) {
+		return;
+	}
+
+	heap = static_cast<mem_heap_t*>(cache->sync_heap->arg);
 
-	for (rbt_node = rbt_first(index_cache->words);
+	for (rbt_node = rbt_first(sync_words);
 	     rbt_node != NULL;
-	     rbt_node = rbt_next(index_cache->words, rbt_node)) {
+	     rbt_node = rbt_first(sync_words)) {
 
+		fts_tokenizer_word_t*	sync_word;
 		fts_tokenizer_word_t*	word;
-		word = rbt_value(fts_tokenizer_word_t, rbt_node);
+		ib_rbt_bound_t		parent;
+
+		sync_word = rbt_value(fts_tokenizer_word_t, rbt_node);
+
+		if (rbt_search(index_cache->words, &parent,
+			       &sync_word->text) != 0) {
 
-		fts_node_t*	fts_node;
-		fts_node = static_cast<fts_node_t*>(ib_vector_last(word->nodes));
+			fts_tokenizer_word_t	new_word;
 
-		fts_node->synced = false;
+			new_word.nodes = NULL;
+			fts_utf8_string_dup(
+				&new_word.text, &sync_word->text, heap);
+
+			parent.last = rbt_add_node(
+				index_cache->words, &parent, &new_word);
+		}
+
+		word = rbt_value(fts_tokenizer_word_t, parent.last);
+
+		/* The ilists move over to the nodes in the cache */
+		word->nodes = fts_sync_vector_join(
+			cache->sync_heap, sync_word->nodes, word->nodes,
+			sizeof(fts_node_t));
+
+		ut_free(rbt_remove_node(sync_words, rbt_node));
 	}
+
+	rbt_free(sync_words);
+	index_cache->sync_words = NULL;
+
+	index_cache->doc_stats = fts_sync_vector_join(
+		cache->sync_heap, index_cache->sync_doc_stats,
+		index_cache->doc_stats, sizeof(fts_doc_stats_t));
+	index_cache->sync_doc_stats = NULL;
+
+	ut_ad(rbt_validate(index_cache->words));
 }
 
 /** Commit the SYNC, change state of processed doc ids etc.
@@ -4449,7 +4556,7 @@ fts_sync_commit(
 
 	/* After each Sync, update the CONFIG table about the max doc id
 	we just sync-ed to index table */
-	error = fts_cmp_set_sync_doc_id(sync->table, sync->max_doc_id, FALSE,
+	error = fts_cmp_set_sync_doc_id(sync->table, sync->sync_doc_id, FALSE,
 					&last_doc_id);
 
 	/* Get the list of deleted documents that are either in the
@@ -4462,11 +4569,33 @@ fts_sync_commit(
 			sync, cache->deleted_doc_ids);
 	}
 
+	for (ulint i = 0; i < ib_vector_size(cache->indexes); ++i) {
+		fts_index_cache_t*	index_cache;
+
+		index_cache = static_cast<fts_index_cache_t*>(
+			ib_vector_get(cache->indexes, i));
+
+		if (index_cache->sync_words != NULL) {
+			fts_words_free(index_cache->sync_words);
+			rbt_free(index_cache->sync_words);
+			index_cache->sync_words = NULL;
+			index_cache->sync_doc_stats = NULL;
+		}
+
+		fts_sync_index_free_graphs(index_cache);
+	}
+
 	/* We need to do this within the deleted lock since fts_delete() can
 	attempt to add a deleted doc id to the cache deleted id array. */
-	fts_cache_clear(cache);
+	mutex_enter(&cache->deleted_lock);
+	cache->deleted_doc_ids = ib_vector_create(
+		cache->sync_heap, sizeof(fts_update_t), 4);
+	mutex_exit(&cache->deleted_lock);
 	DEBUG_SYNC_C("fts_deleted_doc_ids_clear");
-	fts_cache_init(cache);
+
+	mem_heap_free(sync->heap);
+	sync->heap = NULL;
+
 	rw_lock_x_unlock(&cache->lock);
 
 	if (error == DB_SUCCESS) {
@@ -4509,37 +4638,30 @@ fts_sync_rollback(
 	fts_cache_t*	cache = sync->table->fts->cache;
 
 	for (ulint i = 0; i < ib_vector_size(cache->indexes); ++i) {
-		ulint			j;
 		fts_index_cache_t*	index_cache;
 
 		index_cache = static_cast<fts_index_cache_t*>(
 			ib_vector_get(cache->indexes, i));
 
-		/* Reset synced flag so nodes will not be skipped
-		in the next sync, see fts_sync_write_words(). */
-		fts_sync_index_reset(index_cache);
-
-		for (j = 0; fts_index_selector[j].value; ++j) {
+		/* Give the words back to the cache so that the next
+		SYNC writes them. */
+		fts_sync_index_restore(cache, index_cache);
 
-			if (index_cache->ins_graph[j] != NULL) {
+		fts_sync_index_free_graphs(index_cache);
+	}
 
-				fts_que_graph_free_check_lock(
-					NULL, index_cache,
-					index_cache->ins_graph[j]);
+	cache->total_size += sync->sync_size;
 
-				index_cache->ins_graph[j] = NULL;
-			}
+	/* The array of deleted doc ids may still live in the heap of the
+	words; copy it before the heap is freed. */
+	mutex_enter(&cache->deleted_lock);
+	cache->deleted_doc_ids = fts_sync_vector_join(
+		cache->sync_heap, cache->deleted_doc_ids, NULL,
+		sizeof(fts_update_t));
+	mutex_exit(&cache->deleted_lock);
 
-			if (index_cache->sel_graph[j] != NULL) {
-
-				fts_que_graph_free_check_lock(
-					NULL, index_cache,
-					index_cache->sel_graph[j]);
-
-				index_cache->sel_graph[j] = NULL;
-			}
-		}
-	}
+	mem_heap_free(sync->heap);
+	sync->heap = NULL;
 
 	rw_lock_x_unlock(&cache->lock);
 
@@ -4572,7 +4694,7 @@ fts_sync(
 	rw_lock_x_lock(&cache->lock);
 
 	/* Check if cache is being synced.
-	Note: we release cache lock in fts_sync_write_words() to
+	Note: we release cache lock while the words are written to
 	avoid long wait for the lock by other threads. */
 	while (sync->in_progress) {
 		rw_lock_x_unlock(&cache->lock);
@@ -4588,6 +4710,7 @@ fts_sync(
 
 	sync->unlock_cache = unlock_cache;
 	sync->in_progress = true;
+	os_event_reset(sync->event);
 
 	DEBUG_SYNC_C("fts_sync_begin");
 	fts_sync_begin(sync);
@@ -4598,12 +4721,11 @@ fts_sync(
 		sync->trx->dict_operation_lock_mode = RW_S_LATCH;
 	}
 
-begin_sync:
-	if (cache->total_size > fts_max_cache_size) {
-		/* Avoid the case: sync never finish when
-		insert/update keeps comming. */
-		ut_ad(sync->unlock_cache);
-		sync->unlock_cache = false;
+	/* The words to write are out of the cache now: documents that are
+	added from here on go to the emptied cache and are left to the next
+	SYNC. */
+	if (sync->unlock_cache) {
+		rw_lock_x_unlock(&cache->lock);
 	}
 
 	for (i = 0; i < ib_vector_size(cache->indexes); ++i) {
@@ -4618,34 +4740,20 @@ begin_sync:
 
 		error = fts_sync_index(sync, index_cache);
 
-		if (error != DB_SUCCESS && !sync->interrupted) {
-
-			goto end_sync;
+		if (error != DB_SUCCESS) {
+			break;
 		}
 	}
 
 	DBUG_EXECUTE_IF("fts_instrument_sync_interrupted",
 			sync->interrupted = true;
 			error = DB_INTERRUPTED;
-			goto end_sync;
 	);
 
-	/* Make sure all the caches are synced. */
-	for (i = 0; i < ib_vector_size(cache->indexes); ++i) {
-		fts_index_cache_t*	index_cache;
-
-		index_cache = static_cast<fts_index_cache_t*>(
-			ib_vector_get(cache->indexes, i));
-
-		if (index_cache->index->to_be_dropped
-		    || fts_sync_index_check(index_cache)) {
-			continue;
-		}
-
-		goto begin_sync;
+	if (sync->unlock_cache) {
+		rw_lock_x_lock(&cache->lock);
 	}
 
-end_sync:
 	if (error == DB_SUCCESS && !sync->interrupted) {
 		error = fts_sync_commit(sync);
 	}  else {
@@ -5305,6 +5413,8 @@ const ib_vector_t*
 fts_cache_find_word(
 /*================*/
 	const fts_index_cache_t*index_cache,	/*!< in: cache to search */
+	const ib_rbt_t*		words,		/*!< in: index_cache->words or
+						index_cache->sync_words */
 	const fts_string_t*	text)		/*!< in: word to search for */
 {
 	ib_rbt_bound_t		parent;
@@ -5316,8 +5426,11 @@ fts_cache_find_word(
 	ut_ad(rw_lock_own((rw_lock_t*) &cache->lock, RW_LOCK_EX));
 #endif
 
+	ut_ad(words == index_cache->words
+	      || words == index_cache->sync_words);
+
 	/* Lookup the word in the rb tree */
-	if (rbt_search(index_cache->words, &parent, text) == 0) {
+	if (rbt_search(words, &parent, text) == 0) {
 		const fts_tokenizer_word_t*	word;
 
 		word = rbt_value(fts_tokenizer_word_t, parent.last);
@@ -175,6 +175,43 @@ struct fts_optimize_t {
 					been optimized */
 	ibool		del_list_regenerated;
 					/*!< BEING_DELETED list regenarated */
+	fts_optimize_t*	parent;		/*!< optimize instance of the table
+					if this instance optimizes a single
+					auxiliary index partition, else NULL;
+					to_delete belongs to the parent */
+	const char*	last_word_param;/*!< name of the config parameter
+					that holds the last word optimized
+					in the partition */
+};
+
+/** State of the optimize of one auxiliary index partition of an FTS
+index. Each partition is optimized with its own transaction and keeps
+its own last optimized word in the config table, so that partitions can
+be optimized in parallel and each one continues where it left off. */
+struct fts_optimize_part_t {
+	fts_optimize_t*	optim;		/*!< optimize instance of the
+					partition */
+	fts_string_t	word;		/*!< last word optimized in the
+					partition, optimize starts after it */
+	byte		str[FTS_MAX_WORD_LEN + 1];
+					/*!< buffer of word */
+	ibool		exhausted;	/*!< TRUE if no words were left to
+					optimize in the partition */
+	dberr_t		error;		/*!< error seen while reading the
+					words of the partition */
+};
+
+/** State shared by the threads that optimize the partitions of an FTS
+index */
+struct fts_optimize_pll_t {
+	dict_index_t*		index;	/*!< FTS index being optimized */
+	fts_optimize_part_t*	parts;	/*!< the partitions */
+	ulint			n_parts;/*!< number of partitions */
+	ulint			n_words;/*!< max words to read from a
+					partition in this pass */
+	ulint			next_part;
+					/*!< number of partitions taken by
+					threads so far, updated atomically */
 };
 
 /** Used by the optimize, to keep state during compacting nodes. */
@@ -234,6 +271,10 @@ struct fts_msg_t {
 /** The number of words to read and optimize in a single pass. */
 UNIV_INTERN ulong	fts_num_word_optimize;
 
+/** The number of threads that optimize the auxiliary index partitions
+of an FTS index. */
+UNIV_INTERN ulong	fts_optimize_threads;
+
 // FIXME
 UNIV_INTERN char	fts_enable_diag_print;
 
@@ -789,22 +830,22 @@ fts_zip_deflate_end(
 }
 
 /**********************************************************************//**
-Read the words from the FTS INDEX.
-@return DB_SUCCESS if all OK, DB_TABLE_NOT_FOUND if no more indexes
-        to search else error code */
+Read the words of one auxiliary index partition from the FTS INDEX.
+@return DB_SUCCESS if all OK else error code */
 static MY_ATTRIBUTE((nonnull, warn_unused_result))
 dberr_t
 fts_index_fetch_words(
 /*==================*/
-	fts_optimize_t*		optim,	/*!< in: optimize scratch pad */
+	fts_optimize_t*		optim,	/*!< in: optimize scratch pad, its
+					fts_index_table names the partition
+					to read */
 	const fts_string_t*	word,	/*!< in: get words greater than this
 					 word */
 	ulint			n_words)/*!< in: max words to read */
 {
 	pars_info_t*	info;
 	que_t*		graph;
-	ulint		selected;
-	fts_zip_t*	zip = NULL;
+	fts_zip_t*	zip;
 	dberr_t		error = DB_SUCCESS;
 	mem_heap_t*	heap = static_cast<mem_heap_t*>(optim->self_heap->arg);
 	ibool		inited = FALSE;
@@ -817,103 +858,87 @@ fts_index_fetch_words(
 		fts_zip_initialize(optim->zip);
 	}
 
-	for (selected = fts_select_index(
-		optim->fts_index_table.charset, word->f_str, word->f_len);
-	     fts_index_selector[selected].value;
-	     selected++) {
+	zip = optim->zip;
 
-		optim->fts_index_table.suffix = fts_get_suffix(selected);
-
-		/* We've search all indexes. */
-		if (optim->fts_index_table.suffix == NULL) {
-			return(DB_TABLE_NOT_FOUND);
-		}
+	ut_ad(optim->fts_index_table.suffix != NULL);
 
-		info = pars_info_create();
-
-		pars_info_bind_function(
-			info, "my_func", fts_fetch_index_words, optim->zip);
+	info = pars_info_create();
 
-		pars_info_bind_varchar_literal(
-			info, "word", word->f_str, word->f_len);
+	pars_info_bind_function(
+		info, "my_func", fts_fetch_index_words, zip);
 
-		graph = fts_parse_sql(
-			&optim->fts_index_table,
-			info,
-			"DECLARE FUNCTION my_func;\n"
-			"DECLARE CURSOR c IS"
-			" SELECT word\n"
-			" FROM \"%s\"\n"
-			" WHERE word > :word\n"
-			" ORDER BY word;\n"
-			"BEGIN\n"
-			"\n"
-			"OPEN c;\n"
-			"WHILE 1 = 1 LOOP\n"
-			"  FETCH c INTO my_func();\n"
-			"  IF c % NOTFOUND THEN\n"
-			"    EXIT;\n"
-			"  END IF;\n"
-			"END LOOP;\n"
-			"CLOSE c;");
+	pars_info_bind_varchar_literal(
+		info, "word", word->f_str, word->f_len);
 
-		zip = optim->zip;
+	graph = fts_parse_sql(
+		&optim->fts_index_table,
+		info,
+		"DECLARE FUNCTION my_func;\n"
+		"DECLARE CURSOR c IS"
+		" SELECT word\n"
+		" FROM \"%s\"\n"
+		" WHERE word > :word\n"
+		" ORDER BY word;\n"
+		"BEGIN\n"
+		"\n"
+		"OPEN c;\n"
+		"WHILE 1 = 1 LOOP\n"
+		"  FETCH c INTO my_func();\n"
+		"  IF c % NOTFOUND THEN\n"
+		"    EXIT;\n"
+		"  END IF;\n"
+		"END LOOP;\n"
+		"CLOSE c;");
 
-		for(;;) {
-			int	err;
+	for(;;) {
+		int	err;
 
-			if (!inited && ((err = deflateInit(zip->zp, 9))
-					!= Z_OK)) {
-				ut_print_timestamp(stderr);
-				fprintf(stderr,
-					" InnoDB: Error: ZLib deflateInit() "
-					"failed: %d\n", err);
+		if (!inited && ((err = deflateInit(zip->zp, 9))
+				!= Z_OK)) {
+			ut_print_timestamp(stderr);
+			fprintf(stderr,
+				" InnoDB: Error: ZLib deflateInit() "
+				"failed: %d\n", err);
 
-				error = DB_ERROR;
-				break;
-			} else {
-				inited = TRUE;
-				error = fts_eval_sql(optim->trx, graph);
-			}
+			error = DB_ERROR;
+			break;
+		} else {
+			inited = TRUE;
+			error = fts_eval_sql(optim->trx, graph);
+		}
 
-			if (error == DB_SUCCESS) {
-				//FIXME fts_sql_commit(optim->trx);
-				break;
-			} else {
-				//FIXME fts_sql_rollback(optim->trx);
+		if (error == DB_SUCCESS) {
+			//FIXME fts_sql_commit(optim->trx);
+			break;
+		} else {
+			//FIXME fts_sql_rollback(optim->trx);
 
-				ut_print_timestamp(stderr);
+			ut_print_timestamp(stderr);
 
-				if (error == DB_LOCK_WAIT_TIMEOUT) {
-					fprintf(stderr, " InnoDB: "
-						"Warning: lock wait "
-						"timeout reading document. "
-						"Retrying!\n");
+			if (error == DB_LOCK_WAIT_TIMEOUT) {
+				fprintf(stderr, " InnoDB: "
+					"Warning: lock wait "
+					"timeout reading document. "
+					"Retrying!\n");
 
-					/* We need to reset the ZLib state. */
-					inited = FALSE;
-					deflateEnd(zip->zp);
-					fts_zip_init(zip);
+				/* We need to reset the ZLib state. */
+				inited = FALSE;
+				deflateEnd(zip->zp);
+				fts_zip_init(zip);
 
-					optim->trx->error_state = DB_SUCCESS;
-				} else {
-					fprintf(stderr, " InnoDB: Error: (%s) "
-						"while reading document.\n",
-						ut_strerr(error));
+				optim->trx->error_state = DB_SUCCESS;
+			} else {
+				fprintf(stderr, " InnoDB: Error: (%s) "
+					"while reading document.\n",
+					ut_strerr(error));
 
-					break;	/* Exit the loop. */
-				}
+				break;	/* Exit the loop. */
 			}
 		}
-
-		fts_que_graph_free(graph);
-
-		/* Check if max word to fetch is exceeded */
-		if (optim->zip->n_words >= n_words) {
-			break;
-		}
 	}
 
+	fts_que_graph_free(graph);
+
 	if (error == DB_SUCCESS && zip->status == Z_OK && zip->n_words > 0) {
 
 		/* All data should have been read. */
@@ -1578,7 +1603,7 @@ fts_optimize_compact(
 			we use this value for restarting optimize. */
 			error = fts_config_set_index_value(
 				optim->trx, index,
-				FTS_LAST_OPTIMIZED_WORD, &word->text);
+				optim->last_word_param, &word->text);
 		}
 
 		/* Free the word that was optimized. */
@@ -1601,7 +1626,10 @@ static
 fts_optimize_t*
 fts_optimize_create(
 /*================*/
-	dict_table_t*	table)		/*!< in: table with FTS indexes */
+	dict_table_t*	table,		/*!< in: table with FTS indexes */
+	fts_optimize_t*	parent)		/*!< in: optimize instance of the
+					table when creating the instance
+					of a partition, else NULL */
 {
 	fts_optimize_t*	optim;
 	mem_heap_t*	heap = mem_heap_create(128);
@@ -1610,7 +1638,10 @@ fts_optimize_create(
 
 	optim->self_heap = ib_heap_allocator_create(heap);
 
-	optim->to_delete = fts_doc_ids_create();
+	optim->parent = parent;
+
+	optim->to_delete = parent != NULL
+		? parent->to_delete : fts_doc_ids_create();
 
 	optim->words = ib_vector_create(
 		optim->self_heap, sizeof(fts_word_t), 256);
@@ -1742,7 +1773,10 @@ fts_optimize_free(
 
 	trx_free_for_background(optim->trx);
 
-	fts_doc_ids_free(optim->to_delete);
+	if (optim->parent == NULL) {
+		fts_doc_ids_free(optim->to_delete);
+	}
+
 	fts_optimize_graph_free(&optim->graph);
 
 	mem_free(optim->name_prefix);
@@ -1789,10 +1823,6 @@ fts_optimize_words(
 
 	ut_a(!optim->done);
 
-	/* Get the time limit from the config table. */
-	fts_optimize_time_limit = fts_optimize_get_time_limit(
-		optim->trx, &optim->fts_common_table);
-
 	start_time = ut_time();
 
 	/* Setup the callback to use for fetching the word ilist etc. */
@@ -1867,55 +1897,23 @@ fts_optimize_words(
 	}
 }
 
-/**********************************************************************//**
-Select the FTS index to search.
-@return TRUE if last index */
-static
-ibool
-fts_optimize_set_next_word(
-/*=======================*/
-	CHARSET_INFO*	charset,	/*!< in: charset */
-	fts_string_t*	word)		/*!< in: current last word */
-{
-	ulint		selected;
-	ibool		last = FALSE;
-
-	selected = fts_select_next_index(charset, word->f_str, word->f_len);
-
-	/* If this was the last index then reset to start. */
-	if (fts_index_selector[selected].value == 0) {
-		/* Reset the last optimized word to '' if no
-		more words could be read from the FTS index. */
-		word->f_len = 0;
-		*word->f_str = 0;
-
-		last = TRUE;
-	} else {
-		ulint	value = fts_index_selector[selected].value;
-
-		ut_a(value <= 0xff);
-
-		/* Set to the first character of the next slot. */
-		word->f_len = 1;
-		*word->f_str = (byte) value;
-	}
-
-	return(last);
-}
-
 /**********************************************************************//**
 Optimize is complete. Set the completion time, and reset the optimize
-start string for this FTS index to "".
+start string of every partition of this FTS index to "".
 @return DB_SUCCESS if all OK */
 static MY_ATTRIBUTE((nonnull, warn_unused_result))
 dberr_t
 fts_optimize_index_completed(
 /*=========================*/
-	fts_optimize_t*	optim,	/*!< in: optimize instance */
-	dict_index_t*	index)	/*!< in: table with one FTS index */
+	fts_optimize_t*			optim,	/*!< in: optimize instance */
+	dict_index_t*			index,	/*!< in: table with one FTS
+						index */
+	const fts_optimize_pll_t*	pll)	/*!< in: partitions of the
+						index */
 {
 	fts_string_t	word;
 	dberr_t		error;
+	ulint		i;
 	byte		buf[sizeof(ulint)];
 #ifdef FTS_OPTIMIZE_DEBUG
 	ib_time_t	end_time = ut_time();
@@ -1930,8 +1928,13 @@ fts_optimize_index_completed(
 	word.f_str = buf;
 	*word.f_str = '\0';
 
-	error = fts_config_set_index_value(
-		optim->trx, index, FTS_LAST_OPTIMIZED_WORD, &word);
+	error = DB_SUCCESS;
+
+	for (i = 0; i < pll->n_parts && error == DB_SUCCESS; ++i) {
+		error = fts_config_set_index_value(
+			optim->trx, index,
+			pll->parts[i].optim->last_word_param, &word);
+	}
 
 	if (error != DB_SUCCESS) {
 
@@ -1944,65 +1947,143 @@ fts_optimize_index_completed(
 
 
 /**********************************************************************//**
-Read the list of words from the FTS auxiliary index that will be
-optimized in this pass.
+Read the last word that was optimized in a partition from the config
+table. A missing parameter is created, so that the threads optimizing
+the partitions only ever update existing rows of the config table.
 @return DB_SUCCESS if all OK */
 static MY_ATTRIBUTE((nonnull, warn_unused_result))
 dberr_t
-fts_optimize_index_read_words(
-/*==========================*/
-	fts_optimize_t*	optim,	/*!< in: optimize instance */
-	dict_index_t*	index,	/*!< in: table with one FTS index */
-	fts_string_t*	word)	/*!< in: buffer to use */
+fts_optimize_part_read_word(
+/*========================*/
+	fts_optimize_t*		optim,	/*!< in: optimize instance */
+	dict_index_t*		index,	/*!< in: table with one FTS index */
+	fts_optimize_part_t*	part)	/*!< in/out: partition */
 {
-	dberr_t	error = DB_SUCCESS;
+	dberr_t		error = DB_RECORD_NOT_FOUND;
+	fts_string_t*	word = &part->word;
 
-	if (optim->del_list_regenerated) {
-		word->f_len = 0;
-	} else {
+	word->f_str = part->str;
+
+	/* We set the length of word to the size of str since we
+	need to pass the max len info to the fts_get_config_value() function. */
+	word->f_len = sizeof(part->str) - 1;
+
+	memset(word->f_str, 0x0, word->f_len);
+
+	if (!optim->del_list_regenerated) {
 
 		/* Get the last word that was optimized from
 		the config table. */
 		error = fts_config_get_index_value(
-			optim->trx, index, FTS_LAST_OPTIMIZED_WORD, word);
+			optim->trx, index,
+			part->optim->last_word_param, word);
 	}
 
 	/* If record not found then we start from the top. */
 	if (error == DB_RECORD_NOT_FOUND) {
 		word->f_len = 0;
-		error = DB_SUCCESS;
+		*word->f_str = '\0';
+
+		error = fts_config_set_index_value(
+			optim->trx, index,
+			part->optim->last_word_param, word);
 	}
 
-	while (error == DB_SUCCESS) {
+	return(error);
+}
 
-		error = fts_index_fetch_words(
-			optim, word, fts_num_word_optimize);
+/**********************************************************************//**
+Optimize the next batch of words of an auxiliary index partition. */
+static
+void
+fts_optimize_part(
+/*==============*/
+	const fts_optimize_pll_t*	pll,	/*!< in: partitions of the
+						index */
+	fts_optimize_part_t*		part)	/*!< in/out: partition */
+{
+	fts_optimize_t*	optim = part->optim;
 
-		if (error == DB_SUCCESS) {
+	optim->done = FALSE; /* Optimize until !done */
 
-			/* If the search returned an empty set
-			try the next index in the horizontal split. */
-			if (optim->zip->n_words > 0) {
-				break;
-			} else {
+	/* Read the words that will be optimized in this pass. */
+	part->error = fts_index_fetch_words(optim, &part->word, pll->n_words);
 
-				fts_optimize_set_next_word(
-					optim->fts_index_table.charset,
-					word);
+	if (part->error != DB_SUCCESS) {
 
-				if (word->f_len == 0) {
-					break;
-				}
-			}
+		fts_sql_rollback(optim->trx);
+		return;
+	}
+
+	/* If no words are left after the last word optimized then the
+	partition is complete. */
+	if (optim->zip->n_words == 0) {
+
+		part->exhausted = TRUE;
+	} else {
+		int		zip_error;
+		fts_string_t	word;
+
+		ut_a(optim->zip->pos == 0);
+		ut_a(optim->zip->zp->total_in == 0);
+		ut_a(optim->zip->zp->total_out == 0);
+
+		zip_error = inflateInit(optim->zip->zp);
+		ut_a(zip_error == Z_OK);
+
+		word.f_len = 0;
+		word.f_str = part->str;
+
+		/* Read the first word to optimize from the Zip buffer. */
+		if (fts_zip_read_word(optim->zip, &word)) {
+			fts_optimize_words(optim, pll->index, &word);
 		}
 	}
 
-	return(error);
+	/* fts_optimize_words() commits each batch it writes, this ends
+	the read of the words. */
+	fts_sql_commit(optim->trx);
 }
 
 /**********************************************************************//**
-Run OPTIMIZE on the given FTS index. Note: this can take a very long
-time (hours).
+Optimize partitions of an FTS index until no partition is left. */
+static
+void
+fts_optimize_part_worker(
+/*=====================*/
+	fts_optimize_pll_t*	pll)	/*!< in/out: partitions of the index */
+{
+	for (;;) {
+		ulint	i = os_atomic_increment_ulint(&pll->next_part, 1) - 1;
+
+		if (i >= pll->n_parts) {
+			break;
+		}
+
+		fts_optimize_part(pll, &pll->parts[i]);
+	}
+}
+
+/*********************************************************************//**
+Thread entry point of a partition optimize thread.
+@return OS_THREAD_DUMMY_RETURN */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(fts_optimize_part_thread)(
+/*=====================================*/
+	void*	arg)	/*!< in: fts_optimize_pll_t* */
+{
+	fts_optimize_part_worker(static_cast<fts_optimize_pll_t*>(arg));
+
+	os_thread_exit(NULL, false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/**********************************************************************//**
+Run OPTIMIZE on the given FTS index. The auxiliary index partitions are
+optimized by up to fts_optimize_threads threads, each partition in its
+own transactions. Note: this can take a very long time (hours).
 @return DB_SUCCESS if all OK */
 static MY_ATTRIBUTE((nonnull, warn_unused_result))
 dberr_t
@@ -2011,57 +2092,101 @@ fts_optimize_index(
 	fts_optimize_t*	optim,	/*!< in: optimize instance */
 	dict_index_t*	index)	/*!< in: table with one FTS index */
 {
-	fts_string_t	word;
-	dberr_t		error;
-	byte		str[FTS_MAX_WORD_LEN + 1];
+	fts_optimize_pll_t	pll;
+	os_thread_t*		threads;
+	ulint			n_threads;
+	ulint			i;
+	dberr_t			error = DB_SUCCESS;
+	mem_heap_t*		heap = mem_heap_create(1024);
 
 	/* Set the current index that we have to optimize. */
 	optim->fts_index_table.index_id = index->id;
 	optim->fts_index_table.charset = fts_index_get_charset(index);
 
-	optim->done = FALSE; /* Optimize until !done */
+	for (pll.n_parts = 0;
+	     fts_index_selector[pll.n_parts].value;
+	     ++pll.n_parts) {
+	}
 
-	/* We need to read the last word optimized so that we start from
-	the next word. */
-	word.f_str = str;
+	pll.index = index;
+	pll.next_part = 0;
+	pll.parts = static_cast<fts_optimize_part_t*>(
+		mem_heap_zalloc(heap, pll.n_parts * sizeof *pll.parts));
 
-	/* We set the length of word to the size of str since we
-	need to pass the max len info to the fts_get_config_value() function. */
-	word.f_len = sizeof(str) - 1;
+	/* The words of a pass are shared out between the partitions. */
+	pll.n_words = ut_max(fts_num_word_optimize / pll.n_parts, 1);
 
-	memset(word.f_str, 0x0, word.f_len);
+	/* Get the time limit from the config table. */
+	fts_optimize_time_limit = fts_optimize_get_time_limit(
+		optim->trx, &optim->fts_common_table);
 
-	/* Read the words that will be optimized in this pass. */
-	error = fts_optimize_index_read_words(optim, index, &word);
+	for (i = 0; i < pll.n_parts && error == DB_SUCCESS; ++i) {
+		fts_optimize_part_t*	part = &pll.parts[i];
+		fts_optimize_t*		part_optim;
+
+		part_optim = fts_optimize_create(optim->table, optim);
+
+		part_optim->fts_index_table.index_id = index->id;
+		part_optim->fts_index_table.charset =
+			optim->fts_index_table.charset;
+		part_optim->fts_index_table.suffix = fts_get_suffix(i);
+
+		part_optim->last_word_param = mem_heap_printf(
+			heap, "%s_%s", FTS_LAST_OPTIMIZED_WORD,
+			fts_get_suffix(i));
+
+		part->optim = part_optim;
+		part->error = DB_SUCCESS;
+
+		/* We need to read the last word optimized so that we
+		start from the next word. */
+		error = fts_optimize_part_read_word(optim, index, part);
+	}
 
 	if (error == DB_SUCCESS) {
-		int	zip_error;
+		ibool	exhausted = TRUE;
 
-		ut_a(optim->zip->pos == 0);
-		ut_a(optim->zip->zp->total_in == 0);
-		ut_a(optim->zip->zp->total_out == 0);
+		/* The partition threads update the config table too, they
+		must not wait for locks that this thread holds while it
+		waits for them. */
+		fts_sql_commit(optim->trx);
 
-		zip_error = inflateInit(optim->zip->zp);
-		ut_a(zip_error == Z_OK);
+		n_threads = ut_min(ut_max(fts_optimize_threads, 1),
+				   pll.n_parts);
 
-		word.f_len = 0;
-		word.f_str = str;
+		threads = static_cast<os_thread_t*>(
+			mem_heap_zalloc(heap, n_threads * sizeof *threads));
 
-		/* Read the first word to optimize from the Zip buffer. */
-		if (!fts_zip_read_word(optim->zip, &word)) {
+		/* The calling thread optimizes partitions as well. */
+		for (i = 1; i < n_threads; ++i) {
+			threads[i] = os_thread_create(
+				fts_optimize_part_thread, &pll, NULL);
+		}
 
-			optim->done = TRUE;
-		} else {
-			fts_optimize_words(optim, index, &word);
+		fts_optimize_part_worker(&pll);
+
+		for (i = 1; i < n_threads; ++i) {
+			os_thread_join(threads[i]);
+		}
+
+		for (i = 0; i < pll.n_parts; ++i) {
+			if (error == DB_SUCCESS) {
+				error = pll.parts[i].error;
+			}
+
+			if (!pll.parts[i].exhausted) {
+				exhausted = FALSE;
+			}
 		}
 
 		/* If we couldn't read any records then optimize is
 		complete. Increment the number of indexes that have
 		been optimized and set FTS index optimize state to
 		completed. */
-		if (error == DB_SUCCESS && optim->zip->n_words == 0) {
+		if (error == DB_SUCCESS && exhausted) {
 
-			error = fts_optimize_index_completed(optim, index);
+			error = fts_optimize_index_completed(
+				optim, index, &pll);
 
 			if (error == DB_SUCCESS) {
 				++optim->n_completed;
@@ -2069,6 +2194,20 @@ fts_optimize_index(
 		}
 	}
 
+	if (error == DB_SUCCESS) {
+		fts_sql_commit(optim->trx);
+	} else {
+		fts_sql_rollback(optim->trx);
+	}
+
+	for (i = 0; i < pll.n_parts; ++i) {
+		if (pll.parts[i].optim != NULL) {
+			fts_optimize_free(pll.parts[i].optim);
+		}
+	}
+
+	mem_heap_free(heap);
+
 	return(error);
 }
 
@@ -2458,7 +2597,7 @@ fts_optimize_table(
 	ut_print_timestamp(stderr);
 	fprintf(stderr, " InnoDB: FTS start optimize %s\n", table->name);
 
-	optim = fts_optimize_create(table);
+	optim = fts_optimize_create(table, NULL);
 
 	// FIXME: Call this only at the start of optimize, currently we
 	// rely on DB_DUPLICATE_KEY to handle corrupting the snapshot.
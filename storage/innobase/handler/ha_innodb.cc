@@ -78,6 +78,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "fil0fil.h"
 #include "trx0xa.h"
 #include "row0merge.h"
+#include "row0pread.h"
 #include "dict0boot.h"
 #include "dict0stats.h"
 #include "dict0stats_bg.h"
@@ -282,6 +283,24 @@ static TYPELIB innodb_default_row_format_typelib = {
     array_elements(innodb_default_row_format_names) - 1,
     "innodb_default_row_format_typelib", innodb_default_row_format_names, NULL};
 
+/** Possible values for system variable "innodb_compression_algorithm",
+in the order of page_zip_algo_t. */
+static const char* innodb_compression_algorithm_names[] = {
+	"zlib",
+	"lz4",
+	"zstd",
+	NullS
+};
+
+/** Used to define an enumerate type of the system variable
+innodb_compression_algorithm. */
+static TYPELIB innodb_compression_algorithm_typelib = {
+	array_elements(innodb_compression_algorithm_names) - 1,
+	"innodb_compression_algorithm_typelib",
+	innodb_compression_algorithm_names,
+	NULL
+};
+
 /* The following counter is used to convey information to InnoDB
 about server activity: in case of normal DML ops it is not
 sensible to call srv_active_wake_master_thread after each
@@ -347,6 +366,7 @@ static PSI_mutex_info all_innodb_mutexes[] = {
 	{&dict_sys_mutex_key, "dict_sys_mutex", 0},
 	{&file_format_max_mutex_key, "file_format_max_mutex", 0},
 	{&fil_system_mutex_key, "fil_system_mutex", 0},
+	{&fil_shard_mutex_key, "fil_shard_mutex", 0},
 	{&flush_list_mutex_key, "flush_list_mutex", 0},
 	{&fts_bg_threads_mutex_key, "fts_bg_threads_mutex", 0},
 	{&fts_delete_mutex_key, "fts_delete_mutex", 0},
@@ -736,6 +756,15 @@ static MYSQL_THDVAR_STR(tmpdir,
   "Directory for temporary non-tablespace files.",
   innodb_tmpdir_validate, NULL, NULL);
 
+static MYSQL_THDVAR_ENUM(compression_algorithm, PLUGIN_VAR_RQCMDARG,
+  "The algorithm used to compress the pages of ROW_FORMAT=COMPRESSED tables "
+  "created by this session, or rebuilt by an ALTER TABLE that specifies "
+  "ROW_FORMAT or KEY_BLOCK_SIZE. Other rebuilds keep the algorithm of the "
+  "table. Possible values are ZLIB (default), LZ4 and ZSTD. Each compressed "
+  "page records the algorithm it was compressed with, so existing tables "
+  "are not affected by this setting.",
+  NULL, NULL, PAGE_ZIP_ALGO_ZLIB, &innodb_compression_algorithm_typelib);
+
 static SHOW_VAR latency_histogram_async_read[NUMBER_OF_HISTOGRAM_BINS + 1];
 static SHOW_VAR latency_histogram_async_write[NUMBER_OF_HISTOGRAM_BINS + 1];
 
@@ -3203,7 +3232,8 @@ ha_innobase::ha_innobase(
 		  HA_BINLOG_ROW_CAPABLE |
 		  HA_CAN_GEOMETRY | HA_PARTIAL_COLUMN_READ |
 		  HA_TABLE_SCAN_ON_INDEX | HA_CAN_FULLTEXT |
-		  HA_CAN_FULLTEXT_EXT | HA_CAN_EXPORT | HA_ONLINE_ANALYZE),
+		  HA_CAN_FULLTEXT_EXT | HA_CAN_EXPORT | HA_ONLINE_ANALYZE |
+		  HA_HAS_RECORDS),
 	start_of_scan(0),
 	num_write_row(0),
 	ha_partition_stats(NULL)
@@ -10451,6 +10481,10 @@ ha_innobase::update_create_info(
 	if (prebuilt->table->data_dir_path) {
 		create_info->data_file_name = prebuilt->table->data_dir_path;
 	}
+
+	/* Let a rebuild keep the compression algorithm of the table */
+	create_info->page_compression = static_cast<uint>(
+		DICT_TF2_GET_ZIP_ALGO(prebuilt->table->flags2)) + 1;
 }
 
 /*****************************************************************//**
@@ -10810,6 +10844,22 @@ index_bad:
 		*flags2 |= DICT_TF2_USE_TABLESPACE;
 	}
 
+	if (zip_ssize) {
+		ulint	zip_algo = THDVAR(thd, compression_algorithm);
+
+		/* A rebuild keeps the compression algorithm of the table,
+		unless it specifies ROW_FORMAT or KEY_BLOCK_SIZE and thereby
+		asks for innodb_compression_algorithm. */
+		if (create_info->page_compression
+		    && !(create_info->used_fields
+			 & (HA_CREATE_USED_ROW_FORMAT
+			    | HA_CREATE_USED_KEY_BLOCK_SIZE))) {
+			zip_algo = create_info->page_compression - 1;
+		}
+
+		*flags2 |= zip_algo << DICT_TF2_POS_ZIP_ALGO;
+	}
+
 	/* Set the flags2 when create table or alter tables */
 	*flags2 |= DICT_TF2_FTS_AUX_HEX_NAME;
 	DBUG_EXECUTE_IF("innodb_test_wrong_fts_aux_table_name",
@@ -11846,6 +11896,87 @@ ha_innobase::rename_table(
 	DBUG_RETURN(convert_error_code_to_mysql(error, 0, NULL));
 }
 
+/*********************************************************************//**
+Checks if records() can count the rows of the table in the current
+statement, which EXPLAIN asks instead of counting them.
+@return	false if the rows must be counted with a regular table scan */
+UNIV_INTERN
+bool
+ha_innobase::can_count_records()
+/*============================*/
+{
+	dict_index_t*	index;
+
+	DBUG_ENTER("ha_innobase::can_count_records");
+
+	update_thd(ha_thd());
+
+	/* Locking reads and SERIALIZABLE must go through
+	row_search_for_mysql() so that the rows get locked. */
+	if (prebuilt->select_lock_type != LOCK_NONE
+	    || prebuilt->trx->isolation_level == TRX_ISO_SERIALIZABLE
+	    || dict_table_is_discarded(prebuilt->table)
+	    || prebuilt->table->ibd_file_missing) {
+
+		DBUG_RETURN(false);
+	}
+
+	index = dict_table_get_first_index(prebuilt->table);
+
+	DBUG_RETURN(!dict_index_is_corrupted(index)
+		    && row_merge_is_index_usable(prebuilt->trx, index));
+}
+
+/*********************************************************************//**
+Returns the exact number of rows in the table as seen by the current
+transaction, for SELECT COUNT(*) without a WHERE clause. The clustered
+index is scanned by innodb_parallel_read_threads threads that share the
+read view of the transaction.
+@return	number of rows, or HA_POS_ERROR if the rows must be counted
+with a regular table scan */
+UNIV_INTERN
+ha_rows
+ha_innobase::records()
+/*==================*/
+{
+	dict_index_t*	index;
+	ulint		n_rows;
+	dberr_t		err;
+
+	DBUG_ENTER("ha_innobase::records");
+
+	if (!can_count_records()) {
+
+		DBUG_RETURN(HA_POS_ERROR);
+	}
+
+	index = dict_table_get_first_index(prebuilt->table);
+
+	/* In case MySQL calls this in the middle of a SELECT query, release
+	possible adaptive hash latch to avoid deadlocks of threads */
+
+	trx_search_latch_release_if_reserved(prebuilt->trx);
+
+	prebuilt->trx->op_info = "counting rows";
+
+	trx_start_if_not_started(prebuilt->trx);
+
+	if (prebuilt->trx->isolation_level > TRX_ISO_READ_UNCOMMITTED) {
+		trx_assign_read_view(prebuilt->trx);
+	}
+
+	err = row_pread_count(prebuilt->trx, index,
+			      srv_parallel_read_threads, false, &n_rows);
+
+	prebuilt->trx->op_info = "";
+
+	if (err != DB_SUCCESS) {
+		DBUG_RETURN(HA_POS_ERROR);
+	}
+
+	DBUG_RETURN((ha_rows) n_rows);
+}
+
 /*********************************************************************//**
 Estimates the number of index records in a range.
 @return	estimated number of rows */
@@ -12954,7 +13085,37 @@ ha_innobase::check(
 		prebuilt->select_lock_type = LOCK_NONE;
 		prebuilt->select_x_lock_type = LOCK_X_REGULAR;
 
-		if (!row_check_index_for_mysql(prebuilt, index, &n_rows)) {
+		bool	index_ok;
+
+		if (dict_index_is_clust(index)) {
+			/* Count the rows of the clustered index in
+			parallel, on the read view of this transaction. */
+			trx_assign_read_view(prebuilt->trx);
+
+			dberr_t	err = row_pread_count(
+				prebuilt->trx, index,
+				srv_parallel_read_threads, true, &n_rows);
+
+			index_ok = (err != DB_CORRUPTION);
+
+			if (err != DB_SUCCESS && err != DB_CORRUPTION
+			    && err != DB_INTERRUPTED) {
+				/* This error is ignored by CHECK TABLE,
+				as in row_check_index_for_mysql(). */
+				ut_print_timestamp(stderr);
+				fputs("  InnoDB: Warning: CHECK TABLE on ",
+				      stderr);
+				dict_index_name_print(stderr, prebuilt->trx,
+						      index);
+				fprintf(stderr, " returned %lu\n",
+					(ulong) err);
+			}
+		} else {
+			index_ok = row_check_index_for_mysql(
+				prebuilt, index, &n_rows);
+		}
+
+		if (!index_ok) {
 			innobase_format_name(
 				index_name, sizeof index_name,
 				index->name, TRUE);
@@ -18296,6 +18457,12 @@ static MYSQL_SYSVAR_BOOL(buffer_pool_load_at_startup, srv_buffer_pool_load_at_st
   "Load the buffer pool from a file named @@innodb_buffer_pool_filename",
   NULL, NULL, FALSE);
 
+static MYSQL_SYSVAR_BOOL(buffer_pool_load_fast, srv_buffer_pool_load_fast,
+  PLUGIN_VAR_OPCMDARG,
+  "Load the buffer pool hottest pages first, reading the pages of each "
+  "extent as one batch of asynchronous requests",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_BOOL(defragment, srv_defragment,
   PLUGIN_VAR_RQCMDARG,
   "Enable/disable InnoDB defragmentation. When set to FALSE, all existing "
@@ -18440,11 +18607,22 @@ static MYSQL_SYSVAR_ULONG(ft_num_word_optimize, fts_num_word_optimize,
   "InnoDB Fulltext search number of words to optimize for each optimize table call ",
   NULL, NULL, 2000, 1000, 10000, 0);
 
+static MYSQL_SYSVAR_ULONG(ft_optimize_threads, fts_optimize_threads,
+  PLUGIN_VAR_OPCMDARG,
+  "InnoDB Fulltext search number of threads that optimize the auxiliary index tables of an FTS index",
+  NULL, NULL, 2, 1, FTS_OPTIMIZE_MAX_THREADS, 0);
+
 static MYSQL_SYSVAR_ULONG(ft_sort_pll_degree, fts_sort_pll_degree,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "InnoDB Fulltext search parallel sort degree, will round up to nearest power of 2 number",
   NULL, NULL, 2, 1, 16, 0);
 
+static MYSQL_SYSVAR_ULONG(parallel_read_threads, srv_parallel_read_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads used to scan the clustered index for SELECT COUNT(*)"
+  " and CHECK TABLE.",
+  NULL, NULL, 4, 1, ROW_PREAD_MAX_THREADS, 0);
+
 static MYSQL_SYSVAR_ULONG(sort_buffer_size, srv_sort_buf_size,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "Memory buffer size for index creation",
@@ -18493,6 +18671,13 @@ static MYSQL_SYSVAR_LONG(log_buffer_size, innobase_log_buffer_size,
   "The size of the buffer which InnoDB uses to write log to the log files on disk.",
   NULL, NULL, 16*1024*1024L, 256*1024L, LONG_MAX, 1024);
 
+static MYSQL_SYSVAR_BOOL(log_writer_threads, srv_log_writer_threads,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Write and flush the redo log in dedicated log writer and log flusher"
+  " threads, which batch the writes of concurrent commits and overlap them"
+  " with the flush of the previous batch.",
+  NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_LONGLONG(log_file_size, innobase_log_file_size,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "Size of each log file in a log group.",
@@ -18614,6 +18799,21 @@ static MYSQL_SYSVAR_ULONG(undo_logs, srv_undo_logs,
   1,			/* Minimum value */
   TRX_SYS_N_RSEGS, 0);	/* Maximum value */
 
+static MYSQL_SYSVAR_BOOL(undo_log_truncate, srv_undo_log_truncate,
+  PLUGIN_VAR_OPCMDARG,
+  "Enable or disable truncation of undo tablespaces that grew beyond"
+  " innodb_max_undo_log_size.",
+  NULL, NULL, FALSE);
+
+static MYSQL_SYSVAR_ULONGLONG(max_undo_log_size, srv_max_undo_log_size,
+  PLUGIN_VAR_OPCMDARG,
+  "Size in bytes above which purge truncates an undo tablespace when"
+  " innodb_undo_log_truncate is enabled.",
+  NULL, NULL,
+  1024 * 1024 * 1024L,	/* Default setting */
+  10 * 1024 * 1024L,	/* Minimum value */
+  ~0ULL, 0);		/* Maximum value */
+
 /* Alias for innodb_undo_logs, this config variable is deprecated. */
 static MYSQL_SYSVAR_ULONG(rollback_segments, srv_undo_logs,
   PLUGIN_VAR_OPCMDARG,
@@ -18982,6 +19182,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(buffer_pool_load_now),
   MYSQL_SYSVAR(buffer_pool_load_abort),
   MYSQL_SYSVAR(buffer_pool_load_at_startup),
+  MYSQL_SYSVAR(buffer_pool_load_fast),
   MYSQL_SYSVAR(defragment),
   MYSQL_SYSVAR(defragment_pause),
   MYSQL_SYSVAR(defragment_n_pages),
@@ -18997,6 +19198,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(commit_concurrency),
   MYSQL_SYSVAR(concurrency_tickets),
   MYSQL_SYSVAR(compression_level),
+  MYSQL_SYSVAR(compression_algorithm),
   MYSQL_SYSVAR(data_file_path),
   MYSQL_SYSVAR(data_home_dir),
   MYSQL_SYSVAR(deadlock_detect),
@@ -19029,7 +19231,9 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(ft_max_token_size),
   MYSQL_SYSVAR(ft_min_token_size),
   MYSQL_SYSVAR(ft_num_word_optimize),
+  MYSQL_SYSVAR(ft_optimize_threads),
   MYSQL_SYSVAR(ft_sort_pll_degree),
+  MYSQL_SYSVAR(parallel_read_threads),
   MYSQL_SYSVAR(large_prefix),
   MYSQL_SYSVAR(force_load_corrupted),
   MYSQL_SYSVAR(locks_unsafe_for_binlog),
@@ -19040,6 +19244,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
 #endif /* UNIV_LOG_ARCHIVE */
   MYSQL_SYSVAR(page_size),
   MYSQL_SYSVAR(log_buffer_size),
+  MYSQL_SYSVAR(log_writer_threads),
   MYSQL_SYSVAR(log_file_size),
   MYSQL_SYSVAR(log_files_in_group),
   MYSQL_SYSVAR(log_group_home_dir),
@@ -19139,6 +19344,8 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(rollback_segments),
   MYSQL_SYSVAR(undo_directory),
   MYSQL_SYSVAR(undo_tablespaces),
+  MYSQL_SYSVAR(undo_log_truncate),
+  MYSQL_SYSVAR(max_undo_log_size),
   MYSQL_SYSVAR(sync_array_size),
   MYSQL_SYSVAR(compression_failure_threshold_pct),
   MYSQL_SYSVAR(compression_pad_pct_max),
@@ -3709,13 +3709,16 @@ static ST_FIELD_INFO	i_s_fts_index_fields_info[] =
 
 /*******************************************************************//**
 Go through the Doc Node and its ilist, fill the dynamic table
-INFORMATION_SCHEMA.INNODB_FT_INDEX_CACHED for one FTS index on the table.
+INFORMATION_SCHEMA.INNODB_FT_INDEX_CACHED for one word tree of an FTS
+index on the table.
 @return	0 on success, 1 on failure */
 static
 int
 i_s_fts_index_cache_fill_one_index(
 /*===============================*/
 	fts_index_cache_t*	index_cache,	/*!< in: FTS index cache */
+	const ib_rbt_t*		words,		/*!< in: words of the cache,
+						or the words being synced */
 	THD*			thd,		/*!< in: thread */
 	TABLE_LIST*		tables)		/*!< in/out: tables to fill */
 {
@@ -3738,9 +3741,9 @@ i_s_fts_index_cache_fill_one_index(
 	conv_str.f_n_char = 0;
 
 	/* Go through each word in the index cache */
-	for (rbt_node = rbt_first(index_cache->words);
+	for (rbt_node = rbt_first(words);
 	     rbt_node;
-	     rbt_node = rbt_next(index_cache->words, rbt_node)) {
+	     rbt_node = rbt_next(words, rbt_node)) {
 		fts_tokenizer_word_t* word;
 
 		word = rbt_value(fts_tokenizer_word_t, rbt_node);
@@ -3862,15 +3865,29 @@ i_s_fts_index_cache_fill(
 
 	ut_a(cache);
 
+	/* A SYNC only detaches or frees its words under the cache lock */
+	rw_lock_s_lock(&cache->lock);
+
 	for (ulint i = 0; i < ib_vector_size(cache->indexes); i++) {
 		fts_index_cache_t*      index_cache;
 
 		index_cache = static_cast<fts_index_cache_t*> (
 			ib_vector_get(cache->indexes, i));
 
-		i_s_fts_index_cache_fill_one_index(index_cache, thd, tables);
+		/* The words that a running SYNC is writing to disk hold
+		the older documents */
+		if (index_cache->sync_words != NULL) {
+			i_s_fts_index_cache_fill_one_index(
+				index_cache, index_cache->sync_words,
+				thd, tables);
+		}
+
+		i_s_fts_index_cache_fill_one_index(
+			index_cache, index_cache->words, thd, tables);
 	}
 
+	rw_lock_s_unlock(&cache->lock);
+
 	dict_table_close(user_table, FALSE, FALSE);
 
 	DBUG_RETURN(0);
@@ -6526,6 +6543,15 @@ static ST_FIELD_INFO	innodb_sys_tables_fields_info[] =
 	 STRUCT_FLD(old_name,		""),
 	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
 
+#define SYS_TABLES_COMPRESSION_ALGORITHM 8
+	{STRUCT_FLD(field_name,		"COMPRESSION_ALGORITHM"),
+	 STRUCT_FLD(field_length,	4),
+	 STRUCT_FLD(field_type,		MYSQL_TYPE_STRING),
+	 STRUCT_FLD(value,		0),
+	 STRUCT_FLD(field_flags,	MY_I_S_MAYBE_NULL),
+	 STRUCT_FLD(old_name,		""),
+	 STRUCT_FLD(open_method,	SKIP_OPEN_TABLE)},
+
 	END_OF_ST_FIELD_INFO
 };
 
@@ -6547,6 +6573,7 @@ i_s_dict_fill_sys_tables(
 	ulint	zip_size	= dict_tf_get_zip_size(table->flags);
 	const char* file_format;
 	const char* row_format;
+	const char* zip_algo = NULL;
 
 	file_format = trx_sys_file_format_id_to_name(atomic_blobs);
 	if (!compact) {
@@ -6559,6 +6586,20 @@ i_s_dict_fill_sys_tables(
 		row_format = "Dynamic";
 	}
 
+	if (zip_size) {
+		switch (DICT_TF2_GET_ZIP_ALGO(table->flags2)) {
+		case PAGE_ZIP_ALGO_ZLIB:
+			zip_algo = "zlib";
+			break;
+		case PAGE_ZIP_ALGO_LZ4:
+			zip_algo = "lz4";
+			break;
+		case PAGE_ZIP_ALGO_ZSTD:
+			zip_algo = "zstd";
+			break;
+		}
+	}
+
 	DBUG_ENTER("i_s_dict_fill_sys_tables");
 
 	fields = table_to_fill->field;
@@ -6580,6 +6621,9 @@ i_s_dict_fill_sys_tables(
 	OK(fields[SYS_TABLES_ZIP_PAGE_SIZE]->store(
 		static_cast<double>(zip_size)));
 
+	OK(field_store_string(fields[SYS_TABLES_COMPRESSION_ALGORITHM],
+			      zip_algo));
+
 	OK(schema_table_store_record(thd, table_to_fill));
 
 	DBUG_RETURN(0);
@@ -564,6 +564,23 @@ btr_estimate_n_rows_in_range(
 	ulint		mode2,	/*!< in: search mode for range end */
 	trx_t*		trx);	/*!< in: trx */
 /*******************************************************************//**
+Splits an index tree into key ranges for a parallel scan. The range
+boundaries are node pointers of the highest non-leaf level that has at
+least n_parts records, so that every range covers whole subtrees of
+that level and the ranges are of roughly equal size.
+@return number of ranges, at least 1 and at most n_parts; range i
+starts at bounds[i - 1] (the low end of the index for i = 0) and ends
+before bounds[i] (the high end of the index for the last range) */
+UNIV_INTERN
+ulint
+btr_cur_partition_index(
+/*====================*/
+	dict_index_t*	index,	/*!< in: index */
+	ulint		n_parts,/*!< in: desired number of ranges */
+	dtuple_t**	bounds,	/*!< out: n_parts - 1 range boundaries,
+				allocated from heap */
+	mem_heap_t*	heap);	/*!< in/out: memory heap */
+/*******************************************************************//**
 Estimates the number of different key values in a given index, for
 each n-column prefix of the index where 1 <= n <= dict_index_get_n_unique(index).
 The estimates are stored in the array index->stat_n_diff_key_vals[] (indexed
@@ -63,7 +63,7 @@ buf_LRU_flush_or_remove_pages(
 	ulint		id,		/*!< in: space id */
 	buf_remove_t	buf_remove,	/*!< in: remove or flush strategy */
 	const trx_t*	trx);		/*!< to check if the operation must
-					be interrupted */
+					be interrupted, can be 0 */
 
 #if defined UNIV_DEBUG || defined UNIV_BUF_DEBUG
 /********************************************************************//**
@@ -94,6 +94,20 @@ buf_read_page_async(
 	ulint	space,	/*!< in: space id */
 	ulint	offset);/*!< in: page number */
 /********************************************************************//**
+Reads a batch of pages of one tablespace asynchronously into the buffer
+pool, skipping those that are already there. The requests are queued
+first and then submitted together, so that the pages of an extent reach
+the i/o handler threads as one batch. Used by the buffer pool load.
+@return number of page read requests issued */
+UNIV_INTERN
+ulint
+buf_read_pages_async(
+/*=================*/
+	ulint		space,		/*!< in: space id */
+	const ulint*	page_nos,	/*!< in: page numbers to read */
+	ulint		n_pages);	/*!< in: number of page numbers
+					in the array */
+/********************************************************************//**
 Applies a random read-ahead in buf_pool if there are at least a threshold
 value of accessed pages from the random read-ahead area. Does not read any
 page, not even the one at the position (space, offset), if the read-ahead
@@ -195,7 +195,7 @@ ROW_FORMAT=REDUNDANT.  InnoDB engines do not check these flags
 for unknown bits in order to protect backward incompatibility. */
 /* @{ */
 /** Total number of bits in table->flags2. */
-#define DICT_TF2_BITS			7
+#define DICT_TF2_BITS			9
 #define DICT_TF2_BIT_MASK		~(~0U << DICT_TF2_BITS)
 
 /** TEMPORARY; TRUE for tables from CREATE TEMPORARY TABLE. */
@@ -217,8 +217,22 @@ use its own tablespace instead of the system tablespace. */
 /** This bit is set if all aux table names (both common tables and
 index tables) of a FTS table are in HEX format. */
 #define DICT_TF2_FTS_AUX_HEX_NAME	64
+
+/** Compression algorithm of ROW_FORMAT=COMPRESSED pages, one of
+page_zip_algo_t. Zero (zlib) for all tables created before the
+algorithm could be chosen. */
+#define DICT_TF2_POS_ZIP_ALGO		7
+#define DICT_TF2_WIDTH_ZIP_ALGO		2
+#define DICT_TF2_MASK_ZIP_ALGO				\
+		((~(~0U << DICT_TF2_WIDTH_ZIP_ALGO))	\
+		<< DICT_TF2_POS_ZIP_ALGO)
 /* @} */
 
+/** Return the page compression algorithm stored in table flags2 */
+#define DICT_TF2_GET_ZIP_ALGO(flags2)				\
+		(((flags2) & DICT_TF2_MASK_ZIP_ALGO)		\
+		>> DICT_TF2_POS_ZIP_ALGO)
+
 #define DICT_TF2_FLAG_SET(table, flag)				\
 	(table->flags2 = table->flags2 | (flag))
 
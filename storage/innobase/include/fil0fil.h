@@ -222,16 +222,20 @@ struct fil_node_t {
 	ulint		n_pending;
 				/*!< count of pending i/o's on this file;
 				closing of the file is not allowed if
-				this is > 0 */
+				this is > 0; protected by the mutex of
+				the fil_shard_t of the space */
 	ulint		n_pending_flushes;
 				/*!< count of pending flushes on this file;
 				closing of the file is not allowed if
-				this is > 0 */
+				this is > 0; protected by the mutex of
+				the fil_shard_t of the space */
 	ibool		being_extended;
 				/*!< TRUE if the node is currently
 				being extended. */
 	ib_int64_t	modification_counter;/*!< when we write to the file we
-				increment this by one */
+				increment this by one; protected by
+				the mutex of the fil_shard_t of the
+				space, like flush_counter */
 	ib_int64_t	flush_counter;/*!< up to what
 				modification_counter value we have
 				flushed the modifications to disk */
@@ -242,7 +246,8 @@ struct fil_node_t {
 	UT_LIST_NODE_T(fil_node_t) chain;
 				/*!< link field for the file chain */
 	UT_LIST_NODE_T(fil_node_t) LRU;
-				/*!< link field for the LRU list */
+				/*!< link field for the LRU list of
+				the fil_shard_t of the space */
 	ulint		magic_n;/*!< FIL_NODE_MAGIC_N */
 };
 
@@ -339,7 +344,8 @@ struct fil_space_t {
 				file we have written to */
 	bool		is_in_unflushed_spaces;
 				/*!< true if this space is currently in
-				unflushed_spaces */
+				unflushed_spaces of its fil_shard_t;
+				protected by the mutex of the shard */
 	UT_LIST_NODE_T(fil_space_t) space_list;
 				/*!< list of all spaces */
 	os_io_perf2_t	io_perf2;/*!< per tablespace IO perf counters */
@@ -370,20 +376,19 @@ typedef enum {
 	FLUSH_FROM_NUMBER
 } flush_from_t;
 
-/** The tablespace memory cache; also the totality of logs (the log
-data space) is stored here; below we talk about tablespaces, but also
-the ib_logfiles form a 'space' and it is handled here */
-struct fil_system_t {
-#ifndef UNIV_HOTBACKUP
-	ib_mutex_t		mutex;		/*!< The mutex protecting the cache */
-#endif /* !UNIV_HOTBACKUP */
-	hash_table_t*	spaces;		/*!< The hash table of spaces in the
-					system; they are hashed on the space
-					id */
-	hash_table_t*	name_hash;	/*!< hash table based on the space
-					name */
-	hash_table_t* stats_hash;	/*!< hash table based on the space id
-					or fil_stats_t */
+/** Number of shards of the LRU and unflushed_spaces lists; must be a
+power of 2 */
+#define FIL_N_SHARDS	16
+
+/** The part of the tablespace memory cache that the i/o path updates
+when an i/o starts or completes. A space and its file nodes belong to
+the shard of the space id. */
+struct fil_shard_t {
+	ib_mutex_t	mutex;		/*!< The mutex protecting the lists
+					and counters below, and the pending
+					i/o and flush counts and the
+					modification and flush counters of
+					the file nodes of the shard */
 	UT_LIST_BASE_NODE_T(fil_node_t) LRU;
 					/*!< base node for the LRU list of the
 					most recently used open files with no
@@ -401,11 +406,39 @@ struct fil_system_t {
 					unflushed writes; those spaces have
 					at least one file node where
 					modification_counter > flush_counter */
+	ib_int64_t	modification_counter;/*!< when we write to a file we
+					increment this by one */
+};
+
+/** The tablespace memory cache; also the totality of logs (the log
+data space) is stored here; below we talk about tablespaces, but also
+the ib_logfiles form a 'space' and it is handled here */
+struct fil_system_t {
+#ifndef UNIV_HOTBACKUP
+	ib_mutex_t		mutex;		/*!< The mutex protecting the cache */
+#endif /* !UNIV_HOTBACKUP */
+	hash_table_t*	spaces;		/*!< The hash table of spaces in the
+					system; they are hashed on the space
+					id; changes hold both the mutex and
+					the rw-latch of the hash table for
+					the space id, so the i/o path can
+					search it with only the latch */
+	hash_table_t*	name_hash;	/*!< hash table based on the space
+					name */
+	hash_table_t* stats_hash;	/*!< hash table based on the space id
+					or fil_stats_t */
+	fil_shard_t	shards[FIL_N_SHARDS];
+					/*!< the LRU and unflushed_spaces
+					lists, sharded on the space id; a
+					file is opened or closed holding
+					both the mutex and the mutex of its
+					shard */
+	ulint		LRU_shard;	/*!< the shard where the next
+					fil_try_to_close_file_in_LRU() starts
+					looking for a file to close */
 	ulint		n_open;		/*!< number of files currently open */
 	ulint		max_n_open;	/*!< n_open is not allowed to exceed
 					this */
-	ib_int64_t	modification_counter;/*!< when we write to a file we
-					increment this by one */
 	ulint		max_assigned_id;/*!< maximum space id in the existing
 					tables, or assigned during the time
 					mysqld has been up; at an InnoDB
@@ -759,6 +792,18 @@ fil_close_tablespace(
 	ulint	id);	/*!< in: space id */
 #ifndef UNIV_HOTBACKUP
 /*******************************************************************//**
+Truncates a single-file tablespace back to the given size. All pages of
+the tablespace are discarded from the buffer pool without being written;
+the caller must re-initialize the tablespace header afterwards. Used to
+shrink undo tablespaces.
+@return	true if success */
+UNIV_INTERN
+bool
+fil_truncate_tablespace(
+/*====================*/
+	ulint		id,		/*!< in: space id */
+	ulint		size_in_pages);	/*!< in: new size in pages */
+/*******************************************************************//**
 Discards a single-table tablespace. The tablespace must be cached in the
 memory cache. Discarding is like deleting a tablespace, but
 
@@ -105,6 +105,14 @@ extern ulong		fts_sort_pll_degree;
 call */
 extern ulong		fts_num_word_optimize;
 
+/** Variable specifying the number of threads that optimize the auxiliary
+index tables of an FTS index */
+extern ulong		fts_optimize_threads;
+
+/** Maximum number of threads that optimize an FTS index, one for each of
+its auxiliary index tables */
+#define FTS_OPTIMIZE_MAX_THREADS	6
+
 /** Variable specifying whether we do additional FTS diagnostic printout
 in the log */
 extern char		fts_enable_diag_print;
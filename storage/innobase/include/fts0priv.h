@@ -72,7 +72,8 @@ typedef enum fts_table_state_enum fts_table_state_t;
 /** The next doc id */
 #define FTS_SYNCED_DOC_ID		"synced_doc_id"
 
-/** The last word that was OPTIMIZED */
+/** The last word that was OPTIMIZED. Each auxiliary index table keeps
+its own, under this name followed by the suffix of the table. */
 #define FTS_LAST_OPTIMIZED_WORD		"last_optimized_word"
 
 /** Total number of documents that have been deleted. The next_doc_id
@@ -498,6 +499,8 @@ fts_cache_find_word(
 /*================*/
 	const fts_index_cache_t*
 			index_cache,	/*!< in: cache to search */
+	const ib_rbt_t*	words,		/*!< in: index_cache->words or
+					index_cache->sync_words */
 	const fts_string_t*
 			text)		/*!< in: word to search for */
 	MY_ATTRIBUTE((nonnull, warn_unused_result));
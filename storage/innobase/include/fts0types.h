@@ -66,6 +66,11 @@ struct fts_index_cache_t {
 	ib_rbt_t*	words;		/*!< Nodes; indexed by fts_string_t*,
 					cells are fts_tokenizer_word_t*.*/
 
+	ib_rbt_t*	sync_words;	/*!< The words that a running SYNC is
+					writing to disk, NULL if none. They
+					are searched together with words
+					until the SYNC commits */
+
 	ib_vector_t*	doc_stats;	/*!< Array of the fts_doc_stats_t
 					contained in the memory buffer.
 					Must be in sorted order (ascending).
@@ -77,6 +82,8 @@ struct fts_index_cache_t {
 
 	que_t**		sel_graph;	/*!< Select query graphs */
 	CHARSET_INFO*	charset;	/*!< charset */
+
+	ib_vector_t*	sync_doc_stats;	/*!< doc_stats of sync_words */
 };
 
 /** For supporting the tracking of updates on multiple FTS indexes we need
@@ -122,10 +129,19 @@ struct fts_sync_t {
 	doc_id_t	max_doc_id;	/*!< The doc id at which the cache was
 					noted as being full, we use this to
 					set the upper_limit field */
+	doc_id_t	sync_doc_id;	/*!< max_doc_id when the running SYNC
+					took the words out of the cache */
+	mem_heap_t*	heap;		/*!< The heap of the words that the
+					running SYNC is writing, see
+					fts_cache_t::sync_heap */
+	ulint		sync_size;	/*!< fts_cache_t::total_size of the
+					words that the running SYNC is
+					writing */
 	ib_time_t	start_time;	/*!< SYNC start time */
 	bool		in_progress;	/*!< flag whether sync is in progress.*/
-	bool		unlock_cache;	/*!< flag whether unlock cache when
-					write fts node */
+	bool		unlock_cache;	/*!< flag whether the cache lock is
+					released while the words are
+					written */
 	os_event_t	event;		/*!< sync finish event */
 };
 
@@ -166,8 +182,9 @@ struct fts_cache_t {
 					disk */
 	ib_alloc_t*	sync_heap;	/*!< The heap allocator, for indexes
 					and deleted_doc_ids, ie. transient
-					objects, they are recreated after
-					a SYNC is completed */
+					objects; a SYNC takes the heap along
+					with the words it writes and starts
+					a new one for the cache */
 
 	ib_alloc_t*	self_heap;	/*!< This heap is the heap out of
 					which an instance of the cache itself
@@ -215,7 +232,6 @@ struct fts_node_t {
 	ulint		ilist_size_alloc;
 					/*!< Allocated size of ilist in
 					bytes */
-	bool		synced;		/*!< flag whether the node is synced */
 };
 
 /** A tokenizer word. Contains information about one word. */
@@ -72,6 +72,15 @@ static const char ib_logfile_basename[] = "ib_logfile";
 /** Maximum number of log groups in log_group_t::checkpoint_buf */
 #define LOG_MAX_N_GROUPS	32
 
+/** Number of events in log_sys->write_events and log_sys->flush_events;
+a thread waiting for the log writer threads to reach an lsn uses the
+event of the log block of the lsn modulo this */
+#define LOG_WAIT_EVENTS		1024
+
+/** Timeout in microseconds of the waits of the log writer threads and of
+the threads waiting for them */
+#define LOG_WAIT_TIMEOUT	100000
+
 /*******************************************************************//**
 Calculates where in log files we find a specified lsn.
 @return	log file number */
@@ -135,6 +144,36 @@ log_write_low(
 	byte*	str,		/*!< in: string */
 	ulint	str_len);	/*!< in: string length */
 /************************************************************//**
+Reserves space for a string in the log buffer. The string must then be
+copied with log_buffer_copy() and the copy completed with
+log_buffer_copy_complete(), which can be done after the log mutex has been
+released so that mini-transactions copy their log records concurrently.
+It is assumed that the caller holds the log mutex.
+@return	offset in log_sys->buf where the string is to be copied */
+UNIV_INTERN
+ulint
+log_reserve_low(
+/*============*/
+	ulint	str_len);	/*!< in: string length */
+/************************************************************//**
+Copies a string to space in the log buffer that was reserved with
+log_reserve_low(), skipping the log block trailers and headers. The caller
+need not hold the log mutex.
+@return	offset in log_sys->buf where the rest of the string is to be copied */
+UNIV_INTERN
+ulint
+log_buffer_copy(
+/*============*/
+	ulint		offset,	/*!< in: offset in log_sys->buf */
+	const byte*	str,	/*!< in: string */
+	ulint		str_len);/*!< in: string length */
+/************************************************************//**
+Completes the copies of a string reserved with log_reserve_low(). */
+UNIV_INTERN
+void
+log_buffer_copy_complete(void);
+/*==========================*/
+/************************************************************//**
 Closes the log.
 @return	lsn */
 UNIV_INTERN
@@ -228,6 +267,42 @@ log_write_up_to(
 			/*!< in: TRUE if we want the written log
 			also to be flushed to disk */
 	log_sync_type	caller);/* in: identifies the caller */
+/******************************************************//**
+The log writer thread. Writes the new content of the log buffer to the log
+files whenever a thread waits for it, and passes the flush requests to the
+log flusher thread.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(log_writer_thread)(
+/*==============================*/
+	void*	arg);	/*!< in: a dummy parameter required by
+			os_thread_create */
+/******************************************************//**
+The log flusher thread. Flushes the log files up to the lsn written by the
+log writer thread, while the writer thread is writing the next batch.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(log_flusher_thread)(
+/*===============================*/
+	void*	arg);	/*!< in: a dummy parameter required by
+			os_thread_create */
+/******************************************************//**
+Starts the log writer and log flusher threads. From then on
+log_write_up_to() leaves the writes and flushes of the log to these
+threads until log_writer_threads_stop() is called. */
+UNIV_INTERN
+void
+log_writer_threads_start(void);
+/*==========================*/
+/******************************************************//**
+Stops the log writer and log flusher threads and waits for them to exit.
+Threads waiting for these threads do the write themselves after this. */
+UNIV_INTERN
+void
+log_writer_threads_stop(void);
+/*=========================*/
 /****************************************************************//**
 Does a syncronous flush of the log buffer to disk. */
 UNIV_INTERN
@@ -886,6 +961,19 @@ struct log_t{
 					AND flushed to disk */
 	ulint		n_pending_writes;/*!< number of currently
 					pending flushes or writes */
+	ulint		n_pending_copies;/*!< number of strings reserved
+					with log_reserve_low() that are still
+					being copied to the log buffer without
+					the log mutex; updated atomically. The
+					log buffer content up to buf_free may
+					only be written or moved when this is
+					zero */
+	ulint		n_copy_waiters;/*!< number of threads waiting in
+					log_wait_for_copies() on copies_event;
+					updated atomically */
+	os_event_t	copies_event;	/*!< set by log_buffer_copy_complete()
+					when n_pending_copies drops to zero
+					while n_copy_waiters is nonzero */
 	ulint		log_sync_callers[LOG_WRITE_FROM_NUMBER];
 					/* counts calls to log_write_up_to */
 	ulint		log_sync_syncers[LOG_WRITE_FROM_NUMBER];
@@ -916,6 +1004,35 @@ struct log_t{
 					but NOTE that to set or reset this
 					event, the thread MUST own the log
 					mutex! */
+	bool		writer_threads_active;
+					/*!< whether log_write_up_to() leaves
+					the writes to the log writer and log
+					flusher threads */
+	bool		writer_threads_stop;
+					/*!< set to tell the log writer and
+					log flusher threads to exit */
+	ulint		n_writer_threads;
+					/*!< number of running log writer and
+					log flusher threads */
+	os_event_t	writer_event;	/*!< set to wake up the log writer
+					thread */
+	os_event_t	flusher_event;	/*!< set by the log writer thread to
+					wake up the log flusher thread */
+	os_event_t*	write_events;	/*!< LOG_WAIT_EVENTS events on which
+					threads wait for the log writer
+					thread, by the log block of the lsn
+					waited for */
+	os_event_t*	flush_events;	/*!< LOG_WAIT_EVENTS events on which
+					threads wait for the log flusher
+					thread, by the log block of the lsn
+					waited for */
+	ulint		flush_requests;	/*!< number of flushes requested from
+					the log writer threads; incremented
+					atomically without the log mutex */
+	lsn_t		flush_target_lsn;
+					/*!< lsn up to which the log flusher
+					thread is to flush the log; set by the
+					log writer thread */
 	ulint		n_log_ios;	/*!< number of log i/os initiated thus
 					far */
 	ulint		n_log_ios_old;	/*!< number of log i/o's at the
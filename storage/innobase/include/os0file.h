@@ -1006,6 +1006,17 @@ os_file_set_eof(
 /*============*/
 	FILE*		file);	/*!< in: file to be truncated */
 /***********************************************************************//**
+Truncates a file to the given size.
+@return	true if success */
+UNIV_INTERN
+bool
+os_file_truncate(
+/*=============*/
+	const char*	name,	/*!< in: name of the file, for messages */
+	os_file_t	file,	/*!< in: handle to a file */
+	os_offset_t	size)	/*!< in: new file size in bytes */
+	MY_ATTRIBUTE((nonnull, warn_unused_result));
+/***********************************************************************//**
 NOTE! Use the corresponding macro os_file_flush(), not directly this function!
 Flushes the write buffers of a given file to the disk.
 @return	TRUE if success */
@@ -55,6 +55,20 @@ extern my_bool	page_zip_log_pages;
 extern my_bool page_zip_zlib_wrap;
 extern uint page_zip_zlib_strategy;
 
+/** Compression algorithm of a ROW_FORMAT=COMPRESSED page. The algorithm
+of a table is kept in DICT_TF2_MASK_ZIP_ALGO of its flags2 and used for
+all pages compressed from then on. Each compressed page records the
+algorithm it was compressed with, so that pages of either kind can be
+decompressed regardless of the setting of the table. */
+enum page_zip_algo_t {
+	PAGE_ZIP_ALGO_ZLIB = 0,		/*!< zlib deflate, the default */
+	PAGE_ZIP_ALGO_LZ4 = 1,		/*!< LZ4 */
+	PAGE_ZIP_ALGO_ZSTD = 2		/*!< Zstandard */
+};
+
+/** Largest valid page_zip_algo_t value */
+#define PAGE_ZIP_ALGO_MAX	PAGE_ZIP_ALGO_ZSTD
+
 #ifndef UNIV_INNOCHECKSUM
 /**********************************************************************//**
 Determine the size of a compressed page in bytes.
@@ -507,7 +521,8 @@ page_zip_decode_compression_flags(
 	uchar  flags,
 	uint*  level,
 	uint*  no_wrap,
-	uint*  strategy);
+	uint*  strategy,
+	uint*  algo);
 
 /**********************************************************************//**
 Write the compression level and other compression options into the compression
@@ -518,13 +533,24 @@ page_zip_encode_compression_flags(
 /*=============================*/
 	uint  level,
 	uint  no_wrap,
-	uint  strategy);
+	uint  strategy,
+	uint  algo);
 
 #define page_zip_compression_flags \
     page_zip_encode_compression_flags( \
     page_zip_level, \
     page_zip_zlib_wrap, \
-    page_zip_zlib_strategy)
+    page_zip_zlib_strategy, \
+    PAGE_ZIP_ALGO_ZLIB)
+
+/** Compression flags for pages of an index, using the compression
+algorithm of its table */
+#define page_zip_compression_flags_for(index) \
+    page_zip_encode_compression_flags( \
+    page_zip_level, \
+    page_zip_zlib_wrap, \
+    page_zip_zlib_strategy, \
+    DICT_TF2_GET_ZIP_ALGO((index)->table->flags2))
 
 /**********************************************************************//**
 Parses a log record of compressing an index page without the data.
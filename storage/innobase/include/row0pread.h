@@ -0,0 +1,61 @@
+/*****************************************************************************
+
+Copyright (C) 2016 Facebook, Inc. All Rights Reserved.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Suite 500, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file include/row0pread.h
+Parallel read of the clustered index
+
+The clustered index is split into subtree ranges with
+btr_cur_partition_index() and the ranges are scanned by a set of
+threads that all see the rows through the same consistent read view.
+*******************************************************/
+
+#ifndef row0pread_h
+#define row0pread_h
+
+#include "univ.i"
+#include "dict0types.h"
+#include "trx0types.h"
+
+/** Maximum number of threads used by a parallel read */
+#define ROW_PREAD_MAX_THREADS		256
+
+/** Number of key ranges created for every reader thread, so that a
+thread that finishes early can pick up the remaining work */
+#define ROW_PREAD_PARTS_PER_THREAD	4
+
+/*********************************************************************//**
+Counts the records of a clustered index that are visible in the read
+view of a transaction, scanning the index in parallel threads. If the
+transaction has no read view, all records that are not delete-marked
+are counted, as in READ UNCOMMITTED.
+@return DB_SUCCESS, DB_INTERRUPTED, DB_CORRUPTION if check was
+requested and records were found in a wrong order, or another error */
+UNIV_INTERN
+dberr_t
+row_pread_count(
+/*============*/
+	trx_t*		trx,		/*!< in: transaction */
+	dict_index_t*	index,		/*!< in: clustered index */
+	ulint		n_threads,	/*!< in: number of reader threads */
+	bool		check,		/*!< in: whether to verify the order
+					of the records, as CHECK TABLE does */
+	ulint*		n_rows)		/*!< out: number of visible records */
+	MY_ATTRIBUTE((nonnull, warn_unused_result));
+
+#endif /* row0pread_h */
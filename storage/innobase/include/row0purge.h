@@ -118,6 +118,10 @@ struct purge_node_t{
 	btr_pcur_t	pcur;	/*!< persistent cursor used in searching the
 				clustered index record */
 	ibool		done;	/* Debug flag */
+	ulint		n_recs;	/*!< number of undo records attached to
+				this node in the current batch */
+	ib_uint64_t	run_usec;/*!< time in microseconds this node spent
+				purging the current batch */
 
 #ifdef UNIV_DEBUG
 	/***********************************************************//**
@@ -285,6 +285,12 @@ enum monitor_id_t {
 	MONITOR_DML_PURGE_DELAY,
 	MONITOR_PURGE_STOP_COUNT,
 	MONITOR_PURGE_RESUME_COUNT,
+	MONITOR_PURGE_TRX_NO_LAG,
+	MONITOR_PURGE_BATCH_TABLES,
+	MONITOR_PURGE_THREAD_RECORDS,
+	MONITOR_PURGE_THREAD_USEC,
+	MONITOR_PURGE_THREAD_MAX_RECORDS,
+	MONITOR_PURGE_THREAD_MIN_RECORDS,
 
 	/* Recovery related counters */
 	MONITOR_MODULE_RECOVERY,
@@ -217,6 +217,10 @@ and/or load it during startup. */
 extern char		srv_buffer_pool_dump_at_shutdown;
 extern char		srv_buffer_pool_load_at_startup;
 
+/** Whether the buffer pool load reads the hottest pages first, a whole
+extent at a time */
+extern char		srv_buffer_pool_load_fast;
+
 /* Whether to disable file system cache if it is defined */
 extern char		srv_disable_sort_file_cache;
 
@@ -288,6 +292,9 @@ extern ibool	srv_locks_unsafe_for_binlog;
 extern ulong	srv_sort_buf_size;
 /** Maximum modification log file size for online index creation */
 extern unsigned long long	srv_online_max_size;
+/** Number of threads used to count the rows of a table for
+SELECT COUNT(*) and CHECK TABLE */
+extern ulong	srv_parallel_read_threads;
 
 /* If this flag is TRUE, then we will use the native aio of the
 OS (provided we compiled Innobase with it in), otherwise we will
@@ -312,6 +319,13 @@ extern ulint	srv_undo_tablespaces_open;
 /* The number of undo segments to use */
 extern ulong	srv_undo_logs;
 
+/** Whether purge truncates undo tablespaces that grew beyond
+srv_max_undo_log_size. */
+extern my_bool	srv_undo_log_truncate;
+
+/** Size in bytes above which an undo tablespace is truncated. */
+extern unsigned long long	srv_max_undo_log_size;
+
 extern ulint	srv_n_data_files;
 extern char**	srv_data_file_names;
 extern ulint*	srv_data_file_sizes;
@@ -335,6 +349,7 @@ extern ulong	srv_n_log_files;
 extern ib_uint64_t	srv_log_file_size;
 extern ib_uint64_t	srv_log_file_size_requested;
 extern ulint	srv_log_buffer_size;
+extern my_bool	srv_log_writer_threads;
 extern ulong	srv_flush_log_at_trx_commit;
 extern uint	srv_flush_log_at_timeout;
 extern char	srv_adaptive_flushing;
@@ -91,6 +91,14 @@ trx_purge(
 					records to purge in one batch */
 	bool	truncate);		/*!< in: truncate history if true */
 /*******************************************************************//**
+Runs the undo records attached to a purge query thread and records in its
+purge node how long that took. */
+UNIV_INTERN
+void
+trx_purge_run_thr(
+/*==============*/
+	que_thr_t*	thr);	/*!< in: purge query thread */
+/*******************************************************************//**
 Stop purge and wait for it to stop, move to PURGE_STATE_STOP. */
 UNIV_INTERN
 void
@@ -103,6 +111,27 @@ void
 trx_purge_run(void);
 /*================*/
 
+/*******************************************************************//**
+Checks whether the truncation of an undo tablespace was interrupted,
+that is, whether its truncate log file exists.
+@return true if the undo tablespace must be fixed up */
+UNIV_INTERN
+bool
+trx_purge_undo_trunc_log_exists(
+/*============================*/
+	ulint	space_id);	/*!< in: undo tablespace id */
+/*******************************************************************//**
+Completes the truncation of an undo tablespace that was interrupted by a
+crash. The tablespace file must already have been re-created at its
+initial size. Re-initializes the tablespace header and the rollback
+segment headers in it, and removes the truncate log file. Must be called
+after the redo log scan and before trx_sys_init_at_db_start(). */
+UNIV_INTERN
+void
+trx_purge_fixup_undo_tablespace(
+/*============================*/
+	ulint	space_id);	/*!< in: undo tablespace id */
+
 /** Purge states */
 enum purge_state_t {
 	PURGE_STATE_INIT,		/*!< Purge instance created */
@@ -130,6 +159,19 @@ struct purge_iter_t {
 					whose undo number is less than this */
 };
 
+/** The undo tablespace that purge is truncating. Only the purge
+coordinator thread accesses this. */
+struct trx_undo_trunc_t {
+	ulint		space_id;	/*!< Undo tablespace marked for
+					truncation, ULINT_UNDEFINED if none */
+	ulint		scan_start;	/*!< Undo tablespace to examine first
+					when looking for one to truncate */
+	ulint		n_rsegs;	/*!< Number of elements in rsegs */
+	trx_rseg_t*	rsegs[TRX_SYS_N_RSEGS];
+					/*!< Rollback segments in the marked
+					undo tablespace */
+};
+
 /** The control structure used in the purge operation */
 struct trx_purge_t{
 	sess_t*		sess;		/*!< System session running the purge
@@ -203,6 +245,9 @@ struct trx_purge_t{
 					rseg_queue_t::trx_no. It is protected
 					by the bh_mutex */
 	ib_mutex_t		bh_mutex;	/*!< Mutex protecting ib_bh */
+	/*-----------------------------*/
+	trx_undo_trunc_t	undo_trunc;	/*!< Undo tablespace truncation
+						state */
 };
 
 /** Info required to purge a record */
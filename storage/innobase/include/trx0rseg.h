@@ -189,6 +189,15 @@ struct trx_rseg_t{
 					yet purged log */
 	ibool		last_del_marks;	/*!< TRUE if the last not yet purged log
 					needs purging */
+	/*--------------------------------------------------------*/
+	ulint		trx_ref_count;	/*!< Number of transactions that have
+					been assigned this rollback segment
+					and have not yet committed or rolled
+					back */
+	bool		skip_allocation;/*!< true if the undo tablespace of
+					this rollback segment is marked for
+					truncation: the rollback segment is
+					not assigned to new transactions */
 };
 
 /** For prioritising the rollback segments for purge. */
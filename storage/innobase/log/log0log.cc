@@ -184,6 +184,51 @@ log_buf_pool_get_oldest_modification(void)
 	return(lsn);
 }
 
+/************************************************************//**
+Waits until the strings reserved with log_reserve_low() have been copied
+to the log buffer. As the reservations are made with the log mutex held,
+the content of the log buffer up to log_sys->buf_free is complete when
+this returns and stays so while the caller holds the log mutex.
+
+The copies are short, so this spins for SYNC_SPIN_ROUNDS first and then
+sleeps on log_sys->copies_event until the last copy completes. Between
+the reservation and the end of the copy a mini-transaction only acquires
+the flush list mutexes, which rank below the log mutex, so the copies
+complete while the caller holds the log mutex. */
+static
+void
+log_wait_for_copies(void)
+/*=====================*/
+{
+	ulint	i = 0;
+
+	ut_ad(mutex_own(&(log_sys->mutex)));
+
+	while (log_sys->n_pending_copies > 0) {
+		ib_int64_t	sig_count;
+
+		if (++i < SYNC_SPIN_ROUNDS) {
+			ut_delay(ut_rnd_interval(0, srv_spin_wait_delay));
+			continue;
+		}
+
+		sig_count = os_event_reset(log_sys->copies_event);
+
+		/* The atomic increment is a full barrier: either
+		log_buffer_copy_complete() sees the waiter and sets the
+		event, or the count read below sees its copy complete. */
+		os_atomic_increment_ulint(&log_sys->n_copy_waiters, 1);
+
+		if (log_sys->n_pending_copies > 0) {
+			os_event_wait_low(log_sys->copies_event, sig_count);
+		}
+
+		os_atomic_decrement_ulint(&log_sys->n_copy_waiters, 1);
+	}
+
+	os_rmb;
+}
+
 /** Extends the log buffer.
 @param[in] len	requested minimum size in bytes */
 static
@@ -228,6 +273,8 @@ log_buffer_extend(
 		mutex_enter(&(log_sys->mutex));
 	}
 
+	log_wait_for_copies();
+
 	move_start = ut_calc_align_down(
 		log_sys->buf_free,
 		OS_FILE_LOG_BLOCK_SIZE);
@@ -368,16 +415,19 @@ loop:
 }
 
 /************************************************************//**
-Writes to the log the string given. It is assumed that the caller holds the
-log mutex. */
-UNIV_INTERN
-void
-log_write_low(
+Advances log_sys->lsn and log_sys->buf_free over a string to be written to
+the log and initializes the headers of the log blocks that the string
+spans, without copying the string itself. It is assumed that the caller
+holds the log mutex.
+@return	offset in log_sys->buf where the string is to be copied */
+static
+ulint
+log_frame_low(
 /*==========*/
-	byte*	str,		/*!< in: string */
 	ulint	str_len)	/*!< in: string length */
 {
 	log_t*	log	= log_sys;
+	ulint	offset	= log->buf_free;
 	ulint	len;
 	ulint	data_len;
 	byte*	log_block;
@@ -402,10 +452,7 @@ part_loop:
 			- LOG_BLOCK_TRL_SIZE;
 	}
 
-	ut_memcpy(log->buf + log->buf_free, str, len);
-
 	str_len -= len;
-	str = str + len;
 
 	log_block = static_cast<byte*>(
 		ut_align_down(
@@ -437,6 +484,94 @@ part_loop:
 	}
 
 	srv_stats.log_write_requests.inc();
+
+	return(offset);
+}
+
+/************************************************************//**
+Copies a string to space in the log buffer that was reserved with
+log_reserve_low(), skipping the log block trailers and headers. The caller
+need not hold the log mutex.
+@return	offset in log_sys->buf where the rest of the string is to be copied */
+UNIV_INTERN
+ulint
+log_buffer_copy(
+/*============*/
+	ulint		offset,	/*!< in: offset in log_sys->buf */
+	const byte*	str,	/*!< in: string */
+	ulint		str_len)/*!< in: string length */
+{
+	while (str_len > 0) {
+		ulint	len = OS_FILE_LOG_BLOCK_SIZE - LOG_BLOCK_TRL_SIZE
+			- offset % OS_FILE_LOG_BLOCK_SIZE;
+
+		if (len > str_len) {
+			len = str_len;
+		}
+
+		ut_memcpy(log_sys->buf + offset, str, len);
+
+		offset += len;
+		str += len;
+		str_len -= len;
+
+		if (offset % OS_FILE_LOG_BLOCK_SIZE
+		    == OS_FILE_LOG_BLOCK_SIZE - LOG_BLOCK_TRL_SIZE) {
+
+			offset += LOG_BLOCK_TRL_SIZE + LOG_BLOCK_HDR_SIZE;
+		}
+	}
+
+	return(offset);
+}
+
+/************************************************************//**
+Reserves space for a string in the log buffer. The string must then be
+copied with log_buffer_copy() and the copy completed with
+log_buffer_copy_complete(), which can be done after the log mutex has been
+released so that mini-transactions copy their log records concurrently.
+It is assumed that the caller holds the log mutex.
+@return	offset in log_sys->buf where the string is to be copied */
+UNIV_INTERN
+ulint
+log_reserve_low(
+/*============*/
+	ulint	str_len)	/*!< in: string length */
+{
+	ut_ad(mutex_own(&(log_sys->mutex)));
+
+	os_atomic_increment_ulint(&log_sys->n_pending_copies, 1);
+
+	return(log_frame_low(str_len));
+}
+
+/************************************************************//**
+Completes the copies of a string reserved with log_reserve_low(). */
+UNIV_INTERN
+void
+log_buffer_copy_complete(void)
+/*==========================*/
+{
+	ut_ad(log_sys->n_pending_copies > 0);
+
+	if (os_atomic_decrement_ulint(&log_sys->n_pending_copies, 1) == 0
+	    && log_sys->n_copy_waiters > 0) {
+		/* Wake up log_wait_for_copies() */
+		os_event_set(log_sys->copies_event);
+	}
+}
+
+/************************************************************//**
+Writes to the log the string given. It is assumed that the caller holds the
+log mutex. */
+UNIV_INTERN
+void
+log_write_low(
+/*==========*/
+	byte*	str,		/*!< in: string */
+	ulint	str_len)	/*!< in: string length */
+{
+	log_buffer_copy(log_frame_low(str_len), str, str_len);
 }
 
 /************************************************************//**
@@ -925,6 +1060,9 @@ log_init(void)
 	log_sys->written_to_all_lsn = log_sys->lsn;
 
 	log_sys->n_pending_writes = 0;
+	log_sys->n_pending_copies = 0;
+	log_sys->n_copy_waiters = 0;
+	log_sys->copies_event = os_event_create();
 
 	log_sys->log_logical_write_bytes = 0;
 	log_sys->log_physical_write_bytes = 0;
@@ -949,6 +1087,16 @@ log_init(void)
 
 	os_event_set(log_sys->one_flushed_event);
 
+	log_sys->writer_threads_active = false;
+	log_sys->writer_threads_stop = false;
+	log_sys->n_writer_threads = 0;
+	log_sys->writer_event = NULL;
+	log_sys->flusher_event = NULL;
+	log_sys->write_events = NULL;
+	log_sys->flush_events = NULL;
+	log_sys->flush_requests = 0;
+	log_sys->flush_target_lsn = 0;
+
 	/*----------------------------*/
 
 	log_sys->next_checkpoint_no = 0;
@@ -1189,6 +1337,8 @@ log_sys_check_flush_completion(void)
 			/* Move the log buffer content to the start of the
 			buffer */
 
+			log_wait_for_copies();
+
 			move_start = ut_calc_align_down(
 				log_sys->write_end_offset,
 				OS_FILE_LOG_BLOCK_SIZE);
@@ -1475,6 +1625,479 @@ loop:
 	}
 }
 
+/******************************************************//**
+Starts a write of the log buffer up to log_sys->lsn to the log files and
+writes it. The write must be completed with log_write_buf_complete(). */
+static
+void
+log_write_buf_low(
+/*==============*/
+	ibool	flush_to_disk,	/*!< in: TRUE if the caller will also
+				flush the written log to disk */
+	bool	release_mutex)	/*!< in: whether to release the log
+				mutex for the duration of the file write */
+{
+	log_group_t*	group;
+	ulint		start_offset;
+	ulint		end_offset;
+	ulint		area_start;
+	ulint		area_end;
+	lsn_t		written_lsn;
+
+	ut_ad(mutex_own(&(log_sys->mutex)));
+	ut_ad(log_sys->n_pending_writes == 0);
+
+	log_wait_for_copies();
+
+#ifdef UNIV_DEBUG
+	if (log_debug_writes) {
+		fprintf(stderr,
+			"Writing log from " LSN_PF " up to lsn " LSN_PF "\n",
+			log_sys->written_to_all_lsn,
+			log_sys->lsn);
+	}
+#endif /* UNIV_DEBUG */
+	log_sys->n_pending_writes++;
+	MONITOR_INC(MONITOR_PENDING_LOG_WRITE);
+
+	group = UT_LIST_GET_FIRST(log_sys->log_groups);
+	group->n_pending_writes++;	/*!< We assume here that we have only
+					one log group! */
+
+	os_event_reset(log_sys->no_flush_event);
+	os_event_reset(log_sys->one_flushed_event);
+
+	start_offset = log_sys->buf_next_to_write;
+	end_offset = log_sys->buf_free;
+
+	area_start = ut_calc_align_down(start_offset, OS_FILE_LOG_BLOCK_SIZE);
+	area_end = ut_calc_align(end_offset, OS_FILE_LOG_BLOCK_SIZE);
+
+	ut_ad(area_end - area_start > 0);
+
+	log_sys->write_lsn = log_sys->lsn;
+
+	if (flush_to_disk) {
+		log_sys->current_flush_lsn = log_sys->lsn;
+	}
+
+	log_sys->one_flushed = FALSE;
+
+	log_block_set_flush_bit(log_sys->buf + area_start, TRUE);
+	log_block_set_checkpoint_no(
+		log_sys->buf + area_end - OS_FILE_LOG_BLOCK_SIZE,
+		log_sys->next_checkpoint_no);
+
+	/* Copy the last, incompletely written, log block a log block length
+	up, so that when the flush operation writes from the log buffer, the
+	segment to write will not be changed by writers to the log */
+
+	ut_memcpy(log_sys->buf + area_end,
+		  log_sys->buf + area_end - OS_FILE_LOG_BLOCK_SIZE,
+		  OS_FILE_LOG_BLOCK_SIZE);
+
+	log_sys->buf_free += OS_FILE_LOG_BLOCK_SIZE;
+	log_sys->write_end_offset = log_sys->buf_free;
+
+	written_lsn = ut_uint64_align_down(log_sys->written_to_all_lsn,
+					   OS_FILE_LOG_BLOCK_SIZE);
+
+	/* The area being written cannot be modified by other threads:
+	mini-transactions append after log_sys->buf_free, which is beyond the
+	copy of the last block, and log_sys->n_pending_writes keeps other
+	writers and log_buffer_extend() away. */
+	if (release_mutex) {
+		mutex_exit(&(log_sys->mutex));
+	}
+
+	/* Do the write to the log files */
+
+	for (group = UT_LIST_GET_FIRST(log_sys->log_groups);
+	     group != NULL;
+	     group = UT_LIST_GET_NEXT(log_groups, group)) {
+
+		log_group_write_buf(
+			group, log_sys->buf + area_start,
+			area_end - area_start, written_lsn,
+			start_offset - area_start);
+	}
+
+	if (release_mutex) {
+		mutex_enter(&(log_sys->mutex));
+	}
+
+	for (group = UT_LIST_GET_FIRST(log_sys->log_groups);
+	     group != NULL;
+	     group = UT_LIST_GET_NEXT(log_groups, group)) {
+
+		log_group_set_fields(group, log_sys->write_lsn);
+	}
+}
+
+/******************************************************//**
+Completes a write started with log_write_buf_low(): advances
+log_sys->written_to_all_lsn and wakes up the threads waiting on
+log_sys->no_flush_event and log_sys->one_flushed_event. */
+static
+void
+log_write_buf_complete(void)
+/*========================*/
+{
+	log_group_t*	group;
+	ulint		unlock;
+
+	ut_ad(mutex_own(&(log_sys->mutex)));
+
+	group = UT_LIST_GET_FIRST(log_sys->log_groups);
+
+	ut_a(group->n_pending_writes == 1);
+	ut_a(log_sys->n_pending_writes == 1);
+
+	group->n_pending_writes--;
+	log_sys->n_pending_writes--;
+	MONITOR_DEC(MONITOR_PENDING_LOG_WRITE);
+
+	unlock = log_group_check_flush_completion(group);
+	unlock = unlock | log_sys_check_flush_completion();
+
+	log_flush_do_unlocks(unlock);
+}
+
+/******************************************************//**
+Calculates the slot of log_sys->write_events and log_sys->flush_events
+that a thread waiting for an lsn uses.
+@return slot number */
+UNIV_INLINE
+ulint
+log_wait_event_slot(
+/*================*/
+	lsn_t	lsn)	/*!< in: lsn waited for */
+{
+	return((ulint) ((lsn / OS_FILE_LOG_BLOCK_SIZE) % LOG_WAIT_EVENTS));
+}
+
+/******************************************************//**
+Wakes up the threads that wait in log_sys->write_events or
+log_sys->flush_events for an lsn in the range (old_lsn, new_lsn]. */
+static
+void
+log_wait_events_set(
+/*================*/
+	os_event_t*	events,		/*!< in: write_events or
+					flush_events */
+	lsn_t		old_lsn,	/*!< in: previous written or
+					flushed lsn */
+	lsn_t		new_lsn)	/*!< in: new written or flushed lsn */
+{
+	lsn_t	block = old_lsn / OS_FILE_LOG_BLOCK_SIZE;
+	lsn_t	last = new_lsn / OS_FILE_LOG_BLOCK_SIZE;
+
+	if (last - block >= LOG_WAIT_EVENTS) {
+		block = 0;
+		last = LOG_WAIT_EVENTS - 1;
+	}
+
+	for (; block <= last; block++) {
+		os_event_set(events[block % LOG_WAIT_EVENTS]);
+	}
+}
+
+/******************************************************//**
+Waits until the log writer threads have written, and if requested
+flushed, the log up to an lsn.
+@return false if the threads were stopped and the caller must do
+the write itself */
+static
+bool
+log_wait_for_writer_threads(
+/*========================*/
+	lsn_t	lsn,		/*!< in: lsn to wait for */
+	ulint	wait,		/*!< in: LOG_NO_WAIT, LOG_WAIT_ONE_GROUP,
+				or LOG_WAIT_ALL_GROUPS */
+	ibool	flush_to_disk)	/*!< in: TRUE if the log must also be
+				flushed to disk */
+{
+	os_event_t	event;
+	lsn_t*		done_lsn;
+
+	if (lsn == LSN_MAX) {
+		mutex_enter(&(log_sys->mutex));
+		lsn = log_sys->lsn;
+		mutex_exit(&(log_sys->mutex));
+	}
+
+	if (flush_to_disk) {
+		if (log_sys->flushed_to_disk_lsn >= lsn) {
+			return(true);
+		}
+
+		/* Any write started after this point covers lsn, and
+		the writer passes the request on to the flusher when
+		such a write has completed. */
+		os_atomic_increment_ulint(&log_sys->flush_requests, 1);
+
+		event = log_sys->flush_events[log_wait_event_slot(lsn)];
+		done_lsn = &log_sys->flushed_to_disk_lsn;
+	} else {
+		if (log_sys->written_to_all_lsn >= lsn) {
+			return(true);
+		}
+
+		event = log_sys->write_events[log_wait_event_slot(lsn)];
+		done_lsn = &log_sys->written_to_all_lsn;
+	}
+
+	os_event_set(log_sys->writer_event);
+
+	if (wait == LOG_NO_WAIT) {
+		return(true);
+	}
+
+	for (;;) {
+		ib_int64_t	sig_count = os_event_reset(event);
+
+		os_rmb;
+
+		if (*done_lsn >= lsn) {
+			return(true);
+		}
+
+		if (!log_sys->writer_threads_active) {
+			return(false);
+		}
+
+		if (os_event_wait_time_low(event, LOG_WAIT_TIMEOUT, sig_count)
+		    == OS_SYNC_TIME_EXCEEDED) {
+			/* The slot may have been reused for a later lsn
+			and reset before we saw it: ask again. */
+			if (flush_to_disk) {
+				os_atomic_increment_ulint(
+					&log_sys->flush_requests, 1);
+			}
+
+			os_event_set(log_sys->writer_event);
+		}
+	}
+}
+
+/******************************************************//**
+The log writer thread. Writes the new content of the log buffer to the log
+files whenever a thread waits for it, releasing the log mutex during the
+file write so that mini-transactions can commit meanwhile, and passes the
+flush requests to the log flusher thread.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(log_writer_thread)(
+/*==============================*/
+	void*	arg MY_ATTRIBUTE((unused)))
+			/*!< in: a dummy parameter required by
+			os_thread_create */
+{
+	ulint	served_requests = 0;
+
+	while (!log_sys->writer_threads_stop) {
+		ib_int64_t	sig_count = os_event_reset(log_sys->writer_event);
+		ulint		requests = log_sys->flush_requests;
+		lsn_t		old_lsn;
+		lsn_t		target_lsn;
+
+		mutex_enter(&(log_sys->mutex));
+
+		old_lsn = log_sys->written_to_all_lsn;
+		target_lsn = log_sys->lsn;
+
+		if (log_sys->n_pending_writes == 0
+		    && log_sys->buf_free != log_sys->buf_next_to_write) {
+
+			log_write_buf_low(requests != served_requests, true);
+			log_write_buf_complete();
+
+			if (srv_unix_file_flush_method == SRV_UNIX_O_DSYNC
+			    || srv_unix_file_flush_method
+			    == SRV_UNIX_ALL_O_DIRECT) {
+
+				/* The OS did not buffer the write. */
+				lsn_t	old_flushed_lsn
+					= log_sys->flushed_to_disk_lsn;
+
+				log_sys->flushed_to_disk_lsn
+					= log_sys->written_to_all_lsn;
+				log_sys->n_syncs++;
+				log_wait_events_set(
+					log_sys->flush_events, old_flushed_lsn,
+					log_sys->flushed_to_disk_lsn);
+			}
+
+			log_wait_events_set(log_sys->write_events, old_lsn,
+					    log_sys->written_to_all_lsn);
+		}
+
+		if (requests != served_requests
+		    && log_sys->written_to_all_lsn >= target_lsn) {
+
+			/* Every flush request seen so far is for an lsn
+			that has now been written. */
+			served_requests = requests;
+
+			if (log_sys->flush_target_lsn
+			    < log_sys->written_to_all_lsn) {
+
+				log_sys->flush_target_lsn
+					= log_sys->written_to_all_lsn;
+				os_event_set(log_sys->flusher_event);
+			}
+		}
+
+		if (log_sys->written_to_all_lsn != old_lsn) {
+			/* Batch whatever was committed during the write. */
+			mutex_exit(&(log_sys->mutex));
+			continue;
+		}
+
+		mutex_exit(&(log_sys->mutex));
+
+		os_event_wait_time_low(log_sys->writer_event,
+				       LOG_WAIT_TIMEOUT, sig_count);
+	}
+
+	os_atomic_decrement_ulint(&log_sys->n_writer_threads, 1);
+
+	os_thread_exit(NULL, false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/******************************************************//**
+The log flusher thread. Flushes the log files up to the lsn written by the
+log writer thread, while the writer thread is writing the next batch.
+@return a dummy parameter */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(log_flusher_thread)(
+/*===============================*/
+	void*	arg MY_ATTRIBUTE((unused)))
+			/*!< in: a dummy parameter required by
+			os_thread_create */
+{
+	while (!log_sys->writer_threads_stop) {
+		ib_int64_t	sig_count = os_event_reset(
+			log_sys->flusher_event);
+		lsn_t		old_lsn;
+		lsn_t		target_lsn;
+
+		mutex_enter(&(log_sys->mutex));
+		old_lsn = log_sys->flushed_to_disk_lsn;
+		target_lsn = log_sys->flush_target_lsn;
+		mutex_exit(&(log_sys->mutex));
+
+		if (target_lsn <= old_lsn) {
+			os_event_wait_time_low(log_sys->flusher_event,
+					       LOG_WAIT_TIMEOUT, sig_count);
+			continue;
+		}
+
+		fil_flush(UT_LIST_GET_FIRST(log_sys->log_groups)->space_id,
+			  FLUSH_FROM_LOG_WRITE_UP_TO);
+
+		mutex_enter(&(log_sys->mutex));
+
+		if (log_sys->flushed_to_disk_lsn < target_lsn) {
+			old_lsn = log_sys->flushed_to_disk_lsn;
+			log_sys->flushed_to_disk_lsn = target_lsn;
+		}
+
+		log_sys->n_syncs++;
+
+		mutex_exit(&(log_sys->mutex));
+
+		log_wait_events_set(log_sys->flush_events, old_lsn,
+				    target_lsn);
+	}
+
+	os_atomic_decrement_ulint(&log_sys->n_writer_threads, 1);
+
+	os_thread_exit(NULL, false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/******************************************************//**
+Starts the log writer and log flusher threads. From then on
+log_write_up_to() leaves the writes and flushes of the log to these
+threads until log_writer_threads_stop() is called. */
+UNIV_INTERN
+void
+log_writer_threads_start(void)
+/*==========================*/
+{
+	ulint	i;
+
+	ut_ad(!srv_read_only_mode);
+	ut_ad(!log_sys->writer_threads_active);
+
+	log_sys->write_events = static_cast<os_event_t*>(
+		mem_alloc(LOG_WAIT_EVENTS * sizeof *log_sys->write_events));
+	log_sys->flush_events = static_cast<os_event_t*>(
+		mem_alloc(LOG_WAIT_EVENTS * sizeof *log_sys->flush_events));
+
+	for (i = 0; i < LOG_WAIT_EVENTS; i++) {
+		log_sys->write_events[i] = os_event_create();
+		log_sys->flush_events[i] = os_event_create();
+	}
+
+	log_sys->writer_event = os_event_create();
+	log_sys->flusher_event = os_event_create();
+
+	mutex_enter(&(log_sys->mutex));
+	log_sys->flush_target_lsn = log_sys->flushed_to_disk_lsn;
+	mutex_exit(&(log_sys->mutex));
+
+	log_sys->flush_requests = 0;
+	log_sys->writer_threads_stop = false;
+	log_sys->n_writer_threads = 2;
+
+	os_thread_create(log_writer_thread, NULL, NULL);
+	os_thread_create(log_flusher_thread, NULL, NULL);
+
+	log_sys->writer_threads_active = true;
+}
+
+/******************************************************//**
+Stops the log writer and log flusher threads and waits for them to exit.
+Threads waiting for these threads do the write themselves after this. */
+UNIV_INTERN
+void
+log_writer_threads_stop(void)
+/*=========================*/
+{
+	ulint	i;
+
+	if (log_sys->write_events == NULL) {
+		return;
+	}
+
+	/* Send new callers of log_write_up_to() to the old code path
+	first: it coordinates with the writer thread through
+	log_sys->n_pending_writes. */
+	log_sys->writer_threads_active = false;
+	log_sys->writer_threads_stop = true;
+
+	os_wmb;
+
+	while (log_sys->n_writer_threads > 0) {
+		os_event_set(log_sys->writer_event);
+		os_event_set(log_sys->flusher_event);
+		os_thread_sleep(10000);
+	}
+
+	/* Wake up the waiters so that they notice the stop. */
+	for (i = 0; i < LOG_WAIT_EVENTS; i++) {
+		os_event_set(log_sys->write_events[i]);
+		os_event_set(log_sys->flush_events[i]);
+	}
+}
+
 /******************************************************//**
 This function is called, e.g., when a transaction wants to commit. It checks
 that the log has been written to the log file up to the last log entry written
@@ -1495,14 +2118,9 @@ log_write_up_to(
 	log_sync_type	caller)	/* in: identifies caller */
 {
 	log_group_t*	group;
-	ulint		start_offset;
-	ulint		end_offset;
-	ulint		area_start;
-	ulint		area_end;
 #ifdef UNIV_DEBUG
 	ulint		loop_count	= 0;
 #endif /* UNIV_DEBUG */
-	ulint		unlock;
 
 	ut_ad(!srv_read_only_mode);
 
@@ -1515,6 +2133,12 @@ log_write_up_to(
 		return;
 	}
 
+	if (log_sys->writer_threads_active
+	    && log_wait_for_writer_threads(lsn, wait, flush_to_disk)) {
+
+		return;
+	}
+
 loop:
 #ifdef UNIV_DEBUG
 	loop_count++;
@@ -1587,72 +2211,7 @@ loop:
 		return;
 	}
 
-#ifdef UNIV_DEBUG
-	if (log_debug_writes) {
-		fprintf(stderr,
-			"Writing log from " LSN_PF " up to lsn " LSN_PF "\n",
-			log_sys->written_to_all_lsn,
-			log_sys->lsn);
-	}
-#endif /* UNIV_DEBUG */
-	log_sys->n_pending_writes++;
-	MONITOR_INC(MONITOR_PENDING_LOG_WRITE);
-
-	group = UT_LIST_GET_FIRST(log_sys->log_groups);
-	group->n_pending_writes++;	/*!< We assume here that we have only
-					one log group! */
-
-	os_event_reset(log_sys->no_flush_event);
-	os_event_reset(log_sys->one_flushed_event);
-
-	start_offset = log_sys->buf_next_to_write;
-	end_offset = log_sys->buf_free;
-
-	area_start = ut_calc_align_down(start_offset, OS_FILE_LOG_BLOCK_SIZE);
-	area_end = ut_calc_align(end_offset, OS_FILE_LOG_BLOCK_SIZE);
-
-	ut_ad(area_end - area_start > 0);
-
-	log_sys->write_lsn = log_sys->lsn;
-
-	if (flush_to_disk) {
-		log_sys->current_flush_lsn = log_sys->lsn;
-	}
-
-	log_sys->one_flushed = FALSE;
-
-	log_block_set_flush_bit(log_sys->buf + area_start, TRUE);
-	log_block_set_checkpoint_no(
-		log_sys->buf + area_end - OS_FILE_LOG_BLOCK_SIZE,
-		log_sys->next_checkpoint_no);
-
-	/* Copy the last, incompletely written, log block a log block length
-	up, so that when the flush operation writes from the log buffer, the
-	segment to write will not be changed by writers to the log */
-
-	ut_memcpy(log_sys->buf + area_end,
-		  log_sys->buf + area_end - OS_FILE_LOG_BLOCK_SIZE,
-		  OS_FILE_LOG_BLOCK_SIZE);
-
-	log_sys->buf_free += OS_FILE_LOG_BLOCK_SIZE;
-	log_sys->write_end_offset = log_sys->buf_free;
-
-	group = UT_LIST_GET_FIRST(log_sys->log_groups);
-
-	/* Do the write to the log files */
-
-	while (group) {
-		log_group_write_buf(
-			group, log_sys->buf + area_start,
-			area_end - area_start,
-			ut_uint64_align_down(log_sys->written_to_all_lsn,
-					     OS_FILE_LOG_BLOCK_SIZE),
-			start_offset - area_start);
-
-		log_group_set_fields(group, log_sys->write_lsn);
-
-		group = UT_LIST_GET_NEXT(log_groups, group);
-	}
+	log_write_buf_low(flush_to_disk, false);
 
 	mutex_exit(&(log_sys->mutex));
 
@@ -1679,19 +2238,7 @@ loop:
 
 	mutex_enter(&(log_sys->mutex));
 
-	group = UT_LIST_GET_FIRST(log_sys->log_groups);
-
-	ut_a(group->n_pending_writes == 1);
-	ut_a(log_sys->n_pending_writes == 1);
-
-	group->n_pending_writes--;
-	log_sys->n_pending_writes--;
-	MONITOR_DEC(MONITOR_PENDING_LOG_WRITE);
-
-	unlock = log_group_check_flush_completion(group);
-	unlock = unlock | log_sys_check_flush_completion();
-
-	log_flush_do_unlocks(unlock);
+	log_write_buf_complete();
 
 	mutex_exit(&(log_sys->mutex));
 
@@ -3396,6 +3943,9 @@ loop:
 		}
 	}
 
+	/* The remaining writes of the log are done by this thread. */
+	log_writer_threads_stop();
+
 	mutex_enter(&log_sys->mutex);
 	server_busy = log_sys->n_pending_checkpoint_writes
 #ifdef UNIV_LOG_ARCHIVE
@@ -3838,6 +4388,26 @@ log_shutdown(void)
 
 	os_event_free(log_sys->no_flush_event);
 	os_event_free(log_sys->one_flushed_event);
+	os_event_free(log_sys->copies_event);
+
+	if (log_sys->write_events != NULL) {
+		ulint	i;
+
+		ut_ad(log_sys->n_writer_threads == 0);
+
+		for (i = 0; i < LOG_WAIT_EVENTS; i++) {
+			os_event_free(log_sys->write_events[i]);
+			os_event_free(log_sys->flush_events[i]);
+		}
+
+		mem_free(log_sys->write_events);
+		mem_free(log_sys->flush_events);
+		log_sys->write_events = NULL;
+		log_sys->flush_events = NULL;
+
+		os_event_free(log_sys->writer_event);
+		os_event_free(log_sys->flusher_event);
+	}
 
 	rw_lock_free(&log_sys->checkpoint_lock);
 
@@ -240,6 +240,7 @@ mtr_log_reserve_and_write(
 	dyn_array_t*	mlog;
 	ulint		data_size;
 	byte*		first_data;
+	ulint		offset = 0;
 
 	ut_ad(!srv_read_only_mode);
 
@@ -280,6 +281,8 @@ mtr_log_reserve_and_write(
 
 	if (mtr->log_mode == MTR_LOG_ALL) {
 
+#ifdef UNIV_LOG_DEBUG
+		/* log_close() checks the log records in the buffer. */
 		for (dyn_block_t* block = mlog;
 		     block != 0;
 		     block = dyn_array_get_next_block(mlog, block)) {
@@ -289,6 +292,16 @@ mtr_log_reserve_and_write(
 				dyn_block_get_used(block));
 		}
 
+		mtr->end_lsn = log_close();
+
+		mtr_add_dirtied_pages_to_flush_list(mtr);
+
+		return;
+#else /* UNIV_LOG_DEBUG */
+		/* Only reserve the space while holding the log mutex; the
+		log records are copied after the mutex has been released. */
+		offset = log_reserve_low(data_size);
+#endif /* UNIV_LOG_DEBUG */
 	} else {
 		ut_ad(mtr->log_mode == MTR_LOG_NONE
 		      || mtr->log_mode == MTR_LOG_NO_REDO);
@@ -298,6 +311,20 @@ mtr_log_reserve_and_write(
 	mtr->end_lsn = log_close();
 
 	mtr_add_dirtied_pages_to_flush_list(mtr);
+
+	if (mtr->log_mode == MTR_LOG_ALL) {
+
+		for (dyn_block_t* block = mlog;
+		     block != 0;
+		     block = dyn_array_get_next_block(mlog, block)) {
+
+			offset = log_buffer_copy(
+				offset, dyn_block_get_data(block),
+				dyn_block_get_used(block));
+		}
+
+		log_buffer_copy_complete();
+	}
 }
 #endif /* !UNIV_HOTBACKUP */
 
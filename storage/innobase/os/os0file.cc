@@ -2432,6 +2432,39 @@ os_file_set_eof(
 #endif /* __WIN__ */
 }
 
+/***********************************************************************//**
+Truncates a file to the given size.
+@return	true if success */
+UNIV_INTERN
+bool
+os_file_truncate(
+/*=============*/
+	const char*	name,	/*!< in: name of the file, for messages */
+	os_file_t	file,	/*!< in: handle to a file */
+	os_offset_t	size)	/*!< in: new file size in bytes */
+{
+#ifdef __WIN__
+	LARGE_INTEGER	length;
+
+	length.QuadPart = size;
+
+	bool	success = SetFilePointerEx(file, length, NULL, FILE_BEGIN)
+		&& SetEndOfFile(file);
+#else /* __WIN__ */
+	bool	success = !ftruncate(file, size);
+#endif /* __WIN__ */
+
+	if (!success) {
+		ib_logf(IB_LOG_LEVEL_ERROR,
+			"Truncate of file '%s' to " UINT64PF " bytes failed",
+			name, size);
+
+		os_file_handle_error_no_exit(name, "truncate", FALSE);
+	}
+
+	return(success);
+}
+
 #ifndef __WIN__
 /***********************************************************************//**
 Wrapper to fsync(2) that retries the call on some errors.
@@ -56,6 +56,8 @@ using namespace std;
 # include "lock0lock.h"
 # include "srv0srv.h"
 # include "zlib_embedded/zlib.h"
+# include <lz4.h>
+# include <zstd.h>
 #endif /* !UNIV_INNOCHECKSUM */
 # include "buf0lru.h"
 # include "srv0mon.h"
@@ -776,6 +778,368 @@ page_zip_set_alloc(
 	strm->opaque = heap;
 }
 
+/* LZ4 and Zstandard do not offer the incremental interface of zlib
+that page_zip_compress() and page_zip_decompress() are written against.
+Instead, the page payload is gathered or restored in one piece and the
+zlib calls below are redirected to functions that feed it through a
+z_stream in the same way as deflate() and inflate() would.
+
+Such a stream starts with a header of PAGE_ZIP_ALGO_HEADER_SIZE bytes
+at PAGE_DATA:
+ (1) the marker byte PAGE_ZIP_ALGO_MARKER | algorithm << 4,
+ (2) the length of the index field information (2 bytes),
+ (3) the length of the compressed data that follows (2 bytes).
+The low nibble of the marker is neither a valid zlib header (the
+compression method is not 8) nor a valid raw deflate block (BTYPE=3),
+so the stream of any page compressed with zlib can never be mistaken
+for one of these. */
+
+/** Low nibble of the first byte of a stream not compressed by zlib */
+#define PAGE_ZIP_ALGO_MARKER		6
+/** Size of the header of a stream not compressed by zlib */
+#define PAGE_ZIP_ALGO_HEADER_SIZE	5
+
+/** State of a page stream compressed by an algorithm other than zlib.
+It is attached to the z_stream as its opaque pointer, and zalloc is
+cleared to tell it apart from a zlib stream. */
+struct page_zip_algo_stream_t {
+	mem_heap_t*	heap;		/*!< memory heap of the stream */
+	uint		algo;		/*!< page_zip_algo_t */
+	uint		level;		/*!< compression level 0..9 */
+	byte*		buf;		/*!< uncompressed stream */
+	ulint		size;		/*!< size of buf in bytes */
+	ulint		len;		/*!< bytes of data in buf */
+	ulint		pos;		/*!< bytes of buf consumed
+					by inflate() */
+	ulint		block_end;	/*!< end of the index field
+					information in buf, or
+					ULINT_UNDEFINED if not known yet */
+};
+
+/**********************************************************************//**
+Get the state of a stream not compressed by zlib.
+@return the stream, or NULL for a zlib stream */
+static
+page_zip_algo_stream_t*
+page_zip_algo_stream_get(
+/*=====================*/
+	z_stream*	strm)	/*!< in: stream */
+{
+	return(strm->zalloc
+	       ? NULL : static_cast<page_zip_algo_stream_t*>(strm->opaque));
+}
+
+/**********************************************************************//**
+Turn a stream configured by page_zip_set_alloc() into a stream of
+the given algorithm.
+@return the stream state */
+static
+page_zip_algo_stream_t*
+page_zip_algo_stream_init(
+/*======================*/
+	z_stream*	strm,	/*!< in/out: stream */
+	uint		algo,	/*!< in: PAGE_ZIP_ALGO_LZ4 or _ZSTD */
+	uint		level)	/*!< in: compression level 0..9 */
+{
+	mem_heap_t*		heap = static_cast<mem_heap_t*>(strm->opaque);
+	page_zip_algo_stream_t*	s = static_cast<page_zip_algo_stream_t*>(
+		mem_heap_alloc(heap, sizeof *s));
+
+	ut_ad(algo != PAGE_ZIP_ALGO_ZLIB && algo <= PAGE_ZIP_ALGO_MAX);
+
+	s->heap = heap;
+	s->algo = algo;
+	s->level = level;
+	/* The page payload and the index field information */
+	s->size = 2 * UNIV_PAGE_SIZE;
+	s->buf = static_cast<byte*>(mem_heap_alloc(heap, s->size));
+	s->len = 0;
+	s->pos = 0;
+	s->block_end = ULINT_UNDEFINED;
+
+	strm->zalloc = NULL;
+	strm->opaque = s;
+	strm->total_in = 0;
+	strm->total_out = 0;
+	strm->msg = NULL;
+
+	return(s);
+}
+
+/**********************************************************************//**
+Compress the gathered payload of a stream into next_out.
+@return Z_STREAM_END, or Z_BUF_ERROR if it does not fit */
+static
+int
+page_zip_algo_finish(
+/*=================*/
+	page_zip_algo_stream_t*	s,	/*!< in: stream state */
+	z_stream*		strm)	/*!< in/out: stream */
+{
+	byte*	out = strm->next_out + PAGE_ZIP_ALGO_HEADER_SIZE;
+	ulint	out_len;
+
+	if (strm->avail_out <= PAGE_ZIP_ALGO_HEADER_SIZE) {
+		return(Z_BUF_ERROR);
+	}
+
+	out_len = strm->avail_out - PAGE_ZIP_ALGO_HEADER_SIZE;
+
+	switch (s->algo) {
+	case PAGE_ZIP_ALGO_LZ4: {
+		void*	state = mem_heap_alloc(s->heap, LZ4_sizeofState());
+		int	n = LZ4_compress_fast_extState(
+			state, reinterpret_cast<const char*>(s->buf),
+			reinterpret_cast<char*>(out), static_cast<int>(s->len),
+			static_cast<int>(out_len), 1);
+
+		if (n <= 0) {
+			return(Z_BUF_ERROR);
+		}
+
+		out_len = n;
+		break;
+	}
+	case PAGE_ZIP_ALGO_ZSTD: {
+		/* Level 0 means the default of Zstandard, which is
+		not what it means for zlib. */
+		int		level = s->level ? s->level : 1;
+		ZSTD_compressionParameters params
+			= ZSTD_getCParams(level, s->len, 0);
+		size_t		ws_size
+			= ZSTD_estimateCCtxSize_usingCParams(params);
+		ZSTD_CCtx*	cctx = ZSTD_initStaticCCtx(
+			mem_heap_alloc(s->heap, ws_size), ws_size);
+		size_t		n;
+
+		ut_a(cctx);
+
+		n = ZSTD_compressCCtx(cctx, out, out_len, s->buf, s->len,
+				      level);
+
+		if (ZSTD_isError(n)) {
+			return(Z_BUF_ERROR);
+		}
+
+		out_len = n;
+		break;
+	}
+	default:
+		ut_error;
+	}
+
+	ut_ad(s->block_end != ULINT_UNDEFINED);
+
+	strm->next_out[0] = static_cast<byte>(
+		PAGE_ZIP_ALGO_MARKER | s->algo << 4);
+	mach_write_to_2(strm->next_out + 1, s->block_end);
+	mach_write_to_2(strm->next_out + 3, out_len);
+
+	out_len += PAGE_ZIP_ALGO_HEADER_SIZE;
+	strm->next_out += out_len;
+	strm->avail_out -= static_cast<uInt>(out_len);
+	strm->total_out = out_len;
+
+	return(Z_STREAM_END);
+}
+
+/**********************************************************************//**
+Start decompressing a stream that was not compressed by zlib, if the
+data at next_in is one. The whole payload is decompressed here and then
+handed out by page_zip_inflate(). On success, next_in will point to the
+end of the compressed data, as it would after inflate() of a zlib stream
+had returned Z_STREAM_END.
+@return TRUE on success, FALSE if the stream is corrupted */
+static
+ibool
+page_zip_algo_init_d_stream(
+/*========================*/
+	z_stream*	strm)	/*!< in/out: stream configured by
+				page_zip_set_alloc() */
+{
+	const byte*		in = strm->next_in;
+	uint			algo = in[0] >> 4;
+	ulint			fields_len;
+	ulint			c_len;
+	ulint			n;
+	page_zip_algo_stream_t*	s;
+
+	if (algo == PAGE_ZIP_ALGO_ZLIB || algo > PAGE_ZIP_ALGO_MAX
+	    || strm->avail_in < PAGE_ZIP_ALGO_HEADER_SIZE) {
+		return(FALSE);
+	}
+
+	fields_len = mach_read_from_2(in + 1);
+	c_len = mach_read_from_2(in + 3);
+
+	if (c_len > strm->avail_in - PAGE_ZIP_ALGO_HEADER_SIZE) {
+		return(FALSE);
+	}
+
+	s = page_zip_algo_stream_init(strm, algo, 0);
+	in += PAGE_ZIP_ALGO_HEADER_SIZE;
+
+	switch (algo) {
+	case PAGE_ZIP_ALGO_LZ4: {
+		int	ret = LZ4_decompress_safe(
+			reinterpret_cast<const char*>(in),
+			reinterpret_cast<char*>(s->buf),
+			static_cast<int>(c_len), static_cast<int>(s->size));
+
+		if (ret < 0) {
+			return(FALSE);
+		}
+
+		n = ret;
+		break;
+	}
+	case PAGE_ZIP_ALGO_ZSTD: {
+		size_t		ws_size = ZSTD_estimateDCtxSize();
+		ZSTD_DCtx*	dctx = ZSTD_initStaticDCtx(
+			mem_heap_alloc(s->heap, ws_size), ws_size);
+
+		ut_a(dctx);
+
+		n = ZSTD_decompressDCtx(dctx, s->buf, s->size, in, c_len);
+
+		if (ZSTD_isError(n)) {
+			return(FALSE);
+		}
+		break;
+	}
+	default:
+		ut_error;
+	}
+
+	if (fields_len > n) {
+		return(FALSE);
+	}
+
+	s->len = n;
+	s->block_end = fields_len;
+
+	c_len += PAGE_ZIP_ALGO_HEADER_SIZE;
+	strm->next_in += c_len;
+	strm->avail_in -= static_cast<uInt>(c_len);
+	strm->total_in = c_len;
+
+	return(TRUE);
+}
+
+/**********************************************************************//**
+deflate() for page streams. For a stream of another algorithm, the input
+is gathered until Z_FINISH, and Z_FULL_FLUSH marks the end of the index
+field information.
+@return	deflate() status: Z_OK, Z_BUF_ERROR, ... */
+static
+int
+page_zip_deflate(
+/*=============*/
+	z_streamp	strm,	/*!< in/out: compressed stream */
+	int		flush)	/*!< in: deflate() flushing method */
+{
+	page_zip_algo_stream_t*	s = page_zip_algo_stream_get(strm);
+
+	if (!s) {
+		return(deflate(strm, flush));
+	}
+
+	if (strm->avail_in > s->size - s->len) {
+		return(Z_STREAM_ERROR);
+	}
+
+	memcpy(s->buf + s->len, strm->next_in, strm->avail_in);
+	s->len += strm->avail_in;
+	strm->next_in += strm->avail_in;
+	strm->total_in += strm->avail_in;
+	strm->avail_in = 0;
+
+	switch (flush) {
+	case Z_FULL_FLUSH:
+		if (s->block_end == ULINT_UNDEFINED) {
+			s->block_end = s->len;
+		}
+		break;
+	case Z_FINISH:
+		return(page_zip_algo_finish(s, strm));
+	}
+
+	return(Z_OK);
+}
+
+/**********************************************************************//**
+deflateEnd() for page streams.
+@return	deflateEnd() status */
+static
+int
+page_zip_deflate_end(
+/*=================*/
+	z_streamp	strm)	/*!< in/out: compressed stream */
+{
+	return(page_zip_algo_stream_get(strm) ? Z_OK : deflateEnd(strm));
+}
+
+/**********************************************************************//**
+inflate() for page streams. For a stream of another algorithm, the data
+decompressed by page_zip_algo_init_d_stream() is copied out, and Z_BLOCK
+stops at the end of the index field information.
+@return	inflate() status: Z_OK, Z_STREAM_END, Z_BUF_ERROR, ... */
+static
+int
+page_zip_inflate(
+/*=============*/
+	z_streamp	strm,	/*!< in/out: compressed stream */
+	int		flush)	/*!< in: inflate() flushing method */
+{
+	page_zip_algo_stream_t*	s = page_zip_algo_stream_get(strm);
+	ulint			end;
+	ulint			n;
+
+	if (!s) {
+		return(inflate(strm, flush));
+	}
+
+	end = flush == Z_BLOCK && s->pos < s->block_end
+		? s->block_end : s->len;
+	n = ut_min(end - s->pos, static_cast<ulint>(strm->avail_out));
+
+	memcpy(strm->next_out, s->buf + s->pos, n);
+	s->pos += n;
+	strm->next_out += n;
+	strm->avail_out -= static_cast<uInt>(n);
+	strm->total_out += n;
+
+	if (flush == Z_BLOCK) {
+		return(Z_OK);
+	} else if (s->pos == s->len) {
+		return(Z_STREAM_END);
+	}
+
+	return(n ? Z_OK : Z_BUF_ERROR);
+}
+
+/**********************************************************************//**
+inflateEnd() for page streams.
+@return	inflateEnd() status */
+static
+int
+page_zip_inflate_end(
+/*=================*/
+	z_streamp	strm)	/*!< in/out: compressed stream */
+{
+	return(page_zip_algo_stream_get(strm) ? Z_OK : inflateEnd(strm));
+}
+
+/* Redirect the zlib calls of the page stream to the wrappers above. */
+#undef deflate
+#define deflate(strm, flush)	page_zip_deflate(strm, flush)
+#undef deflateEnd
+#define deflateEnd(strm)	page_zip_deflate_end(strm)
+#undef inflate
+#define inflate(strm, flush)	page_zip_inflate(strm, flush)
+#undef inflateEnd
+#define inflateEnd(strm)	page_zip_inflate_end(strm)
+
 #if 0 || defined UNIV_DEBUG || defined UNIV_ZIP_DEBUG
 /** Symbol for enabling compression and decompression diagnostics */
 # define PAGE_ZIP_COMPRESS_DBG
@@ -1249,9 +1613,10 @@ page_zip_compress(
 	uint level;
 	uint wrap;
 	uint strategy;
+	uint algo;
 	int window_bits;
 	page_zip_decode_compression_flags(compression_flags, &level,
-	                                  &wrap, &strategy);
+	                                  &wrap, &strategy, &algo);
 	window_bits = wrap ? UNIV_PAGE_SIZE_SHIFT
 	                   : - ((int) UNIV_PAGE_SIZE_SHIFT);
 	ulint space_id = page_get_space_id(page);
@@ -1387,10 +1752,14 @@ page_zip_compress(
 	/* Compress the data payload. */
 	page_zip_set_alloc(&c_stream, heap);
 
-	err = deflateInit2(&c_stream, static_cast<int>(level),
-			   Z_DEFLATED, window_bits,
-			   MAX_MEM_LEVEL, strategy);
-	ut_a(err == Z_OK);
+	if (algo == PAGE_ZIP_ALGO_ZLIB) {
+		err = deflateInit2(&c_stream, static_cast<int>(level),
+				   Z_DEFLATED, window_bits,
+				   MAX_MEM_LEVEL, strategy);
+		ut_a(err == Z_OK);
+	} else {
+		page_zip_algo_stream_init(&c_stream, algo, level);
+	}
 
 	c_stream.next_out = buf;
 	/* Subtract the space reserved for uncompressed data. */
@@ -3061,12 +3430,18 @@ first try the positive window_bits then negative window_bits, because the
 surest way to determine if the stream has adler32 headers is to see if the
 stream begins with the zlib header together with the adler32 value of it.
 This adds a tiny bit of overhead for the pages that were compressed without
-adler32s. */
+adler32s. Pages compressed by LZ4 or Zstandard are recognized by their
+marker byte and decompressed by page_zip_algo_init_d_stream().
+@return TRUE on success, FALSE if the stream is corrupted */
 static
-void
+ibool
 page_zip_init_d_stream(
 	z_stream* strm)
 {
+	if ((*strm->next_in & 0xf) == PAGE_ZIP_ALGO_MARKER) {
+		return(page_zip_algo_init_d_stream(strm));
+	}
+
 	/* Save initial stream position, in case a reset is required. */
 	Bytef* next_in = strm->next_in;
 	Bytef* next_out = strm->next_out;
@@ -3089,6 +3464,8 @@ page_zip_init_d_stream(
 		/* read the zlib header */
 		ut_a(inflate(strm, Z_BLOCK) == Z_OK);
 	}
+
+	return(TRUE);
 }
 
 /**********************************************************************//**
@@ -3207,7 +3584,13 @@ zlib_error:
 	d_stream.next_out = page + PAGE_ZIP_START;
 	d_stream.avail_out = UNIV_PAGE_SIZE - PAGE_ZIP_START;
 
-	page_zip_init_d_stream(&d_stream);
+	if (UNIV_UNLIKELY(!page_zip_init_d_stream(&d_stream))) {
+
+		page_zip_fail(("page_zip_decompress:"
+			       " 1 corrupted stream header %02x\n",
+			       (unsigned) page_zip->data[PAGE_DATA]));
+		goto zlib_error;
+	}
 
 	if (UNIV_UNLIKELY(inflate(&d_stream, Z_BLOCK) != Z_OK)) {
 
@@ -4806,7 +5189,7 @@ page_zip_reorganize(
 	mtr_set_log_mode(mtr, log_mode);
 
 	if (!page_zip_compress(page_zip, page, index,
-			       page_zip_compression_flags, mtr)) {
+			       page_zip_compression_flags_for(index), mtr)) {
 
 #ifndef UNIV_HOTBACKUP
 		buf_block_free(temp_block);
@@ -0,0 +1,409 @@
+/*****************************************************************************
+
+Copyright (C) 2016 Facebook, Inc. All Rights Reserved.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Suite 500, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file row/row0pread.cc
+Parallel read of the clustered index
+*******************************************************/
+
+#include "row0pread.h"
+#include "btr0cur.h"
+#include "btr0pcur.h"
+#include "dict0dict.h"
+#include "lock0lock.h"
+#include "os0thread.h"
+#include "read0read.h"
+#include "rem0cmp.h"
+#include "row0row.h"
+#include "row0vers.h"
+#include "trx0trx.h"
+
+/** Number of records scanned between checks for an interrupted query.
+The page latches are released at the same time, so that a long scan
+does not block writers of the leaf pages. */
+#define ROW_PREAD_CHECK_INTERVAL	1000
+
+/** State shared by the threads of one parallel read */
+struct row_pread_t {
+	trx_t*		trx;		/*!< transaction that started the read */
+	dict_index_t*	index;		/*!< clustered index */
+	read_view_t*	view;		/*!< read view, or NULL for
+					READ UNCOMMITTED */
+	bool		check;		/*!< whether to verify the order of
+					the records */
+	dtuple_t**	bounds;		/*!< boundaries of the key ranges */
+	ulint		n_parts;	/*!< number of key ranges */
+	ulint		next_part;	/*!< number of key ranges taken by
+					threads so far, updated atomically */
+};
+
+/** State of one reader thread */
+struct row_pread_thread_t {
+	row_pread_t*	pread;		/*!< shared state */
+	ulint		n_rows;		/*!< number of visible records
+					counted by this thread */
+	dberr_t		error;		/*!< error seen by this thread */
+	os_thread_t	thread_hdl;	/*!< thread handle */
+};
+
+/*********************************************************************//**
+Reports a record that is not in ascending order. */
+static
+void
+row_pread_report_order(
+/*===================*/
+	const row_pread_t*	pread,	/*!< in: shared state */
+	const char*		what,	/*!< in: what prev is */
+	const dtuple_t*		prev,	/*!< in: previous record, or the
+					start of the key range */
+	const rec_t*		rec,	/*!< in: record */
+	const ulint*		offsets)/*!< in: rec_get_offsets(rec) */
+{
+	fputs("InnoDB: index records in a wrong order in ", stderr);
+	dict_index_name_print(stderr, pread->trx, pread->index);
+	fprintf(stderr, "\nInnoDB: %s ", what);
+	dtuple_print(stderr, prev);
+	fputs("\nInnoDB: record ", stderr);
+	rec_print_new(stderr, rec, offsets);
+	putc('\n', stderr);
+}
+
+/*********************************************************************//**
+Counts the visible records of one key range.
+
+When the order is checked, the first record must not precede the start
+of the range, and the order is also checked from the last record of the
+range to the end of the page where the next range starts. A record of
+the next range that is out of order there could be skipped by the
+search that positions the next range, so it is checked here.
+@return DB_SUCCESS or error code */
+static
+dberr_t
+row_pread_scan_part(
+/*================*/
+	row_pread_t*	pread,	/*!< in: shared state */
+	ulint		part,	/*!< in: key range to scan */
+	ulint*		n_rows)	/*!< in/out: number of visible records */
+{
+	dict_index_t*	index = pread->index;
+	const dtuple_t*	start = part > 0 ? pread->bounds[part - 1] : NULL;
+	const dtuple_t*	end = part + 1 < pread->n_parts
+		? pread->bounds[part] : NULL;
+	const ulint	comp = dict_table_is_comp(index->table);
+	const ulint	n_uniq = dict_index_get_n_unique(index);
+	btr_pcur_t	pcur;
+	mtr_t		mtr;
+	dtuple_t*	prev_entry = NULL;
+	mem_heap_t*	heap = NULL;
+	mem_heap_t*	vers_heap = NULL;
+	mem_heap_t*	entry_heap = NULL;
+	ulint		offsets_[REC_OFFS_NORMAL_SIZE];
+	ulint*		offsets = offsets_;
+	ulint		n_scanned = 0;
+	bool		wrong_order = false;
+	bool		past_end = false;
+	dberr_t		err = DB_SUCCESS;
+	rec_offs_init(offsets_);
+
+	if (pread->check) {
+		entry_heap = mem_heap_create(UNIV_PAGE_SIZE);
+	}
+
+	mtr_start(&mtr);
+
+	if (start != NULL) {
+		btr_pcur_open(index, start, PAGE_CUR_GE, BTR_SEARCH_LEAF,
+			      &pcur, &mtr);
+	} else {
+		btr_pcur_open_at_index_side(
+			true, index, BTR_SEARCH_LEAF, &pcur, true, 0, &mtr);
+	}
+
+	for (;;) {
+		const rec_t*	rec;
+		rec_t*		old_vers;
+
+		if (!btr_pcur_is_on_user_rec(&pcur)) {
+			goto next_rec;
+		}
+
+		rec = btr_pcur_get_rec(&pcur);
+
+		offsets = rec_get_offsets(rec, index, offsets,
+					  ULINT_UNDEFINED, &heap);
+
+		if (!past_end && end != NULL
+		    && cmp_dtuple_rec(end, rec, offsets) <= 0) {
+
+			if (!pread->check) {
+				break;
+			}
+
+			past_end = true;
+		}
+
+		if (prev_entry != NULL) {
+			ulint	matched_fields = 0;
+			ulint	matched_bytes = 0;
+			int	cmp = cmp_dtuple_rec_with_match(
+				prev_entry, rec, offsets,
+				&matched_fields, &matched_bytes);
+
+			if (cmp > 0 || matched_fields >= n_uniq) {
+				row_pread_report_order(
+					pread, "prev record", prev_entry,
+					rec, offsets);
+				wrong_order = true;
+			}
+		} else if (pread->check && start != NULL
+			   && cmp_dtuple_rec(start, rec, offsets) > 0) {
+			row_pread_report_order(
+				pread, "range start", start, rec, offsets);
+			wrong_order = true;
+		}
+
+		if (entry_heap != NULL) {
+			ulint	n_ext;
+
+			mem_heap_empty(entry_heap);
+
+			prev_entry = row_rec_to_index_entry(
+				rec, index, offsets, &n_ext, entry_heap);
+		}
+
+		if (past_end) {
+			/* The record belongs to the next range; it is
+			only checked, up to the end of the page. */
+			btr_pcur_move_to_next_on_page(&pcur);
+
+			if (btr_pcur_is_after_last_on_page(&pcur)) {
+				break;
+			}
+
+			continue;
+		}
+
+		if (pread->view != NULL
+		    && !lock_clust_rec_cons_read_sees(
+			    rec, index, offsets, pread->view)) {
+
+			if (vers_heap == NULL) {
+				vers_heap = mem_heap_create(UNIV_PAGE_SIZE);
+			} else {
+				mem_heap_empty(vers_heap);
+			}
+
+			err = row_vers_build_for_consistent_read(
+				rec, &mtr, index, &offsets, pread->view,
+				&heap, vers_heap, &old_vers);
+
+			if (err != DB_SUCCESS) {
+				break;
+			}
+
+			/* A NULL version means that the record was
+			inserted after the read view was created. */
+			rec = old_vers;
+		}
+
+		if (rec != NULL && !rec_get_deleted_flag(rec, comp)) {
+			++*n_rows;
+		}
+
+		if (++n_scanned % ROW_PREAD_CHECK_INTERVAL == 0) {
+			if (trx_is_interrupted(pread->trx)) {
+				err = DB_INTERRUPTED;
+				break;
+			}
+
+			/* Release the page latches. The cursor is on a
+			record that has been counted, so after restoring
+			the position we always move to the next one. */
+			btr_pcur_store_position(&pcur, &mtr);
+			mtr_commit(&mtr);
+
+			mtr_start(&mtr);
+			btr_pcur_restore_position(BTR_SEARCH_LEAF, &pcur,
+						  &mtr);
+		}
+
+next_rec:
+		if (!btr_pcur_move_to_next(&pcur, &mtr)) {
+			break;
+		}
+	}
+
+	btr_pcur_close(&pcur);
+	mtr_commit(&mtr);
+
+	if (heap != NULL) {
+		mem_heap_free(heap);
+	}
+
+	if (vers_heap != NULL) {
+		mem_heap_free(vers_heap);
+	}
+
+	if (entry_heap != NULL) {
+		mem_heap_free(entry_heap);
+	}
+
+	if (err == DB_SUCCESS && wrong_order) {
+		err = DB_CORRUPTION;
+	}
+
+	return(err);
+}
+
+/*********************************************************************//**
+Takes key ranges from the shared state and scans them until all ranges
+have been taken or an error occurs. */
+static
+void
+row_pread_worker(
+/*=============*/
+	row_pread_thread_t*	info)	/*!< in/out: thread state */
+{
+	row_pread_t*	pread = info->pread;
+
+	for (;;) {
+		ulint	part = os_atomic_increment_ulint(
+			&pread->next_part, 1) - 1;
+
+		if (part >= pread->n_parts) {
+			break;
+		}
+
+		dberr_t	err = row_pread_scan_part(
+			pread, part, &info->n_rows);
+
+		if (err == DB_SUCCESS) {
+			continue;
+		}
+
+		info->error = err;
+
+		if (err != DB_CORRUPTION) {
+			/* Make the other threads stop as well. */
+			os_atomic_increment_ulint(
+				&pread->next_part, pread->n_parts);
+			break;
+		}
+	}
+}
+
+/*********************************************************************//**
+Thread entry point of a parallel reader.
+@return OS_THREAD_DUMMY_RETURN */
+extern "C" UNIV_INTERN
+os_thread_ret_t
+DECLARE_THREAD(row_pread_thread)(
+/*=============================*/
+	void*	arg)	/*!< in: row_pread_thread_t* */
+{
+	row_pread_worker(static_cast<row_pread_thread_t*>(arg));
+
+	os_thread_exit(NULL, false);
+
+	OS_THREAD_DUMMY_RETURN;
+}
+
+/*********************************************************************//**
+Counts the records of a clustered index that are visible in the read
+view of a transaction, scanning the index in parallel threads. If the
+transaction has no read view, all records that are not delete-marked
+are counted, as in READ UNCOMMITTED.
+@return DB_SUCCESS, DB_INTERRUPTED, DB_CORRUPTION if check was
+requested and records were found in a wrong order, or another error */
+UNIV_INTERN
+dberr_t
+row_pread_count(
+/*============*/
+	trx_t*		trx,		/*!< in: transaction */
+	dict_index_t*	index,		/*!< in: clustered index */
+	ulint		n_threads,	/*!< in: number of reader threads */
+	bool		check,		/*!< in: whether to verify the order
+					of the records, as CHECK TABLE does */
+	ulint*		n_rows)		/*!< out: number of visible records */
+{
+	row_pread_t		pread;
+	row_pread_thread_t*	threads;
+	mem_heap_t*		heap;
+	dberr_t			err = DB_SUCCESS;
+	ulint			i;
+
+	ut_ad(dict_index_is_clust(index));
+
+	if (n_threads == 0) {
+		n_threads = 1;
+	} else if (n_threads > ROW_PREAD_MAX_THREADS) {
+		n_threads = ROW_PREAD_MAX_THREADS;
+	}
+
+	heap = mem_heap_create(1024);
+
+	pread.trx = trx;
+	pread.index = index;
+	pread.view = trx->read_view;
+	pread.check = check;
+	pread.next_part = 0;
+	pread.bounds = static_cast<dtuple_t**>(
+		mem_heap_zalloc(heap, n_threads * ROW_PREAD_PARTS_PER_THREAD
+				* sizeof *pread.bounds));
+	pread.n_parts = btr_cur_partition_index(
+		index, n_threads * ROW_PREAD_PARTS_PER_THREAD,
+		pread.bounds, heap);
+
+	n_threads = ut_min(n_threads, pread.n_parts);
+
+	threads = static_cast<row_pread_thread_t*>(
+		mem_heap_zalloc(heap, n_threads * sizeof *threads));
+
+	for (i = 0; i < n_threads; i++) {
+		threads[i].pread = &pread;
+		threads[i].error = DB_SUCCESS;
+	}
+
+	/* The calling thread is reader 0. */
+	for (i = 1; i < n_threads; i++) {
+		threads[i].thread_hdl = os_thread_create(
+			row_pread_thread, &threads[i], NULL);
+	}
+
+	row_pread_worker(&threads[0]);
+
+	*n_rows = 0;
+
+	for (i = 0; i < n_threads; i++) {
+		if (i > 0) {
+			os_thread_join(threads[i].thread_hdl);
+		}
+
+		*n_rows += threads[i].n_rows;
+
+		if (err == DB_SUCCESS || err == DB_CORRUPTION) {
+			if (threads[i].error != DB_SUCCESS) {
+				err = threads[i].error;
+			}
+		}
+	}
+
+	mem_heap_free(heap);
+
+	return(err);
+}
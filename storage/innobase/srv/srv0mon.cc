@@ -806,6 +806,41 @@ static monitor_info_t	innodb_counter_info[] =
 	 MONITOR_DISPLAY_CURRENT,
 	 MONITOR_DEFAULT_START, MONITOR_PURGE_RESUME_COUNT},
 
+	{"purge_trx_no_lag", "purge",
+	 "Number of transaction serialisation numbers between the newest"
+	 " transaction and the purge position",
+	 MONITOR_DISPLAY_CURRENT,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_TRX_NO_LAG},
+
+	{"purge_batch_tables", "purge",
+	 "Number of tables whose undo records were distributed to purge"
+	 " threads, counted once per batch",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_BATCH_TABLES},
+
+	{"purge_thread_records", "purge",
+	 "Number of undo records processed by purge threads",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_THREAD_RECORDS},
+
+	{"purge_thread_usec", "purge",
+	 "Time (in microseconds) spent by purge threads processing undo"
+	 " records",
+	 MONITOR_NONE,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_THREAD_USEC},
+
+	{"purge_thread_max_records", "purge",
+	 "Number of undo records handled by the busiest purge thread in"
+	 " the last batch",
+	 MONITOR_DISPLAY_CURRENT,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_THREAD_MAX_RECORDS},
+
+	{"purge_thread_min_records", "purge",
+	 "Number of undo records handled by the least busy purge thread in"
+	 " the last batch",
+	 MONITOR_DISPLAY_CURRENT,
+	 MONITOR_DEFAULT_START, MONITOR_PURGE_THREAD_MIN_RECORDS},
+
 	/* ========== Counters for Recovery Module ========== */
 	{"module_log", "recovery", "Recovery Module",
 	 MONITOR_MODULE,
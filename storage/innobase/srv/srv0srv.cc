@@ -112,6 +112,13 @@ UNIV_INTERN ulint	srv_undo_tablespaces_open = 8;
 /* The number of rollback segments to use */
 UNIV_INTERN ulong	srv_undo_logs = 1;
 
+/** Whether purge truncates undo tablespaces that grew beyond
+srv_max_undo_log_size. */
+UNIV_INTERN my_bool	srv_undo_log_truncate = FALSE;
+
+/** Size in bytes above which an undo tablespace is truncated. */
+UNIV_INTERN unsigned long long	srv_max_undo_log_size;
+
 #ifdef UNIV_LOG_ARCHIVE
 UNIV_INTERN char*	srv_arch_dir	= NULL;
 #endif /* UNIV_LOG_ARCHIVE */
@@ -144,6 +151,9 @@ UNIV_INTERN ibool	srv_locks_unsafe_for_binlog = FALSE;
 UNIV_INTERN ulong	srv_sort_buf_size = 1048576;
 /** Maximum modification log file size for online index creation */
 UNIV_INTERN unsigned long long	srv_online_max_size;
+/** Number of threads used to count the rows of a table for
+SELECT COUNT(*) and CHECK TABLE */
+UNIV_INTERN ulong	srv_parallel_read_threads = 4;
 
 /* If this flag is TRUE, then we will use the native aio of the
 OS (provided we compiled Innobase with it in), otherwise we will
@@ -195,6 +205,8 @@ UNIV_INTERN ib_uint64_t	srv_log_file_size	= IB_UINT64_MAX;
 UNIV_INTERN ib_uint64_t	srv_log_file_size_requested;
 /* size in database pages */
 UNIV_INTERN ulint	srv_log_buffer_size	= ULINT_MAX;
+/* whether the log is written and flushed by dedicated threads */
+UNIV_INTERN my_bool	srv_log_writer_threads	= FALSE;
 UNIV_INTERN ulong	srv_flush_log_at_trx_commit = 1;
 UNIV_INTERN uint	srv_flush_log_at_timeout = 1;
 UNIV_INTERN ulong	srv_page_size		= UNIV_PAGE_SIZE_DEF;
@@ -775,6 +787,10 @@ and/or load it during startup. */
 UNIV_INTERN char	srv_buffer_pool_dump_at_shutdown = FALSE;
 UNIV_INTERN char	srv_buffer_pool_load_at_startup = FALSE;
 
+/** Whether the buffer pool load reads the hottest pages first, a whole
+extent at a time */
+UNIV_INTERN char	srv_buffer_pool_load_fast = FALSE;
+
 /** Slot index in the srv_sys->sys_threads array for the purge thread. */
 static const ulint	SRV_PURGE_SLOT	= 1;
 
@@ -3231,7 +3247,7 @@ srv_task_execute(void)
 
 	if (thr != NULL) {
 
-		que_run_threads(thr);
+		trx_purge_run_thr(thr);
 
 		os_atomic_inc_ulint(
 			&purge_sys->bh_mutex, &purge_sys->n_completed, 1);
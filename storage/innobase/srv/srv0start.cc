@@ -148,11 +148,14 @@ static os_fast_mutex_t	srv_os_test_mutex;
 
 /** Name of srv_monitor_file */
 static char*	srv_monitor_file_name;
-#endif /* !UNIV_HOTBACKUP */
 
-/** Default undo tablespace size in UNIV_PAGEs count (10MB). */
-static const ulint SRV_UNDO_TABLESPACE_SIZE_IN_PAGES =
-	((1024 * 1024) * 10) / UNIV_PAGE_SIZE_DEF;
+/** Undo tablespaces whose truncation was interrupted. They are re-created
+by srv_undo_tablespaces_init() and re-initialized once the redo log has
+been scanned. */
+static ulint	srv_undo_spaces_to_fixup[TRX_SYS_N_RSEGS];
+/** Number of elements in srv_undo_spaces_to_fixup */
+static ulint	srv_n_undo_spaces_to_fixup;
+#endif /* !UNIV_HOTBACKUP */
 
 /** */
 #define SRV_N_PENDING_IOS_PER_THREAD	OS_AIO_N_PENDING_IOS_PER_THREAD
@@ -1406,6 +1409,41 @@ srv_undo_tablespaces_init(
 		ut_a(undo_tablespace_ids[i] != 0);
 		ut_a(undo_tablespace_ids[i] != ULINT_UNDEFINED);
 
+		/* If the server stopped while purge was truncating the
+		undo tablespace, its contents are not needed any more:
+		re-create it and complete the truncation after the redo
+		log scan. */
+
+		if (!create_new_db
+		    && trx_purge_undo_trunc_log_exists(
+			    undo_tablespace_ids[i])) {
+
+			if (srv_read_only_mode) {
+				ib_logf(IB_LOG_LEVEL_ERROR,
+					"The truncation of undo tablespace"
+					" '%s' was interrupted and cannot be"
+					" completed in read-only mode.", name);
+
+				return(DB_READ_ONLY);
+			}
+
+			ib_logf(IB_LOG_LEVEL_INFO,
+				"The truncation of undo tablespace '%s' was"
+				" interrupted, re-creating it.", name);
+
+			os_file_delete_if_exists(innodb_file_data_key, name);
+
+			err = srv_undo_tablespace_create(
+				name, SRV_UNDO_TABLESPACE_SIZE_IN_PAGES);
+
+			if (err != DB_SUCCESS) {
+				return(err);
+			}
+
+			srv_undo_spaces_to_fixup[srv_n_undo_spaces_to_fixup++]
+				= undo_tablespace_ids[i];
+		}
+
 		/* Undo space ids start from 1. */
 
 		err = srv_undo_tablespace_open(name, undo_tablespace_ids[i]);
@@ -1891,6 +1929,7 @@ innobase_start_or_create_for_mysql(void)
 			    + 1 /* fts_optimize_thread */
 			    + 1 /* recv_writer_thread */
 			    + 1 /* buf_flush_page_cleaner_thread */
+			    + 2 /* log_writer_thread, log_flusher_thread */
 			    + 1 /* trx_rollback_or_clean_all_recovered */
 			    + 128 /* added as margin, for use of
 				  InnoDB Memcached etc. */
@@ -2559,6 +2598,14 @@ files_checked:
 			return(err);
 		}
 
+		/* The rollback segment headers of an undo tablespace
+		whose truncation was interrupted must be re-created
+		before trx_sys_init_at_db_start() reads them. */
+		for (ulint i = 0; i < srv_n_undo_spaces_to_fixup; ++i) {
+			trx_purge_fixup_undo_tablespace(
+				srv_undo_spaces_to_fixup[i]);
+		}
+
 		ib_bh = trx_sys_init_at_db_start();
 		n_recovered_trx = UT_LIST_GET_LEN(trx_sys->rw_trx_list);
 
@@ -2855,6 +2902,10 @@ files_checked:
 
 	if (!srv_read_only_mode) {
 		os_thread_create(buf_flush_page_cleaner_thread, NULL, NULL);
+
+		if (srv_log_writer_threads) {
+			log_writer_threads_start();
+		}
 	}
 
 	os_thread_create(buf_flush_lru_manager_thread, NULL, NULL);
@@ -29,7 +29,9 @@ Created 3/26/1996 Heikki Tuuri
 #include "trx0purge.ic"
 #endif
 
+#include "buf0lru.h"
 #include "fsp0fsp.h"
+#include "log0log.h"
 #include "mach0data.h"
 #include "trx0rseg.h"
 #include "trx0trx.h"
@@ -45,6 +47,7 @@ Created 3/26/1996 Heikki Tuuri
 #include "os0thread.h"
 #include "srv0mon.h"
 #include "mtr0log.h"
+#include "os0file.h"
 #include <vector>
 #include <unordered_map>
 
@@ -123,6 +126,9 @@ trx_purge_sys_create(
 	purge_sys->state = PURGE_STATE_INIT;
 	purge_sys->event = os_event_create();
 
+	purge_sys->undo_trunc.space_id = ULINT_UNDEFINED;
+	purge_sys->undo_trunc.scan_start = 1;
+
 	/* Take ownership of ib_bh, we are responsible for freeing it. */
 	purge_sys->ib_bh = ib_bh;
 
@@ -531,6 +537,510 @@ trx_purge_truncate_history(
 	}
 }
 
+/*================ UNDO TABLESPACE TRUNCATION =======================*/
+
+/* An undo tablespace that grew beyond srv_max_undo_log_size is truncated
+in these steps:
+
+1. Purge marks the tablespace. Its rollback segments are no longer
+assigned to new transactions.
+2. Purge waits until the rollback segments are drained: no transaction
+uses them and their history lists are empty.
+3. A log checkpoint makes sure that recovery never applies redo log
+records to the old pages of the tablespace.
+4. The truncate log file is created. From now on a restart completes the
+truncation from scratch.
+5. The file is truncated to its initial size and the tablespace header
+and the rollback segment headers are re-created without redo logging.
+Only the TRX_SYS slots that point to the rollback segment headers are
+redo logged.
+6. The pages are flushed, a checkpoint is made and the truncate log file
+is removed. The rollback segments can be assigned again. */
+
+/** Magic number at the start of an undo tablespace truncate log file */
+#define TRX_UNDO_TRUNC_LOG_MAGIC	0x554E5452
+
+/********************************************************************//**
+Builds the name of the truncate log file of an undo tablespace. */
+static
+void
+trx_purge_undo_trunc_log_name(
+/*==========================*/
+	ulint	space_id,	/*!< in: undo tablespace id */
+	char*	name,		/*!< out: file name */
+	ulint	size)		/*!< in: size of name */
+{
+	ut_snprintf(name, size, "%s%cundo%03lu_trunc.log",
+		    srv_undo_dir, SRV_PATH_SEPARATOR, space_id);
+}
+
+/********************************************************************//**
+Creates the truncate log file of an undo tablespace.
+@return true if success */
+static
+bool
+trx_purge_undo_trunc_log_create(
+/*============================*/
+	ulint	space_id)	/*!< in: undo tablespace id */
+{
+	char		name[OS_FILE_MAX_PATH];
+	ibool		success;
+	os_file_t	handle;
+
+	trx_purge_undo_trunc_log_name(space_id, name, sizeof(name));
+
+	handle = os_file_create(
+		innodb_file_data_key, name, OS_FILE_CREATE,
+		OS_FILE_NORMAL, OS_DATA_FILE, &success);
+
+	if (!success) {
+		return(false);
+	}
+
+	/* The file may be opened with O_DIRECT: write one aligned page. */
+	byte*	buf = static_cast<byte*>(ut_malloc(2 * UNIV_PAGE_SIZE));
+	byte*	page = static_cast<byte*>(ut_align(buf, UNIV_PAGE_SIZE));
+
+	memset(page, 0, UNIV_PAGE_SIZE);
+	mach_write_to_4(page, TRX_UNDO_TRUNC_LOG_MAGIC);
+	mach_write_to_4(page + 4, space_id);
+
+	success = os_file_write(name, handle, page, 0, UNIV_PAGE_SIZE)
+		&& os_file_flush(handle);
+
+	os_file_close(handle);
+
+	ut_free(buf);
+
+	if (!success) {
+		os_file_delete_if_exists(innodb_file_data_key, name);
+	}
+
+	return(success);
+}
+
+/********************************************************************//**
+Removes the truncate log file of an undo tablespace. */
+static
+void
+trx_purge_undo_trunc_log_remove(
+/*============================*/
+	ulint	space_id)	/*!< in: undo tablespace id */
+{
+	char	name[OS_FILE_MAX_PATH];
+
+	trx_purge_undo_trunc_log_name(space_id, name, sizeof(name));
+
+	os_file_delete_if_exists(innodb_file_data_key, name);
+}
+
+/*******************************************************************//**
+Checks whether the truncation of an undo tablespace was interrupted,
+that is, whether its truncate log file exists.
+@return true if the undo tablespace must be fixed up */
+UNIV_INTERN
+bool
+trx_purge_undo_trunc_log_exists(
+/*============================*/
+	ulint	space_id)	/*!< in: undo tablespace id */
+{
+	char		name[OS_FILE_MAX_PATH];
+	ibool		exists;
+	os_file_type_t	type;
+
+	trx_purge_undo_trunc_log_name(space_id, name, sizeof(name));
+
+	return(os_file_status(name, &exists, &type) && exists);
+}
+
+/********************************************************************//**
+Initializes a truncated undo tablespace: creates the tablespace header
+and the rollback segment headers in it. These pages are not redo logged;
+the caller flushes them before it removes the truncate log file. The
+TRX_SYS slots pointing to the new rollback segment headers are redo
+logged. */
+static
+void
+trx_purge_init_undo_tablespace(
+/*===========================*/
+	ulint		space_id,	/*!< in: undo tablespace id */
+	const ulint*	slots,		/*!< in: rollback segment slots of
+					the tablespace in TRX_SYS */
+	ulint		n_slots,	/*!< in: number of slots */
+	ulint*		page_nos)	/*!< out: rollback segment header
+					page numbers */
+{
+	mtr_t		mtr;
+	trx_sysf_t*	sys_header;
+
+	mtr_start(&mtr);
+
+	mtr_set_log_mode(&mtr, MTR_LOG_NO_REDO);
+
+	/* To obey the latching order, acquire the file space
+	x-latch before the TRX_SYS header page. */
+	mtr_x_lock(fil_space_get_latch(space_id, NULL), &mtr);
+
+	fsp_header_init(space_id, SRV_UNDO_TABLESPACE_SIZE_IN_PAGES, &mtr);
+
+	for (ulint i = 0; i < n_slots; ++i) {
+		page_nos[i] = trx_rseg_header_create(
+			space_id, 0, ULINT_MAX, slots[i], &mtr);
+
+		ut_a(page_nos[i] != FIL_NULL);
+	}
+
+	mtr_commit(&mtr);
+
+	mtr_start(&mtr);
+
+	sys_header = trx_sysf_get(&mtr);
+
+	for (ulint i = 0; i < n_slots; ++i) {
+		trx_sysf_rseg_set_space(sys_header, slots[i], space_id, &mtr);
+		trx_sysf_rseg_set_page_no(
+			sys_header, slots[i], page_nos[i], &mtr);
+	}
+
+	mtr_commit(&mtr);
+}
+
+/*******************************************************************//**
+Completes the truncation of an undo tablespace that was interrupted by a
+crash. The tablespace file must already have been re-created at its
+initial size. Re-initializes the tablespace header and the rollback
+segment headers in it, and removes the truncate log file. Must be called
+after the redo log scan and before trx_sys_init_at_db_start(). */
+UNIV_INTERN
+void
+trx_purge_fixup_undo_tablespace(
+/*============================*/
+	ulint	space_id)	/*!< in: undo tablespace id */
+{
+	mtr_t		mtr;
+	trx_sysf_t*	sys_header;
+	ulint		slots[TRX_SYS_N_RSEGS];
+	ulint		page_nos[TRX_SYS_N_RSEGS];
+	ulint		n_slots = 0;
+
+	mtr_start(&mtr);
+
+	sys_header = trx_sysf_get(&mtr);
+
+	for (ulint i = 0; i < TRX_SYS_N_RSEGS; ++i) {
+		if (trx_sysf_rseg_get_page_no(sys_header, i, &mtr) != FIL_NULL
+		    && trx_sysf_rseg_get_space(sys_header, i, &mtr)
+		    == space_id) {
+
+			slots[n_slots++] = i;
+		}
+	}
+
+	mtr_commit(&mtr);
+
+	trx_purge_init_undo_tablespace(space_id, slots, n_slots, page_nos);
+
+	buf_LRU_flush_or_remove_pages(space_id, BUF_REMOVE_FLUSH_WRITE, NULL);
+
+	/* The TRX_SYS slots must survive a crash once the truncate
+	log file is gone. */
+	log_buffer_flush_to_disk();
+
+	trx_purge_undo_trunc_log_remove(space_id);
+
+	ib_logf(IB_LOG_LEVEL_INFO,
+		"Completed the interrupted truncation of undo tablespace "
+		"%lu.", space_id);
+}
+
+/********************************************************************//**
+Makes the rollback segments of the marked undo tablespace available to
+new transactions again and clears the mark. */
+static
+void
+trx_purge_unmark_undo_for_truncate(
+/*===============================*/
+	trx_undo_trunc_t*	undo_trunc)	/*!< in/out: truncate state */
+{
+	for (ulint i = 0; i < undo_trunc->n_rsegs; ++i) {
+		trx_rseg_t*	rseg = undo_trunc->rsegs[i];
+
+		mutex_enter(&rseg->mutex);
+		rseg->skip_allocation = false;
+		mutex_exit(&rseg->mutex);
+	}
+
+	undo_trunc->space_id = ULINT_UNDEFINED;
+	undo_trunc->n_rsegs = 0;
+}
+
+/********************************************************************//**
+Looks for an undo tablespace that grew beyond srv_max_undo_log_size and
+marks it for truncation: its rollback segments are no longer assigned to
+new transactions. */
+static
+void
+trx_purge_mark_undo_for_truncate(
+/*=============================*/
+	trx_undo_trunc_t*	undo_trunc)	/*!< in/out: truncate state */
+{
+	ulint	space_id;
+	ulint	limit;
+	ulint	i;
+
+	if (undo_trunc->space_id != ULINT_UNDEFINED
+	    || !srv_undo_log_truncate
+	    || srv_read_only_mode
+	    || srv_undo_tablespaces_open < 2) {
+
+		return;
+	}
+
+	limit = (ulint) (srv_max_undo_log_size / UNIV_PAGE_SIZE);
+
+	/* Start after the undo tablespace that was truncated last, so
+	that every undo tablespace gets its turn. */
+
+	space_id = undo_trunc->scan_start;
+
+	for (i = 0; i < srv_undo_tablespaces_open; ++i) {
+
+		if (space_id > srv_undo_tablespaces_open) {
+			space_id = 1;
+		}
+
+		if (fil_space_get_size(space_id) > limit) {
+			break;
+		}
+
+		++space_id;
+	}
+
+	if (i == srv_undo_tablespaces_open) {
+		return;
+	}
+
+	/* The transactions must be able to use the rollback segments
+	of another undo tablespace while this one is truncated. */
+
+	ulint	n_other = 0;
+
+	for (i = 0; i < TRX_SYS_N_RSEGS; ++i) {
+		trx_rseg_t*	rseg = trx_sys->rseg_array[i];
+
+		if (rseg == NULL) {
+			continue;
+		} else if (rseg->space == space_id) {
+			undo_trunc->rsegs[undo_trunc->n_rsegs++] = rseg;
+		} else if (rseg->space != TRX_SYS_SPACE) {
+			++n_other;
+		}
+	}
+
+	if (undo_trunc->n_rsegs == 0 || n_other == 0) {
+		undo_trunc->n_rsegs = 0;
+		return;
+	}
+
+	undo_trunc->space_id = space_id;
+	undo_trunc->scan_start = space_id + 1;
+
+	for (i = 0; i < undo_trunc->n_rsegs; ++i) {
+		trx_rseg_t*	rseg = undo_trunc->rsegs[i];
+
+		mutex_enter(&rseg->mutex);
+		rseg->skip_allocation = true;
+		mutex_exit(&rseg->mutex);
+	}
+
+	ib_logf(IB_LOG_LEVEL_INFO,
+		"Undo tablespace %lu of %lu pages is marked for truncation.",
+		space_id, fil_space_get_size(space_id));
+}
+
+/********************************************************************//**
+Checks whether the rollback segments of the marked undo tablespace are
+drained: no transaction uses them and their history is purged.
+@return true if the undo tablespace can be truncated */
+static
+bool
+trx_purge_undo_trunc_is_drained(
+/*============================*/
+	const trx_undo_trunc_t*	undo_trunc)	/*!< in: truncate state */
+{
+	for (ulint i = 0; i < undo_trunc->n_rsegs; ++i) {
+		trx_rseg_t*	rseg = undo_trunc->rsegs[i];
+		trx_rsegf_t*	rseg_hdr;
+		ulint		history_len;
+		bool		in_use;
+		mtr_t		mtr;
+
+		mtr_start(&mtr);
+		mutex_enter(&rseg->mutex);
+
+		in_use = rseg->trx_ref_count > 0
+			|| UT_LIST_GET_LEN(rseg->update_undo_list) > 0
+			|| UT_LIST_GET_LEN(rseg->insert_undo_list) > 0
+			|| rseg->last_page_no != FIL_NULL;
+
+		rseg_hdr = trx_rsegf_get(rseg->space, rseg->zip_size,
+					 rseg->page_no, &mtr);
+
+		history_len = flst_get_len(rseg_hdr + TRX_RSEG_HISTORY, &mtr);
+
+		mutex_exit(&rseg->mutex);
+		mtr_commit(&mtr);
+
+		if (in_use || history_len > 0) {
+			return(false);
+		}
+	}
+
+	return(true);
+}
+
+/********************************************************************//**
+Resets the memory object of a rollback segment whose undo tablespace was
+truncated. */
+static
+void
+trx_purge_reset_rseg(
+/*=================*/
+	trx_rseg_t*	rseg,		/*!< in/out: rollback segment */
+	ulint		page_no)	/*!< in: new rollback segment header
+					page number */
+{
+	trx_undo_t*	undo;
+	trx_undo_t*	next_undo;
+
+	mutex_enter(&rseg->mutex);
+
+	ut_a(UT_LIST_GET_LEN(rseg->update_undo_list) == 0);
+	ut_a(UT_LIST_GET_LEN(rseg->insert_undo_list) == 0);
+
+	for (undo = UT_LIST_GET_FIRST(rseg->update_undo_cached);
+	     undo != NULL;
+	     undo = next_undo) {
+
+		next_undo = UT_LIST_GET_NEXT(undo_list, undo);
+
+		UT_LIST_REMOVE(undo_list, rseg->update_undo_cached, undo);
+
+		MONITOR_DEC(MONITOR_NUM_UNDO_SLOT_CACHED);
+
+		trx_undo_mem_free(undo);
+	}
+
+	for (undo = UT_LIST_GET_FIRST(rseg->insert_undo_cached);
+	     undo != NULL;
+	     undo = next_undo) {
+
+		next_undo = UT_LIST_GET_NEXT(undo_list, undo);
+
+		UT_LIST_REMOVE(undo_list, rseg->insert_undo_cached, undo);
+
+		MONITOR_DEC(MONITOR_NUM_UNDO_SLOT_CACHED);
+
+		trx_undo_mem_free(undo);
+	}
+
+	rseg->page_no = page_no;
+	rseg->curr_size = 1;
+	rseg->last_page_no = FIL_NULL;
+	rseg->last_offset = 0;
+	rseg->last_trx_no = 0;
+	rseg->last_del_marks = FALSE;
+
+	mutex_exit(&rseg->mutex);
+}
+
+/********************************************************************//**
+Truncates the marked undo tablespace back to its initial size once its
+rollback segments are drained. */
+static
+void
+trx_purge_truncate_undo_tablespace(
+/*===============================*/
+	trx_undo_trunc_t*	undo_trunc)	/*!< in/out: truncate state */
+{
+	ulint	space_id = undo_trunc->space_id;
+	ulint	slots[TRX_SYS_N_RSEGS];
+	ulint	page_nos[TRX_SYS_N_RSEGS];
+
+	if (space_id == ULINT_UNDEFINED) {
+		return;
+	}
+
+	if (!srv_undo_log_truncate) {
+		/* Truncation was disabled after the tablespace was
+		marked. */
+		trx_purge_unmark_undo_for_truncate(undo_trunc);
+		return;
+	}
+
+	if (!trx_purge_undo_trunc_is_drained(undo_trunc)) {
+		return;
+	}
+
+	/* Nothing modifies the tablespace any more. After this checkpoint
+	recovery never applies redo log records to its old pages. */
+	log_make_checkpoint_at(LSN_MAX, TRUE);
+
+	ib_logf(IB_LOG_LEVEL_INFO,
+		"Truncating undo tablespace %lu.", space_id);
+
+	if (!trx_purge_undo_trunc_log_create(space_id)) {
+		ib_logf(IB_LOG_LEVEL_ERROR,
+			"Cannot create the truncate log file of undo "
+			"tablespace %lu. The tablespace is not truncated.",
+			space_id);
+
+		trx_purge_unmark_undo_for_truncate(undo_trunc);
+		return;
+	}
+
+	DBUG_EXECUTE_IF("ib_undo_trunc_before_truncate", DBUG_SUICIDE(););
+
+	if (!fil_truncate_tablespace(
+		    space_id, SRV_UNDO_TABLESPACE_SIZE_IN_PAGES)) {
+
+		ib_logf(IB_LOG_LEVEL_ERROR,
+			"Cannot truncate undo tablespace %lu.", space_id);
+
+		/* The file is unchanged and its pages were clean. */
+		trx_purge_undo_trunc_log_remove(space_id);
+		trx_purge_unmark_undo_for_truncate(undo_trunc);
+		return;
+	}
+
+	for (ulint i = 0; i < undo_trunc->n_rsegs; ++i) {
+		slots[i] = undo_trunc->rsegs[i]->id;
+	}
+
+	trx_purge_init_undo_tablespace(
+		space_id, slots, undo_trunc->n_rsegs, page_nos);
+
+	for (ulint i = 0; i < undo_trunc->n_rsegs; ++i) {
+		trx_purge_reset_rseg(undo_trunc->rsegs[i], page_nos[i]);
+	}
+
+	DBUG_EXECUTE_IF("ib_undo_trunc_before_flush", DBUG_SUICIDE(););
+
+	buf_LRU_flush_or_remove_pages(space_id, BUF_REMOVE_FLUSH_WRITE, NULL);
+
+	log_make_checkpoint_at(LSN_MAX, TRUE);
+
+	DBUG_EXECUTE_IF("ib_undo_trunc_before_log_remove", DBUG_SUICIDE(););
+
+	trx_purge_undo_trunc_log_remove(space_id);
+
+	trx_purge_unmark_undo_for_truncate(undo_trunc);
+
+	ib_logf(IB_LOG_LEVEL_INFO,
+		"Truncated undo tablespace %lu to %lu pages.",
+		space_id, SRV_UNDO_TABLESPACE_SIZE_IN_PAGES);
+}
+
 /***********************************************************************//**
 Updates the last not yet purged history log info in rseg when we have purged
 a whole undo log. Advances also purge_sys->purge_trx_no past the purged log. */
@@ -957,6 +1467,37 @@ trx_purge_fetch_next_rec(
 	return(trx_purge_get_next_rec(n_pages_handled, heap));
 }
 
+/*******************************************************************//**
+Picks the purge thread that has been given the fewest undo records so far
+in the current batch.
+@return query thread to attach the records of a new table to */
+static
+que_thr_t*
+trx_purge_least_loaded_thr(
+/*=======================*/
+	const std::vector<que_thr_t*>&	run_thrs)	/*!< in: threads that
+							take part in the
+							batch */
+{
+	que_thr_t*	best = NULL;
+	ulint		best_n_recs = ULINT_MAX;
+
+	for (std::vector<que_thr_t*>::const_iterator it = run_thrs.begin();
+	     it != run_thrs.end();
+	     ++it) {
+
+		const purge_node_t*	node
+			= static_cast<const purge_node_t*>((*it)->child);
+
+		if (node->n_recs < best_n_recs) {
+			best = *it;
+			best_n_recs = node->n_recs;
+		}
+	}
+
+	return(best);
+}
+
 /*******************************************************************//**
 This function runs a purge batch.
 @return	number of undo log pages handled in the batch */
@@ -974,7 +1515,6 @@ trx_purge_attach_undo_recs(
 	ulint		n_pages_handled = 0;
 	ulint		n_thrs = UT_LIST_GET_LEN(purge_sys->query->thrs);
 	mem_heap_t*	heap = purge_sys->heap;
-	ulint		free_thr = 0;
 	std::vector<que_thr_t*> run_thrs;
 
 	ut_a(n_purge_threads > 0);
@@ -996,6 +1536,8 @@ trx_purge_attach_undo_recs(
 		ut_a(node->done);
 
 		node->done = FALSE;
+		node->n_recs = 0;
+		node->run_usec = 0;
 		run_thrs.push_back(thr);
 	}
 
@@ -1007,6 +1549,11 @@ trx_purge_attach_undo_recs(
 
 	ut_ad(trx_purge_check_limit());
 
+	/* All undo records of a table go to the same thread, so that the
+	threads of a batch work on disjoint sets of tables and do not
+	contend for the same index pages and dictionary latches. A table
+	seen for the first time in the batch is given to the thread that
+	has the fewest records so far. */
 	std::unordered_map<table_id_t, que_thr_t*> table_thr;
 
 	for (;;) {
@@ -1040,7 +1587,7 @@ trx_purge_attach_undo_recs(
 
 			auto it = table_thr.find(table_id);
 			if (it == table_thr.end()) {
-				thr = run_thrs[free_thr++ % n_purge_threads];
+				thr = trx_purge_least_loaded_thr(run_thrs);
 				table_thr.emplace(table_id, thr);
 			} else {
 				thr = it->second;
@@ -1061,6 +1608,7 @@ trx_purge_attach_undo_recs(
 			}
 
 			ib_vector_push(node->undo_recs, purge_rec);
+			++node->n_recs;
 
 			if (n_pages_handled >= batch_size) {
 
@@ -1073,6 +1621,8 @@ trx_purge_attach_undo_recs(
 
 	ut_ad(trx_purge_check_limit());
 
+	MONITOR_INC_VALUE(MONITOR_PURGE_BATCH_TABLES, table_thr.size());
+
 	return(n_pages_handled);
 }
 
@@ -1177,6 +1727,70 @@ trx_purge_truncate(void)
 	} else {
 		trx_purge_truncate_history(&purge_sys->limit, purge_sys->view);
 	}
+
+	trx_purge_mark_undo_for_truncate(&purge_sys->undo_trunc);
+	trx_purge_truncate_undo_tablespace(&purge_sys->undo_trunc);
+}
+
+/*******************************************************************//**
+Runs the undo records attached to a purge query thread and records in its
+purge node how long that took. */
+UNIV_INTERN
+void
+trx_purge_run_thr(
+/*==============*/
+	que_thr_t*	thr)	/*!< in: purge query thread */
+{
+	purge_node_t*	node = static_cast<purge_node_t*>(thr->child);
+	ib_uint64_t	start_time = ut_time_us(NULL);
+
+	que_run_threads(thr);
+
+	node->run_usec = ut_time_us(NULL) - start_time;
+}
+
+/*******************************************************************//**
+Updates the purge monitor counters once all threads of a batch are done. */
+static
+void
+trx_purge_monitor_batch(
+/*====================*/
+	ulint	n_purge_threads)	/*!< in: number of purge threads
+					that took part in the batch */
+{
+	ulint		n_recs = 0;
+	ulint		max_recs = 0;
+	ulint		min_recs = ULINT_MAX;
+	ib_uint64_t	run_usec = 0;
+	ulint		i = 0;
+	trx_id_t	max_trx_id;
+
+	for (que_thr_t* thr = UT_LIST_GET_FIRST(purge_sys->query->thrs);
+	     thr != NULL && i < n_purge_threads;
+	     thr = UT_LIST_GET_NEXT(thrs, thr), ++i) {
+
+		const purge_node_t*	node
+			= static_cast<const purge_node_t*>(thr->child);
+
+		n_recs += node->n_recs;
+		run_usec += node->run_usec;
+		max_recs = ut_max(max_recs, node->n_recs);
+		min_recs = ut_min(min_recs, node->n_recs);
+	}
+
+	MONITOR_INC_VALUE(MONITOR_PURGE_THREAD_RECORDS, n_recs);
+	MONITOR_INC_VALUE(MONITOR_PURGE_THREAD_USEC, run_usec);
+	MONITOR_SET(MONITOR_PURGE_THREAD_MAX_RECORDS, max_recs);
+	MONITOR_SET(MONITOR_PURGE_THREAD_MIN_RECORDS, min_recs);
+
+	/* Serialisation numbers are assigned from the same counter as
+	transaction ids, so the distance to the purge position tells how
+	far purge lags behind the committed transactions. */
+	max_trx_id = trx_sys_get_max_trx_id();
+
+	MONITOR_SET(MONITOR_PURGE_TRX_NO_LAG,
+		    max_trx_id > purge_sys->iter.trx_no
+		    ? max_trx_id - purge_sys->iter.trx_no : 0);
 }
 
 /*******************************************************************//**
@@ -1251,7 +1865,7 @@ trx_purge(
 run_synchronously:
 		++purge_sys->n_submitted;
 
-		que_run_threads(thr);
+		trx_purge_run_thr(thr);
 
 		os_atomic_inc_ulint(
 			&purge_sys->bh_mutex, &purge_sys->n_completed, 1);
@@ -1263,6 +1877,8 @@ run_synchronously:
 
 	ut_a(purge_sys->n_submitted == purge_sys->n_completed);
 
+	trx_purge_monitor_batch(n_purge_threads);
+
 #ifdef UNIV_DEBUG
 	rw_lock_x_lock(&purge_sys->latch);
 	if (purge_sys->limit.trx_no == 0) {
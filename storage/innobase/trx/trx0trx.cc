@@ -798,6 +798,9 @@ trx_resurrect_insert(
 	trx->xid = undo->xid;
 	trx->id = undo->trx_id;
 	trx->insert_undo = undo;
+
+	/* Single-threaded startup code, no need for rseg->mutex. */
+	++rseg->trx_ref_count;
 	trx->is_recovered = TRUE;
 
 	/* This is single-threaded startup code, we do not need the
@@ -915,6 +918,13 @@ trx_resurrect_update(
 	trx_undo_t*	undo,	/*!< in/out: update UNDO record */
 	trx_rseg_t*	rseg)	/*!< in/out: rollback segment */
 {
+	/* The insert undo log of the transaction, if any, is in the same
+	rollback segment and has already been counted. Single-threaded
+	startup code, no need for rseg->mutex. */
+	if (trx->rseg == NULL) {
+		++rseg->trx_ref_count;
+	}
+
 	trx->rseg = rseg;
 	trx->xid = undo->xid;
 	trx->id = undo->trx_id;
@@ -1070,20 +1080,58 @@ trx_assign_rseg_low(
 	defined for rollback segments. We want all UNDO records to be in
 	the non-system tablespaces. */
 
-	do {
+	for (;;) {
 		rseg = trx_sys->rseg_array[i];
 		ut_a(rseg == NULL || i == rseg->id);
 
-		i = (rseg == NULL) ? 0 : i + 1;
+		i = (rseg == NULL || i + 1 == TRX_SYS_N_RSEGS) ? 0 : i + 1;
+
+		if (rseg == NULL
+		    || (rseg->space == 0
+			&& n_tablespaces > 0
+			&& trx_sys->rseg_array[1] != NULL)) {
+
+			continue;
+		}
+
+		/* Skip the rollback segments of an undo tablespace that
+		purge is about to truncate. Purge only marks a tablespace
+		when another undo tablespace can take its transactions. */
+
+		mutex_enter(&rseg->mutex);
+
+		if (!rseg->skip_allocation) {
+			++rseg->trx_ref_count;
+			mutex_exit(&rseg->mutex);
+			break;
+		}
 
-	} while (rseg == NULL
-		 || (rseg->space == 0
-		     && n_tablespaces > 0
-		     && trx_sys->rseg_array[1] != NULL));
+		mutex_exit(&rseg->mutex);
+	}
 
 	return(rseg);
 }
 
+/****************************************************************//**
+Releases the reference of a transaction to its rollback segment. */
+static
+void
+trx_release_rseg(
+/*=============*/
+	trx_t*	trx)	/*!< in/out: transaction */
+{
+	trx_rseg_t*	rseg = trx->rseg;
+
+	if (rseg != NULL) {
+		mutex_enter(&rseg->mutex);
+		ut_ad(rseg->trx_ref_count > 0);
+		--rseg->trx_ref_count;
+		mutex_exit(&rseg->mutex);
+
+		trx->rseg = NULL;
+	}
+}
+
 /****************************************************************//**
 Assign a read-only transaction a rollback-segment, if it is attempting
 to write to a TEMPORARY table. */
@@ -1634,7 +1682,7 @@ trx_commit_in_memory(
 	trx_named_savept_t*	savep = UT_LIST_GET_FIRST(trx->trx_savepoints);
 	trx_roll_savepoints_free(trx, savep);
 
-	trx->rseg = NULL;
+	trx_release_rseg(trx);
 	trx->undo_no = 0;
 	trx->last_sql_stat_start.least_undo_no = 0;
 
@@ -1776,7 +1824,7 @@ trx_cleanup_at_db_startup(
 		trx_undo_insert_cleanup(trx);
 	}
 
-	trx->rseg = NULL;
+	trx_release_rseg(trx);
 	trx->undo_no = 0;
 	trx->last_sql_stat_start.least_undo_no = 0;
 
@@ -270,6 +270,12 @@ static Rdb_index_stats_thread rdb_is_thread;
 
 static Rdb_manual_compaction_thread rdb_mc_thread;
 
+/* Pool of threads running Rdb_scan_prefetch jobs, empty if disabled */
+static std::vector<std::unique_ptr<Rdb_prefetch_thread>> rdb_prefetch_threads;
+static std::atomic<uint> rdb_prefetch_next_thread(0);
+static void rdb_submit_scan_prefetch(
+    const std::shared_ptr<Rdb_scan_prefetch> &job);
+
 static Rdb_drop_index_thread rdb_drop_idx_thread;
 // List of table names (using regex) that are exceptions to the strict
 // collation check requirement.
@@ -681,6 +687,7 @@ static my_bool rocksdb_debug_ttl_ignore_pk = 0;
 static my_bool rocksdb_reset_stats = 0;
 static uint32_t rocksdb_io_write_timeout_secs = 0;
 static uint32_t rocksdb_seconds_between_stat_computes = 3600;
+static uint32_t rocksdb_scan_prefetch_threads = 0;
 static long long rocksdb_compaction_sequential_deletes = 0l;
 static long long rocksdb_compaction_sequential_deletes_window = 0l;
 static long long rocksdb_compaction_sequential_deletes_file_size = 0l;
@@ -1070,6 +1077,8 @@ const int RDB_MAX_CHECKSUMS_PCT = 100;
 const ulong RDB_DEADLOCK_DETECT_DEPTH = 50;
 const ulong ROCKSDB_MAX_MRR_BATCH_SIZE = 1000;
 const uint ROCKSDB_MAX_BOTTOM_PRI_BACKGROUND_COMPACTIONS = 64;
+const uint RDB_MAX_SCAN_PREFETCH_THREADS = 64;
+const uint RDB_MAX_SCAN_PREFETCH_BLOCKS = 1024;
 
 // TODO: 0 means don't wait at all, and we don't support it yet?
 static MYSQL_THDVAR_ULONG(lock_wait_timeout, PLUGIN_VAR_RQCMDARG,
@@ -2316,6 +2325,21 @@ static MYSQL_THDVAR_LONG(mrr_batch_size, PLUGIN_VAR_RQCMDARG,
                          nullptr, nullptr, /* default */ 100, /* min */ 0,
                          /* max */ ROCKSDB_MAX_MRR_BATCH_SIZE, 0);
 
+static MYSQL_SYSVAR_UINT(
+    scan_prefetch_threads, rocksdb_scan_prefetch_threads,
+    PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+    "Number of threads reading data blocks ahead of range scans into the "
+    "block cache. 0 disables scan prefetching",
+    nullptr, nullptr, /* default */ 0, /* min */ 0,
+    /* max */ RDB_MAX_SCAN_PREFETCH_THREADS, 0);
+
+static MYSQL_THDVAR_UINT(
+    scan_prefetch_blocks, PLUGIN_VAR_RQCMDARG,
+    "How far ahead of a range scan, in data blocks, the scan prefetch threads "
+    "read. 0 disables scan prefetching for the session",
+    nullptr, nullptr, /* default */ 16, /* min */ 0,
+    /* max */ RDB_MAX_SCAN_PREFETCH_BLOCKS, 0);
+
 static MYSQL_SYSVAR_BOOL(skip_locks_if_skip_unique_check,
                          rocksdb_skip_locks_if_skip_unique_check,
                          PLUGIN_VAR_RQCMDARG,
@@ -2511,6 +2535,8 @@ static struct st_mysql_sys_var *rocksdb_system_variables[] = {
     MYSQL_SYSVAR(select_bypass_debug_row_delay),
     MYSQL_SYSVAR(select_bypass_multiget_min),
     MYSQL_SYSVAR(mrr_batch_size),
+    MYSQL_SYSVAR(scan_prefetch_threads),
+    MYSQL_SYSVAR(scan_prefetch_blocks),
     MYSQL_SYSVAR(skip_locks_if_skip_unique_check),
     MYSQL_SYSVAR(alter_column_default_inplace),
     nullptr};
@@ -5966,6 +5992,27 @@ static int rocksdb_init_func(void *const p) {
     DBUG_RETURN(HA_EXIT_FAILURE);
   }
 
+  for (uint i = 0; i < rocksdb_scan_prefetch_threads; i++) {
+    rdb_prefetch_threads.emplace_back(new Rdb_prefetch_thread());
+    Rdb_prefetch_thread *const thread = rdb_prefetch_threads.back().get();
+#ifdef HAVE_PSI_INTERFACE
+    thread->init(rdb_signal_prefetch_psi_mutex_key,
+                 rdb_signal_prefetch_psi_cond_key);
+    err = thread->create_thread(SCAN_PREFETCH_THREAD_NAME,
+                                rdb_prefetch_psi_thread_key);
+#else
+    thread->init();
+    err = thread->create_thread(SCAN_PREFETCH_THREAD_NAME);
+#endif
+    if (err != 0) {
+      // NO_LINT_DEBUG
+      sql_print_error(
+          "RocksDB: Couldn't start the scan prefetch threads: (errno=%d)",
+          err);
+      DBUG_RETURN(HA_EXIT_FAILURE);
+    }
+  }
+
   rdb_set_collation_exception_list(rocksdb_strict_collation_exceptions);
 
   if (rocksdb_pause_background_work) {
@@ -6061,6 +6108,11 @@ static int rocksdb_done_func(void *const p) {
   // signal the manual compaction thread to stop
   rdb_mc_thread.signal(true);
 
+  // signal the scan prefetch threads to stop
+  for (const auto &thread : rdb_prefetch_threads) {
+    thread->signal(true);
+  }
+
   // Wait for the background thread to finish.
   auto err = rdb_bg_thread.join();
   if (err != 0) {
@@ -6095,6 +6147,18 @@ static int rocksdb_done_func(void *const p) {
         "RocksDB: Couldn't stop the manual compaction thread: (errno=%d)", err);
   }
 
+  // Wait for the scan prefetch threads to finish. They drop their queued
+  // jobs, and with them the iterators, before they exit.
+  for (const auto &thread : rdb_prefetch_threads) {
+    err = thread->join();
+    if (err != 0) {
+      // NO_LINT_DEBUG
+      sql_print_error(
+          "RocksDB: Couldn't stop the scan prefetch threads: (errno=%d)", err);
+    }
+  }
+  rdb_prefetch_threads.clear();
+
   if (rdb_open_tables.count()) {
     // Looks like we are getting unloaded and yet we have some open tables
     // left behind.
@@ -6541,6 +6605,7 @@ ha_rocksdb::ha_rocksdb(my_core::handlerton *const hton,
       m_scan_it_snapshot(nullptr),
       m_scan_it_lower_bound(nullptr),
       m_scan_it_upper_bound(nullptr),
+      m_scan_prefetch_bytes(0),
       m_tbl_def(nullptr),
       m_pk_descr(nullptr),
       m_key_descr_arr(nullptr),
@@ -6557,6 +6622,7 @@ ha_rocksdb::ha_rocksdb(my_core::handlerton *const hton,
       m_pack_buffer(nullptr),
       m_lock_rows(RDB_LOCK_NONE),
       m_keyread_only(false),
+      m_read_free_sk(false),
       m_insert_with_update(false),
       m_dup_key_found(false),
       mrr_rowid_reader(nullptr),
@@ -7026,6 +7092,11 @@ int ha_rocksdb::open(const char *const name, int mode, uint test_if_locked) {
   /* Index block size in MyRocks: used by MySQL in query optimization */
   stats.block_size = rocksdb_tbl_options->block_size;
 
+  /* The qualifier has been validated when the table was created */
+  if (Rdb_key_def::extract_read_free_sk(table, m_tbl_def, &m_read_free_sk)) {
+    m_read_free_sk = false;
+  }
+
   /* Determine at open whether we should skip unique checks for this table */
   set_skip_unique_check_tables(THDVAR(ha_thd(), skip_unique_check_tables));
 
@@ -7296,6 +7367,33 @@ int ha_rocksdb::create_key_defs(
     DBUG_RETURN(HA_EXIT_FAILURE);
   }
 
+  bool read_free_sk = false;
+  if ((err = Rdb_key_def::extract_read_free_sk(table_arg, tbl_def_arg,
+                                               &read_free_sk))) {
+    DBUG_RETURN(err);
+  }
+
+  /*
+    Stale entries can only be told apart from live ones through the primary
+    key, and unique secondary keys must stay exact for duplicate checks.
+  */
+  if (read_free_sk) {
+    if (has_hidden_pk(table_arg)) {
+      my_error(ER_NOT_SUPPORTED_YET, MYF(0),
+               "read_free_sk on tables without a primary key");
+      DBUG_RETURN(HA_EXIT_FAILURE);
+    }
+
+    for (uint i = 0; i < table_arg->s->keys; i++) {
+      if (i != table_arg->s->primary_key &&
+          (table_arg->key_info[i].flags & HA_NOSAME)) {
+        my_error(ER_NOT_SUPPORTED_YET, MYF(0),
+                 "read_free_sk on tables with unique secondary keys");
+        DBUG_RETURN(HA_EXIT_FAILURE);
+      }
+    }
+  }
+
   if (!old_tbl_def_arg) {
     /*
       old_tbl_def doesn't exist. this means we are in the process of creating
@@ -8508,8 +8606,9 @@ int ha_rocksdb::read_row_from_secondary_key(uchar *const buf,
 #endif
   DBUG_EXECUTE_IF("dbug.rocksdb.HA_EXTRA_KEYREAD", { m_keyread_only = true; });
 
-  bool covered_lookup = (m_keyread_only && kd.can_cover_lookup()) ||
-                        kd.covers_lookup(&value, &m_lookup_bitmap);
+  bool covered_lookup = !m_read_free_sk &&
+                        ((m_keyread_only && kd.can_cover_lookup()) ||
+                         kd.covers_lookup(&value, &m_lookup_bitmap));
 
 #ifndef DBUG_OFF
   m_keyread_only = save_keyread_only;
@@ -8532,16 +8631,47 @@ int ha_rocksdb::read_row_from_secondary_key(uchar *const buf,
   } else {
     if (kd.m_is_reverse_cf) move_forward = !move_forward;
 
-    rc = find_icp_matching_index_rec(move_forward, buf);
-    if (!rc) {
+    for (;;) {
+      rc = find_icp_matching_index_rec(move_forward, buf);
+      if (rc) {
+        break;
+      }
+
       const rocksdb::Slice &rkey = m_scan_it->key();
       pk_size = kd.get_primary_key_tuple(table, *m_pk_descr, &rkey,
                                          m_pk_packed_tuple);
       if (pk_size == RDB_INVALID_KEY_LEN) {
         rc = HA_ERR_ROCKSDB_CORRUPT_DATA;
-      } else {
-        if (!covered_lookup || m_lock_rows != RDB_LOCK_NONE)
-          rc = get_row_by_rowid(buf, m_pk_packed_tuple, pk_size);
+        break;
+      }
+
+      if (!covered_lookup || m_lock_rows != RDB_LOCK_NONE)
+        rc = get_row_by_rowid(buf, m_pk_packed_tuple, pk_size);
+
+      if (!m_read_free_sk ||
+          (rc != HA_ERR_KEY_NOT_FOUND &&
+           (rc || !is_stale_sk_entry(kd, rkey, buf)))) {
+        break;
+      }
+
+      /*
+        The entry was left behind by a blind write. Move on to the next one,
+        staying within the index and the lookup prefix.
+      */
+      rocksdb_smart_next(!move_forward, m_scan_it);
+      rc = rocksdb_skip_expired_records(kd, m_scan_it, !move_forward);
+      if (rc) {
+        break;
+      }
+
+      if (!is_valid_iterator(m_scan_it) || !kd.covers_key(m_scan_it->key()) ||
+          (m_sk_match_prefix &&
+           !kd.value_matches_prefix(
+               m_scan_it->key(),
+               rocksdb::Slice((const char *)m_sk_match_prefix,
+                              m_sk_match_length)))) {
+        rc = HA_ERR_END_OF_FILE;
+        break;
       }
     }
   }
@@ -8639,8 +8769,9 @@ int ha_rocksdb::secondary_index_read(const int keyno, uchar *const buf) {
 
       rocksdb::Slice value = m_scan_it->value();
       bool covered_lookup =
-          (m_keyread_only && m_key_descr_arr[keyno]->can_cover_lookup()) ||
-          m_key_descr_arr[keyno]->covers_lookup(&value, &m_lookup_bitmap);
+          !m_read_free_sk &&
+          ((m_keyread_only && m_key_descr_arr[keyno]->can_cover_lookup()) ||
+           m_key_descr_arr[keyno]->covers_lookup(&value, &m_lookup_bitmap));
       if (covered_lookup && m_lock_rows == RDB_LOCK_NONE) {
         rc = m_key_descr_arr[keyno]->unpack_record(
             table, buf, &key, &value,
@@ -8649,6 +8780,12 @@ int ha_rocksdb::secondary_index_read(const int keyno, uchar *const buf) {
       } else {
         DEBUG_SYNC(ha_thd(), "rocksdb_concurrent_delete_sk");
         rc = get_row_by_rowid(buf, m_pk_packed_tuple, size);
+        if (!rc && m_read_free_sk &&
+            is_stale_sk_entry(*m_key_descr_arr[keyno], key, buf)) {
+          /* Let the caller skip the entry as if the row was not found */
+          table->status = STATUS_NOT_FOUND;
+          rc = HA_ERR_KEY_NOT_FOUND;
+        }
       }
 
       if (!rc) {
@@ -8835,7 +8972,8 @@ int ha_rocksdb::index_read_map_impl(uchar *const buf, const uchar *const key,
                                       key, keypart_map);
   }
 
-  if ((pushed_idx_cond && pushed_idx_cond_keyno == active_index) &&
+  if (((pushed_idx_cond && pushed_idx_cond_keyno == active_index) ||
+       m_read_free_sk) &&
       (find_flag == HA_READ_KEY_EXACT || find_flag == HA_READ_PREFIX_LAST)) {
     /*
       We are doing a point index lookup, and ICP is enabled. It is possible
@@ -8848,6 +8986,9 @@ int ha_rocksdb::index_read_map_impl(uchar *const buf, const uchar *const key,
       When not using ICP, handler::index_next_same() will make sure that rows
       that don't match the lookup prefix are not returned.
       row matches the lookup prefix.
+
+      With read_free_sk, the tuple is also needed to stop skipping stale
+      entries in read_row_from_secondary_key().
     */
     m_sk_match_prefix = m_sk_match_prefix_buf;
     m_sk_match_length = packed_size;
@@ -9008,6 +9149,7 @@ int ha_rocksdb::find_icp_matching_index_rec(const bool move_forward,
       const enum icp_result icp_status = check_index_cond();
       if (icp_status == ICP_NO_MATCH) {
         rocksdb_smart_next(!move_forward, m_scan_it);
+        scan_prefetch_advance(kd, move_forward);
         continue; /* Get the next (or prev) index tuple */
       } else if (icp_status == ICP_OUT_OF_RANGE) {
         /* We have walked out of range we are scanning */
@@ -9432,9 +9574,11 @@ int ha_rocksdb::index_next_with_direction(uchar *const buf, bool move_forward) {
       if (rc != HA_EXIT_SUCCESS) {
         break;
       }
+      scan_prefetch_advance(*m_key_descr_arr[active_index], move_forward);
       rc = find_icp_matching_index_rec(move_forward, buf);
       if (!rc) rc = secondary_index_read(active_index, buf);
-      if (!should_skip_invalidated_record(rc)) {
+      if (!should_skip_invalidated_record(rc) &&
+          !(m_read_free_sk && rc == HA_ERR_KEY_NOT_FOUND)) {
         break;
       }
     }
@@ -9634,6 +9778,10 @@ int ha_rocksdb::index_last_intern(uchar *const buf) {
     if (is_pk(active_index, table, m_tbl_def)) {
       m_skip_scan_it_next_call = true;
       rc = rnd_next_with_direction(buf, false);
+    } else if (m_read_free_sk) {
+      /* Go through the loop that skips stale secondary key entries */
+      m_skip_scan_it_next_call = true;
+      rc = index_next_with_direction(buf, false);
     } else {
       rc = find_icp_matching_index_rec(false /*move_forward*/, buf);
       if (!rc) rc = secondary_index_read(active_index, buf);
@@ -9674,14 +9822,33 @@ void ha_rocksdb::unlock_row() {
 
 /*
   Returning true if SingleDelete can be used.
-  - Secondary Indexes can always use SingleDelete.
+  - Secondary Indexes can use SingleDelete, unless the table is read_free_sk.
+    Blind writes may Put the same secondary key more than once there.
   - If the index is PRIMARY KEY, and if all of the columns of the table
     are covered by the PRIMARY KEY, SingleDelete can be used.
 */
 bool ha_rocksdb::can_use_single_delete(const uint index) const {
-  return (index != pk_index(table, m_tbl_def) ||
-          (!has_hidden_pk(table) &&
-           table->key_info[index].actual_key_parts == table->s->fields));
+  if (index != pk_index(table, m_tbl_def)) {
+    return !m_read_free_sk;
+  }
+  return !has_hidden_pk(table) &&
+         table->key_info[index].actual_key_parts == table->s->fields;
+}
+
+/*
+  Check whether the secondary key entry 'key' was left behind by a blind
+  write: the row read from the primary key into 'buf' no longer produces it.
+*/
+bool ha_rocksdb::is_stale_sk_entry(const Rdb_key_def &kd,
+                                   const rocksdb::Slice &key,
+                                   const uchar *const buf) {
+  DBUG_ASSERT(m_read_free_sk);
+  DBUG_ASSERT(!has_hidden_pk(table));
+
+  const uint packed_size = kd.pack_record(table, m_pack_buffer, buf,
+                                          m_sk_packed_tuple_old, nullptr, false);
+  return packed_size != key.size() ||
+         memcmp(m_sk_packed_tuple_old, key.data(), packed_size) != 0;
 }
 
 bool ha_rocksdb::skip_unique_check() const {
@@ -10581,8 +10748,13 @@ int ha_rocksdb::update_write_sk(const TABLE *const table_arg,
     old_key_slice = rocksdb::Slice(
         reinterpret_cast<const char *>(m_sk_packed_tuple_old), old_packed_size);
 
-    row_info.tx->get_indexed_write_batch()->SingleDelete(kd.get_cf(),
-                                                         old_key_slice);
+    if (can_use_single_delete(key_id)) {
+      row_info.tx->get_indexed_write_batch()->SingleDelete(kd.get_cf(),
+                                                           old_key_slice);
+    } else {
+      row_info.tx->get_indexed_write_batch()->Delete(kd.get_cf(),
+                                                     old_key_slice);
+    }
 
     bytes_written = old_key_slice.size();
   }
@@ -10839,6 +11011,10 @@ void ha_rocksdb::setup_scan_iterator(const Rdb_key_def &kd,
     release_scan_iterator();
   }
 
+  // The new range starts elsewhere, so read-ahead of the previous one is of
+  // no use.
+  scan_prefetch_reset();
+
   /*
     SQL layer can call rnd_init() multiple times in a row.
     In that case, re-use the iterator, but re-position it at the table start.
@@ -10864,6 +11040,8 @@ void ha_rocksdb::setup_scan_iterator(const Rdb_key_def &kd,
 }
 
 void ha_rocksdb::release_scan_iterator() {
+  scan_prefetch_reset();
+
   delete m_scan_it;
   m_scan_it = nullptr;
 
@@ -10873,6 +11051,67 @@ void ha_rocksdb::release_scan_iterator() {
   }
 }
 
+void ha_rocksdb::scan_prefetch_reset() {
+  if (m_scan_prefetch) {
+    m_scan_prefetch->cancel();
+    m_scan_prefetch.reset();
+  }
+  m_scan_prefetch_bytes = 0;
+}
+
+/*
+  Called after m_scan_it has been moved to the next row of the scan. Starts
+  reading ahead of the scan once it has read more than a data block, and
+  keeps the read-ahead going as the scan advances.
+*/
+void ha_rocksdb::scan_prefetch_advance(const Rdb_key_def &kd,
+                                       const bool move_forward) {
+  if (rdb_prefetch_threads.empty() || !m_scan_it->Valid()) {
+    return;
+  }
+
+  const rocksdb::Slice key = m_scan_it->key();
+  const size_t bytes = key.size() + m_scan_it->value().size();
+
+  if (m_scan_prefetch) {
+    if (m_scan_prefetch->consume(bytes, key)) {
+      rdb_submit_scan_prefetch(m_scan_prefetch);
+    }
+    return;
+  }
+
+  m_scan_prefetch_bytes += bytes;
+
+  const size_t block_size = rocksdb_tbl_options->block_size;
+  const uint blocks = THDVAR(ha_thd(), scan_prefetch_blocks);
+  if (blocks == 0 || m_scan_prefetch_bytes < block_size ||
+      !m_scan_it_skips_bloom) {
+    return;
+  }
+
+  // Stay within the iterate bounds of the scan if it has them, otherwise
+  // within the index.
+  uchar lower[Rdb_key_def::INDEX_NUMBER_SIZE];
+  uchar upper[Rdb_key_def::INDEX_NUMBER_SIZE];
+  rocksdb::Slice lower_slice = m_scan_it_lower_bound_slice;
+  rocksdb::Slice upper_slice = m_scan_it_upper_bound_slice;
+  if (!THDVAR(ha_thd(), enable_iterate_bounds)) {
+    uint size;
+    kd.get_infimum_key(lower, &size);
+    kd.get_supremum_key(upper, &size);
+    lower_slice = rocksdb::Slice(reinterpret_cast<const char *>(lower), size);
+    upper_slice = rocksdb::Slice(reinterpret_cast<const char *>(upper), size);
+    if (kd.m_is_reverse_cf) {
+      std::swap(lower_slice, upper_slice);
+    }
+  }
+
+  m_scan_prefetch = std::make_shared<Rdb_scan_prefetch>(
+      kd.get_shared_cf(), lower_slice, upper_slice, key, move_forward,
+      static_cast<uint64_t>(blocks) * block_size);
+  rdb_submit_scan_prefetch(m_scan_prefetch);
+}
+
 void ha_rocksdb::setup_iterator_for_rnd_scan() {
   uint key_size;
 
@@ -11002,6 +11241,8 @@ int ha_rocksdb::rnd_next_with_direction(uchar *const buf, bool move_forward) {
       break;
     }
 
+    scan_prefetch_advance(*m_pk_descr, move_forward);
+
     if (m_lock_rows != RDB_LOCK_NONE) {
       /*
         Lock the row we've just read.
@@ -11087,9 +11328,12 @@ int ha_rocksdb::index_init(uint idx, bool sorted) {
   Rdb_transaction *const tx = get_or_create_tx(table->in_use);
   DBUG_ASSERT(tx != nullptr);
 
-  // when this table is being updated, decode all fields
-  m_converter->setup_field_decoders(table->read_set,
-                                    m_lock_rows == RDB_LOCK_WRITE);
+  // when this table is being updated, decode all fields. With read_free_sk,
+  // the secondary key fields are needed to verify the entries read.
+  m_converter->setup_field_decoders(
+      table->read_set,
+      m_lock_rows == RDB_LOCK_WRITE ||
+          (m_read_free_sk && idx != table->s->primary_key));
 
   if (!m_keyread_only) {
     m_key_descr_arr[idx]->get_lookup_bitmap(table, &m_lookup_bitmap);
@@ -11220,8 +11464,13 @@ int ha_rocksdb::delete_row(const uchar *const buf) {
                                    nullptr, false, hidden_pk_id);
       rocksdb::Slice secondary_key_slice(
           reinterpret_cast<const char *>(m_sk_packed_tuple), packed_size);
-      tx->get_indexed_write_batch()->SingleDelete(kd.get_cf(),
-                                                  secondary_key_slice);
+      if (can_use_single_delete(i)) {
+        tx->get_indexed_write_batch()->SingleDelete(kd.get_cf(),
+                                                    secondary_key_slice);
+      } else {
+        tx->get_indexed_write_batch()->Delete(kd.get_cf(),
+                                              secondary_key_slice);
+      }
       bytes_written += secondary_key_slice.size();
     }
   }
@@ -14031,6 +14280,10 @@ static void myrocks_update_status() {
 
   export_stats.covered_secondary_key_lookups =
       global_stats.covered_secondary_key_lookups;
+
+  export_stats.scan_prefetch_hit_bytes = global_stats.scan_prefetch_hit_bytes;
+  export_stats.scan_prefetch_waste_bytes =
+      global_stats.scan_prefetch_waste_bytes;
 }
 
 static void myrocks_update_memory_status() {
@@ -14086,6 +14339,10 @@ static SHOW_VAR myrocks_status_variables[] = {
     DEF_STATUS_VAR_FUNC("covered_secondary_key_lookups",
                         &export_stats.covered_secondary_key_lookups,
                         SHOW_LONGLONG),
+    DEF_STATUS_VAR_FUNC("scan_prefetch_hit_bytes",
+                        &export_stats.scan_prefetch_hit_bytes, SHOW_LONGLONG),
+    DEF_STATUS_VAR_FUNC("scan_prefetch_waste_bytes",
+                        &export_stats.scan_prefetch_waste_bytes, SHOW_LONGLONG),
 
     {NullS, NullS, SHOW_LONG}};
 
@@ -14676,6 +14933,159 @@ void Rdb_manual_compaction_thread::clear_all_manual_compaction_requests() {
   RDB_MUTEX_UNLOCK_CHECK(m_mc_mutex);
 }
 
+Rdb_scan_prefetch::Rdb_scan_prefetch(
+    std::shared_ptr<rocksdb::ColumnFamilyHandle> cf,
+    const rocksdb::Slice &lower_bound, const rocksdb::Slice &upper_bound,
+    const rocksdb::Slice &start_key, const bool forward,
+    const uint64_t max_ahead)
+    : m_cf(cf),
+      m_lower_bound(lower_bound.data(), lower_bound.size()),
+      m_upper_bound(upper_bound.data(), upper_bound.size()),
+      m_lower_bound_slice(m_lower_bound),
+      m_upper_bound_slice(m_upper_bound),
+      m_forward(forward),
+      m_max_ahead(max_ahead),
+      m_consumed(0),
+      m_cancelled(false),
+      m_queued(true),
+      m_iterator(nullptr),
+      m_seek_key(start_key.data(), start_key.size()),
+      m_fetched(0),
+      m_fetched_total(0),
+      m_done(false) {}
+
+Rdb_scan_prefetch::~Rdb_scan_prefetch() {
+  // Whatever was read ahead of the final scan position was read in vain.
+  const uint64_t consumed = m_consumed.load(std::memory_order_relaxed);
+  const uint64_t waste = m_fetched > consumed ? m_fetched - consumed : 0;
+
+  global_stats.scan_prefetch_hit_bytes.add(m_fetched_total - waste);
+  global_stats.scan_prefetch_waste_bytes.add(waste);
+
+  delete m_iterator;
+}
+
+/*
+  Account for a row returned by the scan, positioned at key. Returns true if
+  the job has to be queued again, in which case it is already marked queued.
+*/
+bool Rdb_scan_prefetch::consume(const size_t bytes, const rocksdb::Slice &key) {
+  const uint64_t consumed =
+      m_consumed.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+  if (m_queued.load(std::memory_order_acquire) || m_done) {
+    return false;
+  }
+
+  if (m_fetched <= consumed) {
+    // The scan has caught up with the prefetch position, continue from the
+    // scan position.
+    m_seek_key.assign(key.data(), key.size());
+    m_fetched = consumed;
+  } else if (m_fetched - consumed > m_max_ahead / 2) {
+    return false;
+  }
+
+  m_queued.store(true, std::memory_order_release);
+  return true;
+}
+
+void Rdb_scan_prefetch::run(rocksdb::DB *const db) {
+  DBUG_ASSERT(m_queued.load(std::memory_order_relaxed));
+
+  if (m_iterator == nullptr && !m_cancelled.load(std::memory_order_relaxed)) {
+    // No snapshot: only the block cache is populated, the rows themselves
+    // are read by the scan through its own iterator.
+    rocksdb::ReadOptions read_opts;
+    read_opts.total_order_seek = true;
+    read_opts.fill_cache = true;
+    if (!m_lower_bound.empty()) {
+      read_opts.iterate_lower_bound = &m_lower_bound_slice;
+    }
+    if (!m_upper_bound.empty()) {
+      read_opts.iterate_upper_bound = &m_upper_bound_slice;
+    }
+    m_iterator = db->NewIterator(read_opts, m_cf.get());
+  }
+
+  if (m_iterator != nullptr && !m_seek_key.empty()) {
+    if (m_forward) {
+      m_iterator->Seek(m_seek_key);
+    } else {
+      m_iterator->SeekForPrev(m_seek_key);
+    }
+    m_seek_key.clear();
+  }
+
+  while (m_iterator != nullptr &&
+         !m_cancelled.load(std::memory_order_relaxed)) {
+    if (!m_iterator->Valid()) {
+      m_done = true;
+      break;
+    }
+
+    if (m_fetched >= m_consumed.load(std::memory_order_relaxed) + m_max_ahead) {
+      break;
+    }
+
+    const uint64_t bytes =
+        m_iterator->key().size() + m_iterator->value().size();
+    m_fetched += bytes;
+    m_fetched_total += bytes;
+
+    if (m_forward) {
+      m_iterator->Next();
+    } else {
+      m_iterator->Prev();
+    }
+  }
+
+  m_queued.store(false, std::memory_order_release);
+}
+
+void Rdb_prefetch_thread::add_request(
+    const std::shared_ptr<Rdb_scan_prefetch> &job) {
+  RDB_MUTEX_LOCK_CHECK(m_signal_mutex);
+  m_requests.push_back(job);
+  mysql_cond_signal(&m_signal_cond);
+  RDB_MUTEX_UNLOCK_CHECK(m_signal_mutex);
+}
+
+/*
+  A scan prefetch thread. Runs the queued Rdb_scan_prefetch jobs one at a
+  time. A job may be the last reference to a finished scan, in which case it
+  is destroyed here.
+*/
+void Rdb_prefetch_thread::run() {
+  RDB_MUTEX_LOCK_CHECK(m_signal_mutex);
+  for (;;) {
+    while (!m_killed && m_requests.empty()) {
+      mysql_cond_wait(&m_signal_cond, &m_signal_mutex);
+    }
+    if (m_killed) {
+      break;
+    }
+
+    std::shared_ptr<Rdb_scan_prefetch> job = m_requests.front();
+    m_requests.pop_front();
+    RDB_MUTEX_UNLOCK_CHECK(m_signal_mutex);
+
+    job->run(rdb);
+    job.reset();
+
+    RDB_MUTEX_LOCK_CHECK(m_signal_mutex);
+  }
+  m_requests.clear();
+  RDB_MUTEX_UNLOCK_CHECK(m_signal_mutex);
+}
+
+static void rdb_submit_scan_prefetch(
+    const std::shared_ptr<Rdb_scan_prefetch> &job) {
+  DBUG_ASSERT(!rdb_prefetch_threads.empty());
+  const uint i = rdb_prefetch_next_thread++ % rdb_prefetch_threads.size();
+  rdb_prefetch_threads[i]->add_request(job);
+}
+
 void Rdb_manual_compaction_thread::clear_manual_compaction_request(
     int mc_id, bool init_only) {
   bool erase = true;
@@ -15691,6 +16101,16 @@ bool ha_rocksdb::use_read_free_rpl() const {
   DBUG_RETURN(false);
 }
 
+/**
+  @brief
+  Whether the non-unique secondary keys can be written without the old row.
+  Returning true allows the SQL layer to use blind 'replace into' on tables
+  created with read_free_sk=1.
+*/
+bool ha_rocksdb::has_read_free_secondary_keys() const {
+  return m_read_free_sk;
+}
+
 /**
   @brief
   Whether the table or last access partition has TTL column
@@ -16028,7 +16448,8 @@ int ha_rocksdb::multi_range_read_init(RANGE_SEQ_IF *seq, void *seq_init_param,
   if (!current_thd->optimizer_switch_flag(OPTIMIZER_SWITCH_MRR) ||
       (mode & HA_MRR_USE_DEFAULT_IMPL) ||
       (buf->buffer_end - buf->buffer < mrr_get_length_per_rec()) ||
-      (THDVAR(current_thd, mrr_batch_size) == 0)) {
+      (THDVAR(current_thd, mrr_batch_size) == 0) ||
+      (m_read_free_sk && active_index != table->s->primary_key)) {
     mrr_uses_default_impl = true;
     res = handler::multi_range_read_init(seq, seq_init_param, n_ranges, mode,
                                          buf);
@@ -75,6 +75,7 @@ class Rdb_transaction;
 class Rdb_transaction_impl;
 class Rdb_writebatch_impl;
 class Rdb_field_encoder;
+class Rdb_scan_prefetch;
 
 extern char *rocksdb_read_free_rpl_tables;
 extern ulong rocksdb_max_row_locks;
@@ -158,6 +159,15 @@ class ha_rocksdb : public my_core::handler {
   rocksdb::Slice m_scan_it_lower_bound_slice;
   rocksdb::Slice m_scan_it_upper_bound_slice;
 
+  /*
+    Read-ahead of the current range scan, running on the scan prefetch
+    threads. It is only started once the scan has read
+    m_scan_prefetch_bytes >= block_size, so that short ranges do not pay
+    for it.
+  */
+  std::shared_ptr<Rdb_scan_prefetch> m_scan_prefetch;
+  uint64_t m_scan_prefetch_bytes;
+
   Rdb_tbl_def *m_tbl_def;
 
   /* Primary Key encoder from KeyTupleFormat to StorageFormat */
@@ -255,6 +265,13 @@ class ha_rocksdb : public my_core::handler {
 
   bool m_skip_scan_it_next_call;
 
+  /*
+    TRUE means the table was created with read_free_sk=1: the non-unique
+    secondary keys may hold stale entries left by blind writes, and every
+    entry read must be verified against the primary key row.
+  */
+  bool m_read_free_sk;
+
   /* TRUE means we are accessing the first row after a snapshot was created */
   bool m_rnd_scan_is_new_snapshot;
 
@@ -310,6 +327,9 @@ class ha_rocksdb : public my_core::handler {
       MY_ATTRIBUTE((__nonnull__(2, 3), __warn_unused_result__));
   int secondary_index_read(const int keyno, uchar *const buf)
       MY_ATTRIBUTE((__nonnull__, __warn_unused_result__));
+  bool is_stale_sk_entry(const Rdb_key_def &kd, const rocksdb::Slice &key,
+                         const uchar *const buf)
+      MY_ATTRIBUTE((__nonnull__, __warn_unused_result__));
   void setup_iterator_for_rnd_scan();
   bool is_ascending(const Rdb_key_def &keydef,
                     enum ha_rkey_function find_flag) const
@@ -330,6 +350,8 @@ class ha_rocksdb : public my_core::handler {
                            const bool use_all_keys, const uint eq_cond_len)
       MY_ATTRIBUTE((__nonnull__));
   void release_scan_iterator(void);
+  void scan_prefetch_advance(const Rdb_key_def &kd, const bool move_forward);
+  void scan_prefetch_reset();
 
   rocksdb::Status get_for_update(Rdb_transaction *const tx,
                                  const Rdb_key_def &kd,
@@ -1022,6 +1044,7 @@ class ha_rocksdb : public my_core::handler {
   virtual void rpl_before_update_rows() override;
   virtual void rpl_after_update_rows() override;
   virtual bool use_read_free_rpl() const override;
+  virtual bool has_read_free_secondary_keys() const override;
   virtual bool last_part_has_ttl_column() const override;
 
  private:
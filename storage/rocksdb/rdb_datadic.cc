@@ -642,6 +642,44 @@ uint Rdb_key_def::extract_ttl_col(const TABLE *const table_arg,
   return HA_EXIT_SUCCESS;
 }
 
+/*
+  Determine if the secondary keys of the table are maintained without reading
+  the old row, by parsing the table comment.
+
+  @param[IN]  table_arg
+  @param[IN]  tbl_def_arg
+  @param[OUT] read_free_sk        Whether read_free_sk=1 was specified
+*/
+uint Rdb_key_def::extract_read_free_sk(const TABLE *const table_arg,
+                                       const Rdb_tbl_def *const tbl_def_arg,
+                                       bool *read_free_sk) {
+  DBUG_ASSERT(table_arg != nullptr);
+  DBUG_ASSERT(tbl_def_arg != nullptr);
+  DBUG_ASSERT(read_free_sk != nullptr);
+  std::string table_comment(table_arg->s->comment.str,
+                            table_arg->s->comment.length);
+
+  bool read_free_sk_per_part_match_found = false;
+  std::string read_free_sk_str = Rdb_key_def::parse_comment_for_qualifier(
+      table_comment, table_arg, tbl_def_arg,
+      &read_free_sk_per_part_match_found, RDB_READ_FREE_SK_QUALIFIER);
+
+  *read_free_sk = false;
+
+  if (read_free_sk_str.empty() || read_free_sk_str == "0") {
+    return HA_EXIT_SUCCESS;
+  }
+
+  if (read_free_sk_str != "1") {
+    my_error(ER_WRONG_VALUE, MYF(0), RDB_READ_FREE_SK_QUALIFIER,
+             read_free_sk_str.c_str());
+    return HA_EXIT_FAILURE;
+  }
+
+  *read_free_sk = true;
+  return HA_EXIT_SUCCESS;
+}
+
 const std::string Rdb_key_def::gen_qualifier_for_table(
     const char *const qualifier, const std::string &partition_name) {
   bool has_partition = !partition_name.empty();
@@ -660,6 +698,13 @@ const std::string Rdb_key_def::gen_qualifier_for_table(
     return has_partition ? gen_ttl_col_qualifier_for_partition(partition_name)
                          : qualifier_str + RDB_TTL_COL_QUALIFIER +
                                RDB_QUALIFIER_VALUE_SEP;
+  } else if (!strcmp(qualifier, RDB_READ_FREE_SK_QUALIFIER)) {
+    return has_partition ? partition_name +
+                               RDB_PER_PARTITION_QUALIFIER_NAME_SEP +
+                               RDB_READ_FREE_SK_QUALIFIER +
+                               RDB_QUALIFIER_VALUE_SEP
+                         : qualifier_str + RDB_READ_FREE_SK_QUALIFIER +
+                               RDB_QUALIFIER_VALUE_SEP;
   } else {
     DBUG_ASSERT(0);
   }
@@ -593,6 +593,9 @@ class Rdb_key_def {
                               const Rdb_tbl_def *const tbl_def_arg,
                               std::string *ttl_column, uint *ttl_field_index,
                               bool skip_checks = false);
+  static uint extract_read_free_sk(const TABLE *const table_arg,
+                                   const Rdb_tbl_def *const tbl_def_arg,
+                                   bool *read_free_sk);
   inline bool has_ttl() const { return m_ttl_duration > 0; }
 
   static bool has_index_flag(uint32 index_flags, enum INDEX_FLAG flag);
@@ -126,6 +126,11 @@ const char *const INDEX_STATS_THREAD_NAME = "myrocks-is";
 */
 const char *const MANUAL_COMPACTION_THREAD_NAME = "myrocks-mc";
 
+/*
+  Name for the scan prefetch threads.
+*/
+const char *const SCAN_PREFETCH_THREAD_NAME = "myrocks-prefetch";
+
 /*
   Separator between partition name and the qualifier. Sample usage:
 
@@ -164,6 +169,11 @@ const char *const RDB_TTL_DURATION_QUALIFIER = "ttl_duration";
 */
 const char *const RDB_TTL_COL_QUALIFIER = "ttl_col";
 
+/*
+  Qualifier name for read-free maintenance of non-unique secondary keys.
+*/
+const char *const RDB_READ_FREE_SK_QUALIFIER = "read_free_sk";
+
 /*
   Default, minimal valid, and maximum valid sampling rate values when collecting
   statistics about table.
@@ -390,6 +400,9 @@ struct st_global_stats {
       table_index_stats_result[TABLE_INDEX_STATS_RESULT_MAX];
 
   ib_counter_t<ulonglong, 64, RDB_INDEXER> covered_secondary_key_lookups;
+
+  ib_counter_t<ulonglong, 64, RDB_INDEXER> scan_prefetch_hit_bytes;
+  ib_counter_t<ulonglong, 64, RDB_INDEXER> scan_prefetch_waste_bytes;
 };
 
 /* Struct used for exporting status to MySQL */
@@ -416,6 +429,9 @@ struct st_export_stats {
   ulonglong table_index_stats_req_queue_length;
 
   ulonglong covered_secondary_key_lookups;
+
+  ulonglong scan_prefetch_hit_bytes;
+  ulonglong scan_prefetch_waste_bytes;
 };
 
 /* Struct used for exporting RocksDB memory status */
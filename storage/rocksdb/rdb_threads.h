@@ -17,8 +17,10 @@
 #pragma once
 
 /* C++ standard header files */
+#include <atomic>
 #include <deque>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -195,6 +197,86 @@ class Rdb_manual_compaction_thread : public Rdb_thread {
   void clear_all_manual_compaction_requests();
 };
 
+/*
+  Read-ahead job of one range scan.
+
+  RocksDB reads the data blocks of an SST file synchronously as an iterator
+  advances, so a long scan over cold data pays for one block read after
+  another. A prefetch job walks a private iterator over the same key range
+  some distance ahead of the scan, from a Rdb_prefetch_thread, so that the
+  blocks the scan is about to read are already in the block cache.
+
+  The scan thread owns the job and reports its progress with consume(). The
+  job is handed to a prefetch thread whenever the distance between the
+  prefetch position and the scan position drops below half of m_max_ahead,
+  and the prefetch thread advances until the distance is m_max_ahead bytes
+  again. While the job is queued (m_queued is set) only the prefetch thread
+  may touch its position; otherwise only the scan thread may.
+*/
+class Rdb_scan_prefetch {
+ private:
+  // Disable Copying
+  Rdb_scan_prefetch(const Rdb_scan_prefetch &);
+  Rdb_scan_prefetch &operator=(const Rdb_scan_prefetch &);
+
+  const std::shared_ptr<rocksdb::ColumnFamilyHandle> m_cf;
+  const std::string m_lower_bound;
+  const std::string m_upper_bound;
+  rocksdb::Slice m_lower_bound_slice;
+  rocksdb::Slice m_upper_bound_slice;
+  const bool m_forward;
+  const uint64_t m_max_ahead;
+
+  /* Bytes returned to the scan so far, only written by the scan thread */
+  std::atomic<uint64_t> m_consumed;
+
+  /* Set by the scan thread when the job is given up */
+  std::atomic<bool> m_cancelled;
+
+  /* Set while the job is waiting for or running on a prefetch thread */
+  std::atomic<bool> m_queued;
+
+  /*
+    Prefetch position. m_fetched is the number of bytes the scan has to
+    consume to reach the position of m_iterator. If m_seek_key is not empty
+    the prefetch thread repositions m_iterator at it before advancing.
+  */
+  rocksdb::Iterator *m_iterator;
+  std::string m_seek_key;
+  uint64_t m_fetched;
+  uint64_t m_fetched_total;
+  bool m_done;
+
+ public:
+  Rdb_scan_prefetch(std::shared_ptr<rocksdb::ColumnFamilyHandle> cf,
+                    const rocksdb::Slice &lower_bound,
+                    const rocksdb::Slice &upper_bound,
+                    const rocksdb::Slice &start_key, const bool forward,
+                    const uint64_t max_ahead);
+
+  ~Rdb_scan_prefetch();
+
+  /* Called by the scan thread */
+  bool consume(const size_t bytes, const rocksdb::Slice &key);
+  void cancel() { m_cancelled.store(true, std::memory_order_relaxed); }
+
+  /* Called by the prefetch thread */
+  void run(rocksdb::DB *const db);
+};
+
+/*
+  One thread of the scan prefetch pool. Jobs are queued under
+  m_signal_mutex and run in the order they were submitted.
+*/
+class Rdb_prefetch_thread : public Rdb_thread {
+ private:
+  std::deque<std::shared_ptr<Rdb_scan_prefetch>> m_requests;
+
+ public:
+  virtual void run() override;
+  void add_request(const std::shared_ptr<Rdb_scan_prefetch> &job);
+};
+
 /*
   Drop index thread control
 */
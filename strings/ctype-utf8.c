@@ -22,6 +22,10 @@
 #include "m_ctype.h"
 #include <errno.h>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #ifndef EILSEQ
 #define EILSEQ ENOENT
 #endif
@@ -4874,6 +4878,99 @@ MY_UNICASE_INFO my_unicase_unicode520=
 };
 
 
+/*
+  ASCII fast paths.
+
+  In the ASCII compatible character sets (utf8 and utf8mb4, those with
+  mbminlen == 1) a byte below 0x80 is a complete character with the same
+  code. The functions below skip over runs of such bytes a block at a time,
+  16 bytes with SSE2 or 8 bytes otherwise, and the collation functions go
+  through mb_wc() only for the other characters.
+*/
+
+#define MY_ASCII_MASK64 0x8080808080808080ULL
+
+static inline ulonglong
+my_load_uint64(const uchar *s)
+{
+  ulonglong x;
+  memcpy(&x, s, sizeof(x));
+  return x;
+}
+
+
+/* Return the number of ASCII bytes at the start of s, at most len */
+static inline size_t
+my_ascii_prefix_len(const uchar *s, size_t len)
+{
+  size_t i= 0;
+#ifdef __SSE2__
+  for (; i + 16 <= len; i+= 16)
+  {
+    __m128i a= _mm_loadu_si128((const __m128i*) (s + i));
+    if (_mm_movemask_epi8(a))
+      break;
+  }
+#endif
+  for (; i + 8 <= len; i+= 8)
+  {
+    if (my_load_uint64(s + i) & MY_ASCII_MASK64)
+      break;
+  }
+  for (; i < len && s[i] < 0x80; i++)
+  {}
+  return i;
+}
+
+
+/*
+  Return the length of the common prefix of s and t, at most len bytes,
+  that consists of ASCII bytes only. Its weights are equal in every
+  collation.
+*/
+static inline size_t
+my_ascii_common_prefix_len(const uchar *s, const uchar *t, size_t len)
+{
+  size_t i= 0;
+#ifdef __SSE2__
+  for (; i + 16 <= len; i+= 16)
+  {
+    __m128i a= _mm_loadu_si128((const __m128i*) (s + i));
+    __m128i b= _mm_loadu_si128((const __m128i*) (t + i));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) != 0xFFFF ||
+        _mm_movemask_epi8(a))
+      break;
+  }
+#endif
+  for (; i + 8 <= len; i+= 8)
+  {
+    ulonglong a= my_load_uint64(s + i);
+    if (a != my_load_uint64(t + i) || (a & MY_ASCII_MASK64))
+      break;
+  }
+  for (; i < len && s[i] == t[i] && s[i] < 0x80; i++)
+  {}
+  return i;
+}
+
+
+/*
+  Decode a character, without the indirect mb_wc() call for ASCII bytes
+  if the character set is ASCII compatible.
+*/
+static inline int
+my_mb_wc_fast(const CHARSET_INFO *cs, my_bool ascii_compat,
+              my_wc_t *wc, const uchar *s, const uchar *e)
+{
+  if (ascii_compat && s < e && *s < 0x80)
+  {
+    *wc= *s;
+    return 1;
+  }
+  return cs->cset->mb_wc(cs, wc, s, e);
+}
+
+
 static inline void
 my_tosort_unicode(MY_UNICASE_INFO *uni_plane, my_wc_t *wc, uint flags)
 {
@@ -4912,9 +5009,8 @@ my_wildcmp_unicode_impl(const CHARSET_INFO *cs,
   int result= -1;                             /* Not found, using wildcards */
   my_wc_t s_wc, w_wc;
   int scan;
-  int (*mb_wc)(const struct charset_info_st *, my_wc_t *,
-               const uchar *, const uchar *);
-  mb_wc= cs->cset->mb_wc;
+  const my_bool ascii_compat= cs->mbminlen == 1 &&
+                               !(cs->state & MY_CS_NONASCII);
 
  if (my_string_stack_guard && my_string_stack_guard(recurse_level))
    return 1;
@@ -4923,8 +5019,9 @@ my_wildcmp_unicode_impl(const CHARSET_INFO *cs,
     while (1)
     {
       my_bool escaped= 0;
-      if ((scan= mb_wc(cs, &w_wc, (const uchar*)wildstr,
-                       (const uchar*)wildend)) <= 0)
+      if ((scan= my_mb_wc_fast(cs, ascii_compat, &w_wc,
+                               (const uchar*)wildstr,
+                               (const uchar*)wildend)) <= 0)
         return 1;
 
       if (w_wc == (my_wc_t) w_many)
@@ -4936,15 +5033,17 @@ my_wildcmp_unicode_impl(const CHARSET_INFO *cs,
       wildstr+= scan;
       if (w_wc ==  (my_wc_t) escape && wildstr < wildend)
       {
-        if ((scan= mb_wc(cs, &w_wc, (const uchar*)wildstr,
-                         (const uchar*)wildend)) <= 0)
+        if ((scan= my_mb_wc_fast(cs, ascii_compat, &w_wc,
+                                 (const uchar*)wildstr,
+                                 (const uchar*)wildend)) <= 0)
           return 1;
         wildstr+= scan;
         escaped= 1;
       }
       
-      if ((scan= mb_wc(cs, &s_wc, (const uchar*)str,
-                       (const uchar*)str_end)) <= 0)
+      if ((scan= my_mb_wc_fast(cs, ascii_compat, &s_wc,
+                               (const uchar*)str,
+                               (const uchar*)str_end)) <= 0)
         return 1;
       str+= scan;
       
@@ -4973,8 +5072,9 @@ my_wildcmp_unicode_impl(const CHARSET_INFO *cs,
       /* Remove any '%' and '_' from the wild search string */
       for ( ; wildstr != wildend ; )
       {
-        if ((scan= mb_wc(cs, &w_wc, (const uchar*)wildstr,
-                         (const uchar*)wildend)) <= 0)
+        if ((scan= my_mb_wc_fast(cs, ascii_compat, &w_wc,
+                                 (const uchar*)wildstr,
+                                 (const uchar*)wildend)) <= 0)
           return 1;
         
         if (w_wc == (my_wc_t)w_many)
@@ -4986,8 +5086,9 @@ my_wildcmp_unicode_impl(const CHARSET_INFO *cs,
         if (w_wc == (my_wc_t)w_one)
         {
           wildstr+= scan;
-          if ((scan= mb_wc(cs, &s_wc, (const uchar*)str,
-                           (const uchar*)str_end)) <=0)
+          if ((scan= my_mb_wc_fast(cs, ascii_compat, &s_wc,
+                                   (const uchar*)str,
+                                   (const uchar*)str_end)) <=0)
             return 1;
           str+= scan;
           continue;
@@ -5001,8 +5102,9 @@ my_wildcmp_unicode_impl(const CHARSET_INFO *cs,
       if (str == str_end)
         return -1;
       
-      if ((scan= mb_wc(cs, &w_wc, (const uchar*)wildstr,
-                       (const uchar*)wildend)) <=0)
+      if ((scan= my_mb_wc_fast(cs, ascii_compat, &w_wc,
+                               (const uchar*)wildstr,
+                               (const uchar*)wildend)) <=0)
         return 1;
       wildstr+= scan;
       
@@ -5010,8 +5112,9 @@ my_wildcmp_unicode_impl(const CHARSET_INFO *cs,
       {
         if (wildstr < wildend)
         {
-          if ((scan= mb_wc(cs, &w_wc, (const uchar*)wildstr,
-                           (const uchar*)wildend)) <=0)
+          if ((scan= my_mb_wc_fast(cs, ascii_compat, &w_wc,
+                                   (const uchar*)wildstr,
+                                   (const uchar*)wildend)) <=0)
             return 1;
           wildstr+= scan;
         }
@@ -5022,8 +5125,9 @@ my_wildcmp_unicode_impl(const CHARSET_INFO *cs,
         /* Skip until the first character from wildstr is found */
         while (str != str_end)
         {
-          if ((scan= mb_wc(cs, &s_wc, (const uchar*)str,
-                           (const uchar*)str_end)) <=0)
+          if ((scan= my_mb_wc_fast(cs, ascii_compat, &s_wc,
+                                   (const uchar*)str,
+                                   (const uchar*)str_end)) <=0)
             return 1;
           if (weights)
           {
@@ -5147,12 +5251,32 @@ my_strnxfrm_unicode(const CHARSET_INFO *cs,
   const uchar *se= src + srclen;
   MY_UNICASE_INFO *uni_plane= (cs->state & MY_CS_BINSORT) ?
                                NULL : cs->caseinfo;
+  const my_bool ascii_compat= cs->mbminlen == 1 &&
+                               !(cs->state & MY_CS_NONASCII);
   LINT_INIT(wc);
   DBUG_ASSERT(src || srclen == 0);
+
+  if (ascii_compat)
+  {
+    /* Leading ASCII characters, two weight bytes each */
+    size_t n= my_ascii_prefix_len(src, MY_MIN(srclen, nweights));
+    const uchar *ascii_end;
+    n= MY_MIN(n, (size_t) (de - dst) / 2);
+    for (ascii_end= src + n; src < ascii_end; src++)
+    {
+      wc= *src;
+      if (uni_plane)
+        my_tosort_unicode(uni_plane, &wc, cs->state);
+      dst[0]= (uchar) (wc >> 8);
+      dst[1]= (uchar) (wc & 0xFF);
+      dst+= 2;
+    }
+    nweights-= (uint) n;
+  }
   
   for (; dst < de && nweights; nweights--)
   {
-    if ((res= cs->cset->mb_wc(cs, &wc, src, se)) <= 0)
+    if ((res= my_mb_wc_fast(cs, ascii_compat, &wc, src, se)) <= 0)
       break;
     src+= res;
 
@@ -8175,8 +8299,15 @@ my_hash_sort_utf8mb4(const CHARSET_INFO *cs, const uchar *s, size_t slen,
   while (e > s && e[-1] == ' ')
     e--;
 
-  while ((res= my_mb_wc_utf8mb4(cs, &wc, (uchar*) s, (uchar*) e)) > 0)
+  while (s < e)
   {
+    if (*s < 0x80)
+    {
+      wc= *s;
+      res= 1;
+    }
+    else if ((res= my_mb_wc_utf8mb4(cs, &wc, (uchar*) s, (uchar*) e)) <= 0)
+      break;
     my_tosort_unicode(uni_plane, &wc, cs->state);
     my_hash_add(n1, n2, (uint) (wc & 0xFF));
     my_hash_add(n1, n2, (uint) (wc >> 8)  & 0xFF);
@@ -8299,8 +8430,24 @@ my_strnncoll_utf8mb4(const CHARSET_INFO *cs,
 
   while ( s < se && t < te )
   {
-    int s_res= my_mb_wc_utf8mb4(cs, &s_wc, s, se);
-    int t_res= my_mb_wc_utf8mb4(cs, &t_wc, t, te);
+    int s_res, t_res;
+    size_t n= my_ascii_common_prefix_len(s, t, MY_MIN(se - s, te - t));
+    s+= n;
+    t+= n;
+    if (s == se || t == te)
+      break;
+
+    if (*s < 0x80 && *t < 0x80)
+    {
+      s_wc= *s;
+      t_wc= *t;
+      s_res= t_res= 1;
+    }
+    else
+    {
+      s_res= my_mb_wc_utf8mb4(cs, &s_wc, s, se);
+      t_res= my_mb_wc_utf8mb4(cs, &t_wc, t, te);
+    }
 
     if ( s_res <= 0 || t_res <= 0 )
     {
@@ -8371,8 +8518,24 @@ my_strnncollsp_utf8mb4(const CHARSET_INFO *cs,
 
   while ( s < se && t < te )
   {
-    int s_res= my_mb_wc_utf8mb4(cs, &s_wc, s, se);
-    int t_res= my_mb_wc_utf8mb4(cs, &t_wc, t, te);
+    int s_res, t_res;
+    size_t n= my_ascii_common_prefix_len(s, t, MY_MIN(se - s, te - t));
+    s+= n;
+    t+= n;
+    if (s == se || t == te)
+      break;
+
+    if (*s < 0x80 && *t < 0x80)
+    {
+      s_wc= *s;
+      t_wc= *t;
+      s_res= t_res= 1;
+    }
+    else
+    {
+      s_res= my_mb_wc_utf8mb4(cs, &s_wc, s, se);
+      t_res= my_mb_wc_utf8mb4(cs, &t_wc, t, te);
+    }
 
     if ( s_res <= 0 || t_res <= 0 )
     {
@@ -0,0 +1,209 @@
+/* Copyright (c) 2016, Facebook, Inc.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+// First include (the generated) my_config.h, to get correct platform defines.
+#include "my_config.h"
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "my_sys.h"
+
+namespace mysys_io_cache_unittest {
+
+/*
+  Sequential IO_CACHE reads with and without read-ahead must return the
+  same bytes and fail the same way at the end of the file.
+*/
+class IOCacheReadAheadTest : public ::testing::Test
+{
+protected:
+  // Read the file this many times. Increase value for benchmarking!
+  static const int num_iterations= 1;
+  static const size_t file_size= 3 * 1024 * 1024 + 1234;
+  static const size_t cache_size= 64 * 1024;
+
+  virtual void SetUp()
+  {
+    char name[FN_REFLEN];
+    m_file= create_temp_file(name, NULL, "ioc",
+                             O_RDWR | O_BINARY | O_TRUNC, MYF(MY_WME));
+    ASSERT_LE(0, m_file);
+    my_delete(name, MYF(MY_WME));
+    append(file_size);
+  }
+
+  virtual void TearDown()
+  {
+    my_close(m_file, MYF(MY_WME));
+  }
+
+  static uchar pattern(my_off_t pos)
+  {
+    return (uchar) (pos * 31 + pos / 7);
+  }
+
+  // Append n bytes of the pattern to the file.
+  void append(size_t n)
+  {
+    std::vector<uchar> data(n);
+    for (size_t i= 0; i < n; ++i)
+      data[i]= pattern(m_size + i);
+    ASSERT_EQ(0U, my_pwrite(m_file, &data[0], n, m_size, MYF(MY_NABP)));
+    m_size+= n;
+  }
+
+  void open_cache(IO_CACHE *cache, bool read_ahead, myf flags= 0)
+  {
+    ASSERT_EQ(0, init_io_cache(cache, m_file, cache_size, READ_CACHE, 0,
+                               0, MYF(MY_WME | flags)));
+    if (read_ahead)
+      EXPECT_EQ(0, init_io_cache_read_ahead(cache));
+  }
+
+  // Read the cache to its end in chunks, checking every byte.
+  void read_to_end(IO_CACHE *cache, size_t chunk)
+  {
+    std::vector<uchar> buf(chunk);
+    for (;;)
+    {
+      my_off_t pos= my_b_tell(cache);
+      if (my_b_read(cache, &buf[0], chunk))
+      {
+        ASSERT_NE(-1, cache->error);
+        ASSERT_EQ(m_size - pos, (my_off_t) cache->error);
+        for (int i= 0; i < cache->error; ++i)
+          ASSERT_EQ(pattern(pos + i), buf[i]) << "pos " << pos + i;
+        return;
+      }
+      for (size_t i= 0; i < chunk; ++i)
+        ASSERT_EQ(pattern(pos + i), buf[i]) << "pos " << pos + i;
+    }
+  }
+
+  // Read the whole file, summing up the data as a stand-in for real work.
+  ha_checksum scan(bool read_ahead)
+  {
+    ha_checksum crc= 0;
+    uchar buf[200];
+    for (int n= 0; n < num_iterations; ++n)
+    {
+      IO_CACHE cache;
+      crc= 0;
+      open_cache(&cache, read_ahead);
+      while (!my_b_read(&cache, buf, sizeof(buf)))
+        crc= my_checksum(crc, buf, sizeof(buf));
+      end_io_cache(&cache);
+    }
+    return crc;
+  }
+
+  // What scan() computes for one pass over the file.
+  ha_checksum expected_crc()
+  {
+    ha_checksum crc= 0;
+    uchar buf[200];
+    for (my_off_t pos= 0; pos + sizeof(buf) <= m_size; pos+= sizeof(buf))
+    {
+      for (size_t i= 0; i < sizeof(buf); ++i)
+        buf[i]= pattern(pos + i);
+      crc= my_checksum(crc, buf, sizeof(buf));
+    }
+    return crc;
+  }
+
+  File m_file;
+  my_off_t m_size;
+
+public:
+  IOCacheReadAheadTest() : m_file(-1), m_size(0) {}
+};
+
+
+TEST_F(IOCacheReadAheadTest, ChunkSizes)
+{
+  const size_t chunks[]= { 1, 100, IO_SIZE + 1, 70000, 300000 };
+  for (size_t i= 0; i < array_elements(chunks); ++i)
+  {
+    for (int read_ahead= 0; read_ahead <= 1; ++read_ahead)
+    {
+      SCOPED_TRACE(testing::Message() << "chunk " << chunks[i]
+                   << " read_ahead " << read_ahead);
+      IO_CACHE cache;
+      open_cache(&cache, read_ahead);
+      read_to_end(&cache, chunks[i]);
+      end_io_cache(&cache);
+    }
+  }
+}
+
+
+TEST_F(IOCacheReadAheadTest, SeekAndReinit)
+{
+  IO_CACHE cache;
+  uchar buf[1000];
+  open_cache(&cache, true);
+
+  const my_off_t positions[]= { 5000, 2 * 1024 * 1024 + 17, 100, 1024 * 1024 };
+  for (size_t i= 0; i < array_elements(positions); ++i)
+  {
+    my_b_seek(&cache, positions[i]);
+    for (int n= 0; n < 300; ++n)
+    {
+      my_off_t pos= my_b_tell(&cache);
+      ASSERT_EQ(0, my_b_read(&cache, buf, sizeof(buf)));
+      for (size_t j= 0; j < sizeof(buf); ++j)
+        ASSERT_EQ(pattern(pos + j), buf[j]);
+    }
+  }
+
+  ASSERT_EQ(0, reinit_io_cache(&cache, READ_CACHE, 12345, 0, 0));
+  ASSERT_EQ(12345U, my_b_tell(&cache));
+  read_to_end(&cache, 777);
+  end_io_cache(&cache);
+}
+
+
+TEST_F(IOCacheReadAheadTest, GrowingFile)
+{
+  for (int read_ahead= 0; read_ahead <= 1; ++read_ahead)
+  {
+    SCOPED_TRACE(testing::Message() << "read_ahead " << read_ahead);
+    IO_CACHE cache;
+    open_cache(&cache, read_ahead, MY_DONT_CHECK_FILESIZE);
+    read_to_end(&cache, 4000);
+
+    // New data at the end is found once the reader seeks back to it.
+    my_off_t old_size= m_size;
+    append(cache_size * 3 + 10);
+    my_b_seek(&cache, old_size - 100);
+    read_to_end(&cache, 4000);
+    end_io_cache(&cache);
+  }
+}
+
+
+TEST_F(IOCacheReadAheadTest, ThroughputPlain)
+{
+  EXPECT_EQ(expected_crc(), scan(false));
+}
+
+
+TEST_F(IOCacheReadAheadTest, ThroughputReadAhead)
+{
+  EXPECT_EQ(expected_crc(), scan(true));
+}
+
+}
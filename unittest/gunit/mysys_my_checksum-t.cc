@@ -0,0 +1,70 @@
+/* Copyright (c) 2016, Facebook, Inc. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+// First include (the generated) my_config.h, to get correct platform defines.
+#include "my_config.h"
+#include <gtest/gtest.h>
+
+#include <my_global.h>
+#include <my_sys.h>
+#include <zlib.h>
+
+namespace mysys_my_checksum_unittest {
+
+TEST(Mysys, ChecksumCombine)
+{
+  uchar buf[20000];
+  for (size_t i= 0; i < sizeof(buf); i++)
+    buf[i]= (uchar) (i * 7 + (i >> 8));
+
+  const size_t lengths[]= { 0, 1, 3, 19, 64, 255, 4096, 8191, 19999 };
+  for (size_t i= 0; i < array_elements(lengths); i++)
+  {
+    const size_t split= lengths[i];
+    const size_t length2= sizeof(buf) - split;
+    ha_checksum crc1= my_checksum(0, buf, split);
+    ha_checksum crc2= my_checksum(0, buf + split, length2);
+    EXPECT_EQ(my_checksum(0, buf, sizeof(buf)),
+              my_checksum_combine(crc1, crc2, length2)) << split;
+    EXPECT_EQ(my_checksum(0, buf, split + 1),
+              my_checksum_combine(crc1, my_checksum(0, buf + split, 1), 1))
+      << split;
+  }
+  EXPECT_EQ(my_checksum(0, buf, 100),
+            my_checksum_combine(my_checksum(0, buf, 100), 0, 0));
+}
+
+/*
+  my_checksum_combine() is a faster version of zlib's crc32_combine(),
+  which squares a 32x32 bit matrix for every bit of the length.
+*/
+TEST(Mysys, ChecksumCombineZlib)
+{
+  for (int i= 0; i < 10000; i++)
+  {
+    const ha_checksum crc1= (ha_checksum) rand() << 16 ^ rand();
+    const ha_checksum crc2= (ha_checksum) rand() << 16 ^ rand();
+    /* Below 2^30, so that it fits in any z_off_t, and often much shorter */
+    const size_t length2=
+      (((size_t) rand() << 15 ^ rand()) & ((1 << 30) - 1)) >> (rand() % 30);
+    if (length2 == 0)
+      continue;
+    EXPECT_EQ((ha_checksum) crc32_combine(crc1, crc2, (z_off_t) length2),
+              my_checksum_combine(crc1, crc2, length2))
+      << crc1 << " " << crc2 << " " << length2;
+  }
+}
+
+}
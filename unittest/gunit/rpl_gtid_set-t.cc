@@ -0,0 +1,183 @@
+/* Copyright (c) 2016, Facebook, Inc. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA */
+
+// First include (the generated) my_config.h, to get correct platform defines.
+#include "my_config.h"
+#include <gtest/gtest.h>
+
+#include "rpl_gtid.h"
+
+#include <set>
+#include <vector>
+
+namespace rpl_gtid_set_unittest {
+
+/*
+  Gtid_set keeps the intervals of every SIDNO in a sorted array and
+  updates it with binary search and merges. The tests below apply random
+  operations to a Gtid_set and to a std::set of GNOs and check that both
+  agree, and that the intervals stay sorted, disjoint and non-adjacent.
+*/
+
+typedef std::set<rpl_gno> Gno_set;
+
+static const rpl_gno MAX_TEST_GNO= 200;
+
+class GtidSetTest : public ::testing::Test
+{
+protected:
+  GtidSetTest() : sid_map(NULL) {}
+
+  virtual void SetUp()
+  {
+    rpl_sid sid;
+    sid.parse("00000000-0000-0000-0000-000000000001");
+    sidno= sid_map.add_sid(sid);
+    ASSERT_EQ(1, sidno);
+    srand(4711);
+  }
+
+  /* Check the interval invariants and compare with the model. */
+  void check(const Gtid_set &gs, const Gno_set &model)
+  {
+    Gno_set found;
+    rpl_gno last_end= 0;
+    Gtid_set::Const_interval_iterator ivit(&gs, sidno);
+    const Gtid_set::Interval *iv;
+    while ((iv= ivit.get()) != NULL)
+    {
+      EXPECT_LT(last_end, iv->start);
+      EXPECT_LT(iv->start, iv->end);
+      for (rpl_gno gno= iv->start; gno < iv->end; gno++)
+        found.insert(gno);
+      last_end= iv->end;
+      ivit.next();
+    }
+    EXPECT_TRUE(model == found);
+    for (rpl_gno gno= 1; gno <= MAX_TEST_GNO + 1; gno++)
+      EXPECT_EQ(model.count(gno) != 0, gs.contains_gtid(sidno, gno)) << gno;
+  }
+
+  /* Fill a Gtid_set and its model with random GNOs. */
+  void fill_random(Gtid_set *gs, Gno_set *model, int n)
+  {
+    ASSERT_EQ(RETURN_STATUS_OK, gs->ensure_sidno(sidno));
+    for (int i= 0; i < n; i++)
+    {
+      rpl_gno gno= 1 + rand() % MAX_TEST_GNO;
+      ASSERT_EQ(RETURN_STATUS_OK, gs->_add_gtid(sidno, gno));
+      model->insert(gno);
+    }
+  }
+
+  Sid_map sid_map;
+  rpl_sidno sidno;
+};
+
+
+TEST_F(GtidSetTest, AddRemoveGtid)
+{
+  Gtid_set gs(&sid_map);
+  Gno_set model;
+  ASSERT_EQ(RETURN_STATUS_OK, gs.ensure_sidno(sidno));
+  for (int i= 0; i < 5000; i++)
+  {
+    rpl_gno gno= 1 + rand() % MAX_TEST_GNO;
+    if (rand() % 3 == 0)
+    {
+      ASSERT_EQ(RETURN_STATUS_OK, gs._remove_gtid(sidno, gno));
+      model.erase(gno);
+    }
+    else
+    {
+      ASSERT_EQ(RETURN_STATUS_OK, gs._add_gtid(sidno, gno));
+      model.insert(gno);
+    }
+    if (i % 100 == 0)
+      check(gs, model);
+  }
+  check(gs, model);
+}
+
+
+TEST_F(GtidSetTest, AddRemoveGtidSet)
+{
+  for (int round= 0; round < 200; round++)
+  {
+    Gtid_set gs1(&sid_map), gs2(&sid_map);
+    Gno_set model1, model2;
+    fill_random(&gs1, &model1, rand() % 100);
+    fill_random(&gs2, &model2, rand() % 100);
+
+    bool subset= true, intersects= false;
+    for (Gno_set::iterator it= model1.begin(); it != model1.end(); ++it)
+    {
+      if (model2.count(*it))
+        intersects= true;
+      else
+        subset= false;
+    }
+    EXPECT_EQ(subset, gs1.is_subset(&gs2));
+    if (!model1.empty())
+      EXPECT_EQ(intersects, gs1.is_intersection_nonempty(&gs2));
+
+    Gtid_set sum(&sid_map), difference(&sid_map);
+    ASSERT_EQ(RETURN_STATUS_OK, sum.add_gtid_set(&gs1));
+    ASSERT_EQ(RETURN_STATUS_OK, sum.add_gtid_set(&gs2));
+    ASSERT_EQ(RETURN_STATUS_OK, difference.add_gtid_set(&gs1));
+    ASSERT_EQ(RETURN_STATUS_OK, difference.remove_gtid_set(&gs2));
+
+    Gno_set model_sum(model1), model_difference;
+    model_sum.insert(model2.begin(), model2.end());
+    for (Gno_set::iterator it= model1.begin(); it != model1.end(); ++it)
+      if (!model2.count(*it))
+        model_difference.insert(*it);
+    check(sum, model_sum);
+    check(difference, model_difference);
+    EXPECT_TRUE(gs2.is_subset(&sum));
+    EXPECT_TRUE(difference.is_subset(&gs1));
+  }
+}
+
+
+TEST_F(GtidSetTest, EncodeDecode)
+{
+  Gtid_set gs(&sid_map);
+  Gno_set model;
+  fill_random(&gs, &model, 150);
+
+  std::vector<uchar> buf(gs.get_encoded_length());
+  gs.encode(&buf[0]);
+
+  Gtid_set decoded(&sid_map);
+  ASSERT_EQ(RETURN_STATUS_OK,
+            decoded.add_gtid_encoding(&buf[0], buf.size()));
+  check(decoded, model);
+
+  char *text1, *text2;
+  gs.to_string(&text1);
+  decoded.to_string(&text2);
+  EXPECT_STREQ(text1, text2);
+  my_free(text1);
+  my_free(text2);
+
+  Gtid_set parsed(&sid_map);
+  gs.to_string(&text1);
+  ASSERT_EQ(RETURN_STATUS_OK, parsed.add_gtid_text(text1));
+  check(parsed, model);
+  my_free(text1);
+}
+
+}
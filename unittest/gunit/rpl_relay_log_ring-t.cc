@@ -0,0 +1,116 @@
+/* Copyright (c) 2016, Facebook, Inc. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA */
+
+// First include (the generated) my_config.h, to get correct platform defines.
+#include "my_config.h"
+#include <gtest/gtest.h>
+
+#include "rpl_relay_log_ring.h"
+
+#include <string>
+
+namespace rpl_relay_log_ring_unittest {
+
+static const uint open_count= 1;
+
+/* Add an event of len bytes at pos, filled with a byte derived from pos */
+static void add_event(Relay_log_ring *ring, my_off_t pos, uint len,
+                      ulonglong max_bytes)
+{
+  std::string event(len, (char) ('a' + pos % 26));
+  ring->add(open_count, pos, event.data(), len, max_bytes);
+}
+
+/* Take the event at pos and check its contents */
+static bool take_event(Relay_log_ring *ring, my_off_t pos, uint len)
+{
+  char *buf;
+  uint buf_len;
+  if (!ring->take(open_count, pos, &buf, &buf_len))
+    return false;
+  EXPECT_EQ(len, buf_len);
+  EXPECT_EQ(std::string(len, (char) ('a' + pos % 26)), std::string(buf, len));
+  EXPECT_EQ(0, buf[len]);
+  my_free(buf);
+  return true;
+}
+
+TEST(RelayLogRingTest, TakeInOrder)
+{
+  Relay_log_ring ring;
+  my_off_t pos= 4;
+  for (uint i= 1; i <= 10; i++)
+  {
+    add_event(&ring, pos, 10 * i, 10000);
+    pos+= 10 * i;
+  }
+  EXPECT_EQ(550U, ring.get_bytes());
+
+  pos= 4;
+  for (uint i= 1; i <= 10; i++)
+  {
+    EXPECT_TRUE(take_event(&ring, pos, 10 * i));
+    pos+= 10 * i;
+  }
+  EXPECT_FALSE(take_event(&ring, pos, 10));
+  EXPECT_EQ(0U, ring.get_bytes());
+}
+
+TEST(RelayLogRingTest, Eviction)
+{
+  Relay_log_ring ring;
+  for (my_off_t pos= 0; pos < 1000; pos+= 100)
+    add_event(&ring, pos, 100, 300);
+  EXPECT_EQ(300U, ring.get_bytes());
+
+  /* An applier that fell behind reads from the relay log */
+  EXPECT_FALSE(take_event(&ring, 0, 100));
+  EXPECT_FALSE(take_event(&ring, 600, 100));
+  /* Once it catches up it takes the remaining events */
+  EXPECT_TRUE(take_event(&ring, 700, 100));
+  EXPECT_TRUE(take_event(&ring, 800, 100));
+  EXPECT_TRUE(take_event(&ring, 900, 100));
+  EXPECT_EQ(0U, ring.get_bytes());
+}
+
+TEST(RelayLogRingTest, MissingEvents)
+{
+  Relay_log_ring ring;
+  add_event(&ring, 100, 50, 1000);
+  /* Too big to be added */
+  add_event(&ring, 150, 2000, 1000);
+  add_event(&ring, 2150, 50, 1000);
+
+  EXPECT_TRUE(take_event(&ring, 100, 50));
+  EXPECT_FALSE(take_event(&ring, 150, 2000));
+  EXPECT_TRUE(take_event(&ring, 2150, 50));
+}
+
+TEST(RelayLogRingTest, RotateAndDisable)
+{
+  Relay_log_ring ring;
+  add_event(&ring, 4, 100, 1000);
+  ring.add(open_count + 1, 4, "x", 1, 1000);
+  /* The entries of the old relay log are gone */
+  EXPECT_EQ(1U, ring.get_bytes());
+  EXPECT_FALSE(take_event(&ring, 4, 100));
+
+  add_event(&ring, 4, 100, 1000);
+  EXPECT_EQ(100U, ring.get_bytes());
+  add_event(&ring, 104, 100, 0);
+  EXPECT_EQ(0U, ring.get_bytes());
+}
+
+}
@@ -0,0 +1,252 @@
+/* Copyright (c) 2016, Facebook, Inc. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA */
+
+// First include (the generated) my_config.h, to get correct platform defines.
+#include "my_config.h"
+#include <gtest/gtest.h>
+
+#include <my_global.h>
+#include <m_ctype.h>
+
+#include <string>
+
+namespace strings_utf8mb4_unittest {
+
+/*
+  The utf8mb4 collation functions handle ASCII characters without decoding
+  them, and skip common ASCII prefixes a machine word at a time. The tests
+  below check that the results are the same as for the utf8 (utf8mb3)
+  functions, which decode every character, and that strings mixing ASCII
+  and multibyte characters are still handled at every offset.
+
+  The DISABLED_ tests are microbenchmarks, run them with
+  --gtest_also_run_disabled_tests.
+*/
+
+// Do each benchmark this many times. Increase value for benchmarking!
+static const int num_iterations= 10;
+
+static CHARSET_INFO *cs4= &my_charset_utf8mb4_general_ci;
+static CHARSET_INFO *cs3= &my_charset_utf8_general_ci;
+
+static int sign(int x)
+{
+  return x < 0 ? -1 : (x > 0 ? 1 : 0);
+}
+
+static int collsp(CHARSET_INFO *cs, const std::string &a, const std::string &b)
+{
+  return sign(cs->coll->strnncollsp(cs,
+                                    reinterpret_cast<const uchar*>(a.data()),
+                                    a.length(),
+                                    reinterpret_cast<const uchar*>(b.data()),
+                                    b.length(), false));
+}
+
+static int coll(CHARSET_INFO *cs, const std::string &a, const std::string &b)
+{
+  return sign(cs->coll->strnncoll(cs,
+                                  reinterpret_cast<const uchar*>(a.data()),
+                                  a.length(),
+                                  reinterpret_cast<const uchar*>(b.data()),
+                                  b.length(), false));
+}
+
+static void hash(CHARSET_INFO *cs, const std::string &a,
+                 ulong *nr1, ulong *nr2)
+{
+  *nr1= 1;
+  *nr2= 4;
+  cs->coll->hash_sort(cs, reinterpret_cast<const uchar*>(a.data()),
+                      a.length(), nr1, nr2);
+}
+
+static std::string xfrm(CHARSET_INFO *cs, const std::string &a, uint nweights)
+{
+  uchar buf[512];
+  size_t len= cs->coll->strnxfrm(cs, buf, sizeof(buf), nweights,
+                                 reinterpret_cast<const uchar*>(a.data()),
+                                 a.length(), MY_STRXFRM_PAD_WITH_SPACE);
+  return std::string(reinterpret_cast<const char*>(buf), len);
+}
+
+static bool like(CHARSET_INFO *cs, const std::string &a, const std::string &w)
+{
+  return cs->coll->wildcmp(cs, a.data(), a.data() + a.length(),
+                           w.data(), w.data() + w.length(),
+                           '\\', '_', '%') == 0;
+}
+
+/* Greek small and capital alpha in UTF-8 */
+static const char alpha[]= "\xCE\xB1";
+static const char ALPHA[]= "\xCE\x91";
+
+static const char *ascii_strings[]=
+{
+  "", " ", "a", "A", "abc", "ABC", "abd", "abc  ",
+  "the quick brown fox jumps over the lazy dog",
+  "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG",
+  "the quick brown fox jumps over the lazy dot",
+  "0123456789012345678901234567890123456789",
+  "01234567890123456789012345678901234567890",
+};
+
+TEST(StringsUtf8mb4Test, AsciiSameAsUtf8)
+{
+  const size_t n= array_elements(ascii_strings);
+  for (size_t i= 0; i < n; i++)
+  {
+    const std::string a(ascii_strings[i]);
+    ulong a4_1, a4_2, a3_1, a3_2;
+    hash(cs4, a, &a4_1, &a4_2);
+    hash(cs3, a, &a3_1, &a3_2);
+    EXPECT_EQ(a3_1, a4_1) << a;
+    EXPECT_EQ(xfrm(cs3, a, 64), xfrm(cs4, a, 64)) << a;
+
+    for (size_t j= 0; j < n; j++)
+    {
+      const std::string b(ascii_strings[j]);
+      EXPECT_EQ(collsp(cs3, a, b), collsp(cs4, a, b)) << a << " : " << b;
+      EXPECT_EQ(coll(cs3, a, b), coll(cs4, a, b)) << a << " : " << b;
+    }
+  }
+}
+
+TEST(StringsUtf8mb4Test, CaseAndTrailingSpace)
+{
+  EXPECT_EQ(0, collsp(cs4, "abc", "ABC"));
+  EXPECT_EQ(0, collsp(cs4, "abc", "abc   "));
+  EXPECT_EQ(-1, collsp(cs4, "abc", "abd"));
+  EXPECT_EQ(1, coll(cs4, "abc ", "abc"));
+
+  ulong a1, a2, b1, b2;
+  hash(cs4, "Hello World", &a1, &a2);
+  hash(cs4, "hello world  ", &b1, &b2);
+  EXPECT_EQ(a1, b1);
+  EXPECT_EQ(a2, b2);
+
+  const std::string w= xfrm(cs4, "aB", 2);
+  const uchar expected[]= { 0x00, 0x41, 0x00, 0x42 };
+  EXPECT_EQ(std::string(reinterpret_cast<const char*>(expected), 4), w);
+}
+
+/*
+  Put a multibyte character at every position of a string that is
+  otherwise ASCII, so that it falls before, inside and after the blocks
+  that the fast paths skip.
+*/
+TEST(StringsUtf8mb4Test, MixedAsciiMultibyte)
+{
+  const std::string base("abcdefghijklmnopqrstuvwxyz0123456789");
+  for (size_t pos= 0; pos <= base.length(); pos++)
+  {
+    std::string lower(base), upper(base), other(base);
+    lower.insert(pos, alpha);
+    upper.insert(pos, ALPHA);
+    other.insert(pos, "a");
+
+    for (size_t i= 0; i < upper.length(); i++)
+      upper[i]= (char) my_toupper(&my_charset_latin1, upper[i]);
+
+    EXPECT_EQ(0, collsp(cs4, lower, upper)) << pos;
+    EXPECT_EQ(collsp(cs3, lower, other), collsp(cs4, lower, other)) << pos;
+    EXPECT_EQ(collsp(cs3, other, lower), collsp(cs4, other, lower)) << pos;
+
+    ulong l1, l2, u1, u2, m1, m2;
+    hash(cs4, lower, &l1, &l2);
+    hash(cs4, upper, &u1, &u2);
+    hash(cs3, lower, &m1, &m2);
+    EXPECT_EQ(l1, u1) << pos;
+    EXPECT_EQ(m1, l1) << pos;
+
+    EXPECT_EQ(xfrm(cs3, lower, 64), xfrm(cs4, upper, 64)) << pos;
+
+    EXPECT_TRUE(like(cs4, lower, upper)) << pos;
+    EXPECT_TRUE(like(cs4, lower, std::string("%") + ALPHA + "%")) << pos;
+    EXPECT_FALSE(like(cs4, other, std::string("%") + ALPHA + "%")) << pos;
+  }
+}
+
+/*
+  The filename character set has mbminlen 1 but is not ASCII compatible:
+  '@' starts an escape sequence and most punctuation is invalid. The ASCII
+  fast paths of the shared unicode functions must not be used for it.
+*/
+TEST(StringsUtf8mb4Test, FilenameNotAscii)
+{
+  CHARSET_INFO *csf= &my_charset_filename;
+
+  EXPECT_EQ(xfrm(csf, "abc", 8), xfrm(csf, "a@0062c", 8));
+  EXPECT_EQ(xfrm(csf, "a", 8), xfrm(csf, "a-b", 8));
+  EXPECT_NE(xfrm(csf, "a@", 8), xfrm(csf, "a@0040", 8));
+
+  EXPECT_TRUE(like(csf, "a@0062c", "abc"));
+  EXPECT_TRUE(like(csf, "a@0062c", "a_c"));
+  EXPECT_FALSE(like(csf, "a@0062c", "a_____c"));
+}
+
+static std::string make_string(bool ascii)
+{
+  std::string s;
+  for (int i= 0; s.length() < 200; i++)
+  {
+    s.push_back('a' + i % 26);
+    if (!ascii && i % 16 == 15)
+      s.append(alpha);
+  }
+  return s;
+}
+
+static void benchmark_collsp(bool ascii)
+{
+  const std::string a= make_string(ascii);
+  std::string b(a);
+  b[b.length() - 1]= 'Z';
+  for (int i= 0; i < num_iterations * 100000; i++)
+    collsp(cs4, a, b);
+}
+
+static void benchmark_hash(bool ascii)
+{
+  const std::string a= make_string(ascii);
+  ulong nr1, nr2;
+  for (int i= 0; i < num_iterations * 100000; i++)
+    hash(cs4, a, &nr1, &nr2);
+}
+
+static void benchmark_xfrm(bool ascii)
+{
+  const std::string a= make_string(ascii);
+  for (int i= 0; i < num_iterations * 100000; i++)
+    xfrm(cs4, a, 200);
+}
+
+static void benchmark_like(bool ascii)
+{
+  const std::string a= make_string(ascii);
+  for (int i= 0; i < num_iterations * 100000; i++)
+    like(cs4, a, "%xyz%0");
+}
+
+TEST(StringsUtf8mb4Test, DISABLED_StrnncollspAscii) { benchmark_collsp(true); }
+TEST(StringsUtf8mb4Test, DISABLED_StrnncollspMixed) { benchmark_collsp(false); }
+TEST(StringsUtf8mb4Test, DISABLED_HashSortAscii) { benchmark_hash(true); }
+TEST(StringsUtf8mb4Test, DISABLED_HashSortMixed) { benchmark_hash(false); }
+TEST(StringsUtf8mb4Test, DISABLED_StrnxfrmAscii) { benchmark_xfrm(true); }
+TEST(StringsUtf8mb4Test, DISABLED_StrnxfrmMixed) { benchmark_xfrm(false); }
+TEST(StringsUtf8mb4Test, DISABLED_WildcmpAscii) { benchmark_like(true); }
+TEST(StringsUtf8mb4Test, DISABLED_WildcmpMixed) { benchmark_like(false); }
+
+}